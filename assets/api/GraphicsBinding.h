@@ -63,11 +63,44 @@ extern "C"
 		float ty;
 	} wosC_gfx_vertex_t;
 
+	typedef struct
+	{
+		double x;
+		double y;
+		double w;
+		double h;
+	} wosC_gfx_rectangle_t;
+
 	typedef struct
 	{
 		double matrix[9];
 	} wosC_gfx_transform_t;
 
+	/**
+	 * Filled circle for batched drawing. The color is packed as for vertices.
+	 */
+	typedef struct
+	{
+		float x;
+		float y;
+		float radius;
+		int32_t color;
+	} wosC_gfx_circle_t;
+
+	/**
+	 * Line segment for batched drawing, with its width linearly interpolated between the two endpoints.
+	 */
+	typedef struct
+	{
+		float x1;
+		float y1;
+		float x2;
+		float y2;
+		float width1;
+		float width2;
+		int32_t color;
+	} wosC_gfx_line_t;
+
 
 	WOSC_API wosC_gfx_imageID_t wosC_gfx_loadImage(wosC_gfx_t gfxID, const char * name);
 	WOSC_API void wosC_gfx_unloadImage(wosC_gfx_t gfxID, wosC_gfx_imageID_t imageID);
@@ -109,6 +142,67 @@ extern "C"
 	                                    wosC_gfx_vertexBuffer_size_t vertexOffset,
 	                                    wosC_gfx_vertexBuffer_size_t vertexCount, wosC_gfx_vertex_t * vertices);
 
+	/**
+	 * Makes room for 'vertexCount' vertices at the specified vertex offset (at most the buffer size), growing the
+	 * buffer geometrically, and returns a pointer to the first of them for writing the vertices in place. Colors are
+	 * stored as in wosC_gfx_writeVertices.
+	 *
+	 * The buffer holds all reserved vertices until wosC_gfx_commitVertices drops the unused ones. The pointer is
+	 * invalidated by any other call modifying the buffer. Returns a null pointer for invalid buffers or offsets.
+	 */
+	WOSC_API wosC_gfx_vertex_t * wosC_gfx_reserveVertices(wosC_gfx_t gfxID, wosC_gfx_vertexBuffer_t vbufferID,
+	                                                      wosC_gfx_vertexBuffer_size_t vertexOffset,
+	                                                      wosC_gfx_vertexBuffer_size_t vertexCount);
+
+	/**
+	 * Finishes writing 'vertexCount' vertices at the specified offset into reserved vertices, truncating the buffer
+	 * after them.
+	 */
+	WOSC_API void wosC_gfx_commitVertices(wosC_gfx_t gfxID, wosC_gfx_vertexBuffer_t vbufferID,
+	                                      wosC_gfx_vertexBuffer_size_t vertexOffset,
+	                                      wosC_gfx_vertexBuffer_size_t vertexCount);
+
+	/**
+	 * Tessellates the specified circles into untextured triangles, starting at the specified vertex offset. The
+	 * number of segments adapts to each circle's radius, up to 'maxSegments'. A non-zero 'feather' adds an
+	 * anti-aliased edge of the specified width (in pixels), fading out to full transparency.
+	 *
+	 * The output is padded with a degenerate triangle to a multiple of 6 vertices, as only whole quads are drawn.
+	 * Returns the number of vertices written.
+	 */
+	WOSC_API wosC_gfx_vertexBuffer_size_t wosC_gfx_writeCircles(wosC_gfx_t gfxID, wosC_gfx_vertexBuffer_t vbufferID,
+	                                                            wosC_gfx_vertexBuffer_size_t vertexOffset,
+	                                                            const wosC_gfx_circle_t * circles,
+	                                                            wosC_gfx_vertexBuffer_size_t circleCount,
+	                                                            wosC_gfx_vertexBuffer_size_t maxSegments, double feather);
+
+	/**
+	 * Tessellates the specified line segments into untextured triangles, starting at the specified vertex offset. A
+	 * non-zero 'feather' adds anti-aliased edges along both sides of each segment.
+	 *
+	 * Returns the number of vertices written.
+	 */
+	WOSC_API wosC_gfx_vertexBuffer_size_t wosC_gfx_writeLines(wosC_gfx_t gfxID, wosC_gfx_vertexBuffer_t vbufferID,
+	                                                          wosC_gfx_vertexBuffer_size_t vertexOffset,
+	                                                          const wosC_gfx_line_t * lines,
+	                                                          wosC_gfx_vertexBuffer_size_t lineCount, double feather);
+
+	/**
+	 * Returns the number of vertices that wosC_gfx_writeCircles would write for the specified circles.
+	 */
+	WOSC_API wosC_gfx_vertexBuffer_size_t wosC_gfx_countCircleVertices(wosC_gfx_t gfxID,
+	                                                                   const wosC_gfx_circle_t * circles,
+	                                                                   wosC_gfx_vertexBuffer_size_t circleCount,
+	                                                                   wosC_gfx_vertexBuffer_size_t maxSegments,
+	                                                                   double feather);
+
+	/**
+	 * Returns the number of vertices that wosC_gfx_writeLines would write for the specified number of lines.
+	 */
+	WOSC_API wosC_gfx_vertexBuffer_size_t wosC_gfx_countLineVertices(wosC_gfx_t gfxID,
+	                                                                 wosC_gfx_vertexBuffer_size_t lineCount,
+	                                                                 double feather);
+
 	WOSC_API void wosC_gfx_writeVertexTextureIDs(wosC_gfx_t gfxID, wosC_gfx_vertexBuffer_t vbufferID,
 	                                             wosC_gfx_vertexBuffer_size_t vertexOffset,
 	                                             wosC_gfx_vertexBuffer_size_t textureIDCount,
@@ -130,12 +224,20 @@ extern "C"
 	                                    const wosC_gfx_transform_t * transform);
 	WOSC_API const wosC_gfx_transform_t * wosC_gfx_getTransform(wosC_gfx_t gfxID, wosC_gfx_vertexBuffer_t vbufferID);
 
+	WOSC_API void wosC_gfx_setClippingRectangle(wosC_gfx_t gfxID, wosC_gfx_vertexBuffer_t vbufferID,
+	                                            const wosC_gfx_rectangle_t * rect);
+	WOSC_API const wosC_gfx_rectangle_t * wosC_gfx_getClippingRectangle(wosC_gfx_t gfxID,
+	                                                                    wosC_gfx_vertexBuffer_t vbufferID);
+
 	WOSC_API void wosC_gfx_sortBuffer(wosC_gfx_t gfxID, wosC_gfx_vertexBuffer_t vbufferID);
 	WOSC_API void wosC_gfx_mergeSortedBuffers(wosC_gfx_t gfxID, const wosC_gfx_vertexBuffer_t * sourceIDs,
 	                                          wosC_gfx_vertexBuffer_size_t sourceCount,
 	                                          wosC_gfx_vertexBuffer_t targetID);
 
 	WOSC_API void wosC_gfx_drawVertexBuffer(wosC_gfx_t gfxID, wosC_gfx_vertexBuffer_t vbufferID);
+	WOSC_API void wosC_gfx_drawVertexBufferRange(wosC_gfx_t gfxID, wosC_gfx_vertexBuffer_t vbufferID,
+	                                             wosC_gfx_vertexBuffer_size_t vertexOffset,
+	                                             wosC_gfx_vertexBuffer_size_t vertexCount);
 }
 
 #endif
@@ -1,15 +1,11 @@
 local draw = {}
 
 local gfx = require "system.game.Graphics"
-local vector2 = require "system.utils.Vector2"
 local color = require "system.utils.Color"
 local orderedSelector = require "system.events.OrderedSelector"
 
-local drawTriangle = gfx.drawTriangle
 local drawTriangleGradient = gfx.drawTriangleGradient
 
-local pi = math.pi
-
 local themeSelector = orderedSelector.new(event.themeChanged, {
 	"colorConstants",
 	"colors"
@@ -131,6 +127,61 @@ local function updateTheme()
 	end
 end
 
+-- Circles and lines are tessellated natively. Outside of draw.beginBatch/draw.endBatch, each primitive is written
+-- immediately; inside, consecutive primitives of the same kind and settings are collected and written with one call.
+local circleBatch = gfx.newCircleBatch(1024)
+local lineBatch = gfx.newLineBatch(1024)
+
+local batching = false
+local pendingBatch
+local pendingSegments
+local pendingFeather
+
+local function flushPrimitives()
+	if pendingBatch == circleBatch then
+		circleBatch.draw(pendingSegments, pendingFeather)
+	elseif pendingBatch == lineBatch then
+		lineBatch.draw(pendingFeather)
+	end
+	pendingBatch = nil
+end
+
+local function selectBatch(batch, segments, feather)
+	if pendingBatch ~= batch or pendingSegments ~= segments or pendingFeather ~= feather then
+		flushPrimitives()
+		pendingBatch, pendingSegments, pendingFeather = batch, segments, feather
+	end
+	return batch
+end
+
+local function submitPrimitive()
+	if not batching then
+		flushPrimitives()
+	end
+end
+
+local function getFeather(smooth)
+	return smooth and 1 or 0
+end
+
+--- Starts collecting circles and lines, so that runs of them are tessellated with a single native call.
+--- Other drawing functions in this module flush the collected primitives first to preserve the drawing order; direct
+--- calls to the graphics module must be preceded by draw.endBatch or draw.flush.
+function draw.beginBatch()
+	batching = true
+end
+
+--- Writes all collected circles and lines
+function draw.flush()
+	flushPrimitives()
+end
+
+--- Writes all collected circles and lines and stops collecting
+function draw.endBatch()
+	flushPrimitives()
+	batching = false
+end
+
 local function drawText(args, extraArgs)
 	if type(args) ~= "table" then
 		error("Invalid argument (expected table, got '" .. type(args) .. "')", 2)
@@ -161,6 +212,8 @@ local function drawText(args, extraArgs)
 		for k, v in pairs(extraArgs) do
 			textInfo[k] = v
 		end
+	elseif pendingBatch then
+		flushPrimitives()
 	end
 
 	return gfx.drawText(textInfo)
@@ -175,33 +228,23 @@ function draw.measureText(args)
 end
 
 function draw.rect(r, col)
+	flushPrimitives()
 	return gfx.drawRect(r, col)
 end
 
 function draw.rectGradient(r, color1, color2, vertical)
+	flushPrimitives()
 	local topLeft, bottomRight = r:topLeft(), r:bottomRight()
 	drawTriangleGradient(topLeft, r:topRight(), bottomRight, color1, vertical and color1 or color2, color2)
 	drawTriangleGradient(topLeft, bottomRight, r:bottomLeft(), color1, color2, vertical and color2 or color1)
 end
 
-function draw.line(p1, p2, col, thicknessStart, thicknessEnd)
+function draw.line(p1, p2, col, thicknessStart, thicknessEnd, smooth)
 	thicknessStart = thicknessStart or 1
 	thicknessEnd = thicknessEnd or thicknessStart
 
-	local direction = p2 - p1
-	local unitDirection = direction:normalize()
-	local unitPerpendicular = vector2(-unitDirection.y, unitDirection.x)
-
-	local offsetStart = unitPerpendicular * (thicknessStart * 0.5)
-	local offsetEnd = unitPerpendicular * (thicknessEnd * 0.5)
-
-	local v1 = p1 + offsetStart
-	local v2 = p1 - offsetStart
-	local v3 = p2 - offsetEnd
-	local v4 = p2 + offsetEnd
-
-	drawTriangle(v1, v2, v3, col)
-	drawTriangle(v1, v3, v4, col)
+	selectBatch(lineBatch, nil, getFeather(smooth)).add(p1.x, p1.y, p2.x, p2.y, thicknessStart, thicknessEnd, col)
+	submitPrimitive()
 end
 
 function draw.lineCapped(p1, p2, col, thickness, pointiness, arrow1, arrow2)
@@ -214,43 +257,11 @@ function draw.lineCapped(p1, p2, col, thickness, pointiness, arrow1, arrow2)
 	draw.line(p2, p2 - (p1 - p2):normalize() * pointiness * arrow2, col, arrow2, 0)
 end
 
-local function circlePoint(center, radius, fraction)
-	return vector2(radius, 0):rotate(fraction) + center
-end
-
+--- Draws a filled circle. The segment count is an upper bound; small circles use fewer segments. Smooth circles get
+--- an anti-aliased edge.
 function draw.circle(center, radius, col, segments, smooth)
-	smooth = smooth or false
-	if (not smooth) then
-		-- draw circle with the help of triangles
-		segments = segments or 25
-		local multiplier = 2 * pi / segments
-		local v1 = center
-		for i = 1, segments do
-			local v2 = circlePoint(center, radius, i * multiplier)
-			local v3 = circlePoint(center, radius, (i + 1) * multiplier)
-			drawTriangle(v1, v2, v3, col)
-		end
-	else
-		-- at the border, set single pixels for smoothing
-		local border = 2
-		local size = math.ceil(radius) + border
-		local smoothing_per_one = 1 / 2
-		local center_int = vector2(math.floor(center.x + 0.5), math.floor(center.y + 0.5))
-		for i = -size, size do
-			for j = -size, size do
-				local distance = math.sqrt((center_int.x + i - center.x)^2 + (center_int.y + j - center.y)^2)
-				--if (distance > radius) then
-					distance = distance - radius + border
-					if (distance < border) then
-						local alpha = math.min(1, math.max(0, 1 - smoothing_per_one * distance))
-						if (alpha > 0) then
-							gfx.drawVertex(center_int + vector2(i, j), color.setA(col, color.getA(col) * alpha))
-						end
-					end
-				--end
-			end
-		end
-	end
+	selectBatch(circleBatch, segments or 25, getFeather(smooth)).add(center.x, center.y, radius, col)
+	submitPrimitive()
 end
 
 function draw.colorWithAlpha(col, alpha)
@@ -1,21 +1,116 @@
 ---@diagnostic disable: need-check-nil
-local fileIO = require "system.game.FileIO"
-local framebuffer = require "system.game.Framebuffer"
+local frameSequence = require "system.game.FrameSequence"
 local gfx = require "system.game.Graphics"
 local input = require "system.game.Input"
+local retainedScene = require "system.game.RetainedScene"
 
+local array = require "system.utils.Array"
 local color = require "system.utils.Color"
 local timer = require "system.utils.Timer"
 local utils = require "system.utils.Utilities"
 local vector2 = require "system.utils.Vector2"
 
-local svglib = require "luavis.vis.SVG"
+local flowGraph = require "system.accel.FlowGraph"
+local frameAnalyzer = require "system.accel.FrameAnalyzer"
+local frameIndex = require "system.accel.FrameIndex"
+local graphFile = require "system.accel.GraphFile"
+local graphLOD = require "system.accel.GraphLOD"
+local layout = require "system.accel.Layout"
+local metricReduction = require "system.accel.Metrics"
+local spatialIndex = require "system.accel.SpatialIndex"
+local svgWriter = require "system.accel.SVGWriter"
+local timeIndex = require "system.accel.TimeIndex"
+local topology = require "system.accel.Topology"
+
 local draw = require "luavis.vis.Draw"
 
+local scriptLoader = require "core.ScriptLoader"
+
 -- ----------------------------------------------------------
 -- Settings to change input dataset and layout.
 -- ----------------------------------------------------------
-local graphData = dofile("assets/scripts/luavis/vis/example/graph.lua")
+local graphPath = "assets/scripts/luavis/vis/example/graph"
+
+-- Without any graph file, the graph is extracted from the segmented frames in this resource directory instead
+local extractImgDir = "scripts/luavis/vis/example/data"
+
+-- Gray level ranges of invading fluid and solid in the frames (see system.accel.FlowGraph), used for graph extraction
+-- and pixel-level frame statistics
+local segmentationSettings = {}
+
+-- Prefer the binary columnar version of the graph (see system.accel.GraphFile), falling back to the Lua file
+local graphBinary = graphFile.load(graphPath .. ".lvg")
+local graphSource = io.open(graphPath .. ".lua")
+if graphSource then
+	graphSource:close()
+elseif not graphBinary and extractImgDir then
+	-- The graph is extracted in the background, and the visualization is reloaded once it is ready
+	graphBinary = extractedGraph
+	if not graphBinary and not graphExtraction then
+		graphExtraction = assert(flowGraph.start(extractImgDir, segmentationSettings))
+	end
+end
+
+-- Reload the visualization whenever a running simulation rewrites the graph file
+if graphWatch then
+	graphWatch.destroy()
+end
+graphWatch = frameIndex.new(graphPath:match("^(.*)/[^/]*$") or ".", "", 1)
+
+event.cycle.add("graphLiveReload", "autoReload", function ()
+	for _, change in ipairs(graphWatch and graphWatch.poll() or {}) do
+		if change.type ~= "removed" and (change.path == graphPath .. ".lvg" or change.path == graphPath .. ".lua") then
+			scriptLoader.loadScript("luavis.vis.Graph")
+			return
+		end
+	end
+end)
+
+if not graphBinary and graphExtraction then
+	local extractionError
+
+	event.cycle.add("graphExtraction", "tick", function ()
+		if not graphExtraction or not select(3, graphExtraction.getProgress()) then
+			return
+		end
+
+		local graph, err = graphExtraction.getGraph()
+		graphExtraction.destroy()
+		graphExtraction = nil
+
+		if not graph then
+			extractionError = err
+			log.error("Failed to extract graph: %s", err)
+			return
+		end
+
+		extractedGraph = graph
+		scriptLoader.loadScript("luavis.vis.Graph")
+	end)
+
+	event.render.add("graphExtraction", "vis", function ()
+		local text = "Failed to extract graph: " .. tostring(extractionError)
+		if graphExtraction then
+			local processed, total = graphExtraction.getProgress()
+			text = "Extracting graph: frame " .. processed .. " / " .. total
+		end
+
+		draw.text {
+			font = draw.Font.SEGOE_SEMIBOLD,
+			text = text,
+			x = gfx.getWidth() / 2,
+			y = gfx.getHeight() / 2,
+			size = gfx.getWidth() / 40,
+			fillColor = color.rgb(100, 150, 255),
+			alignX = 0.5,
+			alignY = 0.5,
+		}
+	end)
+
+	return
+end
+
+local graphData = graphBinary and graphBinary.toGraphData() or dofile(graphPath .. ".lua")
 
 local imgDir = graphData.imgDir
 local rightToLeft = true
@@ -82,9 +177,14 @@ setKey({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, "activeMetricID", 1, function(key, name)
 local exportMetrics -- forward defined function
 setKey("M", "exportMetrics", nil, function() exportMetrics() end)
 
-local ForceAtlas2Loop -- forward defined function
+local ForceAtlas2Update -- forward defined function
 setKey("Q", "forceAtlas2running", true, toggle)
 
+-- Cycles between the detailed graph (0) and increasingly coarse cluster overviews
+local lodLevelCount = 6
+setKey("K", "lodLevel", 0, function(_, name)
+	settings[name] = (settings[name] + 1) % (lodLevelCount + 1) end)
+
 -- ----------------------------------------------------------
 -- Parse input path and set layout.
 -- ----------------------------------------------------------
@@ -124,23 +224,23 @@ pcall(function ()
 	breakthroughThreshold = graphData.btt
 end)
 
-local nodes = utils.deepCopy(graphData.Nodes)
-local edges = utils.deepCopy(graphData.Edges)
+local nodes
+local edges = graphData.Edges
+
+if graphBinary then
+	nodes = graphBinary.readNodes()
+else
+	nodes = {}
+	for i, entry in ipairs(graphData.Nodes) do
+		local node = {}
+		for index, column in ipairs(graphFile.NodeColumns) do
+			node[column.name] = entry[index]
+		end
+		nodes[i] = node
+	end
+end
 
 for _, node in ipairs(nodes) do
-	local function move(dst, src) node[dst], node[src] = node[src], nil end
-
-	-- values stored in the graph file
-	move("Time", 1)
-	move("Id", 2)
-	move("X", 3)
-	move("Y", 4)
-	move("Velocity", 5)
-	move("Modified", 6)
-	move("Area", 7)
-	move("EdgesIn", 8)
-	move("EdgesOut", 9)
-
 	-- values calculated and stored later on
 	node["Pos"] = false
 	node["Rad"] = false
@@ -158,53 +258,51 @@ for _, node in ipairs(nodes) do
 	node["Layouts"] = {
 		MainChannel = { Pos = false, Index = 0 },
 		SimpleBreakthrough = { Pos = false },
-		ForceAtlas2 = { Pos = false, mass = false, old_d = false, d = false },
+		ForceAtlas2 = { Index = false },
 	}
-	node["Parents"] = {}
-	node["Children"] = {}
 end
 
--- set up 1-to-1 parent-child relationships with respective largest areas,
--- thus, covering the main channels implicitly
-for i = 1, #edges, 2 do
-	local src, dest = nodes[edges[i] + 1], nodes[edges[i + 1] + 1]
-	local parent = nodes[dest.Parent]
-	local child = nodes[src.Child]
-	if not parent or parent.Area < src.Area then
-		dest.Parent = src.Id + 1
+-- ----------------------------------------------------------
+-- Derive parent/child links, lineages and the simplified graph natively.
+-- ----------------------------------------------------------
+local nodeColumns = graphBinary and graphBinary.columns
+if not nodeColumns then
+	nodeColumns = {
+		Edges = array.new(array.Type.INT32, #edges),
+		Area = array.new(array.Type.DOUBLE, #nodes),
+		Time = array.new(array.Type.INT32, #nodes),
+		X = array.new(array.Type.DOUBLE, #nodes),
+		Y = array.new(array.Type.DOUBLE, #nodes),
+	}
+	for i = 1, #edges do
+		nodeColumns.Edges[i - 1] = edges[i]
 	end
-	if not child or child.Area < dest.Area then
-		src.Child = dest.Id + 1
+	for i, node in ipairs(nodes) do
+		nodeColumns.Area[i - 1] = node.Area
+		nodeColumns.Time[i - 1] = node.Time
+		nodeColumns.X[i - 1] = node.X
+		nodeColumns.Y[i - 1] = node.Y
 	end
-	table.insert(src.Children, dest.Id + 1)
-	table.insert(dest.Parents, src.Id + 1)
 end
 
---
-local simplifiedNodes = {}
-local simplifiedEdges = {}
-
-local tempNodes = {}
-
-for i = 1, #edges, 2 do
-	local src, dst = nodes[edges[i] + 1], nodes[edges[i + 1] + 1]
+local topo = assert(topology.build(nodeColumns.Edges, nodeColumns.Area, nodeColumns.Time, nodeColumns.X,
+	nodeColumns.Y))
 
-	while src.EdgesIn == 1 and src.EdgesOut == 1 do
-		src = nodes[src.Parent]
-	end
-	while dst.EdgesIn == 1 and dst.EdgesOut == 1 do
-		dst = nodes[dst.Child]
-	end
-
-	tempNodes[src.Id + 1] = src
-	tempNodes[dst.Id + 1] = dst
-
-	table.insert(simplifiedEdges, src.Id + 1)
-	table.insert(simplifiedEdges, dst.Id + 1)
+-- Parent and child are the 1-to-1 relationships with the respective largest areas, thus covering the main channels
+-- implicitly. The lineage ID is shared along these relationships.
+for i, node in ipairs(nodes) do
+	local parent = topo.parents[i - 1]
+	local child = topo.children[i - 1]
+	node.Parent = parent >= 0 and parent + 1
+	node.Child = child >= 0 and child + 1
+	node.Uid = topo.lineages[i - 1]
 end
 
-for _, node in pairs(tempNodes) do
-	table.insert(simplifiedNodes, node)
+-- The simplified graph collapses chains of nodes with one incoming and one outgoing edge. Its edges are stored as
+-- zero-based node index pairs in topo.simplifiedEdges.
+local simplifiedNodes = {}
+for i = 1, topo.simplifiedNodeCount do
+	simplifiedNodes[i] = nodes[topo.simplifiedNodes[i - 1] + 1]
 end
 
 -- 
@@ -215,56 +313,19 @@ for _, node in ipairs(nodes) do
 	table.insert(nodesByTime[node.Time], node)
 end
 
--- 
-local currentUID = 0
-local function nextUID()
-	currentUID = currentUID + 1
-	return currentUID
-end
-
-function spairs(t, order)
-    -- collect the keys
-    local keys = {}
-    for k in pairs(t) do keys[#keys+1] = k end
-
-    -- if order function given, sort by it by passing the table and keys a, b,
-    -- otherwise just sort the keys 
-    if order then
-        table.sort(keys, function(a,b) return order(t, a, b) end)
-    else
-        table.sort(keys)
-    end
-
-    -- return the iterator function
-    local i = 0
-    return function()
-        i = i + 1
-        if keys[i] then
-            return keys[i], t[keys[i]]
-        end
-    end
-end
-
-for _, node in spairs(nodes, function(t, a, b) return t[a].Time < t[b].Time end) do
-	local parent = nodes[node.Parent]
-	--node.Uid = parent and (parent.Child == (node.Id + 1) and parent.EdgesOut == 1) and parent.Uid or nextUID()
-	node.Uid = parent and (parent.Child == (node.Id + 1)) and parent.Uid or nextUID()
-end
-
 -- 
 local mainChannelLength = 0
 
-local function traceMainChannel(node, index)
-	index = index or 0
-	if node then
-		node.Break = true
-		node.Index = index
-		if nodes[node.Parent] then
-			local distance = math.sqrt((node.X - nodes[node.Parent].X)^2 + (node.Y - nodes[node.Parent].Y)^2)
-			mainChannelLength = mainChannelLength + distance
-			nodes[node.Parent].Layouts.MainChannel.Pos = node.Layouts.MainChannel.Pos + distance
+local function traceMainChannel(node)
+	local startPos = node.Layouts.MainChannel.Pos
+	mainChannelLength = topo.traceMainChannel(node.Id) or 0
+	for i, channelNode in ipairs(nodes) do
+		local index = topo.channelIndices[i - 1]
+		if index >= 0 then
+			channelNode.Break = true
+			channelNode.Index = index
+			channelNode.Layouts.MainChannel.Pos = startPos + topo.channelDistances[i - 1]
 		end
-		return traceMainChannel(nodes[node.Parent], index + 1)
 	end
 end
 
@@ -290,24 +351,54 @@ pcall(function ()
 	end
 end)
 
---
-local allNodes = {}
-local liveNodes = {}
-local allPreBreakNodes = {}
-local livePreBreakNodes = {}
+-- Drawn nodes and links are kept in time order, so that the items up to a time step and the items of one time step
+-- are contiguous ranges of each list (see system.accel.TimeIndex). Hiding unreached or post-breakthrough items thus
+-- reduces to drawing a prefix of the scenes.
+local function newTimeOrderedList(items, times)
+	if not times then
+		times = array.new(array.Type.INT32, #items)
+		for i, item in ipairs(items) do
+			times[i - 1] = item.Time or item.time
+		end
+	end
 
-for i, node in ipairs(nodes) do
-	allNodes[#allNodes + 1] = i
+	local index = assert(timeIndex.build(times))
+	local list = {index = index}
+	for i = 1, #items do
+		list[i] = items[index.order[i - 1] + 1]
+	end
+	return list
+end
+
+local allNodes = newTimeOrderedList(nodes, nodeColumns.Time)
+local liveNodes = {}
+for _, node in ipairs(nodes) do
 	if not (node.EdgesIn == 1 and node.EdgesOut == 1) then
-		liveNodes[#liveNodes + 1] = i
-		if node.Time <= breakthrough then
-			livePreBreakNodes[#livePreBreakNodes + 1] = i
-		end
+		liveNodes[#liveNodes + 1] = node
 	end
-	if node.Time <= breakthrough then
-		allPreBreakNodes[#allPreBreakNodes + 1] = i
+end
+liveNodes = newTimeOrderedList(liveNodes)
+local simplifiedNodeList = newTimeOrderedList(simplifiedNodes)
+
+local links = {}
+for i = 1, #edges, 2 do
+	local src = nodes[edges[i] + 1]
+	local dst = nodes[edges[i + 1] + 1]
+	if src.X ~= 0 or src.Y ~= 0 then
+		links[#links + 1] = {source = src, dest = dst, time = dst.Time}
 	end
 end
+links = newTimeOrderedList(links)
+
+local simplifiedLinks = {}
+for i = 1, topo.simplifiedEdgeCount do
+	local src = nodes[topo.simplifiedEdges[i * 2 - 2] + 1]
+	local dst = nodes[topo.simplifiedEdges[i * 2 - 1] + 1]
+	if src.X ~= 0 or src.Y ~= 0 then
+		simplifiedLinks[#simplifiedLinks + 1] = {source = src, dest = dst, time = dst.Time}
+	end
+end
+simplifiedLinks = newTimeOrderedList(simplifiedLinks)
 
 -- ----------------------------------------------------------
 -- Create metrics based on graph information.
@@ -315,48 +406,64 @@ end
 local metrics = {}
 local metricData = {}
 
-local function binOpAdd(v1, v2)
-	return (v1 or 0) + (v2 or 0)
-end
+local Operation = metricReduction.Operation
 
-local function binOpMax(v1, v2)
-	v1 = v1 or 0
-	v2 = v2 or 0
+-- Per-node time steps and a scratch value column, reduced natively into one bucket per time step
+local nodeTimes = nodeColumns.Time
+local nodeValues = array.new(array.Type.DOUBLE, #nodes)
+local minTime, maxTime = 0, -1
 
-	return math.max(v1, v2)
+for i = 1, #nodes do
+	local time = nodes[i].Time
+	if i == 1 or time < minTime then minTime = time end
+	if i == 1 or time > maxTime then maxTime = time end
 end
 
-local function makeMetric(name, func, binOp, createRaw)
-	local metric = {}
+local timeBucketCount = maxTime - minTime + 1
+local bucketValues = array.new(array.Type.DOUBLE, timeBucketCount)
+local bucketCounts = array.new(array.Type.INT32, timeBucketCount)
+
+local function makeMetric(name, func, operation, createRaw)
+	local metric
 	local raw = {}
+	local maxValue = -math.huge
+	local minValue = math.huge
+	local maxRaw = -math.huge
+	local minRaw = math.huge
 	if createRaw == nil then createRaw = true end
 	if type(func) == "function" then
-		binOp = binOp or binOpAdd
+		-- Missing values are passed as NaN, which still creates the metric entry for the node's time step
+		local nan = 0 / 0
 		for i = 1, #nodes do
-			local node = nodes[i]
-			local ts = node.Time + 1
-			local value = func(node)
-			metric[ts] = binOp(value, metric[ts])
+			local value = func(nodes[i])
+			nodeValues[i - 1] = value or nan
 			raw[i] = value
 		end
+
+		local result, counts, stats = metricReduction.reduce(operation or Operation.SUM, nodeTimes, nodeValues,
+			timeBucketCount, {timeOffset = minTime, result = bucketValues, counts = bucketCounts})
+		if result then
+			-- Time step t is stored at index t + 1
+			metric = metricReduction.toTable(result, counts, minTime + 1)
+			if stats.populatedBuckets > 0 then
+				minValue, maxValue = stats.min, stats.max
+			end
+			if next(raw) then
+				minRaw, maxRaw = stats.valueMin, stats.valueMax
+			end
+		else
+			log.error("Failed to compute metric '%s': %s", name, counts)
+			metric = {}
+		end
 	else
 		metric = func
+		for k, v in pairs(metric) do
+			minValue = math.min(minValue, v)
+			maxValue = math.max(maxValue, v)
+		end
 	end
 	id = #metrics + 1
 	metrics[id] = metric
-	local maxValue = -math.huge
-	local minValue = math.huge
-	local min, max = math.min, math.max
-	for k, v in pairs(metric) do
-		minValue = min(minValue, v)
-		maxValue = max(maxValue, v)
-	end
-	local maxRaw = -math.huge
-	local minRaw = math.huge
-	for k, v in pairs(raw) do
-		minRaw = min(minRaw, v)
-		maxRaw = max(maxRaw, v)
-	end
 	metricData[id] = {
 		id = id,
 		min = minValue,
@@ -417,7 +524,7 @@ if graphData.Interfaces then
 		-- Weigh velocity proportionally to fluid interface of each node
 		-- because we want to get an average, and not a sum
 		return node.Velocity * nodeFluidProportion[node.Id + 1]
-	end, binOpAdd, false)
+	end, Operation.SUM, false)
 end
 
 if graphData.Velocities then
@@ -450,11 +557,11 @@ end
 
 local metMaxEdgesIn = makeMetric("Max. incoming edges", function (node)
 	return node.EdgesIn
-end, binOpMax, false)
+end, Operation.MAX, false)
 
 local metMaxEdgesOut = makeMetric("Max. outgoing edges", function (node)
 	return node.EdgesOut
-end, binOpMax, false)
+end, Operation.MAX, false)
 
 local metMainArea = makeMetric("Main Channel Area", function (node)
 	return node.Break and node.Area or 0
@@ -470,6 +577,38 @@ do
 	makeMetric("Main Channel Area Ratio", ratio)
 end
 
+-- Pixel-level statistics of the frames are computed in the background (and cached on disk), and added as metrics once
+-- all frames are done
+if frameAnalysis then
+	frameAnalysis.destroy()
+end
+frameAnalysis = imgDir and frameAnalyzer.start(imgDir, segmentationSettings)
+
+event.cycle.add("frameAnalysis", "tick", function ()
+	if not frameAnalysis or not select(3, frameAnalysis.getProgress()) then
+		return
+	end
+
+	local statistics, err = frameAnalysis.getStatistics()
+	frameAnalysis.destroy()
+	frameAnalysis = nil
+
+	if not statistics then
+		log.error("Failed to analyze frames: %s", err)
+		return
+	end
+
+	-- The front is the fluid pixel furthest from the inlet side
+	local front = frameAnalyzer.toMetric(rightToLeft and statistics.FrontLeft or statistics.FrontRight)
+	for ts, value in pairs(front) do
+		front[ts] = value < 0 and 0 or (rightToLeft and 1 - value or value)
+	end
+
+	makeMetric("Saturation", frameAnalyzer.toMetric(statistics.Saturation))
+	makeMetric("Front position", front)
+	makeMetric("Fractal dimension", frameAnalyzer.toMetric(statistics.FractalDimension))
+end)
+
 local minRange = graphData.minRange
 local maxRange = graphData.maxRange
 
@@ -493,168 +632,72 @@ local FA2Params = {
 	gravity = 0.5,
 	jitterTolerance = 0.1,
 	baseMass = 1,
+	maxDisplacement = 10,
+	barnesHutTheta = 1.2,
+	-- speed adaptation restarts on every iteration
+	resetSpeed = true,
 }
 
 -- initialize
 local outboundCompensation = 0
-local g1 = imgH / 3
-local g2 = 2 * g1
+local simplifiedEdges = topo.simplifiedEdges
+local fa2Layout = layout.newForceAtlas2(#simplifiedNodes, topo.simplifiedEdgeCount, FA2Params)
+fa2Layout.setGravityLines(imgH / 3, 2 * imgH / 3)
 
-for _, node in ipairs(simplifiedNodes) do
+for index, node in ipairs(simplifiedNodes) do
+	local pos
 	if node.Layouts.MainChannel.Pos then
-		node.Layouts.ForceAtlas2.Pos = vector2(node.Layouts.MainChannel.Pos
-			/ mainChannelLength, 0.5):multiply(vector2(imgW, imgH))
+		pos = vector2(node.Layouts.MainChannel.Pos / mainChannelLength, 0.5):multiply(vector2(imgW, imgH))
 	else
-		node.Layouts.ForceAtlas2.Pos = vector2(node.X, node.Y)
+		pos = vector2(node.X, node.Y)
 		-- todo: better start layout?
 	end
 
-	node.Layouts.ForceAtlas2.mass = FA2Params.baseMass + node.EdgesIn + node.EdgesOut
-	node.Layouts.ForceAtlas2.old_d = vector2(0, 0)
-	node.Layouts.ForceAtlas2.d = vector2(0, 0)
+	local mass = FA2Params.baseMass + node.EdgesIn + node.EdgesOut
+	fa2Layout.setNode(index, pos.x, pos.y, mass, 0, node.Layouts.MainChannel.Pos)
+	node.Layouts.ForceAtlas2.Index = index
 
-	outboundCompensation = outboundCompensation + node.Layouts.ForceAtlas2.mass
+	outboundCompensation = outboundCompensation + mass
 end
 
 outboundCompensation = outboundCompensation / #simplifiedNodes
+fa2Layout.setOutboundCompensation(outboundCompensation)
 
--- functions for calculating repulsing and attracting forces
-local function repulsionNodeNode(n1, n2)
-	local dist = n1.Layouts.ForceAtlas2.Pos:subtract(n2.Layouts.ForceAtlas2.Pos)
-	local distance = dist:length() - (n1.WIn + n1.WOut + n2.WIn + n2.WOut) -- 1.5 is the approximate radius of a node
-
-	local factor = FA2Params.scalingRatio * n1.Layouts.ForceAtlas2.mass
-			* n2.Layouts.ForceAtlas2.mass
-
-	if distance > 0 then
-		factor = factor / (distance * distance);
-	elseif distance < 0 then
-		factor = factor * 100
-	end
-
-    n1.Layouts.ForceAtlas2.d = n1.Layouts.ForceAtlas2.d:add(dist:multiply(factor))
-    n2.Layouts.ForceAtlas2.d = n2.Layouts.ForceAtlas2.d:subtract(dist:multiply(factor))
+for i = 1, topo.simplifiedEdgeCount do
+	fa2Layout.setEdge(i, nodes[simplifiedEdges[i * 2 - 2] + 1].Layouts.ForceAtlas2.Index,
+		nodes[simplifiedEdges[i * 2 - 1] + 1].Layouts.ForceAtlas2.Index)
 end
 
-local function repulsionGravity(n)
-	local dist1 = vector2(0, n.Layouts.ForceAtlas2.Pos.y - g1)
-	local dist2 = vector2(0, n.Layouts.ForceAtlas2.Pos.y - g2)
-	local dist = dist1:length() < dist2:length() and dist1 or dist2
-	local distance = dist:length()
-
-	if distance > 0 then
-		local factor = FA2Params.scalingRatio * n.Layouts.ForceAtlas2.mass
-			* FA2Params.gravity / distance
-		
-		n.Layouts.ForceAtlas2.d = n.Layouts.ForceAtlas2.d:subtract(dist:multiply(factor))
+local function updateForceAtlas2Radii()
+	-- node radii depend on the currently displayed frame
+	for index, node in ipairs(simplifiedNodes) do
+		fa2Layout.setRadius(index, node.WIn + node.WOut)
 	end
 end
 
-local function attractionNodeNode(n1, n2)
-	local dist = n1.Layouts.ForceAtlas2.Pos:subtract(n2.Layouts.ForceAtlas2.Pos)
-	local distance = dist:length() - (n1.WIn + n1.WOut + n2.WIn + n2.WOut) -- 1.5 is the approximate radius of a node
-
-	if distance > 0 then
-		local factor = -outboundCompensation / (0.5 * (n1.Layouts.ForceAtlas2.mass + n2.Layouts.ForceAtlas2.mass))
-
-		n1.Layouts.ForceAtlas2.d = n1.Layouts.ForceAtlas2.d:add(dist:multiply(factor))
-		n2.Layouts.ForceAtlas2.d = n2.Layouts.ForceAtlas2.d:subtract(dist:multiply(factor))
+local function ForceAtlas2Stop()
+	if fa2Layout.hasWorker() then
+		fa2Layout.swap()
+		fa2Layout.stopWorker()
 	end
 end
 
-local function ForceAtlas2()
-	-- initialize
-	local speed = 1
-	local speedEfficiency = 1
-
-	for _, node in ipairs(simplifiedNodes) do
-		node.Layouts.ForceAtlas2.old_d = node.Layouts.ForceAtlas2.d
-		node.Layouts.ForceAtlas2.d = vector2(0, 0)
-	end
-
-	-- get forces
-	for i = 2, #simplifiedNodes do
-		for j = 1, i - 1 do
-			repulsionNodeNode(simplifiedNodes[i], simplifiedNodes[j])
-		end
-	end
-
-	for _, node in ipairs(simplifiedNodes) do
-		repulsionGravity(node)
-	end
-
-	for i = 1, #simplifiedEdges, 2 do
-		attractionNodeNode(nodes[simplifiedEdges[i]], nodes[simplifiedEdges[i + 1]])
-	end
-	
-	-- adjust speed
-	local totalSwinging = 0
-    local totalEffectiveTraction = 0
-    for _, node in ipairs(simplifiedNodes) do
-        if (not node.Layouts.MainChannel.Pos) then
-            local swinging = node.Layouts.ForceAtlas2.old_d:subtract(node.Layouts.ForceAtlas2.d):length()
-            totalSwinging = totalSwinging + node.Layouts.ForceAtlas2.mass * swinging;
-            totalEffectiveTraction = totalEffectiveTraction + node.Layouts.ForceAtlas2.mass * 0.5
-				* node.Layouts.ForceAtlas2.old_d:add(node.Layouts.ForceAtlas2.d):length()
-        end
-    end
-
-	local estimatedOptimalJitterTolerance = 0.05 * math.sqrt(#simplifiedNodes);
-    local minJT = math.sqrt(estimatedOptimalJitterTolerance);
-    local jt = FA2Params.jitterTolerance * math.max(minJT, math.min(10,
-		estimatedOptimalJitterTolerance * totalEffectiveTraction / math.pow(#simplifiedNodes, 2)));
-
-	if totalSwinging / totalEffectiveTraction > 2.0 then
-        if speedEfficiency > 0.05 then
-            speedEfficiency = speedEfficiency * 0.5
-        end
-
-        jt = math.max(jt, FA2Params.jitterTolerance);
-    end
-
-    local targetSpeed = jt * speedEfficiency * totalEffectiveTraction / totalSwinging;
-
-	if totalSwinging > jt * totalEffectiveTraction then
-        if speedEfficiency > 0.05 then
-            speedEfficiency = speedEfficiency * 0.7
-        end
-    elseif speed < 1000 then
-        speedEfficiency = speedEfficiency * 1.3;
-    end
-
-	speed = speed + math.min(targetSpeed - speed, 0.5 * speed);
-
-	-- apply forces
-	for _, node in ipairs(simplifiedNodes) do
-		if (not node.Layouts.MainChannel.Pos) then
-			local swinging = node.Layouts.ForceAtlas2.mass *
-				node.Layouts.ForceAtlas2.old_d:subtract(node.Layouts.ForceAtlas2.d):length()
-			local factor = 0.1 * speed / (1 + math.sqrt(speed * swinging))
-
-			local df = node.Layouts.ForceAtlas2.d:length()
-			factor = math.min(factor * df, 10) / df
-
-			node.Layouts.ForceAtlas2.Pos = node.Layouts.ForceAtlas2.Pos:add(
-				node.Layouts.ForceAtlas2.d:multiply(factor))
+-- run ForceAtlas2 on a background worker, picking up the latest positions once per frame
+ForceAtlas2Update = function()
+	if settings.forceAtlas2running then
+		updateForceAtlas2Radii()
+		if fa2Layout.hasWorker() then
+			fa2Layout.updateWorkerRadii()
+		else
+			fa2Layout.startWorker()
 		end
+		fa2Layout.swap()
+	else
+		ForceAtlas2Stop()
 	end
+	requestGraphReload = true
 end
 
--- call ForceAtlas2 until convergence
-ForceAtlas2Loop = coroutine.create(
-	function()
-		while true do
-			if settings.forceAtlas2running then
-				for i = 1, 5 do
-					ForceAtlas2()
-				end
-			end
-			requestGraphReload = true
-			coroutine.yield()
-		end
-	end
-)
-
 -- ----------------------------------------------------------
 -- Node mappers hold information for graph layouts.
 -- ----------------------------------------------------------
@@ -705,7 +748,12 @@ local nodeMappers = {
 	{
 		posMapper =
 			function(node)
-				return node.Layouts.ForceAtlas2.Pos and node.Layouts.ForceAtlas2.Pos:divide(vector2(imgW, imgH)) or 0
+				local index = node.Layouts.ForceAtlas2.Index
+				if not index then
+					return 0
+				end
+				local x, y = fa2Layout.getPosition(index)
+				return vector2(x / imgW, y / imgH)
 			end,
 		radMapper =
 			function ()
@@ -713,7 +761,9 @@ local nodeMappers = {
 			end,
 		interpolatable = false,
 		simplifiedOnly = true,
-		iterative = function() coroutine.resume(ForceAtlas2Loop) end,
+		iterative = function() ForceAtlas2Update() end,
+		-- the worker only iterates while this mapper is shown
+		deactivate = function() ForceAtlas2Stop() end,
 	},
 	{
 		posMapper =
@@ -746,12 +796,26 @@ local nodeMappers = {
 nodeMapperIndex = 0
 nodeMapperTargetIndex = 0
 
+-- The mapper whose iterative hook was last called, deactivated as soon as another mapper is shown
+local activeMapper = nil
+
+local function activateMapper(mapper)
+	if activeMapper ~= mapper and activeMapper and activeMapper.deactivate then
+		activeMapper.deactivate()
+	end
+	activeMapper = mapper
+	if mapper then
+		mapper.iterative()
+	end
+end
+
 getPosMapper = function(index)
 	if index ~= math.floor(index) then
 		local mapper1 = nodeMappers[math.floor(index) % #nodeMappers + 1]
 		local mapper2 = nodeMappers[math.ceil(index) % #nodeMappers + 1]
 		if mapper1.interpolatable and mapper2.interpolatable then
 			local fac = index - math.floor(index)
+			activateMapper(nil)
 			return
 				function (node)
 					return mapper1.posMapper(node) * (1 - fac) + mapper2.posMapper(node) * fac
@@ -764,16 +828,16 @@ getPosMapper = function(index)
 				false
 		else
 			if mapper1.interpolatable then
-				mapper2.iterative()
+				activateMapper(mapper2)
 				return mapper2.posMapper, mapper2.radMapper, mapper2.simplifiedOnly
 			else
-				mapper1.iterative()
+				activateMapper(mapper1)
 				return mapper1.posMapper, mapper1.radMapper, mapper1.simplifiedOnly
 			end
 		end
 	else
 		local mapper = nodeMappers[index % #nodeMappers + 1]
-		mapper.iterative()
+		activateMapper(mapper)
 		return mapper.posMapper, mapper.radMapper, mapper.simplifiedOnly
 	end
 end
@@ -792,9 +856,6 @@ local nodeColorInvis = color.fromTable {127, 127, 127, 70}
 local nodeBaseRadius = 0
 local nodeRadiusFactor = 1
 
-local links
-local preBreakLinks
-
 local function getNodeTypeColor(node)
 	local nIn, nOut = node.EdgesIn, node.EdgesOut
 	
@@ -821,7 +882,24 @@ end
 
 currentPosMapper, currentRadMapper, currentSimplified = 0, 0, 0
 
+-- Nodes of the current frame are emphasized by a more opaque border and wider outgoing links
+local function updateNodeFrameState(node)
+	local col = utils.clamp(0, (node.Time - frameNum) + 0.5, 1)
+	local a = col % 1 * 0.5 + 0.75
+
+	node.Rad = color.fade(getNodeTypeColor(node), a)
+	node.WOut = 10 + a * 5
+end
+
+-- The frame that the nodes' frame-dependent state was last computed for
+local nodeFrame = frameNum
+
+-- Incremented whenever node positions, sizes or colors are recomputed
+local graphRevision = 0
+
 local function initGraph()
+	graphRevision = graphRevision + 1
+
 	local t
 	local y = 0
 
@@ -910,28 +988,10 @@ local function initGraph()
 	for _, node in ipairs(nodes) do
 		node.Pos = vector2(offsetX, offsetY) + currentPosMapper(node) * wSize
 		node.PosOrigSize = currentPosMapper(node) * imgSize
-
-		local col = utils.clamp(0, (node.Time - frameNum) + 0.5, 1)
-		local a = col % 1 * 0.5 + 0.75
-
-		node.Rad = color.fade(getNodeTypeColor(node), a)
 		node.WIn = 2 + utils.clamp(0, math.sqrt(node.Area) / 16, 8)
-		node.WOut = 10 + a * 5
-	end
-
-	links = {}
-	preBreakLinks = {}
-	for i = 1, #edges, 2 do
-		local src = nodes[edges[i] + 1]
-		local dst = nodes[edges[i + 1] + 1]
-		if src.X ~= 0 or src.Y ~= 0 then
-			local w = (src.WOut + dst.WOut) * 0.5
-			links[#links + 1] = {source = src, dest = dst, weight = w - 10, time = dst.Time}
-			if dst.Time <= breakthrough then
-				preBreakLinks[#preBreakLinks + 1] = links[#links]
-			end
-		end
+		updateNodeFrameState(node)
 	end
+	nodeFrame = frameNum
 end
 
 initGraph()
@@ -1130,39 +1190,32 @@ end
 -- ----------------------------------------------------------
 -- Draw image for the current frame.
 -- ----------------------------------------------------------
-frameBuffers = {}
+frameSequences = {}
 
 imgCacheDir = nil
 imgCache = {}
 
 local frameName = nil
 local frameInfo = nil
-local numCacheEntries = 25
 
 local function drawImage()
 	local imgIndex = frameNum
 	local imgPath = imgCache[imgIndex + 1]
+	local frames = frameSequences[fb_id]
 
-	if imgPath then
-		-- Load image into framebuffer
-		local frameMemIndex = imgIndex % numCacheEntries + 1
-
-		if frameBuffers[fb_id][frameMemIndex].name ~= imgPath then
-			frameBuffers[fb_id][frameMemIndex].name = imgPath
-			frameBuffers[fb_id][frameMemIndex].buffer.load(imgPath)
-		end
+	if imgPath and frames then
+		-- Request the frame; the previous image stays visible until it has been decoded in the background
+		local fb, name = frames.show(imgIndex + 1)
+		frameName = imgPath
 
 		if settings.showDebugInfo then
-			frameInfo = frameBuffers[fb_id][frameMemIndex].name .. " - " .. frameBuffers[fb_id][frameMemIndex].buffer.id .. " - " .. fb_id
+			frameInfo = tostring(name) .. " - " .. fb.id .. " - " .. fb_id
 		else
 			frameInfo = nil
 		end
 
-		frameName = frameBuffers[fb_id][frameMemIndex].name
-
 		-- Draw image
-		local fb = frameBuffers[fb_id][frameMemIndex].buffer
-		if fb then
+		if name then
 			gfx.drawTintedSprite(fb.id, {offsetX, offsetY, graphWidth, graphHeight}, {0, 0, imgW, imgH}, {255,255,255,255})
 		end
 	end
@@ -1171,42 +1224,163 @@ end
 -- ----------------------------------------------------------
 -- Draw graph and interfaces according to user's settings.
 -- ----------------------------------------------------------
-local nodeCircles = {} -- array of {.position, .radius, .color, .marked}
-local linkLines = {} -- array of {.source, .target, .color}
 local interfaceRects = {} -- array of {.lower, .larger, .color, .marked}
 
-local function drawNode(node)
-	if (settings.hideUnreachedNodes and node.Time > frameNum) then return end
+-- Links and nodes are kept in retained scenes, which are only updated when the graph or its display settings change
+local linkScene = retainedScene.new()
+local nodeScene = retainedScene.new()
 
-	local nodeRadius = (settings.unscaledNodes and 1 or node.WIn) * nodeRadiusFactor + nodeBaseRadius
+-- Spatial indices over the drawn nodes and links, keyed like the scenes, for picking and visibility queries. Their
+-- shapes are staged in flat arrays while the scenes are updated.
+local nodeIndex = spatialIndex.new(16)
+local linkIndex = spatialIndex.new(32)
+local nodeKeyCount, linkKeyCount = 0, 0
+local nodesByKey, linksByKey, nodeKeysByNode, linkKeysByNode = {}, {}, {}, {}
 
-	local alpha = math.max(color.getA(node.Rad), 50)
+-- Marks staged shapes as removed: shapes that are not drawn again are removed from the index on the next update
+local function clearShapes(arr, first, count, stride)
+	local nan = 0 / 0
+	for o = first * stride, (count - 1) * stride, stride do
+		arr[o] = nan
+	end
+end
+
+local function newShapes(count, stride)
+	local arr = array.new(array.Type.DOUBLE, count * stride)
+	clearShapes(arr, 0, count, stride)
+	return arr
+end
 
-	-- Mark current frame's nodes
-	if node.Time == frameNum then
-		draw.circle(node.Pos, sizeFactor * (nodeRadius * 1.1 + 2), settings.colorByNodeType and getNodeTypeColor(node) or node.Color, 30, settings.smoothGraph)
+-- Returns the array, or a larger copy of it if it cannot hold 'count' elements of 'stride' values
+local function reserveShapes(arr, count, stride)
+	if count * stride <= arr.size then
+		return arr
 	end
+	local grown = newShapes(math.max(count, math.floor(arr.size / stride) * 2), stride)
+	array.copy(arr, grown)
+	return grown
+end
 
-	-- Draw node and emulate black border by drawing a larger, black circle beneath
-	draw.circle(node.Pos, sizeFactor * (nodeRadius + 1), color.rgba(0, 0, 0, alpha), 30, settings.smoothGraph)
-	draw.circle(node.Pos, sizeFactor * nodeRadius, settings.colorByNodeType and getNodeTypeColor(node) or node.Color2, 30, settings.smoothGraph)
+local nodeShapes = newShapes(1024, spatialIndex.CircleStride)
+local nodeColors = newShapes(1024, 1)
+local linkShapes = newShapes(1024, spatialIndex.SegmentStride)
+
+local function setNodeShape(key, node, x, y, radius, fillColor)
+	nodeShapes = reserveShapes(nodeShapes, key, spatialIndex.CircleStride)
+	nodeColors = reserveShapes(nodeColors, key, 1)
+	local o = (key - 1) * spatialIndex.CircleStride
+	nodeShapes[o], nodeShapes[o + 1], nodeShapes[o + 2] = x, y, radius
+	nodeColors[key - 1] = fillColor
+	nodesByKey[key] = node
+	nodeKeysByNode[node] = key
+	nodeKeyCount = math.max(nodeKeyCount, key)
+end
+
+local function setLinkShape(key, link, x1, y1, x2, y2, halfWidth)
+	linkShapes = reserveShapes(linkShapes, key, spatialIndex.SegmentStride)
+	local o = (key - 1) * spatialIndex.SegmentStride
+	linkShapes[o], linkShapes[o + 1], linkShapes[o + 2], linkShapes[o + 3], linkShapes[o + 4] = x1, y1, x2, y2, halfWidth
+	linksByKey[key] = link
+	linkKeyCount = math.max(linkKeyCount, key)
+end
+
+local sceneSettings = {
+	"colorByNodeType",
+	"simplify",
+	"unscaledNodes",
+	"unweightedLinks",
+	"smoothGraph",
+}
+local sceneState = {}
+
+local function updateSceneState(name, value)
+	if sceneState[name] ~= value then
+		sceneState[name] = value
+		return true
+	end
+	return false
+end
+
+-- The current frame is not part of the scene state: frame changes only patch the affected nodes and links
+local function isSceneOutdated()
+	local outdated = updateSceneState("graphRevision", graphRevision)
+	outdated = updateSceneState("sizeFactor", sizeFactor) or outdated
+	outdated = updateSceneState("nodeMapperTargetIndex", nodeMapperTargetIndex) or outdated
+	for _, name in ipairs(sceneSettings) do
+		outdated = updateSceneState(name, settings[name]) or outdated
+	end
+	return outdated
+end
+
+-- Time-ordered node and link lists of the current scene (see newTimeOrderedList), indexed by scene key
+local drawnNodes, drawnLinks = allNodes, links
 
-	table.insert(nodeCircles, {position = node.PosOrigSize, radius = nodeRadius, color = {color.getRGBA(node.Color2)}, marked = (node.Time == frameNum)})
+-- Nodes and links up to this time step are drawn
+local function getVisibleTime()
+	local time = math.huge
+	if settings.hideUnreachedNodes then
+		time = frameNum
+	end
+	if settings.hidePostBreakthrough then
+		time = math.min(time, breakthrough)
+	end
+	return time
 end
 
-local function drawLink(link)
-	if (settings.hideUnreachedNodes and link.time > frameNum) then return end
+local linkColor = color.hsv(0, 0.0, 0.6, 0.6)
 
+local function getNodeRadius(node)
+	return (settings.unscaledNodes and 1 or node.WIn) * nodeRadiusFactor + nodeBaseRadius
+end
+
+local function getNodeFillColor(node)
+	return settings.colorByNodeType and getNodeTypeColor(node) or node.Color2
+end
+
+-- Nodes occupy two consecutive scene keys: border and fill
+local function drawNode(key, node)
+	local borderKey, fillKey = key * 2, key * 2 + 1
+
+	local nodeRadius = getNodeRadius(node)
+	local feather = settings.smoothGraph and 1 or 0
+	local x, y = node.Pos.x, node.Pos.y
+
+	local alpha = math.max(color.getA(node.Rad), 50)
+
+	-- Draw node and emulate black border by drawing a larger, black circle beneath
+	local fillColor = getNodeFillColor(node)
+	nodeScene.circle(borderKey, x, y, sizeFactor * (nodeRadius + 1), color.rgba(0, 0, 0, alpha), 30, feather)
+	nodeScene.circle(fillKey, x, y, sizeFactor * nodeRadius, fillColor, 30, feather)
+	setNodeShape(key, node, x, y, sizeFactor * (nodeRadius + 1), fillColor)
+end
+
+local function drawLink(key, link)
 	local startWeight, endWeight = 1.5 * sizeFactor, 1.5 * sizeFactor
 
 	if not settings.unweightedLinks and nodeMapperTargetIndex % #nodeMappers == 0 then
-		startWeight = sizeFactor * link.weight
+		startWeight = sizeFactor * ((link.source.WOut + link.dest.WOut) * 0.5 - 10)
 		endWeight = 0
 	end
 
-	draw.line(link.source.Pos, link.dest.Pos, color.hsv(0, 0.0, 0.6, 0.6), startWeight, endWeight, settings.smoothGraph)
+	local source, dest = link.source.Pos, link.dest.Pos
+	linkScene.line(key, source.x, source.y, dest.x, dest.y, startWeight, endWeight, linkColor, settings.smoothGraph and 1 or 0)
+	setLinkShape(key, link, source.x, source.y, dest.x, dest.y, math.max(startWeight, endWeight) * 0.5)
+end
+
+-- Current frame markers are kept in a separate scene, which only holds the nodes of the current frame
+local markerScene = retainedScene.new()
+
+local function updateMarkerScene()
+	local feather = settings.smoothGraph and 1 or 0
 
-	table.insert(linkLines, {source = link.source.PosOrigSize, target = link.dest.PosOrigSize, color = {color.getRGBA(color.hsv(0, 0.0, 0.6, 0.6))}})
+	markerScene.beginUpdate()
+	local first, last = drawnNodes.index.getRange(frameNum)
+	for key = first + 1, last do
+		local node = drawnNodes[key]
+		markerScene.circle(key, node.Pos.x, node.Pos.y, sizeFactor * (getNodeRadius(node) * 1.1 + 2),
+			settings.colorByNodeType and getNodeTypeColor(node) or node.Color, 30, feather)
+	end
+	markerScene.endUpdate()
 end
 
 local function drawActiveInterfaces()
@@ -1231,46 +1405,226 @@ local function drawActiveInterfaces()
 	end
 end
 
-local function drawGraph()
-	nodeCircles = {}
-	linkLines = {}
-	interfaceRects = {}
+-- Cluster overviews of the drawn graph (see system.accel.GraphLOD). The links between the drawn nodes are staged
+-- whenever the graph scene is updated; all levels are precomputed natively for the visible nodes, so that switching
+-- levels only needs to update the overview scenes.
+local lodLinkScene = retainedScene.new()
+local lodNodeScene = retainedScene.new()
+local lodLevels, lodSceneLevel, lodNodeCount = nil, nil, nil
+local lodLinks = array.new(array.Type.INT32, 2048)
+local lodLinkWeights = array.new(array.Type.DOUBLE, 1024)
+local lodLinkCount = 0
+
+local function stageGraphLODLinks()
+	if lodLinkWeights.size < linkKeyCount then
+		lodLinks = array.new(array.Type.INT32, linkKeyCount * 4)
+		lodLinkWeights = array.new(array.Type.DOUBLE, linkKeyCount * 2)
+	end
+
+	-- Links refer to the drawn nodes by their zero-based scene key, like the staged node shapes
+	lodLinkCount = 0
+	for key = 1, linkKeyCount do
+		local link = linksByKey[key]
+		local sourceKey = link and nodeKeysByNode[link.source]
+		local destKey = link and nodeKeysByNode[link.dest]
+		if sourceKey and destKey then
+			lodLinks[lodLinkCount * 2], lodLinks[lodLinkCount * 2 + 1] = sourceKey - 1, destKey - 1
+			lodLinkWeights[lodLinkCount] = linkShapes[(key - 1) * spatialIndex.SegmentStride + 4] * 2
+			lodLinkCount = lodLinkCount + 1
+		end
+	end
+
+	lodLevels = nil
+end
+
+-- Nodes are time-ordered by key, so the visible nodes are the first 'nodeCount' staged shapes. Links to nodes beyond
+-- them are dropped natively.
+local function buildGraphLOD(nodeCount)
+	local err
+	lodLevels, err = graphLOD.build(nodeShapes, nodeColors, lodLinks, lodLinkWeights, {
+		nodeCount = nodeCount,
+		linkCount = lodLinkCount,
+		baseCellSize = 4 * sizeFactor,
+		levelCount = lodLevelCount,
+	})
+	if not lodLevels then
+		log.error("Failed to build graph overview: %s", err)
+	end
+	lodNodeCount = nodeCount
+	lodSceneLevel = nil
+end
+
+local function updateLODScene(level)
+	local clusters, lodLinkArray = level.clusters, level.links
+	local clusterStride, linkStride = graphLOD.ClusterStride, graphLOD.LinkStride
+	local feather = settings.smoothGraph and 1 or 0
+
+	lodLinkScene.beginUpdate()
+	for i = 0, level.linkCount - 1 do
+		local o = i * linkStride
+		local source, dest = lodLinkArray[o] * clusterStride, lodLinkArray[o + 1] * clusterStride
+		local weight, count = lodLinkArray[o + 2], lodLinkArray[o + 3]
+
+		-- Merged links grow with the square root of their link count, but stay thinner than the clusters they connect
+		local width = math.min(weight / count * math.sqrt(count), clusters[source + 2], clusters[dest + 2])
+		lodLinkScene.line(i + 1, clusters[source], clusters[source + 1], clusters[dest], clusters[dest + 1], width,
+			width, linkColor, feather)
+	end
+	lodLinkScene.endUpdate()
+
+	-- Cluster radii include the node border, like the staged node shapes
+	lodNodeScene.beginUpdate()
+	for i = 0, level.clusterCount - 1 do
+		local o = i * clusterStride
+		local x, y, radius, fillColor = clusters[o], clusters[o + 1], clusters[o + 2], clusters[o + 3]
+		local alpha = math.max(color.getA(fillColor), 50)
+		lodNodeScene.circle(i * 2 + 1, x, y, radius, color.rgba(0, 0, 0, alpha), 30, feather)
+		lodNodeScene.circle(i * 2 + 2, x, y, math.max(radius - sizeFactor, 1), fillColor, 30, feather)
+	end
+	lodNodeScene.endUpdate()
+end
+
+-- Specifies all nodes and links of the current lists. Hidden nodes and links are only left out when drawing.
+local function updateGraphScene()
+	clearShapes(nodeShapes, 0, nodeKeyCount, spatialIndex.CircleStride)
+	clearShapes(linkShapes, 0, linkKeyCount, spatialIndex.SegmentStride)
+	local previousNodeKeyCount, previousLinkKeyCount = nodeKeyCount, linkKeyCount
+	nodeKeyCount, linkKeyCount = 0, 0
+	nodesByKey, linksByKey, nodeKeysByNode, linkKeysByNode = {}, {}, {}, {}
 
 	if not currentSimplified then
-		for _, link in ipairs(settings.hidePostBreakthrough and preBreakLinks or links) do
-			drawLink(link)
-		end
-		for _, i in ipairs((settings.simplify and (settings.hidePostBreakthrough and livePreBreakNodes or liveNodes))
-				or (settings.hidePostBreakthrough and allPreBreakNodes or allNodes)) do
+		drawnNodes, drawnLinks = settings.simplify and liveNodes or allNodes, links
+	else
+		drawnNodes, drawnLinks = simplifiedNodeList, simplifiedLinks
+	end
 
-			drawNode(nodes[i])
+	local function addLinkKey(node, key)
+		local keys = linkKeysByNode[node]
+		if not keys then
+			keys = {}
+			linkKeysByNode[node] = keys
 		end
-		if nodeMapperIndex % #nodeMappers == 0 and settings.showInterfaces then
-			drawActiveInterfaces()
+		keys[#keys + 1] = key
+	end
+
+	linkScene.beginUpdate()
+	for key, link in ipairs(drawnLinks) do
+		drawLink(key, link)
+		addLinkKey(link.source, key)
+		addLinkKey(link.dest, key)
+	end
+	linkScene.endUpdate()
+
+	nodeScene.beginUpdate()
+	for key, node in ipairs(drawnNodes) do
+		drawNode(key, node)
+	end
+	nodeScene.endUpdate()
+
+	updateMarkerScene()
+
+	-- Elements that were not drawn again still hold NaN and are removed; only moved elements change grid cells
+	nodeIndex.setCircles(nodeShapes, math.max(nodeKeyCount, previousNodeKeyCount), 1)
+	nodeIndex.truncate(nodeKeyCount + 1)
+	linkIndex.setSegments(linkShapes, math.max(linkKeyCount, previousLinkKeyCount), 1)
+	linkIndex.truncate(linkKeyCount + 1)
+
+	stageGraphLODLinks()
+end
+
+-- Updates the frame-dependent state of the nodes of the previous and the current frame. Returns these nodes.
+local function updateFrameNodes()
+	local changedNodes = {}
+	for _, time in ipairs({nodeFrame, frameNum}) do
+		local first, last = allNodes.index.getRange(time)
+		for i = first + 1, last do
+			local node = allNodes[i]
+			updateNodeFrameState(node)
+			changedNodes[#changedNodes + 1] = node
 		end
-	else
-		for i = 1, #simplifiedEdges, 2 do
-			local src = nodes[simplifiedEdges[i]]
-			local dst = nodes[simplifiedEdges[i + 1]]
-			if src.X ~= 0 or src.Y ~= 0 then
-				local w = (src.WOut + dst.WOut) * 0.5
-				drawLink({source = src, dest = dst, weight = w - 10, time = dst.Time})
-			end
+	end
+	nodeFrame = frameNum
+	return changedNodes
+end
+
+-- Re-specifies the changed nodes and their links only, leaving the rest of the scenes untouched
+local function patchGraphScene(changedNodes)
+	nodeScene.beginPatch()
+	linkScene.beginPatch()
+	for _, node in ipairs(changedNodes) do
+		local key = nodeKeysByNode[node]
+		if key then
+			drawNode(key, node)
 		end
-		for _, node in ipairs(simplifiedNodes) do
-			drawNode(node)
+		for _, linkKey in ipairs(linkKeysByNode[node] or {}) do
+			drawLink(linkKey, linksByKey[linkKey])
+			linkIndex.setSegments(linkShapes, 1, linkKey, linkKey - 1)
 		end
 	end
+	linkScene.endPatch()
+	nodeScene.endPatch()
+
+	updateMarkerScene()
+end
+
+-- Number of leading scene keys that are currently drawn
+local visibleNodeCount, visibleLinkCount = 0, 0
+
+-- Returns a description of the node or link under the point, or nil
+local function inspectGraph(x, y)
+	local tolerance = 2 * sizeFactor
+
+	local nodeKey = nodeIndex.pick(x, y, tolerance)
+	if nodeKey and nodeKey <= visibleNodeCount then
+		local node = nodesByKey[nodeKey]
+		return string.format("Node %d: time %d, area %.1f, edges in/out %d/%d", node.Id, node.Time, node.Area,
+			node.EdgesIn, node.EdgesOut)
+	end
+
+	local linkKey = linkIndex.pick(x, y, tolerance)
+	if linkKey and linkKey <= visibleLinkCount then
+		local link = linksByKey[linkKey]
+		return string.format("Link: node %d -> node %d", link.source.Id, link.dest.Id)
+	end
 end
 
-local function hexColor(rgba)
-	local hex = "#"
-	for i = 1, 3 do
-		local minor = rgba[i] % 16
-		local major = (rgba[i] - minor) / 16
-		hex = hex .. string.format("%x", major) .. string.format("%x", minor)
+local function drawGraph()
+	local changedNodes = nodeFrame ~= frameNum and updateFrameNodes()
+
+	if isSceneOutdated() then
+		updateGraphScene()
+	elseif changedNodes then
+		patchGraphScene(changedNodes)
+	end
+
+	local visibleTime = getVisibleTime()
+	visibleNodeCount = drawnNodes.index.countUpTo(visibleTime)
+	visibleLinkCount = drawnLinks.index.countUpTo(visibleTime)
+
+	if settings.lodLevel > 0 and (not lodLevels or lodNodeCount ~= visibleNodeCount) then
+		buildGraphLOD(visibleNodeCount)
+	end
+
+	local lodLevel = lodLevels and lodLevels[settings.lodLevel]
+	if lodLevel then
+		if lodSceneLevel ~= lodLevel then
+			updateLODScene(lodLevel)
+			lodSceneLevel = lodLevel
+		end
+		lodLinkScene.draw()
+		lodNodeScene.draw()
+	else
+		linkScene.draw(visibleLinkCount)
+		if frameNum <= visibleTime then
+			markerScene.draw()
+		end
+		nodeScene.draw(visibleNodeCount * 2)
+	end
+
+	interfaceRects = {}
+	if not currentSimplified and nodeMapperIndex % #nodeMappers == 0 and settings.showInterfaces then
+		drawActiveInterfaces()
 	end
-	return hex
 end
 
 printGraph = function ()
@@ -1278,42 +1632,42 @@ printGraph = function ()
 	local timestamp = os.date('%Y-%m-%d-%H-%M-%S')
 	filename = filename .. "_" .. timestamp .. ".svg"
 
-	-- Create SVG file from nodeCircles and linkLines
-	local svg_graph = svglib:create(imgW, imgH)
+	-- Stream SVG elements from the visible nodes and links of the current scene, and interfaceRects
+	local writer, err = svgWriter.open(filename, imgW, imgH)
+	if not writer then
+		log.error("Unable to create SVG file: %s", err)
+		return
+	end
+
+	local black = color.rgba(0, 0, 0, 255)
+	local transparent = color.rgba(0, 0, 0, 0)
 
-	for _, link in ipairs(linkLines) do
-		svg_graph:addLine(link.source.x, link.source.y, link.target.x, link.target.y, hexColor(link.color), 4, hexColor(link.color))
+	for key = 1, visibleLinkCount do
+		local source, target = drawnLinks[key].source.PosOrigSize, drawnLinks[key].dest.PosOrigSize
+		writer.line(source.x, source.y, target.x, target.y, linkColor, 4)
 	end
-	
-	for _, node in ipairs(nodeCircles) do
-		local radius = 4 * node.radius
-		svg_graph:addCircle(radius, node.position.x, node.position.y, "#000000", 3, hexColor(node.color))
-		if node.marked then
-			local h, s, v, a = color.toHSV(color.rgba(unpack(node.color)))
+
+	for key = 1, visibleNodeCount do
+		local node = drawnNodes[key]
+		local position = node.PosOrigSize
+		local radius = 4 * getNodeRadius(node)
+		writer.circle(position.x, position.y, radius, black, 3, node.Color2)
+		if node.Time == frameNum then
+			local h, s, v, a = color.toHSV(node.Color2)
 			s = math.min(1, s * 1.2)
 			v = math.min(1, v * 1.2)
-			svg_graph:addCircle(radius * 1.2, node.position.x, node.position.y, hexColor({color.getRGBA(color.hsv(h, s, v, a))}), 4, "transparent")
+			writer.circle(position.x, position.y, radius * 1.2, color.hsv(h, s, v, a), 4, transparent)
 		end
 	end
-	
+
 	for _, interfaces in ipairs(interfaceRects) do
-		svg_graph:addRect(interfaces.lower.x, interfaces.lower.y, interfaces.larger.x - interfaces.lower.x,
-			interfaces.larger.y - interfaces.lower.y, hexColor(interfaces.color), interfaces.marked and 6 or 3, "transparent")
+		writer.rect(interfaces.lower.x, interfaces.lower.y, interfaces.larger.x - interfaces.lower.x,
+			interfaces.larger.y - interfaces.lower.y, interfaces.color, interfaces.marked and 6 or 3, transparent)
 	end
 
-	local content = svg_graph:draw()
-
-	local file = io.open(filename, "w")
-	if file then
-		local success = file:write(content)
-		if success then
-			file:flush()
-		else
-			log.error("Unable to write SVG file.")
-		end
-		file:close()
-	else
-		log.error("Unable to create SVG file.")
+	local success, result = writer.close()
+	if not success then
+		log.error("Unable to write SVG file: %s", result)
 	end
 end
 
@@ -1367,41 +1721,27 @@ event.render.add("graph2", "vis", function ()
 	local needsGraphReload = requestGraphReload
 	requestGraphReload = false
 
-	-- Create image cache when input path changed
+	-- Create image index when input path changed, and pick up frames written since then afterwards
 	if imgCacheDir ~= imgDir then
-		local files = fileIO.listFiles(imgDir, fileIO.List.FILES, fileIO.List.FULL_PATH)
-		
-		imgCacheDir = imgDir
-		imgCache = {}
-		for _, name in ipairs(files) do
-			if string.sub(name, -3, -1) == "png" then
-				table.insert(imgCache, name)
-			end
+		if imgFrames then
+			imgFrames.destroy()
 		end
+		imgFrames = frameIndex.newResource(imgDir, ".png")
 
-		local nameSortCache = {}
-		local function padNum(n)
-			return string.rep("0", 5 - #n) .. n
-		end
-		for _, name in ipairs(imgCache) do
-			nameSortCache[name] = name:gsub("%d+", padNum)
-		end
-
-		table.sort(imgCache, function (name1, name2)
-			return nameSortCache[name1] < nameSortCache[name2]
-		end)
+		imgCacheDir = imgDir
+		imgCache = imgFrames and imgFrames.paths or {}
 
 		frameNum = 0
 		frameCnt = #imgCache
 
-		if frameBuffers[fb_id] == nil then
-			frameBuffers[fb_id] = {}
-			for i = 1, numCacheEntries do
-				frameBuffers[fb_id][i] = {name = nil, buffer = framebuffer.new(imgW, imgH)}
-			end
-		end
+		frameSequences[fb_id] = frameSequence.new(imgCache, imgW, imgH)
 
 		needsGraphReload = true
+	elseif imgFrames and #imgFrames.poll() > 0 then
+		-- Keep following the newest frame while it is shown
+		local following = frameNum >= frameCnt - 1
+		frameCnt = #imgCache
+		frameNum = following and math.max(frameCnt - 1, 0) or math.min(frameNum, math.max(frameCnt - 1, 0))
 	end
 	
 	-- Handle keybord events to change settings
@@ -1430,11 +1770,8 @@ event.render.add("graph2", "vis", function ()
 		if (settings.hidePostBreakthrough and newFrame > breakthrough) then newFrame = breakthrough end
 
 		if click or (settings.hidePostBreakthrough and frameNum > breakthrough) then
-			if frameNum ~= newFrame then
-				frameNum = newFrame
-
-				needsGraphReload = true
-			end
+			-- Frame changes are applied to the graph scene incrementally by drawGraph
+			frameNum = newFrame
 		end
 	end
 
@@ -1549,5 +1886,60 @@ event.render.add("graph2", "vis", function ()
 			alignX = 1,
 			alignY = 1,
 		}
+
+		draw.text {
+			font = font,
+			text = "Uploaded vertices: " .. gfx.getVertexUploadStats().lastFrame,
+			x = offsetX + graphWidth,
+			y = sizeFactor * 60,
+			size = sizeFactor * 12,
+			fillColor = color.rgb(100, 150, 255),
+			alignX = 1,
+			alignY = 1,
+		}
+
+		local graphRect = {offsetX, offsetY, graphWidth, graphHeight}
+		-- Elements beyond the visible key counts are indexed, but not drawn
+		local function countVisible(visibleCount, keys, count)
+			local visible = 0
+			for i = 0, count - 1 do
+				if keys[i] <= visibleCount then
+					visible = visible + 1
+				end
+			end
+			return visible
+		end
+
+		local visibleNodes = countVisible(visibleNodeCount, nodeIndex.queryRect(graphRect))
+		local visibleLinks = countVisible(visibleLinkCount, linkIndex.queryRect(graphRect))
+
+		local lodLevel = lodLevels and lodLevels[settings.lodLevel]
+		local lodText = lodLevel and string.format(" (overview %d: %d clusters / %d links)", settings.lodLevel,
+			lodLevel.clusterCount, lodLevel.linkCount) or ""
+
+		draw.text {
+			font = font,
+			text = "Visible nodes/links: " .. visibleNodes .. " / " .. visibleLinks .. lodText,
+			x = offsetX + graphWidth,
+			y = sizeFactor * 75,
+			size = sizeFactor * 12,
+			fillColor = color.rgb(100, 150, 255),
+			alignX = 1,
+			alignY = 1,
+		}
+
+		local inspected = inspectGraph(input.mouseX(), input.mouseY())
+		if inspected then
+			draw.text {
+				font = font,
+				text = inspected,
+				x = offsetX + graphWidth,
+				y = sizeFactor * 90,
+				size = sizeFactor * 12,
+				fillColor = color.rgb(255, 255, 255),
+				alignX = 1,
+				alignY = 1,
+			}
+		end
 	end
 end)
@@ -0,0 +1,77 @@
+local flowGraph = {}
+
+local frameIndex = require "system.accel.FrameIndex"
+local graphFile = require "system.accel.GraphFile"
+
+local flowGraphBridge = bridge.flowgraph
+
+--- Starts extracting a flow graph from the segmented PNG frames in the resource directory 'imgDir' (in natural order)
+--- on the thread pool, without blocking the render loop. Frames are read from the asset directory on disk, so frames
+--- in packages are not found.
+---
+--- Frames are classified by gray level. The optional settings table may contain:
+--- - fluidMin, fluidMax: inclusive gray level range of invading fluid (default 128 to 255)
+--- - solidMin, solidMax: inclusive gray level range of solid (default 0 to 0); other levels are defending fluid
+--- - minArea: minimum pixel count of fluid components that become nodes (default 1)
+--- - minOverlap: minimum number of pixels shared by components of consecutive frames for an edge (default 1)
+--- - diagonal: whether diagonally adjacent fluid pixels are connected (default false)
+---
+--- Returns the extraction, or nil and an error message.
+function flowGraph.start(imgDir, settings)
+	local paths, err = frameIndex.list(frameIndex.getNativeDirectory(imgDir), ".png")
+	if not paths then
+		return nil, err
+	end
+
+	if #paths == 0 then
+		return nil, "No frames found in '" .. imgDir .. "'"
+	end
+
+	local extractorID = flowGraphBridge.start(paths, settings or {})
+
+	local extraction = {}
+
+	--- Returns the number of processed frames, the total number of frames, and whether the extraction is done
+	function extraction.getProgress()
+		return flowGraphBridge.getProgress(extractorID)
+	end
+
+	--- Blocks until all frames were processed
+	function extraction.wait()
+		flowGraphBridge.wait(extractorID)
+	end
+
+	--- Returns the extracted graph, with the same interface as graphs loaded via GraphFile.load, or nil and an error
+	--- message if the extraction failed or is not done yet. The graph can only be taken once.
+	function extraction.getGraph()
+		local result, takeErr = flowGraphBridge.take(extractorID)
+		if not result then
+			return nil, takeErr
+		end
+
+		result.metadata.imgDir = imgDir
+		return graphFile.fromColumns(result.columns, result.metadata)
+	end
+
+	--- Cancels the extraction if it is still running
+	function extraction.destroy()
+		flowGraphBridge.destroy(extractorID)
+	end
+
+	return extraction
+end
+
+--- Extracts the flow graph synchronously (see start). Returns the graph, or nil and an error message.
+function flowGraph.extract(imgDir, settings)
+	local extraction, err = flowGraph.start(imgDir, settings)
+	if not extraction then
+		return nil, err
+	end
+
+	extraction.wait()
+	local graph, graphErr = extraction.getGraph()
+	extraction.destroy()
+	return graph, graphErr
+end
+
+return flowGraph
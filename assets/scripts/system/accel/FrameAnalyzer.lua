@@ -0,0 +1,103 @@
+local frameAnalyzer = {}
+
+local array = require "system.utils.Array"
+local frameIndex = require "system.accel.FrameIndex"
+
+local frameAnalyzerBridge = bridge.frameanalyzer
+
+--- Per-frame statistics, as returned by getStatistics (one double array per statistic, indexed by zero-based frame)
+frameAnalyzer.Statistics = {
+	{name = "FluidPixels", title = "Fluid pixels"},
+	{name = "SolidPixels", title = "Solid pixels"},
+	{name = "DefendingPixels", title = "Defending fluid pixels"},
+	-- Fraction of the pore space (all non-solid pixels) occupied by invading fluid
+	{name = "Saturation", title = "Saturation"},
+	-- Leftmost and rightmost column containing invading fluid, relative to the frame width, or -1 without fluid
+	{name = "FrontLeft", title = "Front position (left)"},
+	{name = "FrontRight", title = "Front position (right)"},
+	-- Box-counting dimension of the invading fluid, or 0 if there is too little fluid to estimate it
+	{name = "FractalDimension", title = "Fractal dimension"},
+	{name = "MeanGray", title = "Mean gray level"},
+}
+
+--- Starts computing pixel-level statistics of the segmented PNG frames in the resource directory 'imgDir' (in natural
+--- order) on the thread pool. Frames are classified by gray level; the optional settings table may contain
+--- fluidMin/fluidMax (default 128 to 255) and solidMin/solidMax (default 0 to 0), and other levels are defending fluid.
+---
+--- Unless 'useCache' is false, the statistics of each frame are cached on disk, so that only new or modified frames
+--- are analyzed when the sequence is opened again.
+---
+--- The frames are read from disk, so 'imgDir' cannot be a directory in a package (see FrameIndex.getNativeDirectory).
+---
+--- Returns the analysis, or nil and an error message.
+function frameAnalyzer.start(imgDir, settings, useCache)
+	local paths, err = frameIndex.list(frameIndex.getNativeDirectory(imgDir), ".png")
+	if not paths then
+		return nil, err
+	end
+
+	if #paths == 0 then
+		return nil, "No frames found in '" .. imgDir .. "'"
+	end
+
+	local analyzerID = frameAnalyzerBridge.start(paths, settings or {}, useCache ~= false)
+
+	local analysis = {}
+
+	--- Returns the number of processed frames, the total number of frames, whether the analysis is done, and the
+	--- number of frames whose statistics were taken from the cache
+	function analysis.getProgress()
+		return frameAnalyzerBridge.getProgress(analyzerID)
+	end
+
+	--- Blocks until all frames were processed
+	function analysis.wait()
+		frameAnalyzerBridge.wait(analyzerID)
+	end
+
+	--- Returns a table mapping each statistic's name to a double array of per-frame values, or nil and an error
+	--- message if the analysis failed or is not done yet. The statistics can only be taken once.
+	function analysis.getStatistics()
+		local columns, takeErr = frameAnalyzerBridge.take(analyzerID)
+		if not columns then
+			return nil, takeErr
+		end
+
+		local statistics = {}
+		for name, column in pairs(columns) do
+			statistics[name] = array.getArrayByID(column.type, column.id)
+		end
+		return statistics
+	end
+
+	--- Cancels the analysis if it is still running
+	function analysis.destroy()
+		frameAnalyzerBridge.destroy(analyzerID)
+	end
+
+	return analysis
+end
+
+--- Analyzes the frames synchronously (see start). Returns the statistics, or nil and an error message.
+function frameAnalyzer.analyze(imgDir, settings, useCache)
+	local analysis, err = frameAnalyzer.start(imgDir, settings, useCache)
+	if not analysis then
+		return nil, err
+	end
+
+	analysis.wait()
+	local statistics, statisticsErr = analysis.getStatistics()
+	analysis.destroy()
+	return statistics, statisticsErr
+end
+
+--- Converts a per-frame array into a table indexed by one-based time step, as used for metrics.
+function frameAnalyzer.toMetric(values)
+	local metric = {}
+	for i = 0, values.size - 1 do
+		metric[i + 1] = values[i]
+	end
+	return metric
+end
+
+return frameAnalyzer
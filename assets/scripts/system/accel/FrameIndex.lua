@@ -0,0 +1,131 @@
+local frameIndex = {}
+
+local config = require "system.game.Config"
+local fileIO = require "system.game.FileIO"
+
+local frameIndexBridge = bridge.frameindex
+
+local insert = table.insert
+local remove = table.remove
+
+local function createIndex(directory, suffix, settleDelay, mapPath)
+	local indexID, err = frameIndexBridge.create(directory, suffix or "", settleDelay or 0.5)
+	if not indexID then
+		return nil, err
+	end
+
+	local paths = frameIndexBridge.getPaths(indexID) or {}
+	if mapPath then
+		for i, path in ipairs(paths) do
+			paths[i] = mapPath(path)
+		end
+	end
+
+	local index = {
+		--- Paths of all frames in order. Updated in place by poll().
+		paths = paths,
+	}
+
+	--- Applies the changes observed since the last call to 'paths' and returns them as a list of
+	--- {type = "added" | "removed" | "modified", path = ..., index = ...}. The index is the one-based position of the
+	--- frame after adding it, or before removing it.
+	function index.poll()
+		local changes = frameIndexBridge.poll(indexID)
+		if not changes then
+			return {}
+		end
+
+		for _, change in ipairs(changes) do
+			change.index = change.index + 1
+			if mapPath then
+				change.path = mapPath(change.path)
+			end
+
+			if change.type == "added" then
+				insert(paths, change.index, change.path)
+			elseif change.type == "removed" then
+				remove(paths, change.index)
+			end
+		end
+		return changes
+	end
+
+	function index.destroy()
+		frameIndexBridge.destroy(indexID)
+	end
+
+	return index
+end
+
+-- Resources from packages cannot be observed, so their frames are listed once and never change
+local function listResources(directory, suffix)
+	local paths = {}
+	for _, path in ipairs(fileIO.listFiles(directory, fileIO.List.FILES, fileIO.List.FULL_PATH) or {}) do
+		if path:sub(-#suffix) == suffix or suffix == "" then
+			paths[#paths + 1] = path
+		end
+	end
+
+	local sortKeys = {}
+	for _, path in ipairs(paths) do
+		sortKeys[path] = path:gsub("%d+", function (digits)
+			return string.rep("0", 10 - #digits) .. digits
+		end)
+	end
+	table.sort(paths, function (path1, path2)
+		return sortKeys[path1] < sortKeys[path2]
+	end)
+
+	return {
+		paths = paths,
+		poll = function ()
+			return {}
+		end,
+		destroy = function ()
+		end,
+	}
+end
+
+--- Keeps a naturally sorted list ("frame9" before "frame10") of the files in 'directory' whose names end with
+--- 'suffix', updated incrementally while a simulation keeps writing to it. Files are only reported once they have not
+--- changed for 'settleDelay' seconds (default 0.5), so partially written frames are skipped. A delay of 0 reports
+--- files immediately.
+---
+--- Returns the index, or nil and an error message if the directory cannot be observed.
+function frameIndex.new(directory, suffix, settleDelay)
+	return createIndex(directory, suffix, settleDelay)
+end
+
+--- Returns the naturally sorted paths of the files in 'directory' whose names end with 'suffix', without observing the
+--- directory for changes. Returns nil and an error message if the directory cannot be listed.
+function frameIndex.list(directory, suffix)
+	return frameIndexBridge.list(directory, suffix or "")
+end
+
+--- Returns the file system path of a resource directory within the asset directory. Resources from packages
+--- (wos.game.assets.packages) have no such path.
+function frameIndex.getNativeDirectory(directory)
+	directory = directory:gsub("/+$", "")
+
+	local assetsPath = config.getString("wos.game.assets.path")
+	return assetsPath ~= "" and assetsPath .. "/" .. directory or directory
+end
+
+--- Same as new, for a resource directory within the asset directory. Paths are reported as resource names (as
+--- returned by FileIO.listFiles with FULL_PATH), so that they can be passed to the graphics functions directly.
+---
+--- Directories that are not on disk, such as those in packages, are listed once via FileIO.listFiles instead, and
+--- poll() never reports changes for them.
+function frameIndex.newResource(directory, suffix, settleDelay)
+	directory = directory:gsub("/+$", "")
+
+	local nativeDirectory = frameIndex.getNativeDirectory(directory)
+	local nameOffset = #nativeDirectory + 2
+
+	local index = createIndex(nativeDirectory, suffix, settleDelay, function(path)
+		return directory .. "/" .. path:sub(nameOffset)
+	end)
+	return index or listResources(directory, suffix or "")
+end
+
+return frameIndex
@@ -0,0 +1,223 @@
+local graphFile = {}
+
+local array = require "system.utils.Array"
+
+local graphFileBridge = bridge.graphfile
+
+local Type = array.Type
+
+local floor = math.floor
+local pairs = pairs
+local type = type
+
+--- Per-node columns, in the order of the node entries in Lua graph files
+graphFile.NodeColumns = {
+	{name = "Time", type = Type.INT32},
+	{name = "Id", type = Type.INT32},
+	{name = "X", type = Type.DOUBLE},
+	{name = "Y", type = Type.DOUBLE},
+	{name = "Velocity", type = Type.DOUBLE},
+	{name = "Modified", type = Type.UINT8},
+	{name = "Area", type = Type.DOUBLE},
+	{name = "EdgesIn", type = Type.INT32},
+	{name = "EdgesOut", type = Type.INT32},
+}
+
+--- Remaining columns:
+--- - Edges:       int32[2 * edgeCount] (zero-based source/target node index pairs, in file order)
+--- - OutOffsets:  int32[nodeCount + 1] (CSR offsets into OutTargets)
+--- - OutTargets:  int32[edgeCount]     (zero-based target node indices, grouped by source node)
+--- - InOffsets:   int32[nodeCount + 1] (CSR offsets into InSources)
+--- - InSources:   int32[edgeCount]     (zero-based source node indices, grouped by target node)
+--- - Rects:       double[4 * rectCount] (left, top, right, bottom)
+--- - Interfaces:  double[2 * nodeCount] (fluid and solid interface lengths)
+--- - Velocities:  double[velocityCount]
+graphFile.Column = {
+	EDGES = "Edges",
+	OUT_OFFSETS = "OutOffsets",
+	OUT_TARGETS = "OutTargets",
+	IN_OFFSETS = "InOffsets",
+	IN_SOURCES = "InSources",
+	RECTS = "Rects",
+	INTERFACES = "Interfaces",
+	VELOCITIES = "Velocities",
+}
+
+local function buildCSR(nodeCount, edgeList, keyOffset)
+	local edgeCount = floor(#edgeList / 2)
+	local offsets = array.new(Type.INT32, nodeCount + 1)
+	local targets = array.new(Type.INT32, edgeCount)
+
+	for i = 1, #edgeList - 1, 2 do
+		local key = edgeList[i + keyOffset]
+		offsets[key + 1] = offsets[key + 1] + 1
+	end
+	for i = 1, nodeCount do
+		offsets[i] = offsets[i] + offsets[i - 1]
+	end
+
+	local fill = {}
+	for i = 1, #edgeList - 1, 2 do
+		local key = edgeList[i + keyOffset]
+		local slot = offsets[key] + (fill[key] or 0)
+		fill[key] = (fill[key] or 0) + 1
+		targets[slot] = edgeList[i + 1 - keyOffset]
+	end
+
+	return offsets, targets
+end
+
+local function fromList(arrayType, list, count)
+	local result = array.new(arrayType, count or #list)
+	for i = 1, result.size do
+		result[i - 1] = list[i] or 0
+	end
+	return result
+end
+
+--- Converts a graph stored as a Lua file (as loaded via dofile) into the binary columnar graph format.
+--- Returns true on success, or false and an error message.
+function graphFile.convert(sourceFileName, targetFileName)
+	local graphData = dofile(sourceFileName)
+	local nodes = graphData.Nodes or {}
+	local nodeCount = #nodes
+	local edgeList = graphData.Edges or {}
+
+	local columns = {}
+	local keepAlive = {}
+
+	local function addColumn(name, arr)
+		columns[#columns + 1] = {name = name, type = arr.type, id = arr.id}
+		keepAlive[#keepAlive + 1] = arr
+	end
+
+	for index, column in ipairs(graphFile.NodeColumns) do
+		local arr = array.new(column.type, nodeCount)
+		for i = 1, nodeCount do
+			local value = nodes[i][index] or 0
+			arr[i - 1] = type(value) == "boolean" and (value and 1 or 0) or value
+		end
+		addColumn(column.name, arr)
+	end
+
+	addColumn(graphFile.Column.EDGES, fromList(Type.INT32, edgeList, floor(#edgeList / 2) * 2))
+
+	local outOffsets, outTargets = buildCSR(nodeCount, edgeList, 0)
+	addColumn(graphFile.Column.OUT_OFFSETS, outOffsets)
+	addColumn(graphFile.Column.OUT_TARGETS, outTargets)
+
+	local inOffsets, inSources = buildCSR(nodeCount, edgeList, 1)
+	addColumn(graphFile.Column.IN_OFFSETS, inOffsets)
+	addColumn(graphFile.Column.IN_SOURCES, inSources)
+
+	if graphData.Rects then
+		local rects = graphData.Rects
+		local arr = array.new(Type.DOUBLE, #rects * 4)
+		for i = 1, #rects do
+			for j = 1, 4 do
+				arr[(i - 1) * 4 + j - 1] = rects[i][j] or 0
+			end
+		end
+		addColumn(graphFile.Column.RECTS, arr)
+	end
+
+	if graphData.Interfaces then
+		addColumn(graphFile.Column.INTERFACES, fromList(Type.DOUBLE, graphData.Interfaces, nodeCount * 2))
+	end
+
+	if graphData.Velocities then
+		addColumn(graphFile.Column.VELOCITIES, fromList(Type.DOUBLE, graphData.Velocities))
+	end
+
+	-- All scalar fields (image directory, time range, etc.) are stored as metadata
+	local metadata = {}
+	for key, value in pairs(graphData) do
+		if type(key) == "string" and type(value) ~= "table" then
+			metadata[key] = value
+		end
+	end
+
+	return graphFileBridge.save(targetFileName, columns, metadata)
+end
+
+--- Wraps native column arrays, given as {name = {id = arrayID, type = arrayType}}, and a metadata table into a graph
+--- with the same interface as the graphs returned by load.
+function graphFile.fromColumns(columnIDs, metadata)
+	local graph = {
+		metadata = metadata,
+		columns = {},
+	}
+
+	for name, column in pairs(columnIDs) do
+		graph.columns[name] = array.getArrayByID(column.type, column.id)
+	end
+
+	local columns = graph.columns
+	graph.nodeCount = columns.Time and columns.Time.size or 0
+	graph.edgeCount = columns.Edges and floor(columns.Edges.size / 2) or 0
+
+	--- Returns a table per node, with the same named fields as used for Lua graph files
+	function graph.readNodes()
+		local nodes = {}
+		for i = 1, graph.nodeCount do
+			local node = {}
+			for _, column in ipairs(graphFile.NodeColumns) do
+				node[column.name] = columns[column.name][i - 1]
+			end
+			nodes[i] = node
+		end
+		return nodes
+	end
+
+	--- Returns a table in the layout of the Lua graph files, without the node list
+	function graph.toGraphData()
+		local graphData = {}
+		for key, value in pairs(graph.metadata) do
+			graphData[key] = value
+		end
+
+		local function toList(arr)
+			local list = {}
+			for i = 1, arr.size do
+				list[i] = arr[i - 1]
+			end
+			return list
+		end
+
+		graphData.Edges = columns.Edges and toList(columns.Edges) or {}
+
+		if columns.Rects then
+			local rects = {}
+			for i = 1, floor(columns.Rects.size / 4) do
+				local base = (i - 1) * 4
+				rects[i] = {columns.Rects[base], columns.Rects[base + 1], columns.Rects[base + 2], columns.Rects[base + 3]}
+			end
+			graphData.Rects = rects
+		end
+
+		if columns.Interfaces then
+			graphData.Interfaces = toList(columns.Interfaces)
+		end
+
+		if columns.Velocities then
+			graphData.Velocities = toList(columns.Velocities)
+		end
+
+		return graphData
+	end
+
+	return graph
+end
+
+--- Loads a graph in the binary columnar format. The file is memory-mapped and its columns are copied into arrays.
+--- Returns the graph, or nil and an error message.
+function graphFile.load(fileName)
+	local result, err = graphFileBridge.load(fileName)
+	if not result then
+		return nil, err
+	end
+
+	return graphFile.fromColumns(result.columns, result.metadata)
+end
+
+return graphFile
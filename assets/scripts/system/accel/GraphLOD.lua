@@ -0,0 +1,49 @@
+local graphLOD = {}
+
+local array = require "system.utils.Array"
+
+local lodBridge = bridge.lod
+
+local Type = array.Type
+
+local floor = math.floor
+
+--- Number of values per element in the cluster and link arrays of a level:
+--- - clusters: x, y, radius, packed color, node count, total area
+--- - links:    zero-based source cluster, zero-based target cluster, summed weight, link count
+graphLOD.ClusterStride = 6
+graphLOD.LinkStride = 4
+
+--- Precomputes a screen-space level-of-detail hierarchy natively (see GraphLOD.hpp). Nodes are clustered by grid cell,
+--- starting at 'options.baseCellSize' (default 8) and doubling per level, for 'options.levelCount' levels (default 6).
+--- Links between clusters are merged per ordered cluster pair.
+---
+--- 'circles' is a double array of x, y, radius triples and 'colors' a double array of packed colors, one per node;
+--- nodes with a NaN coordinate are left out. 'links' is an int32 array of zero-based source/target node index pairs,
+--- and 'linkWeights' an optional double array with one weight per link.
+---
+--- Returns a list of levels from finest to coarsest, each holding its cellSize, the clusters, links and nodeClusters
+--- (int32, -1 for left out nodes) arrays and the clusterCount and linkCount. Returns nil and an error message on
+--- failure.
+function graphLOD.build(circles, colors, links, linkWeights, options)
+	options = options or {}
+
+	local nodeCount = options.nodeCount or floor(circles.size / 3)
+	local linkCount = options.linkCount or floor(links.size / 2)
+
+	local levels, err = lodBridge.build(circles.id, colors.id, nodeCount, links.id, linkWeights and linkWeights.id or -1,
+		linkCount, options.baseCellSize or 8, options.levelCount or 6)
+	if not levels then
+		return nil, err
+	end
+
+	for _, level in ipairs(levels) do
+		level.clusters = array.getArrayByID(Type.DOUBLE, level.clusters)
+		level.links = array.getArrayByID(Type.DOUBLE, level.links)
+		level.nodeClusters = array.getArrayByID(Type.INT32, level.nodeClusters)
+	end
+
+	return levels
+end
+
+return graphLOD
@@ -0,0 +1,205 @@
+local layout = {}
+
+local array = require "system.utils.Array"
+local proxy = require "system.utils.Proxy"
+
+local ffi = require "ffi"
+local C = ffi.C
+
+local layoutBridge = bridge.layout
+
+local arrayContextID = bridge.array.getContext()
+
+local graphCType = ffi.typeof("wosC_accel_layout_graph_t")
+local fa2ParamsCType = ffi.typeof("wosC_accel_layout_fa2Params_t")
+
+layout.ForceAtlas2Defaults = {
+	scalingRatio = 50,
+	gravity = 0.5,
+	jitterTolerance = 0.1,
+	maxDisplacement = 10,
+	barnesHutTheta = 1.2,
+}
+
+-- The background worker stops after maxIterations iterations, or once the total swinging per node falls below
+-- minSwinging, and resumes when node radii change
+layout.WorkerStopDefaults = {
+	maxIterations = 10000,
+	minSwinging = 0.01,
+}
+
+-- Creates a native ForceAtlas2 layout over flat node/edge arrays.
+-- Node and edge indices are 1-based on the Lua side.
+function layout.newForceAtlas2(nodeCount, edgeCount, params)
+	params = params or {}
+
+	local positions = array.new(array.Type.DOUBLE, nodeCount * 2)
+	local forces = array.new(array.Type.DOUBLE, nodeCount * 4)
+	local masses = array.new(array.Type.DOUBLE, nodeCount)
+	local radii = array.new(array.Type.DOUBLE, nodeCount)
+	local fixed = array.new(array.Type.UINT8, nodeCount)
+	local edges = array.new(array.Type.INT32, edgeCount * 2)
+
+	local graph = ffi.new(graphCType)
+	graph.arrayContext = arrayContextID
+	graph.positionArrayID = positions.id
+	graph.forceArrayID = forces.id
+	graph.massArrayID = masses.id
+	graph.radiusArrayID = radii.id
+	graph.fixedArrayID = fixed.id
+	graph.edgeArrayID = edges.id
+	graph.nodeCount = nodeCount
+	graph.edgeCount = edgeCount
+
+	local fa2Params = ffi.new(fa2ParamsCType)
+	for key, default in pairs(layout.ForceAtlas2Defaults) do
+		fa2Params[key] = params[key] or default
+	end
+	fa2Params.speed = 1
+	fa2Params.speedEfficiency = 1
+	fa2Params.resetSpeed = params.resetSpeed and 1 or 0
+
+	-- Plain table copy of the graph structure, as expected by the layout bridge
+	local graphTable = {
+		arrayContext = arrayContextID,
+		positionArrayID = positions.id,
+		forceArrayID = forces.id,
+		massArrayID = masses.id,
+		radiusArrayID = radii.id,
+		fixedArrayID = fixed.id,
+		edgeArrayID = edges.id,
+		nodeCount = nodeCount,
+		edgeCount = edgeCount,
+	}
+
+	local workerID
+
+	-- The arrays are referenced by the instance to keep them alive for as long as the layout is in use
+	local instance = {
+		positions = positions,
+		forces = forces,
+		masses = masses,
+		radii = radii,
+		fixed = fixed,
+		edges = edges,
+	}
+
+	function instance.setNode(index, x, y, mass, radius, isFixed)
+		positions[index * 2 - 2] = x
+		positions[index * 2 - 1] = y
+		masses[index - 1] = mass
+		radii[index - 1] = radius
+		fixed[index - 1] = isFixed and 1 or 0
+	end
+
+	function instance.setRadius(index, radius)
+		radii[index - 1] = radius
+	end
+
+	function instance.setEdge(index, node1, node2)
+		edges[index * 2 - 2] = node1 - 1
+		edges[index * 2 - 1] = node2 - 1
+	end
+
+	function instance.getPosition(index)
+		return positions[index * 2 - 2], positions[index * 2 - 1]
+	end
+
+	function instance.setGravityLines(line1, line2)
+		fa2Params.gravityLine1 = line1
+		fa2Params.gravityLine2 = line2
+	end
+
+	function instance.setOutboundCompensation(value)
+		fa2Params.outboundCompensation = value
+	end
+
+	function instance.resetSpeed()
+		fa2Params.speed = 1
+		fa2Params.speedEfficiency = 1
+	end
+
+	function instance.step(iterations)
+		C.wosC_accel_layout_fa2Step(graph, fa2Params, iterations or 1)
+	end
+
+	function instance.getTotalSwinging()
+		return fa2Params.totalSwinging
+	end
+
+	function instance.getTotalEffectiveTraction()
+		return fa2Params.totalEffectiveTraction
+	end
+
+	-- Starts iterating on a background worker, using the current node data as the initial state
+	function instance.startWorker()
+		instance.stopWorker()
+
+		local paramsTable = {}
+		for key in pairs(layout.ForceAtlas2Defaults) do
+			paramsTable[key] = fa2Params[key]
+		end
+		paramsTable.gravityLine1 = fa2Params.gravityLine1
+		paramsTable.gravityLine2 = fa2Params.gravityLine2
+		paramsTable.outboundCompensation = fa2Params.outboundCompensation
+		paramsTable.speed = fa2Params.speed
+		paramsTable.speedEfficiency = fa2Params.speedEfficiency
+		paramsTable.resetSpeed = fa2Params.resetSpeed ~= 0
+		for key, default in pairs(layout.WorkerStopDefaults) do
+			paramsTable[key] = params[key] or default
+		end
+
+		local id = layoutBridge.startWorker(graphTable, paramsTable)
+		if id >= 0 then
+			workerID = id
+		end
+		return workerID ~= nil
+	end
+
+	function instance.stopWorker()
+		if workerID then
+			layoutBridge.stopWorker(workerID)
+			workerID = nil
+		end
+	end
+
+	-- Returns true if a background worker was started and not stopped, even if it currently rests after converging
+	function instance.hasWorker()
+		return workerID ~= nil
+	end
+
+	function instance.isWorkerRunning()
+		return workerID ~= nil and layoutBridge.isWorkerRunning(workerID)
+	end
+
+	function instance.isWorkerConverged()
+		return workerID ~= nil and layoutBridge.isWorkerConverged(workerID)
+	end
+
+	-- Passes the current node radii to the background worker, resuming it if it converged and any radius changed
+	function instance.updateWorkerRadii()
+		return workerID ~= nil and layoutBridge.updateWorkerRadii(workerID, graphTable)
+	end
+
+	-- Copies the latest background worker positions into the position array.
+	-- Returns false if no new positions were available.
+	function instance.swap()
+		return workerID ~= nil and layoutBridge.swapWorkerPositions(workerID, graphTable)
+	end
+
+	function instance.getIterationRate()
+		return workerID and layoutBridge.getWorkerIterationRate(workerID) or 0
+	end
+
+	function instance.getWorkerSwinging()
+		return workerID and layoutBridge.getWorkerSwinging(workerID) or 0
+	end
+
+	return proxy.setMetatable(instance, {
+		__gc = function ()
+			instance.stopWorker()
+		end,
+	})
+end
+
+return layout
@@ -0,0 +1,62 @@
+local metrics = {}
+
+local array = require "system.utils.Array"
+
+local metricBridge = bridge.metric
+
+local Type = array.Type
+
+--- Reduction operations. Missing values (NaN) are counted by COUNT, but ignored by all other operations.
+metrics.Operation = {
+	SUM = 1,
+	MAX = 2,
+	MIN = 3,
+	MEAN = 4,
+	COUNT = 5,
+}
+
+--- Reduces a double array of values grouped by the time steps in an int32 array of the same size, in a single native
+--- pass. Bucket i (zero-based) of the result holds time step i + options.timeOffset; rows outside the bucket range are
+--- skipped. 'values' may be nil for COUNT.
+---
+--- The result and per-bucket row count arrays are allocated unless passed as options.result and options.counts.
+--- Returns the result array, the row count array and a table with the fields min, max (over the buckets containing
+--- at least one row), valueMin, valueMax (over all present values), populatedBuckets and skippedRows.
+--- Returns nil and an error message on failure.
+function metrics.reduce(operation, times, values, bucketCount, options)
+	options = options or {}
+
+	if times.type ~= Type.INT32 then
+		return nil, "Time array must be of type INT32"
+	end
+	if values and values.type ~= Type.DOUBLE then
+		return nil, "Value array must be of type DOUBLE"
+	end
+
+	local result = options.result or array.new(Type.DOUBLE, bucketCount)
+	local counts = options.counts or array.new(Type.INT32, result.size)
+
+	local stats, err = metricBridge.reduce(operation, times.id, values and values.id or -1, result.id, counts.id,
+		options.timeOffset or 0)
+	if not stats then
+		return nil, err
+	end
+
+	return result, counts, stats
+end
+
+--- Converts a reduced result into a Lua table indexed by bucket + indexOffset (default 1), which only contains the
+--- buckets with at least one row.
+function metrics.toTable(result, counts, indexOffset)
+	indexOffset = indexOffset or 1
+
+	local tab = {}
+	for i = 0, result.size - 1 do
+		if counts[i] > 0 then
+			tab[i + indexOffset] = result[i]
+		end
+	end
+	return tab
+end
+
+return metrics
@@ -0,0 +1,135 @@
+local svgWriter = {}
+
+local array = require "system.utils.Array"
+local color = require "system.utils.Color"
+
+local svgBridge = bridge.svg
+
+local colorFromTable = color.fromTable
+
+local floor = math.floor
+
+--- Element types, with the values stored per element in flat double arrays:
+--- - CIRCLE: cx, cy, r, strokeColor, strokeWidth, fillColor
+--- - LINE:   x1, y1, x2, y2, strokeColor, strokeWidth
+--- - RECT:   x, y, width, height, strokeColor, strokeWidth, fillColor
+--- Colors are packed RGBA values (see system.utils.Color); fully transparent colors are written as "transparent".
+svgWriter.Element = {
+	CIRCLE = 1,
+	LINE = 2,
+	RECT = 3,
+}
+
+svgWriter.Stride = {
+	[svgWriter.Element.CIRCLE] = 6,
+	[svgWriter.Element.LINE] = 6,
+	[svgWriter.Element.RECT] = 7,
+}
+
+local Element = svgWriter.Element
+local Stride = svgWriter.Stride
+
+-- Number of elements buffered by the per-element functions before they are passed to the native writer
+local batchSize = 4096
+
+local function toColor(value)
+	return value and colorFromTable(value) or 0
+end
+
+--- Opens a streaming SVG writer for the specified file. The file is gzip-compressed if options.compress is set, or if
+--- the file name ends with ".svgz". options.precision sets the maximum number of decimal places (default 3).
+--- Returns the writer, or nil and an error message.
+function svgWriter.open(fileName, width, height, options)
+	options = options or {}
+
+	local compress = options.compress
+	if compress == nil then
+		compress = fileName:sub(-5):lower() == ".svgz"
+	end
+
+	local writerID, err = svgBridge.open(fileName, width, height, compress, options.precision or 3)
+	if writerID < 0 then
+		return nil, err
+	end
+
+	local batch = array.new(array.Type.DOUBLE, batchSize * Stride[Element.RECT])
+	local batchType = Element.CIRCLE
+	local batchCount = 0
+	local batchOffset = 0
+	local errorMessage
+
+	local function check(success, message)
+		if not success and not errorMessage then
+			errorMessage = message
+		end
+	end
+
+	local function flush()
+		if batchCount > 0 then
+			check(svgBridge.write(writerID, batchType, batch.id, 0, batchCount))
+			batchCount = 0
+			batchOffset = 0
+		end
+	end
+
+	-- Starts a new buffered element, flushing the batch if it is full or holds a different element type
+	local function nextElement(elementType)
+		if batchType ~= elementType or batchCount == batchSize then
+			flush()
+			batchType = elementType
+		end
+		local offset = batchOffset
+		batchCount = batchCount + 1
+		batchOffset = offset + Stride[elementType]
+		return offset
+	end
+
+	local writer = {}
+
+	function writer.circle(cx, cy, r, stroke, strokeWidth, fill)
+		local o = nextElement(Element.CIRCLE)
+		batch[o], batch[o + 1], batch[o + 2] = cx, cy, r
+		batch[o + 3], batch[o + 4], batch[o + 5] = toColor(stroke), strokeWidth or 1, toColor(fill)
+	end
+
+	function writer.line(x1, y1, x2, y2, stroke, strokeWidth)
+		local o = nextElement(Element.LINE)
+		batch[o], batch[o + 1], batch[o + 2], batch[o + 3] = x1, y1, x2, y2
+		batch[o + 4], batch[o + 5] = toColor(stroke), strokeWidth or 1
+	end
+
+	function writer.rect(x, y, width, height, stroke, strokeWidth, fill)
+		local o = nextElement(Element.RECT)
+		batch[o], batch[o + 1], batch[o + 2], batch[o + 3] = x, y, width, height
+		batch[o + 4], batch[o + 5], batch[o + 6] = toColor(stroke), strokeWidth or 1, toColor(fill)
+	end
+
+	--- Writes 'count' elements from a flat double array, starting at element index 'offset' (default 0). Elements
+	--- specified individually before this call are written first.
+	function writer.writeArray(elementType, arr, count, offset)
+		flush()
+		offset = offset or 0
+		count = count or (floor(arr.size / Stride[elementType]) - offset)
+		check(svgBridge.write(writerID, elementType, arr.id, offset, count))
+	end
+
+	--- Finishes the document. Returns true and the number of written elements, or false and the first error.
+	function writer.close()
+		flush()
+		local success, message, elementCount = svgBridge.close(writerID)
+		check(success, message)
+		if errorMessage then
+			return false, errorMessage
+		end
+		return true, elementCount
+	end
+
+	return writer
+end
+
+--- Returns the maximum number of elements of the specified type that fit into a single array.
+function svgWriter.getMaxArrayElements(elementType)
+	return floor(array.MAX_SIZE / array.getByteSizeByType(array.Type.DOUBLE) / Stride[elementType])
+end
+
+return svgWriter
@@ -0,0 +1,85 @@
+local spatialIndex = {}
+
+local array = require "system.utils.Array"
+
+local spatialBridge = bridge.spatial
+
+local Type = array.Type
+
+local floor = math.floor
+local max = math.max
+
+--- Number of values per element in the flat double arrays passed to setCircles and setSegments:
+--- - circles:  x, y, radius
+--- - segments: x1, y1, x2, y2, halfWidth
+--- Elements with a NaN coordinate are removed from the index.
+spatialIndex.CircleStride = 3
+spatialIndex.SegmentStride = 5
+
+--- Creates a native uniform-grid index over circles and line segments, identified by non-negative element IDs
+--- (typically retained scene keys). cellSize should be somewhat larger than a typical element (default 32).
+function spatialIndex.new(cellSize)
+	local indexID = spatialBridge.create(cellSize or 32)
+
+	local resultArray = array.new(Type.INT32, 256)
+
+	local index = {}
+
+	--- Sets 'count' circles from a flat double array, starting at element 'offset' (default 0) of the array, as the
+	--- elements firstID, firstID + 1, ... (default 0). Unchanged elements are cheap to set again.
+	function index.setCircles(arr, count, firstID, offset)
+		offset = offset or 0
+		count = count or (floor(arr.size / spatialIndex.CircleStride) - offset)
+		return spatialBridge.setCircles(indexID, firstID or 0, arr.id, offset, count)
+	end
+
+	--- Same as setCircles, for line segments.
+	function index.setSegments(arr, count, firstID, offset)
+		offset = offset or 0
+		count = count or (floor(arr.size / spatialIndex.SegmentStride) - offset)
+		return spatialBridge.setSegments(indexID, firstID or 0, arr.id, offset, count)
+	end
+
+	function index.remove(elementID)
+		spatialBridge.remove(indexID, elementID)
+	end
+
+	--- Removes all elements with an ID of 'count' or higher.
+	function index.truncate(count)
+		spatialBridge.truncate(indexID, count)
+	end
+
+	function index.getElementCount()
+		return spatialBridge.getElementCount(indexID)
+	end
+
+	--- Returns the ID of the element closest to the point within 'tolerance' (default 0), or nil. Circles take
+	--- precedence over segments that also contain the point.
+	function index.pick(x, y, tolerance)
+		local elementID = spatialBridge.pick(indexID, x, y, tolerance or 0)
+		if elementID < 0 then
+			return nil
+		end
+		return elementID
+	end
+
+	--- Finds all elements intersecting the rectangle {x, y, width, height}. Returns an int32 array holding the element
+	--- IDs in its first 'count' entries, and the count. The array is reused by subsequent queries.
+	function index.queryRect(rect)
+		local x1, y1, x2, y2 = rect[1], rect[2], rect[1] + rect[3], rect[2] + rect[4]
+		local count = spatialBridge.queryRect(indexID, x1, y1, x2, y2, resultArray.id)
+		if count > resultArray.size then
+			resultArray = array.new(Type.INT32, max(count, resultArray.size * 2))
+			count = spatialBridge.queryRect(indexID, x1, y1, x2, y2, resultArray.id)
+		end
+		return resultArray, count
+	end
+
+	function index.destroy()
+		spatialBridge.destroy(indexID)
+	end
+
+	return index
+end
+
+return spatialIndex
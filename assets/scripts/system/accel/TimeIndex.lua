@@ -0,0 +1,81 @@
+local timeIndex = {}
+
+local array = require "system.utils.Array"
+
+local ffi = require "ffi"
+local C = ffi.C
+
+local arrayContextID = bridge.array.getContext()
+
+local indexCType = ffi.typeof("wosC_accel_timeIndex_t")
+
+local Type = array.Type
+
+local floor = math.floor
+
+--- Sorts items by time step natively (see TimeIndexBinding.h), so that all items of one time step, and all items up
+--- to a time step, form contiguous ranges of the order.
+---
+--- 'times' is an int32 array holding the time step of each item. The order is zero-based, and items of the same time
+--- step keep their relative order. Returns the index, or nil and an error message.
+function timeIndex.build(times)
+	local itemCount = times.size
+
+	local structure = ffi.new(indexCType)
+	structure.arrayContext = arrayContextID
+	structure.timeArrayID = times.id
+	structure.itemCount = itemCount
+
+	if not C.wosC_accel_timeIndex_getTimeRange(structure) then
+		return nil, "Invalid time array"
+	end
+
+	local minTime, maxTime = structure.minTime, structure.maxTime
+
+	-- The time array is referenced by the instance to keep it alive for as long as the index is in use
+	local index = {
+		itemCount = itemCount,
+		minTime = minTime,
+		maxTime = maxTime,
+
+		times = times,
+		order = array.new(Type.INT32, itemCount),
+		offsets = array.new(Type.INT32, maxTime - minTime + 2),
+	}
+
+	structure.orderArrayID = index.order.id
+	structure.offsetArrayID = index.offsets.id
+
+	if not C.wosC_accel_timeIndex_build(structure) then
+		return nil, "Failed to build time index"
+	end
+
+	local offsets = index.offsets
+
+	--- Returns the position of the first item in the order whose time step is 'time' or later.
+	function index.getStart(time)
+		time = floor(time)
+		if time <= minTime then
+			return 0
+		elseif time > maxTime then
+			return itemCount
+		end
+		return offsets[time - minTime]
+	end
+
+	local getStart = index.getStart
+
+	--- Returns the number of items with a time step up to and including 'time', which are the first items in the order.
+	function index.countUpTo(time)
+		return getStart(time + 1)
+	end
+
+	--- Returns the zero-based, half-open range of positions in the order holding the items of time step 'time'.
+	function index.getRange(time)
+		return getStart(time), getStart(time + 1)
+	end
+
+	return index
+end
+
+return timeIndex
@@ -0,0 +1,98 @@
+local topology = {}
+
+local array = require "system.utils.Array"
+
+local ffi = require "ffi"
+local C = ffi.C
+
+local arrayContextID = bridge.array.getContext()
+
+local graphCType = ffi.typeof("wosC_accel_topology_graph_t")
+
+local Type = array.Type
+
+local floor = math.floor
+
+--- Builds the topology of a directed graph natively: CSR in/out adjacency, parent/child links by largest area,
+--- lineage IDs and the simplified graph with pass-through chains collapsed (see TopologyBinding.h).
+---
+--- 'edges' is an int32 array of zero-based source/target node index pairs. 'areas', 'xs' and 'ys' are double arrays
+--- and 'times' is an int32 array, with one entry per node.
+---
+--- All result arrays are zero-based and use -1 for missing nodes. Returns the topology, or nil and an error message.
+function topology.build(edges, areas, times, xs, ys)
+	local nodeCount = areas.size
+	local edgeCount = floor(edges.size / 2)
+
+	if times.size ~= nodeCount or xs.size ~= nodeCount or ys.size ~= nodeCount then
+		return nil, "Node array sizes do not match"
+	end
+
+	-- The input arrays are referenced by the instance to keep them alive for as long as the topology is in use
+	local topo = {
+		nodeCount = nodeCount,
+		edgeCount = edgeCount,
+
+		edges = edges,
+		areas = areas,
+		times = times,
+		xs = xs,
+		ys = ys,
+
+		outOffsets = array.new(Type.INT32, nodeCount + 1),
+		outTargets = array.new(Type.INT32, edgeCount),
+		inOffsets = array.new(Type.INT32, nodeCount + 1),
+		inSources = array.new(Type.INT32, edgeCount),
+		parents = array.new(Type.INT32, nodeCount),
+		children = array.new(Type.INT32, nodeCount),
+		lineages = array.new(Type.INT32, nodeCount),
+		simplifiedNodes = array.new(Type.INT32, nodeCount),
+		simplifiedEdges = array.new(Type.INT32, edgeCount * 2),
+
+		channelIndices = array.new(Type.INT32, nodeCount),
+		channelDistances = array.new(Type.DOUBLE, nodeCount),
+	}
+
+	local graph = ffi.new(graphCType)
+	graph.arrayContext = arrayContextID
+	graph.edgeArrayID = edges.id
+	graph.areaArrayID = areas.id
+	graph.timeArrayID = times.id
+	graph.xArrayID = xs.id
+	graph.yArrayID = ys.id
+	graph.outOffsetArrayID = topo.outOffsets.id
+	graph.outTargetArrayID = topo.outTargets.id
+	graph.inOffsetArrayID = topo.inOffsets.id
+	graph.inSourceArrayID = topo.inSources.id
+	graph.parentArrayID = topo.parents.id
+	graph.childArrayID = topo.children.id
+	graph.lineageArrayID = topo.lineages.id
+	graph.simplifiedNodeArrayID = topo.simplifiedNodes.id
+	graph.simplifiedEdgeArrayID = topo.simplifiedEdges.id
+	graph.channelIndexArrayID = topo.channelIndices.id
+	graph.channelDistanceArrayID = topo.channelDistances.id
+	graph.nodeCount = nodeCount
+	graph.edgeCount = edgeCount
+
+	if not C.wosC_accel_topology_build(graph) then
+		return nil, "Invalid graph topology"
+	end
+
+	topo.simplifiedNodeCount = graph.simplifiedNodeCount
+	topo.simplifiedEdgeCount = graph.simplifiedEdgeCount
+	topo.lineageCount = graph.lineageCount
+
+	--- Follows the parent links from the zero-based start node, filling channelIndices and channelDistances.
+	--- Returns the total length of the channel, or nil if the start node is invalid.
+	function topo.traceMainChannel(startNode)
+		local length = C.wosC_accel_topology_traceMainChannel(graph, startNode)
+		if length < 0 then
+			return nil
+		end
+		return length
+	end
+
+	return topo
+end
+
+return topology
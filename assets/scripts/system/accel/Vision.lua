@@ -0,0 +1,21 @@
+local vision = {}
+
+local visionBridge = bridge.vision
+
+--- Times the vision map kernels on synthetic width x height maps (in seconds per update, averaged over 'iterations'),
+--- comparing the scalar light map update and radial light application against the vectorized, row-parallel and
+--- lookup table-based kernels. 'identical' tells whether all kernels produced the same maps.
+function vision.benchmark(width, height, iterations)
+	local scalarLightMap, vectorLightMap, parallelLightMap, scalarRadial, tableRadial, identical =
+		visionBridge.benchmark(width or 2048, height or 2048, iterations or 10)
+	return {
+		scalarLightMap = scalarLightMap,
+		vectorLightMap = vectorLightMap,
+		parallelLightMap = parallelLightMap,
+		scalarRadial = scalarRadial,
+		tableRadial = tableRadial,
+		identical = identical,
+	}
+end
+
+return vision
@@ -0,0 +1,125 @@
+local workerPool = {}
+
+local array = require "system.utils.Array"
+local proxy = require "system.utils.Proxy"
+
+local workersBridge = bridge.workers
+
+local floor = math.floor
+
+--- Describes 'count' elements starting at 'first' (default: the entire array) of an array, for passing to jobs.
+--- Read-only regions may be shared by any number of jobs in flight. Writable regions (for results) must not overlap
+--- any other region of jobs in flight (until their results were polled), and require a writable array; submitting
+--- a conflicting region fails.
+function workerPool.region(arr, first, count, writable)
+	first = floor(first or 0)
+	count = floor(count or arr.size - first)
+	if first < 0 or count < 0 or first + count > arr.size then
+		error("Array region out of bounds", 2)
+	end
+
+	local elementSize = array.getByteSizeByType(arr.type)
+	return {
+		array = arr,
+		offset = first * elementSize,
+		size = count * elementSize,
+		writable = writable and true or false,
+	}
+end
+
+--- Starts a pool of 'workerCount' workers (default: one per hardware thread), each running the script source in its
+--- own Lua state. The script must return the job function, which is called as 'function(input, regions)' for each job
+--- and may return an output string. Each region is a table {pointer = lightuserdata, size = bytes, writable = bool}
+--- referencing the array memory directly, for example:
+---
+---     local ffi = require "ffi"
+---     return function(input, regions)
+---         local values = ffi.cast("const double *", regions[1].pointer)
+---         local sums = ffi.cast("double *", regions[2].pointer)
+---         ...
+---     end
+---
+--- The globals worker.index and worker.count identify the worker. Job functions must not retain regions beyond the
+--- call.
+function workerPool.new(source, workerCount)
+	local poolID = workersBridge.create(source, workerCount or 0)
+
+	-- Arrays referenced by jobs in flight, by job ID, so that they are not collected while in use
+	local heldArrays = {}
+
+	local pool = {
+		workerCount = workersBridge.getWorkerCount(poolID),
+	}
+
+	--- Submits jobs at once, each given as {input = string, regions = {region or array, ...}}. Whole arrays are passed
+	--- as read-only regions. Returns the ID of the first job (subsequent jobs have consecutive IDs), or nil and an
+	--- error message.
+	function pool.submitBatch(jobs)
+		local nativeJobs = {}
+		local jobArrays = {}
+		for i, job in ipairs(jobs) do
+			local regions = {}
+			local arrays = {}
+			for j, region in ipairs(job.regions or {}) do
+				if array.isArray(region) then
+					region = workerPool.region(region)
+				end
+				regions[j] = {array = region.array.id, offset = region.offset, size = region.size,
+					writable = region.writable}
+				arrays[j] = region.array
+			end
+			nativeJobs[i] = {input = job.input or "", regions = regions}
+			jobArrays[i] = arrays
+		end
+
+		local firstJobID, err = workersBridge.submit(poolID, nativeJobs)
+		if not firstJobID then
+			return nil, err
+		end
+
+		for i, arrays in ipairs(jobArrays) do
+			heldArrays[firstJobID + i - 1] = arrays
+		end
+		return firstJobID
+	end
+
+	--- Submits a single job. Returns its ID, or nil and an error message.
+	function pool.submit(input, regions)
+		return pool.submitBatch({{input = input, regions = regions}})
+	end
+
+	--- Returns the jobs finished since the last call as a list of
+	--- {job = ID, success = bool, output = string or error message, waitTime = seconds, runTime = seconds}, where
+	--- waitTime is the time spent queued and runTime the time spent in the job function.
+	function pool.poll()
+		local results = workersBridge.poll(poolID) or {}
+		for _, result in ipairs(results) do
+			heldArrays[result.job] = nil
+		end
+		return results
+	end
+
+	function pool.getPendingJobCount()
+		return workersBridge.getPendingJobCount(poolID)
+	end
+
+	--- Returns the error that occurred while starting a worker, or an empty string.
+	function pool.getError()
+		return workersBridge.getError(poolID)
+	end
+
+	--- Stops the workers after their current jobs. Queued jobs fail.
+	function pool.destroy()
+		workersBridge.destroy(poolID)
+		heldArrays = {}
+	end
+
+	-- The finalizer keeps the held arrays reachable, so the workers are stopped before the arrays can be released
+	return proxy.setMetatable(pool, {
+		__gc = function ()
+			pool.destroy()
+		end,
+	})
+end
+
+return workerPool
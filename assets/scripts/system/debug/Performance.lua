@@ -15,6 +15,12 @@ function performance.getMemoryUsage(m)
 	return bridge.perf.getMemoryUsage(m)
 end
 
+--- Returns a list of {name, memoryUsage} entries: the total, followed by up to 'count' detail entries (such as the
+--- size classes of "Arrays").
+function performance.getMemoryUsageEntries(m, count)
+	return bridge.perf.getMemoryUsageEntries(m, count or 0)
+end
+
 function performance.isEnabled()
 	return perfEnabled
 end
@@ -72,6 +78,14 @@ function performance.getTargetTime()
 	end
 end
 
+function performance.getLayoutIterationRate()
+	return bridge.perf.getLayoutIterationRate()
+end
+
+function performance.getLayoutSwinging()
+	return bridge.perf.getLayoutSwinging()
+end
+
 function performance.startLuaJITProfiler(mode)
 	luaJITProfiler.start(mode)
 end
@@ -0,0 +1,130 @@
+local frameSequence = {}
+
+local framebuffer = require "system.game.Framebuffer"
+local proxy = require "system.utils.Proxy"
+
+local gfxBridge = bridge.gfx
+
+local AsyncStatus = framebuffer.AsyncStatus
+
+local abs = math.abs
+local pairs = pairs
+
+local defaultLookAhead = 4
+
+local function getDefaultLookAhead()
+	local value = bridge.config.getInt("wos.game.graphics.frameStreaming.lookAhead")
+	return value > 0 and value or defaultLookAhead
+end
+
+-- Returns the counters of the decoded image cache shared by all frame sequences, along with its memory usage and
+-- budget in bytes
+function frameSequence.getCacheStats()
+	local hits, misses, evictions, memoryUsage, budget = gfxBridge.getDecodedImageCacheStats()
+	return {
+		hits = hits,
+		misses = misses,
+		evictions = evictions,
+		memoryUsage = memoryUsage,
+		budget = budget,
+	}
+end
+
+-- Streams the frames of an image sequence into a framebuffer. Frames are decoded in the background, and neighbouring
+-- frames in the current scrubbing direction are prefetched within a look-ahead window.
+function frameSequence.new(imageNames, width, height, lookAhead)
+	lookAhead = lookAhead or getDefaultLookAhead()
+
+	local buffer = framebuffer.new(width, height)
+	local shownName
+	local currentIndex
+	local direction = 1
+
+	-- Pending and decoded frames, indexed by image name: {index = frameIndex, handle = asyncImageHandle, failed = bool}
+	local loads = {}
+
+	local function startLoad(index)
+		local name = imageNames[index]
+		if name and not loads[name] then
+			loads[name] = {index = index, handle = gfxBridge.loadImageAsync(name)}
+		end
+	end
+
+	local function releaseLoad(name)
+		gfxBridge.releaseAsyncImage(loads[name].handle)
+		loads[name] = nil
+	end
+
+	local function updatePrefetch(index)
+		for name, entry in pairs(loads) do
+			if abs(entry.index - index) > lookAhead then
+				releaseLoad(name)
+			end
+		end
+
+		for offset = 1, lookAhead do
+			if gfxBridge.getAvailablePreloadCapacity() <= 0 then
+				break
+			end
+			startLoad(index + offset * direction)
+		end
+	end
+
+	local instance = {}
+
+	-- Requests the specified frame (1-based) and returns the framebuffer along with the name of the image currently
+	-- shown in it. The previously shown image is kept until the requested frame has finished decoding.
+	function instance.show(index)
+		if currentIndex and index ~= currentIndex then
+			direction = index > currentIndex and 1 or -1
+		end
+		currentIndex = index
+
+		local name = imageNames[index]
+		if name and name ~= shownName then
+			startLoad(index)
+
+			local entry = loads[name]
+			if not entry.failed then
+				local status = gfxBridge.getAsyncImageStatus(entry.handle)
+				if status == AsyncStatus.READY then
+					gfxBridge.applyAsyncImage(entry.handle, buffer.id)
+					shownName = name
+				elseif status == AsyncStatus.FAILED then
+					entry.failed = true
+				end
+			end
+		end
+
+		updatePrefetch(index)
+
+		return buffer, shownName
+	end
+
+	function instance.getFramebuffer()
+		return buffer
+	end
+
+	function instance.getLookAhead()
+		return lookAhead
+	end
+
+	function instance.setLookAhead(value)
+		lookAhead = value
+	end
+
+	-- Releases all pending and decoded frames
+	function instance.clear()
+		for name in pairs(loads) do
+			releaseLoad(name)
+		end
+	end
+
+	return proxy.setMetatable(instance, {
+		__gc = function ()
+			instance.clear()
+		end,
+	})
+end
+
+return frameSequence
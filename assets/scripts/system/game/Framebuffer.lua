@@ -11,6 +11,13 @@ local gfxBridge = bridge.gfx
 
 local gfxID = gfxBridge.getID()
 
+-- Status of background image loads, as reported by gfx.getAsyncImageStatus
+framebuffer.AsyncStatus = {
+	FAILED = -1,
+	PENDING = 0,
+	READY = 1,
+}
+
 local refCType = ffi.typeof("wosC_array_ref_t")
 local arrayContextID = bridge.array.getContext()
 
@@ -11,6 +11,8 @@ local gfxID = bridge.gfx.getID()
 
 local sin = math.sin
 local cos = math.cos
+local max = math.max
+local copy = ffi.copy
 
 local getRGBA = color.getRGBA
 local colorFromTable = color.fromTable
@@ -25,6 +27,15 @@ local currentVertexOffset = 0
 local vertexStructBuffer = nil
 local vertexStructBufferTinted = nil
 
+local vertexSize = ffi.sizeof("wosC_gfx_vertex_t")
+local minStagingCapacity = 1024
+
+-- Vertices reserved in the current vertex buffer for writing in place, starting at vertex 'stagingOffset'. Primitives
+-- are copied there without a native call each; the written vertices are committed when switching buffers.
+local stagingVertices = nil
+local stagingOffset = 0
+local stagingCapacity = 0
+
 local viewWidth = nil
 local viewHeight = nil
 
@@ -33,7 +44,36 @@ local function getCurrentVertexBuffer()
 	return vertexBuffers[currentVertexBuffer]
 end
 
+local function commitStagedVertices()
+	if stagingVertices ~= nil then
+		C.wosC_gfx_commitVertices(gfxID, getCurrentVertexBuffer(), stagingOffset, currentVertexOffset - stagingOffset)
+		stagingVertices = nil
+	end
+end
+
+-- Returns the staged vertices and the index at which 'count' vertices can be written, reserving more if necessary.
+-- Reservations double in size within a buffer, so that a frame takes a handful of native calls per buffer.
+local function stageVertices(count)
+	local index = currentVertexOffset - stagingOffset
+	if stagingVertices == nil or index + count > stagingCapacity then
+		local capacity = max(count, minStagingCapacity, stagingVertices ~= nil and stagingCapacity * 2 or 0)
+		commitStagedVertices()
+
+		local vertices = C.wosC_gfx_reserveVertices(gfxID, getCurrentVertexBuffer(), currentVertexOffset, capacity)
+		if vertices == nil then
+			error("Failed to reserve vertices", 3)
+		end
+		stagingVertices = vertices
+		stagingOffset = currentVertexOffset
+		stagingCapacity = capacity
+		index = 0
+	end
+	currentVertexOffset = currentVertexOffset + count
+	return stagingVertices, index
+end
+
 local function nextVertexBuffer()
+	commitStagedVertices()
 	currentVertexBuffer = currentVertexBuffer + 1
 	currentVertexOffset = 0
 	if getCurrentVertexBuffer() == nil then
@@ -58,13 +98,14 @@ local function selectTexturePage(page)
 end
 
 local function writeVertices()
-	C.wosC_gfx_writeVertices(gfxID, getCurrentVertexBuffer(), currentVertexOffset, 6, vertexStructBuffer)
-	currentVertexOffset = currentVertexOffset + 6
+	local vertices, index = stageVertices(6)
+	copy(vertices + index, vertexStructBuffer, 6 * vertexSize)
 end
 
-local function writeTintedVertices()
-	C.wosC_gfx_writeVertices(gfxID, getCurrentVertexBuffer(), currentVertexOffset, 6, vertexStructBufferTinted)
-	currentVertexOffset = currentVertexOffset + 6
+local function writeTintedVertices(count)
+	count = count or 6
+	local vertices, index = stageVertices(count)
+	copy(vertices + index, vertexStructBufferTinted, count * vertexSize)
 end
 
 local function acquireImage(imageName)
@@ -94,6 +135,43 @@ function gfx.flush()
 	end
 end
 
+--- Queues a vertex buffer that is managed outside of this module (e.g. by a retained scene) for drawing, keeping its
+--- position in the drawing order relative to the immediate-mode drawing functions.
+function gfx.drawVertexBuffer(vbufferID)
+	C.wosC_gfx_drawVertexBuffer(gfxID, vbufferID)
+
+	-- Subsequent immediate-mode drawing must start a new buffer to be drawn on top
+	currentTexturePage = nil
+end
+
+--- Like drawVertexBuffer, but only draws 'vertexCount' vertices starting at 'vertexOffset'.
+function gfx.drawVertexBufferRange(vbufferID, vertexOffset, vertexCount)
+	C.wosC_gfx_drawVertexBufferRange(gfxID, vbufferID, vertexOffset, vertexCount)
+	currentTexturePage = nil
+end
+
+--- Returns the number of vertices written to vertex buffers during the last frame, and in total
+function gfx.getVertexUploadStats()
+	local lastFrame, total = bridge.gfx.getVertexUploadStats()
+	return {
+		lastFrame = lastFrame,
+		total = total,
+	}
+end
+
+--- Times Z-order sorting and merging of synthetic vertex buffers (in seconds), comparing the previous comparison sort
+--- and pairwise merge against the radix sort and single-pass heap merge
+function gfx.benchmarkZOrderSort(quadCount, bufferCount)
+	local comparisonSort, radixSort, pairwiseMerge, heapMerge =
+		bridge.gfx.benchmarkZOrderSort(quadCount or 1000000, bufferCount or 16)
+	return {
+		comparisonSort = comparisonSort,
+		radixSort = radixSort,
+		pairwiseMerge = pairwiseMerge,
+		heapMerge = heapMerge,
+	}
+end
+
 function gfx.clear()
 	if vertexStructBuffer == nil then
 		vertexStructBuffer = ffi.new("wosC_gfx_vertex_t [?]", 6)
@@ -107,6 +185,7 @@ function gfx.clear()
 	currentVertexBuffer = 0
 	currentVertexOffset = 0
 	currentTexturePage = nil
+	stagingVertices = nil
 	bridge.gfx.clear()
 end
 
@@ -225,8 +304,7 @@ function gfx.drawTriangle(p1, p2, p3, color)
 	for i = 0, 2 do
 		setTintedVertexColor(i, color)
 	end
-	C.wosC_gfx_writeVertices(gfxID, getCurrentVertexBuffer(), currentVertexOffset, 3, vertexStructBufferTinted)
-	currentVertexOffset = currentVertexOffset + 3
+	writeTintedVertices(3)
 end
 
 function gfx.drawTriangleGradient(p1, p2, p3, c1, c2, c3)
@@ -237,8 +315,95 @@ function gfx.drawTriangleGradient(p1, p2, p3, c1, c2, c3)
 	setTintedVertexColor(0, c1)
 	setTintedVertexColor(1, c2)
 	setTintedVertexColor(2, c3)
-	C.wosC_gfx_writeVertices(gfxID, getCurrentVertexBuffer(), currentVertexOffset, 3, vertexStructBufferTinted)
-	currentVertexOffset = currentVertexOffset + 3
+	writeTintedVertices(3)
+end
+
+local circleArrayCType = ffi.typeof("wosC_gfx_circle_t [?]")
+local lineArrayCType = ffi.typeof("wosC_gfx_line_t [?]")
+
+local defaultCircleSegments = 30
+local minBatchCapacity = 64
+
+local function newPrimitiveBatch(arrayCType, capacity, writeFunc)
+	capacity = math.max(capacity or minBatchCapacity, 1)
+
+	local batch = {}
+	local data = ffi.new(arrayCType, capacity)
+	local count = 0
+
+	-- Returns the next free primitive slot, growing the batch if necessary
+	function batch.next()
+		if count >= capacity then
+			local newData = ffi.new(arrayCType, capacity * 2)
+			ffi.copy(newData, data, ffi.sizeof(arrayCType, capacity))
+			data = newData
+			capacity = capacity * 2
+		end
+		count = count + 1
+		return data[count - 1]
+	end
+
+	function batch.getCount()
+		return count
+	end
+
+	function batch.clear()
+		count = 0
+	end
+
+	-- Tessellates all primitives into the current vertex buffer and clears the batch
+	function batch.draw(...)
+		if count > 0 then
+			selectTexturePage(-1)
+			commitStagedVertices()
+			currentVertexOffset = currentVertexOffset
+				+ writeFunc(gfxID, getCurrentVertexBuffer(), currentVertexOffset, data, count, ...)
+			count = 0
+		end
+	end
+
+	return batch
+end
+
+--- Creates a batch of filled circles, which are tessellated natively with a single call.
+--- batch.draw(maxSegments, feather) writes all added circles; a non-zero feather (in pixels) anti-aliases the edges.
+function gfx.newCircleBatch(capacity)
+	local batch = newPrimitiveBatch(circleArrayCType, capacity, function (gfxID, buffer, offset, data, count,
+			maxSegments, feather)
+		return C.wosC_gfx_writeCircles(gfxID, buffer, offset, data, count, maxSegments or defaultCircleSegments,
+			feather or 0)
+	end)
+
+	function batch.add(x, y, radius, color)
+		local circle = batch.next()
+		circle.x = x
+		circle.y = y
+		circle.radius = radius
+		circle.color = colorFromTable(color)
+	end
+
+	return batch
+end
+
+--- Creates a batch of line segments with per-endpoint widths, which are tessellated natively with a single call.
+--- batch.draw(feather) writes all added lines; a non-zero feather (in pixels) anti-aliases the edges.
+function gfx.newLineBatch(capacity)
+	local batch = newPrimitiveBatch(lineArrayCType, capacity, function (gfxID, buffer, offset, data, count, feather)
+		return C.wosC_gfx_writeLines(gfxID, buffer, offset, data, count, feather or 0)
+	end)
+
+	function batch.add(x1, y1, x2, y2, width1, width2, color)
+		local line = batch.next()
+		line.x1 = x1
+		line.y1 = y1
+		line.x2 = x2
+		line.y2 = y2
+		line.width1 = width1
+		line.width2 = width2 or width1
+		line.color = colorFromTable(color)
+	end
+
+	return batch
 end
 
 function gfx.drawSprite(imageName, rect, textureRect)
@@ -430,4 +595,7 @@ function gfx.getSize()
 	return gfx.getWidth(), gfx.getHeight()
 end
 
+-- Called last in every tick: commits the vertices staged in the last buffer before the frame is drawn
+event.cycle.add("commitStagedVertices", {order = "performance", priority = -1000}, commitStagedVertices)
+
 return gfx
@@ -0,0 +1,322 @@
+local retainedScene = {}
+
+local gfx = require "system.game.Graphics"
+local color = require "system.utils.Color"
+
+local ffi = require "ffi"
+local C = ffi.C
+
+local gfxID = bridge.gfx.getID()
+
+local colorFromTable = color.fromTable
+
+local Kind = {
+	CIRCLE = 1,
+	LINE = 2,
+}
+
+local defaultCircleSegments = 30
+
+-- Creates a retained scene: a persistent vertex buffer holding one vertex range per primitive. Primitives are
+-- identified by caller-provided keys and kept in the order they were first specified.
+--
+-- Between scene.beginUpdate() and scene.endUpdate(), every primitive that should remain in the scene is specified
+-- again via scene.circle, scene.line or scene.hide. Only primitives whose parameters changed are re-tessellated;
+-- primitives that were not specified during an update are removed. When nothing changes, no vertices are uploaded,
+-- and scene.draw() only queues the buffer.
+--
+-- Between scene.beginPatch() and scene.endPatch(), only the primitives that changed are specified again, and all
+-- other primitives are kept. Patches cannot add primitives; changed primitives that keep their vertex count are
+-- rewritten in place.
+function retainedScene.new()
+	local vbufferID = C.wosC_gfx_newVertexBuffer(gfxID)
+	C.wosC_gfx_setVertexBufferTexture(gfxID, vbufferID, -1)
+
+	local circleBuffer = ffi.new("wosC_gfx_circle_t [1]")
+	local lineBuffer = ffi.new("wosC_gfx_line_t [1]")
+
+	-- Items in drawing order: {key, kind, visible, offset, count, dirty, touched, p1..p8}
+	local items = {}
+	local itemsByKey = {}
+
+	local updateIndex = 0
+	local touchedItems = {}
+	local reordered = false
+	local dirtyCount = 0
+
+	local patching = false
+	local patchedItems = {}
+
+	local stats = {
+		items = 0,
+		vertices = 0,
+		uploadedVertices = 0,
+		rebuilds = 0,
+	}
+
+	local function touch(key, kind)
+		local item = itemsByKey[key]
+		if patching then
+			if not item then
+				error("Primitive key cannot be added by a scene patch: " .. tostring(key), 3)
+			end
+			if item.kind ~= kind then
+				item.kind = kind
+				item.p1 = nil
+			end
+			patchedItems[#patchedItems + 1] = item
+			return item
+		end
+
+		if item then
+			if item.touched then
+				error("Primitive key specified twice in one scene update: " .. tostring(key), 3)
+			end
+			-- Items must be specified in their stored order, otherwise the buffer needs to be rebuilt
+			if item.index <= updateIndex then
+				reordered = true
+			end
+			updateIndex = item.index
+		else
+			item = {key = key, kind = kind, offset = 0, count = 0, visible = false, dirty = true}
+			itemsByKey[key] = item
+			dirtyCount = dirtyCount + 1
+			if updateIndex < #items then
+				reordered = true
+			end
+		end
+
+		if item.kind ~= kind then
+			item.kind = kind
+			item.p1 = nil
+		end
+
+		item.touched = true
+		touchedItems[#touchedItems + 1] = item
+		return item
+	end
+
+	local function markDirty(item)
+		if not item.dirty then
+			item.dirty = true
+			dirtyCount = dirtyCount + 1
+		end
+	end
+
+	local function setParams(item, p1, p2, p3, p4, p5, p6, p7, p8)
+		if not item.visible or item.p1 ~= p1 or item.p2 ~= p2 or item.p3 ~= p3 or item.p4 ~= p4 or item.p5 ~= p5
+				or item.p6 ~= p6 or item.p7 ~= p7 or item.p8 ~= p8 then
+			item.p1, item.p2, item.p3, item.p4, item.p5, item.p6, item.p7, item.p8 = p1, p2, p3, p4, p5, p6, p7, p8
+			item.visible = true
+			markDirty(item)
+		end
+	end
+
+	-- Fills the native primitive buffer for an item and returns its vertex count
+	local function prepare(item)
+		if not item.visible then
+			return 0
+		elseif item.kind == Kind.CIRCLE then
+			local circle = circleBuffer[0]
+			circle.x, circle.y, circle.radius, circle.color = item.p1, item.p2, item.p3, item.p4
+			return C.wosC_gfx_countCircleVertices(gfxID, circleBuffer, 1, item.p5, item.p6)
+		else
+			local line = lineBuffer[0]
+			line.x1, line.y1, line.x2, line.y2 = item.p1, item.p2, item.p3, item.p4
+			line.width1, line.width2, line.color = item.p5, item.p6, item.p7
+			return C.wosC_gfx_countLineVertices(gfxID, 1, item.p8)
+		end
+	end
+
+	-- Writes the primitive prepared by the last call to prepare()
+	local function write(item, offset)
+		if not item.visible then
+			return 0
+		elseif item.kind == Kind.CIRCLE then
+			return C.wosC_gfx_writeCircles(gfxID, vbufferID, offset, circleBuffer, 1, item.p5, item.p6)
+		else
+			return C.wosC_gfx_writeLines(gfxID, vbufferID, offset, lineBuffer, 1, item.p8)
+		end
+	end
+
+	local function rebuild()
+		C.wosC_gfx_clearVertexBuffer(gfxID, vbufferID)
+
+		local offset = 0
+		for index, item in ipairs(touchedItems) do
+			prepare(item)
+			item.index = index
+			item.offset = offset
+			item.count = write(item, offset)
+			item.dirty = false
+			offset = offset + item.count
+		end
+
+		stats.uploadedVertices = offset
+		stats.rebuilds = stats.rebuilds + 1
+	end
+
+	-- Resizes the vertex ranges of changed items in place. Expects the ranges of all listed items to be contiguous.
+	local function patch(list)
+		local offset = 0
+		local uploaded = 0
+		for index, item in ipairs(list) do
+			if item.dirty then
+				local newCount = prepare(item)
+				if newCount > item.count then
+					C.wosC_gfx_insertVertices(gfxID, vbufferID, offset + item.count, newCount - item.count)
+				elseif newCount < item.count then
+					C.wosC_gfx_removeVertices(gfxID, vbufferID, offset + newCount, item.count - newCount)
+				end
+				write(item, offset)
+				uploaded = uploaded + newCount
+				item.count = newCount
+				item.dirty = false
+			end
+			item.index = index
+			item.offset = offset
+			offset = offset + item.count
+		end
+
+		stats.uploadedVertices = uploaded
+	end
+
+	local scene = {}
+
+	function scene.beginUpdate()
+		updateIndex = 0
+		reordered = false
+	end
+
+	function scene.circle(key, x, y, radius, col, segments, feather)
+		setParams(touch(key, Kind.CIRCLE), x, y, radius, colorFromTable(col), segments or defaultCircleSegments,
+			feather or 0)
+	end
+
+	function scene.line(key, x1, y1, x2, y2, width1, width2, col, feather)
+		setParams(touch(key, Kind.LINE), x1, y1, x2, y2, width1, width2 or width1, colorFromTable(col), feather or 0)
+	end
+
+	-- Keeps a primitive's position in the drawing order, but does not draw it
+	function scene.hide(key)
+		local item = touch(key, itemsByKey[key] and itemsByKey[key].kind or Kind.CIRCLE)
+		if item.visible then
+			item.visible = false
+			markDirty(item)
+		end
+	end
+
+	function scene.endUpdate()
+		-- Drop primitives that were not specified during this update
+		local removed = false
+		for _, item in ipairs(items) do
+			if not item.touched then
+				itemsByKey[item.key] = nil
+				if item.count > 0 then
+					removed = true
+				end
+			end
+		end
+
+		if reordered then
+			rebuild()
+		elseif dirtyCount > 0 or removed then
+			if removed then
+				local shift = 0
+				for _, item in ipairs(items) do
+					if not item.touched and item.count > 0 then
+						C.wosC_gfx_removeVertices(gfxID, vbufferID, item.offset - shift, item.count)
+						shift = shift + item.count
+					end
+				end
+			end
+			patch(touchedItems)
+		else
+			stats.uploadedVertices = 0
+		end
+
+		items, touchedItems = touchedItems, items
+		for i = #touchedItems, 1, -1 do
+			touchedItems[i] = nil
+		end
+		for _, item in ipairs(items) do
+			item.touched = false
+		end
+		dirtyCount = 0
+
+		local last = items[#items]
+		stats.items = #items
+		stats.vertices = last and last.offset + last.count or 0
+	end
+
+	function scene.beginPatch()
+		patching = true
+	end
+
+	function scene.endPatch()
+		patching = false
+
+		-- Primitives with an unchanged vertex count are rewritten in place, without touching the rest of the scene
+		local resized = false
+		local uploaded = 0
+		for _, item in ipairs(patchedItems) do
+			if item.dirty then
+				local newCount = prepare(item)
+				if newCount == item.count then
+					write(item, item.offset)
+					uploaded = uploaded + newCount
+					item.dirty = false
+					dirtyCount = dirtyCount - 1
+				else
+					resized = true
+				end
+			end
+		end
+
+		for i = #patchedItems, 1, -1 do
+			patchedItems[i] = nil
+		end
+
+		if resized then
+			patch(items)
+			stats.uploadedVertices = stats.uploadedVertices + uploaded
+			dirtyCount = 0
+		else
+			stats.uploadedVertices = uploaded
+		end
+
+		local last = items[#items]
+		stats.vertices = last and last.offset + last.count or 0
+	end
+
+	-- Queues the scene's vertex buffer for drawing at the current position in the drawing order. If 'itemCount' is
+	-- specified, only the first 'itemCount' primitives in drawing order are drawn.
+	function scene.draw(itemCount)
+		if itemCount and itemCount < #items then
+			local last = items[itemCount]
+			gfx.drawVertexBufferRange(vbufferID, 0, last and last.offset + last.count or 0)
+		else
+			gfx.drawVertexBuffer(vbufferID)
+		end
+	end
+
+	function scene.clear()
+		C.wosC_gfx_clearVertexBuffer(gfxID, vbufferID)
+		items = {}
+		itemsByKey = {}
+		touchedItems = {}
+		dirtyCount = 0
+		stats.items = 0
+		stats.vertices = 0
+	end
+
+	-- Returns the number of primitives and vertices in the scene, the number of vertices uploaded by the last update,
+	-- and the number of full rebuilds so far
+	function scene.getStats()
+		return stats
+	end
+
+	return scene
+end
+
+return retainedScene
@@ -9,15 +9,23 @@ local floor = math.floor
 local min = math.min
 local copy = ffi.copy
 
-local arrayContextID = bridge.array.getContext()
+local arrayBridge = bridge.array
+local arrayContextID = arrayBridge.getContext()
 
 local arrayCTypes = {}
 local arrayByteSizes = {}
 local arrayTypeNames = {}
-local arrayMaxSize = 1024 * 1024 * 8
+-- Array sizes are 64-bit natively, so the only limits are the available memory and the integers that Lua numbers
+-- represent exactly
+local arrayMaxSize = 2 ^ 53
 
 local refCType = ffi.typeof("wosC_array_ref_t")
 
+local viewCTypes = {}
+
+-- Views reference their array's memory without owning it: the array is kept alive for as long as a view of it is
+local viewOwners = setmetatable({}, {__mode = "k"})
+
 
 array.Type =
 {
@@ -33,6 +41,16 @@ array.Type =
 
 array.MAX_SIZE = arrayMaxSize
 
+--- Access pattern hints for file-backed arrays (see array.adviseAccess).
+array.Access =
+{
+	NORMAL = 0,
+	SEQUENTIAL = 1,
+	RANDOM = 2,
+	WILL_NEED = 3,
+	DONT_NEED = 4,
+}
+
 -- Generate array type lookup tables
 arrayCTypes = {
 	ffi.typeof("int8_t *"), ffi.typeof("int16_t *"), ffi.typeof("int32_t *"),
@@ -62,7 +80,10 @@ local function createArrayWrapper(arrayID, arrayType)
 
 	-- Get effective array data pointer and size (in full array items, rather than bytes)
 	local arrayData = ffi.cast(arrayCTypes[arrayType], arrayInfo.data)
-	local size = floor(arrayInfo.size / arrayByteSizes[arrayType])
+	local size = floor(tonumber(arrayInfo.size) / arrayByteSizes[arrayType])
+
+	-- Read-only file-backed arrays must not be written to natively, so writes are rejected here
+	local writable = C.wosC_array_isWritable(arrayContextID, arrayID)
 
 	return setmetatable({}, {
 		__index = function(tbl, key)
@@ -78,18 +99,24 @@ local function createArrayWrapper(arrayID, arrayType)
 			if key == "id" then
 				return arrayID
 			end
+			if key == "writable" then
+				return writable
+			end
 			if key == sentinel then
 				return arrayInfo, arrayRef
 			end
 		end,
 		__newindex = function(tbl, key, value)
 			if type(key) == "number" and key >= 0 and key < size then
+				if not writable then
+					error("Attempt to write to read-only array", 2)
+				end
 				arrayData[key] = value
 			end
 		end,
 		_copy = array.copy,
 		_serialize = function ()
-			return {type = "array", arrayType = arrayType, data = ffi.string(arrayInfo.data, arrayInfo.size)}
+			return {type = "array", arrayType = arrayType, data = ffi.string(arrayInfo.data, tonumber(arrayInfo.size))}
 		end,
 		_dbg = function ()
 			local result = {}
@@ -108,6 +135,126 @@ local function createArrayWrapper(arrayID, arrayType)
 	})
 end
 
+local function createViewType(arrayType)
+	local itemSize = arrayByteSizes[arrayType]
+	local typeName = arrayTypeNames[arrayType]
+	local viewCType
+
+	local methods = {}
+
+	--- Raises an error unless the zero-based range of 'count' elements starting at 'first' lies within the view.
+	--- Checking a range once before a loop over 'view.data' keeps the loop free of per-element checks.
+	local function check(view, first, count)
+		local size = tonumber(view.size)
+		if first < 0 or count < 0 or first + count > size then
+			error(string.format("Array view range [%d, %d) out of bounds (size %d)", first, first + count, size), 3)
+		end
+	end
+
+	function methods.check(view, first, count)
+		check(view, first, count or 1)
+	end
+
+	function methods.get(view, index)
+		check(view, index, 1)
+		return view.data[index]
+	end
+
+	function methods.set(view, index, value)
+		check(view, index, 1)
+		view.data[index] = value
+	end
+
+	--- Returns a view of a sub-range, sharing the data of this view.
+	function methods.slice(view, first, count)
+		first = first or 0
+		count = count or tonumber(view.size) - first
+		check(view, first, count)
+
+		local slice = viewCType(view.data + first, count, view.array, tonumber(view.offset) + first)
+		viewOwners[slice] = viewOwners[view]
+		return slice
+	end
+
+	function methods.fill(view, value, first, count)
+		first = first or 0
+		count = count or tonumber(view.size) - first
+		check(view, first, count)
+		if not C.wosC_array_fill(view.data + first, count, arrayType, value) then
+			error("Cannot fill " .. arrayTypeNames[arrayType] .. " array view with " .. tostring(value), 2)
+		end
+		return view
+	end
+
+	--- Copies elements to a view of the same type, which may overlap with this view.
+	function methods.copy(view, dest, first, destFirst, count)
+		first = first or 0
+		destFirst = destFirst or 0
+		count = count or tonumber(view.size) - first
+		if not ffi.istype(viewCType, dest) then
+			error("Array view copy failed: mismatched view types", 2)
+		end
+		check(view, first, count)
+		check(dest, destFirst, count)
+		C.wosC_array_move(dest.data + destFirst, view.data + first, count * itemSize)
+		return dest
+	end
+
+	--- Stores func(value, index) for each element of the range in 'dest' (default: this view) at the same index.
+	function methods.map(view, func, first, count, dest)
+		first = first or 0
+		count = count or tonumber(view.size) - first
+		dest = dest or view
+		check(view, first, count)
+		check(dest, first, count)
+
+		local source, target = view.data, dest.data
+		for i = first, first + count - 1 do
+			target[i] = func(source[i], i)
+		end
+		return dest
+	end
+
+	--- Returns the elements of the range as a one-based Lua table, converted natively.
+	function methods.toTable(view, first, count)
+		first = first or 0
+		count = count or tonumber(view.size) - first
+		check(view, first, count)
+		local result, err = arrayBridge.toTable(view.array, arrayType, tonumber(view.offset) + first, count)
+		if not result then
+			error(err, 2)
+		end
+		return result
+	end
+
+	--- Stores the elements of a one-based Lua table in the view, starting at 'first', converted natively.
+	function methods.fromTable(view, values, first)
+		first = first or 0
+		check(view, first, #values)
+		local success, err = arrayBridge.fromTable(view.array, arrayType, tonumber(view.offset) + first, values)
+		if not success then
+			error(err, 2)
+		end
+		return view
+	end
+
+	viewCType = ffi.metatype(string.format("wosC_array_view_%s_t", typeName), {
+		__index = methods,
+		__len = function (view)
+			return tonumber(view.size)
+		end,
+		__tostring = function (view)
+			return string.format("array view %s[%d] (id %d, offset %d)", typeName, tonumber(view.size), view.array,
+				tonumber(view.offset))
+		end,
+	})
+	return viewCType
+end
+
+for arrayType = 1, #arrayTypeNames do
+	viewCTypes[arrayType] = createViewType(arrayType)
+end
+
 event.deserializeType.add("array", "array", function (ev)
 	ev.output = array.fromString(ev.input.arrayType, ev.input.data)
 end)
@@ -116,23 +263,33 @@ function array.isArray(arr)
 	return type(arr) == "table" and arr[sentinel] ~= nil
 end
 
-function array.new(arrayType, size)
+local function newArray(arrayType, size, create)
 	local ctype = arrayCTypes[arrayType]
 	if ctype == nil then
-		error("Invalid array type specified", 2)
+		error("Invalid array type specified", 3)
 	end
 
 	if type(size) ~= "number" then
-		error("Array size must be a number", 2)
+		error("Array size must be a number", 3)
 	end
 
 	local byteSize = floor(size) * arrayByteSizes[arrayType]
 
 	if byteSize < 0 or byteSize > arrayMaxSize then
-		error("Array size must be between 0 and " .. floor(arrayMaxSize / arrayByteSizes[arrayType]), 2)
+		error("Array size must be between 0 and " .. floor(arrayMaxSize / arrayByteSizes[arrayType]), 3)
 	end
 
-	return createArrayWrapper(C.wosC_array_new(arrayContextID, byteSize), arrayType)
+	return createArrayWrapper(create(arrayContextID, byteSize), arrayType)
+end
+
+function array.new(arrayType, size)
+	return newArray(arrayType, size, C.wosC_array_new)
+end
+
+--- Creates an array like array.new, but leaves its contents uninitialized. Use this for buffers that are fully
+--- overwritten before being read.
+function array.newUninitialized(arrayType, size)
+	return newArray(arrayType, size, C.wosC_array_newUninitialized)
 end
 
 function array.fromString(arrayType, str)
@@ -149,6 +306,54 @@ function array.fromString(arrayType, str)
 	return output
 end
 
+--- Creates an array backed by a memory mapping of a file region, so that the data is paged in lazily when accessed
+--- instead of being read eagerly. This allows arrays far larger than the available memory, and is not subject to
+--- array.MAX_SIZE.
+---
+--- The file must not be truncated while the array exists, since accessing pages past its end crashes the process. Use
+--- a regular array for files that other programs may rewrite in place.
+---
+--- Options:
+--- - offset:   byte offset of the region in the file (default 0)
+--- - count:    number of elements in the region (default: up to the end of the file)
+--- - readOnly: maps the file read-only; by default, the mapping is copy-on-write, so writes never reach the file
+--- - access:   initial access pattern hint (see array.Access)
+---
+--- Returns the array, or nil and an error message.
+function array.mapFile(arrayType, fileName, options)
+	local elementSize = arrayByteSizes[arrayType]
+	if elementSize == nil then
+		error("Invalid array type specified", 2)
+	end
+
+	options = options or {}
+	local offset = floor(options.offset or 0)
+	local byteSize = options.count and floor(options.count) * elementSize or 0
+	if offset < 0 or byteSize < 0 or (options.count and byteSize == 0) then
+		return nil, "Invalid file region"
+	end
+
+	local arrayID = C.wosC_array_mapFile(arrayContextID, fileName, offset, byteSize, options.readOnly and true or false)
+	if arrayID == 0 then
+		return nil, "Failed to map file '" .. tostring(fileName) .. "'"
+	end
+
+	local arr = createArrayWrapper(arrayID, arrayType)
+	if options.access then
+		array.adviseAccess(arr, options.access)
+	end
+	return arr
+end
+
+--- Hints the access pattern of 'count' elements starting at 'first' (default: the entire array) of a file-backed
+--- array. Returns false for other arrays or unsupported hints.
+function array.adviseAccess(arr, access, first, count)
+	local elementSize = arrayByteSizes[arr.type]
+	first = floor(first or 0)
+	count = floor(count or arr.size - first)
+	return C.wosC_array_adviseAccess(arrayContextID, arr.id, access, first * elementSize, count * elementSize)
+end
+
 function array.getArrayByID(arrayType, arrayID)
 	local ctype = arrayCTypes[arrayType]
 	if ctype == nil then
@@ -162,6 +367,43 @@ function array.getArrayByID(arrayType, arrayID)
 	return createArrayWrapper(arrayID, arrayType)
 end
 
+--- Returns a typed view of the array (or of 'count' elements starting at 'first'): a cdata struct whose 'data' field
+--- is a typed pointer to the first element and whose 'size' field holds the element count.
+---
+--- Element accesses via 'view.data[i]' are zero-based and unchecked, and compile to plain loads and stores. Ranges can
+--- be validated up front with 'view:check(first, count)'; 'view:get(i)' and 'view:set(i, value)' check every access.
+--- Views provide the bulk operations fill, copy, slice, map, toTable and fromTable.
+function array.view(arr, first, count)
+	local arrayInfo = arr[sentinel]
+	if arrayInfo == nil then
+		error("Invalid array specified", 2)
+	end
+
+	-- Views cannot prevent writes, which would fault on read-only mappings
+	if not arr.writable then
+		error("Cannot view read-only array (map the file copy-on-write instead)", 2)
+	end
+
+	first = floor(first or 0)
+	count = floor(count or arr.size - first)
+	if first < 0 or count < 0 or first + count > arr.size then
+		error("Array view range out of bounds", 2)
+	end
+
+	local arrayType = arr.type
+	local viewCType = viewCTypes[arrayType]
+	local view = viewCType(ffi.cast(arrayCTypes[arrayType], arrayInfo.data) + first, count, arr.id, first)
+	viewOwners[view] = arr
+	return view
+end
+
+--- Creates an array holding the values of a one-based Lua table, converted natively.
+function array.fromTable(arrayType, values)
+	local output = array.new(arrayType, #values)
+	array.view(output):fromTable(values)
+	return output
+end
+
 function array.getByteSizeByType(arrayType)
 	return arrayByteSizes[arrayType]
 end
@@ -194,6 +436,10 @@ function array.copy(sourceArray, destArray, sourceOffset, destOffset, count)
 		error("Array copy failed: destination index out of range", 2)
 	end
 
+	if not destArray.writable then
+		error("Array copy failed: destination array is read-only", 2)
+	end
+
 	local itemSize = arrayByteSizes[sourceArray.type]
 	copy(destArrayInfo.data + itemSize * destOffset, sourceArrayInfo.data + itemSize * sourceOffset, itemSize * count)
 	return destArray
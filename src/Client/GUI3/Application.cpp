@@ -104,6 +104,17 @@ Interface * Application::open()
 	return newInterface;
 }
 
+Interface * Application::openHeadless(sf::Vector2u size)
+{
+	Interface * newInterface = makeInterface();
+	newInterface->setHeadless(true);
+	newInterface->resize(size, false);
+	newInterface->openWindow();
+
+	myInterfaces.push_back(std::unique_ptr<Interface>(newInterface));
+	return newInterface;
+}
+
 void Application::close(const Interface * interface)
 {
 	for (auto it = myInterfaces.begin(); it != myInterfaces.end(); ++it)
@@ -69,6 +69,13 @@ public:
 	 */
 	Interface * open();
 
+	/**
+	 * Opens an interface of the specified size that renders to an offscreen texture instead of a system window.
+	 *
+	 * The same pointer validity rules as for open() apply.
+	 */
+	Interface * openHeadless(sf::Vector2u size);
+
 	/**
 	 * Closes an interface and its associated system window. If this is the last open interface, the application will
 	 * exit (the call to run() will return).
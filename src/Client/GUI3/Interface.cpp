@@ -10,6 +10,7 @@
 #include <Client/GUI3/Interface.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <SFML/Graphics/RenderStates.hpp>
+#include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/View.hpp>
 #include <SFML/Window/ContextSettings.hpp>
 #include <SFML/Window/Event.hpp>
@@ -66,6 +67,15 @@ sf::String Interface::getTitle() const
 
 void Interface::resize(sf::Vector2u size, bool fullscreen)
 {
+	if (myIsHeadlessOpen)
+	{
+		myWindowSize = size;
+		myNonFullscreenSize = size;
+		myOffscreenTexture.create(size.x, size.y);
+		myRootContainer.setSize(sf::Vector2f(myWindowSize));
+		return;
+	}
+
 	if (myWindow.isOpen())
 	{
 		// If window is or will be fullscreen, recreate it.
@@ -146,6 +156,11 @@ void Interface::setIcon(const sf::Image & icon)
 
 void Interface::setMaximized(bool maximized)
 {
+	if (myIsHeadless)
+	{
+		return;
+	}
+
 	if (!isWindowOpen())
 	{
 		myNeedMaximize = maximized;
@@ -274,18 +289,48 @@ bool Interface::isMinimized() const
 
 void Interface::display()
 {
-	myWindow.clear();
-	myWindow.setView(sf::View(sf::FloatRect(0, 0, getSize().x, getSize().y)));
+	sf::RenderTarget & target = getRenderTarget();
+
+	target.clear();
+	target.setView(sf::View(sf::FloatRect(0, 0, getSize().x, getSize().y)));
 
 	//glEnable(0x9346); // conservative rasterization (NV)
 
 	sf::RenderStates states;
 	states.texture = getParentApplication().getMainTexture();
-	myRootContainer.onRender(myWindow, states);
+	myRootContainer.onRender(target, states);
 
 	onRender();
 
-	myWindow.display();
+	if (myIsHeadless)
+	{
+		myOffscreenTexture.display();
+	}
+	else
+	{
+		myWindow.display();
+	}
+}
+
+bool Interface::isHeadless() const
+{
+	return myIsHeadless;
+}
+
+sf::Image Interface::capture() const
+{
+	if (myIsHeadless)
+	{
+		return myOffscreenTexture.getTexture().copyToImage();
+	}
+
+	sf::Texture windowTexture;
+	if (!windowTexture.create(myWindow.getSize().x, myWindow.getSize().y))
+	{
+		return sf::Image();
+	}
+	windowTexture.update(myWindow);
+	return windowTexture.copyToImage();
 }
 
 Interface::Interface(Application * parentApplication) :
@@ -299,21 +344,38 @@ Interface::Interface(Application * parentApplication) :
 
 sf::RenderTarget & Interface::getRenderTarget()
 {
+	if (myIsHeadless)
+	{
+		return myOffscreenTexture;
+	}
 	return myWindow;
 }
 
 const sf::RenderTarget & Interface::getRenderTarget() const
 {
+	if (myIsHeadless)
+	{
+		return myOffscreenTexture;
+	}
 	return myWindow;
 }
 
 bool Interface::isWindowOpen() const
 {
-	return myWindow.isOpen();
+	return myIsHeadless ? myIsHeadlessOpen : myWindow.isOpen();
 }
 
 void Interface::openWindow()
 {
+	if (myIsHeadless)
+	{
+		// Render textures create their own OpenGL context, so no window or display connection is needed
+		myIsHeadlessOpen = myOffscreenTexture.create(myWindowSize.x, myWindowSize.y);
+		myIsFullscreen = false;
+		myRootContainer.setSize(sf::Vector2f(myWindowSize));
+		return;
+	}
+
 	sf::ContextSettings context;
 	// context.antialiasingLevel = 4;
 
@@ -346,16 +408,22 @@ void Interface::closeWindow()
 		myRootContainer.fireStateEvent(StateEvent(StateEvent::WindowClosed));
 		getParentApplication().cleanUpWindowResources();
 		myWindow.close();
+		myIsHeadlessOpen = false;
 	}
 }
 
+void Interface::setHeadless(bool headless)
+{
+	myIsHeadless = headless;
+}
+
 void Interface::setVerticalSyncEnabled(bool enabled)
 {
 	if (myIsVSyncEnabled != enabled)
 	{
 		myIsVSyncEnabled = enabled;
 
-		if (isWindowOpen())
+		if (isWindowOpen() && !myIsHeadless)
 		{
 			myWindow.setVerticalSyncEnabled(enabled);
 		}
@@ -369,11 +437,9 @@ bool Interface::isVerticalSyncEnabled() const
 
 void Interface::process()
 {
-	myWindowPosition = myWindow.getPosition();
-
-	for (sf::Event event; myWindow.pollEvent(event);)
+	if (!myIsHeadless)
 	{
-		processEvent(event);
+		processWindowEvents();
 
 		if (!isWindowOpen())
 		{
@@ -394,6 +460,21 @@ void Interface::process()
 	display();
 }
 
+void Interface::processWindowEvents()
+{
+	myWindowPosition = myWindow.getPosition();
+
+	for (sf::Event event; myWindow.pollEvent(event);)
+	{
+		processEvent(event);
+
+		if (!isWindowOpen())
+		{
+			return;
+		}
+	}
+}
+
 void Interface::processEvent(const sf::Event & event)
 {
 	switch (event.type)
@@ -9,6 +9,8 @@
 #define SRC_CLIENT_GUI3_INTERFACE_HPP_
 
 #include <Client/GUI3/Widgets/Panels/Panel.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/System/String.hpp>
 #include <SFML/System/Vector2.hpp>
@@ -115,6 +117,16 @@ public:
 	 */
 	void display();
 
+	/**
+	 * Returns true if this interface renders to an offscreen texture instead of a system window.
+	 */
+	bool isHeadless() const;
+
+	/**
+	 * Returns a copy of the most recently displayed frame.
+	 */
+	sf::Image capture() const;
+
 protected:
 	/**
 	 * Constructs a new default interface. Only usable by Application.
@@ -134,6 +146,12 @@ protected:
 	void openWindow();
 	void closeWindow();
 
+	/**
+	 * Makes this interface render to an offscreen texture of the interface's size instead of opening a system window.
+	 * No events are processed in headless mode. Must be called before the window is opened.
+	 */
+	void setHeadless(bool headless);
+
 private:
 	/**
 	 * Enables/disables Vertical Sync for this interface's window.
@@ -150,6 +168,11 @@ private:
 	 */
 	void process();
 
+	/**
+	 * Polls and handles all pending window events.
+	 */
+	void processWindowEvents();
+
 	/**
 	 * Called for each event during processing.
 	 */
@@ -199,6 +222,11 @@ private:
 	 */
 	sf::RenderWindow myWindow;
 
+	/**
+	 * Offscreen render target used in place of the window in headless mode.
+	 */
+	sf::RenderTexture myOffscreenTexture;
+
 	/**
 	 * Various (self-explanatory) flags.
 	 */
@@ -207,6 +235,8 @@ private:
 	bool myHasFocus = true;
 	bool myIsVSyncEnabled = false;
 	bool myNeedMaximize = false;
+	bool myIsHeadless = false;
+	bool myIsHeadlessOpen = false;
 
 	/**
 	 * Root container widget that holds this interface's widgets.
@@ -3,6 +3,8 @@
 #include <Client/GUI3/Events/KeyEvent.hpp>
 #include <Client/GUI3/Events/StateEvent.hpp>
 #include <Client/Game/LocalGame.hpp>
+#include <Client/Lua/Bridges/FlowGraphBridge.hpp>
+#include <Client/Lua/Bridges/FrameAnalyzerBridge.hpp>
 #include <Client/Lua/Bridges/GraphicsBridge.hpp>
 #include <Client/Lua/Bridges/InputBridge.hpp>
 #include <Client/Lua/Bridges/WindowBridge.hpp>
@@ -19,10 +21,20 @@
 #include <Shared/Lua/Bridges/ConfigBridge.hpp>
 #include <Shared/Lua/Bridges/CoreBridge.hpp>
 #include <Shared/Lua/Bridges/DebugBridge.hpp>
+#include <Shared/Lua/Bridges/FrameIndexBridge.hpp>
+#include <Shared/Lua/Bridges/GraphFileBridge.hpp>
+#include <Shared/Lua/Bridges/LODBridge.hpp>
+#include <Shared/Lua/Bridges/LayoutBridge.hpp>
+#include <Shared/Lua/Bridges/MetricBridge.hpp>
 #include <Shared/Lua/Bridges/PerformanceBridge.hpp>
 #include <Shared/Lua/Bridges/ResourceBridge.hpp>
+#include <Shared/Lua/Bridges/SVGBridge.hpp>
+#include <Shared/Lua/Bridges/SpatialBridge.hpp>
 #include <Shared/Lua/Bridges/ScriptBridge.hpp>
 #include <Shared/Lua/Bridges/UtilityBridge.hpp>
+#include <Shared/Lua/Bridges/VisionBridge.hpp>
+#include <Shared/Lua/Bridges/WorkerPoolBridge.hpp>
+#include <Shared/Utils/StrNumCon.hpp>
 
 #include <Version.hpp>
 
@@ -79,6 +91,17 @@ LocalGame::LocalGame(res::SourceAggregator & resources) :
 		std::make_shared<lua::ArrayBridge>(arrayContext),
 		std::make_shared<lua::UtilityBridge>(),
 		std::make_shared<lua::PerformanceBridge>(performance),
+		std::make_shared<lua::LayoutBridge>(getThreadPool(), performance),
+		std::make_shared<lua::GraphFileBridge>(arrayContext),
+		std::make_shared<lua::SVGBridge>(arrayContext),
+		std::make_shared<lua::MetricBridge>(getThreadPool(), arrayContext),
+		std::make_shared<lua::SpatialBridge>(arrayContext),
+		std::make_shared<lua::LODBridge>(arrayContext),
+		std::make_shared<lua::FrameIndexBridge>(),
+		std::make_shared<lua::WorkerPoolBridge>(arrayContext),
+		std::make_shared<lua::VisionBridge>(getThreadPool()),
+		std::make_shared<lua::FlowGraphBridge>(getThreadPool(), arrayContext),
+		std::make_shared<lua::FrameAnalyzerBridge>(getThreadPool(), arrayContext),
 		std::make_shared<lua::DebugBridge>(*this, scripts)
 	};
 	// clang-format on
@@ -127,6 +150,8 @@ void LocalGame::cleanUp()
 
 	graphics.reset();
 
+	// Stops background work before the arrays it may access are released
+	scripts.unloadBridges();
 	arrayContext.clear();
 }
 
@@ -229,9 +254,33 @@ void LocalGame::initializeMemoryUsageProviders()
 		    }));
 	};
 
-	registerSimpleMemoryUsageProvider("Arrays", [this]() {
-		return arrayContext.getTotalMemoryUsage();
-	});
+	// Array memory is broken down by allocation size class and mapped files, following the total
+	performance.registerMemoryUsageProvider(
+	    "Arrays", wos::PerformanceCounter::MemoryUsageProvider([this](std::size_t entryCount) {
+		    std::vector<PerformanceCounter::MemoryUsageEntry> result(1);
+		    result[0].name = "Total";
+		    result[0].memoryUsage = arrayContext.getTotalMemoryUsage();
+		    for (const auto & usage : arrayContext.getMemoryUsageBySizeClass())
+		    {
+			    if (result.size() > entryCount || usage.blockCount == 0)
+			    {
+				    continue;
+			    }
+			    PerformanceCounter::MemoryUsageEntry entry;
+			    entry.name = usage.blockSize ? "Blocks up to " + cNtoS(usage.blockSize) + " bytes" : "Large blocks";
+			    entry.memoryUsage = usage.usedBytes;
+			    result.push_back(entry);
+		    }
+		    // File-backed arrays are paged in on demand, so only their mapped size is known
+		    if (result.size() <= entryCount && arrayContext.getMappedSize() > 0)
+		    {
+			    PerformanceCounter::MemoryUsageEntry entry;
+			    entry.name = "Mapped files";
+			    entry.memoryUsage = arrayContext.getMappedSize();
+			    result.push_back(entry);
+		    }
+		    return result;
+	    }));
 
 	// TODO move memory usage functions to base resource manager class
 	if (auto resourceManager = dynamic_cast<WOSResourceManager *>(&getParentApplication()->getResourceManager()))
@@ -243,6 +292,10 @@ void LocalGame::initializeMemoryUsageProviders()
 		registerSimpleMemoryUsageProvider("Data", [resourceManager]() {
 			return resourceManager->getDataMemoryUsage();
 		});
+
+		registerSimpleMemoryUsageProvider("Decoded images", [resourceManager]() {
+			return resourceManager->getDecodedImageCacheMemoryUsage();
+		});
 	}
 }
 
@@ -2,6 +2,7 @@
 #include <Client/GUI3/Widget.hpp>
 #include <Client/Game/LocalGame.hpp>
 #include <Client/GameRenderer/GraphicsManager.hpp>
+#include <Client/GameRenderer/ZOrderSort.hpp>
 #include <Client/Graphics/UtilitiesSf.hpp>
 #include <Client/System/WOSResourceManager.hpp>
 #include <SFML/Config.hpp>
@@ -16,8 +17,11 @@
 #include <Shared/Utils/MiscMath.hpp>
 #include <Shared/Utils/VectorMul.hpp>
 #include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstring>
 #include <iterator>
+#include <utility>
 
 namespace wos
 {
@@ -25,7 +29,10 @@ static cfg::Bool textureFiltering("wos.game.graphics.filterTextures");
 
 constexpr std::size_t GraphicsManager::QUAD_SIZE;
 
-GraphicsManager::GraphicsManager(LocalGame & game) : game(game), logger("GraphicsManager")
+GraphicsManager::GraphicsManager(LocalGame & game) :
+	game(game),
+	screenshotWriter(game.getThreadPool()),
+	logger("GraphicsManager")
 {
 	gfxID = wosc::bindGFX(*this);
 }
@@ -371,6 +378,7 @@ void GraphicsManager::writeVertices(wosC_gfx_vertexBuffer_t vbufferID, wosC_gfx_
 			// the data to be usable by OpenGL.
 			static_assert(sizeof(wosC_gfx_vertex_t) == sizeof(sf::Vertex), "Vertex size mismatch");
 			std::memcpy(buffer.data() + vertexOffset, vertices, vertexCount * sizeof(wosC_gfx_vertex_t));
+			frameUploadedVertices += vertexCount;
 		}
 		else
 		{
@@ -408,6 +416,334 @@ void GraphicsManager::readVertices(wosC_gfx_vertexBuffer_t vbufferID, wosC_gfx_v
 	}
 }
 
+wosC_gfx_vertex_t * GraphicsManager::reserveVertices(wosC_gfx_vertexBuffer_t vbufferID,
+                                                     wosC_gfx_vertexBuffer_size_t vertexOffset,
+                                                     wosC_gfx_vertexBuffer_size_t vertexCount) noexcept
+{
+	if (!isVertexBufferIDValid(vbufferID))
+	{
+		logger.warn("Attempt to reserve vertices in invalid vertex buffer with ID '{}'", vbufferID);
+		return nullptr;
+	}
+
+	auto & buffer = vertexBuffers[vbufferID].vertices;
+	if (vertexOffset < 0 || vertexCount < 0 || (std::size_t) vertexOffset > buffer.size())
+	{
+		logger.warn("Out-of-range reservation of {} vertices at {} in vertex buffer with ID '{}' and size {}",
+		            vertexCount, vertexOffset, vbufferID, buffer.size());
+		return nullptr;
+	}
+
+	// Grow geometrically, so that repeated reservations take amortized constant time per vertex
+	std::size_t requiredSize = (std::size_t) vertexOffset + vertexCount;
+	if (requiredSize > buffer.capacity())
+	{
+		buffer.reserve(std::max(requiredSize, buffer.capacity() * 2));
+	}
+	buffer.resize(std::max(buffer.size(), requiredSize));
+
+	static_assert(sizeof(wosC_gfx_vertex_t) == sizeof(sf::Vertex), "Vertex size mismatch");
+	return reinterpret_cast<wosC_gfx_vertex_t *>(buffer.data() + vertexOffset);
+}
+
+void GraphicsManager::commitVertices(wosC_gfx_vertexBuffer_t vbufferID, wosC_gfx_vertexBuffer_size_t vertexOffset,
+                                     wosC_gfx_vertexBuffer_size_t vertexCount) noexcept
+{
+	if (!isVertexBufferIDValid(vbufferID))
+	{
+		logger.warn("Attempt to commit vertices to invalid vertex buffer with ID '{}'", vbufferID);
+		return;
+	}
+
+	auto & buffer = vertexBuffers[vbufferID].vertices;
+	if (vertexOffset < 0 || vertexCount < 0 || (std::size_t) vertexOffset + vertexCount > buffer.size())
+	{
+		logger.warn("Out-of-range commit of {} vertices at {} in vertex buffer with ID '{}' and size {}", vertexCount,
+		            vertexOffset, vbufferID, buffer.size());
+		return;
+	}
+
+	// Drop reserved vertices that were not written; capacity is kept for subsequent reservations
+	buffer.resize(vertexOffset + vertexCount);
+	frameUploadedVertices += vertexCount;
+}
+
+// Aim for circle segments of about 3 pixels in length
+static constexpr float circleSegmentLength = 3.f;
+static constexpr std::size_t minCircleSegments = 8;
+
+static sf::Color unpackVertexColor(std::int32_t packedColor)
+{
+	// Uses the same memory layout as colors in wosC_gfx_vertex_t
+	sf::Color color;
+	static_assert(sizeof(color) == sizeof(packedColor), "Color size mismatch");
+	std::memcpy(&color, &packedColor, sizeof(color));
+	return color;
+}
+
+static sf::Color scaleAlpha(sf::Color color, float factor)
+{
+	color.a = sf::Uint8(color.a * clamp(0.f, factor, 1.f));
+	return color;
+}
+
+static std::size_t getCircleSegments(float radius, std::size_t maxSegments)
+{
+	// Clamped before the conversion, which is undefined for negative, NaN or huge values
+	const std::size_t segmentLimit = std::max(minCircleSegments, maxSegments);
+	const float segments = std::ceil(std::max(0.f, radius) * math::fpi2 / circleSegmentLength);
+	if (!(segments < segmentLimit))
+	{
+		return segmentLimit;
+	}
+	return std::max(minCircleSegments, static_cast<std::size_t>(segments));
+}
+
+static std::size_t getCircleVertexCount(float radius, std::size_t maxSegments, bool feathered)
+{
+	// Each segment consists of one fan triangle, plus a feathered quad along the edge
+	return getCircleSegments(radius, maxSegments) * (feathered ? 9 : 3);
+}
+
+// Sum of the circles' vertex counts, before padding to a whole number of quads
+static std::size_t getUnpaddedCircleVertexCount(const wosC_gfx_circle_t * circles, std::size_t circleCount,
+                                                std::size_t maxSegments, bool feathered)
+{
+	std::size_t vertexCount = 0;
+	for (std::size_t i = 0; i < circleCount; ++i)
+	{
+		vertexCount += getCircleVertexCount(circles[i].radius, maxSegments, feathered);
+	}
+	return vertexCount;
+}
+
+static std::size_t getLineVertexCount(bool feathered)
+{
+	// One core quad, plus a feathered quad along each side
+	return feathered ? 18 : 6;
+}
+
+namespace
+{
+class PrimitiveWriter
+{
+public:
+	PrimitiveWriter(sf::Vertex * output) :
+		output(output)
+	{
+	}
+
+	void triangle(sf::Vector2f p1, sf::Color c1, sf::Vector2f p2, sf::Color c2, sf::Vector2f p3, sf::Color c3)
+	{
+		vertex(p1, c1);
+		vertex(p2, c2);
+		vertex(p3, c3);
+	}
+
+	void quad(sf::Vector2f p1, sf::Color c1, sf::Vector2f p2, sf::Color c2, sf::Vector2f p3, sf::Color c3,
+	          sf::Vector2f p4, sf::Color c4)
+	{
+		triangle(p1, c1, p2, c2, p3, c3);
+		triangle(p1, c1, p3, c3, p4, c4);
+	}
+
+private:
+	void vertex(sf::Vector2f position, sf::Color color)
+	{
+		output->position = position;
+		output->color = color;
+		output->texCoords = sf::Vector2f(0, 0);
+		++output;
+	}
+
+	sf::Vertex * output;
+};
+}
+
+wosC_gfx_vertexBuffer_size_t GraphicsManager::writeCircles(wosC_gfx_vertexBuffer_t vbufferID,
+                                                           wosC_gfx_vertexBuffer_size_t vertexOffset,
+                                                           const wosC_gfx_circle_t * circles,
+                                                           wosC_gfx_vertexBuffer_size_t circleCount,
+                                                           wosC_gfx_vertexBuffer_size_t maxSegments,
+                                                           double feather) noexcept
+{
+	if (!isVertexBufferIDValid(vbufferID))
+	{
+		logger.warn("Attempt to write circles to invalid vertex buffer with ID '{}'", vbufferID);
+		return 0;
+	}
+
+	auto & buffer = vertexBuffers[vbufferID].vertices;
+	if ((std::size_t) vertexOffset > buffer.size() || circleCount < 0)
+	{
+		logger.warn("Out-of-range write of {} circles to {} in vertex buffer with ID '{}' and size {}", circleCount,
+		            vertexOffset, vbufferID, buffer.size());
+		return 0;
+	}
+
+	const bool feathered = feather > 0;
+	const float halfFeather = feathered ? feather * 0.5f : 0.f;
+	const std::size_t segmentLimit = std::max<wosC_gfx_vertexBuffer_size_t>(0, maxSegments);
+
+	const std::size_t unpaddedCount = getUnpaddedCircleVertexCount(circles, circleCount, segmentLimit, feathered);
+	const std::size_t vertexCount = (unpaddedCount + QUAD_SIZE - 1) / QUAD_SIZE * QUAD_SIZE;
+
+	buffer.resize(std::max<std::size_t>(buffer.size(), vertexOffset + vertexCount));
+
+	// Unit circle lookup, shared by all circles with the same segment count
+	std::vector<sf::Vector2f> unitCircle;
+	std::size_t unitCircleSegments = 0;
+
+	PrimitiveWriter writer(buffer.data() + vertexOffset);
+	for (wosC_gfx_vertexBuffer_size_t i = 0; i < circleCount; ++i)
+	{
+		const auto & circle = circles[i];
+		const std::size_t segments = getCircleSegments(circle.radius, segmentLimit);
+
+		if (segments != unitCircleSegments)
+		{
+			unitCircle.resize(segments + 1);
+			for (std::size_t j = 0; j <= segments; ++j)
+			{
+				float angle = math::fpi2 * j / segments;
+				unitCircle[j] = sf::Vector2f(std::cos(angle), std::sin(angle));
+			}
+			unitCircleSegments = segments;
+		}
+
+		const sf::Vector2f center(circle.x, circle.y);
+		const float radius = std::max(0.f, circle.radius);
+		const float innerRadius = std::max(0.f, radius - halfFeather);
+		const float outerRadius = radius + halfFeather;
+
+		// Circles thinner than the feather width only partially cover their pixels
+		sf::Color color = unpackVertexColor(circle.color);
+		if (feathered)
+		{
+			color = scaleAlpha(color, radius / halfFeather);
+		}
+		const sf::Color edgeColor = scaleAlpha(color, 0);
+
+		for (std::size_t j = 0; j < segments; ++j)
+		{
+			const sf::Vector2f & d1 = unitCircle[j];
+			const sf::Vector2f & d2 = unitCircle[j + 1];
+
+			writer.triangle(center, color, center + d1 * innerRadius, color, center + d2 * innerRadius, color);
+
+			if (feathered)
+			{
+				writer.quad(center + d1 * innerRadius, color, center + d1 * outerRadius, edgeColor,
+				            center + d2 * outerRadius, edgeColor, center + d2 * innerRadius, color);
+			}
+		}
+	}
+
+	// Odd segment counts leave half a quad, which drawBuffer would skip along with the last real triangle. The padding
+	// must be written, since the reserved range may still hold stale vertices from an earlier write
+	if (unpaddedCount != vertexCount)
+	{
+		writer.triangle(sf::Vector2f(0, 0), sf::Color::Transparent, sf::Vector2f(0, 0), sf::Color::Transparent,
+		                sf::Vector2f(0, 0), sf::Color::Transparent);
+	}
+
+	frameUploadedVertices += vertexCount;
+	return vertexCount;
+}
+
+wosC_gfx_vertexBuffer_size_t GraphicsManager::writeLines(wosC_gfx_vertexBuffer_t vbufferID,
+                                                         wosC_gfx_vertexBuffer_size_t vertexOffset,
+                                                         const wosC_gfx_line_t * lines,
+                                                         wosC_gfx_vertexBuffer_size_t lineCount,
+                                                         double feather) noexcept
+{
+	if (!isVertexBufferIDValid(vbufferID))
+	{
+		logger.warn("Attempt to write lines to invalid vertex buffer with ID '{}'", vbufferID);
+		return 0;
+	}
+
+	auto & buffer = vertexBuffers[vbufferID].vertices;
+	if ((std::size_t) vertexOffset > buffer.size() || lineCount < 0)
+	{
+		logger.warn("Out-of-range write of {} lines to {} in vertex buffer with ID '{}' and size {}", lineCount,
+		            vertexOffset, vbufferID, buffer.size());
+		return 0;
+	}
+
+	const bool feathered = feather > 0;
+	const float halfFeather = feathered ? feather * 0.5f : 0.f;
+	const std::size_t vertexCount = lineCount * getLineVertexCount(feathered);
+
+	buffer.resize(std::max<std::size_t>(buffer.size(), vertexOffset + vertexCount));
+
+	PrimitiveWriter writer(buffer.data() + vertexOffset);
+	for (wosC_gfx_vertexBuffer_size_t i = 0; i < lineCount; ++i)
+	{
+		const auto & line = lines[i];
+		const sf::Vector2f p1(line.x1, line.y1);
+		const sf::Vector2f p2(line.x2, line.y2);
+
+		// Zero-length lines produce degenerate triangles, keeping the vertex count predictable
+		sf::Vector2f normal(p1.y - p2.y, p2.x - p1.x);
+		float length = std::sqrt(normal.x * normal.x + normal.y * normal.y);
+		normal = length > 0 ? normal / length : sf::Vector2f(0, 0);
+
+		const float halfWidth1 = std::max(0.f, line.width1) * 0.5f;
+		const float halfWidth2 = std::max(0.f, line.width2) * 0.5f;
+
+		sf::Color color1 = unpackVertexColor(line.color);
+		sf::Color color2 = color1;
+		if (feathered)
+		{
+			color1 = scaleAlpha(color1, halfWidth1 / halfFeather);
+			color2 = scaleAlpha(color2, halfWidth2 / halfFeather);
+		}
+
+		const sf::Vector2f inner1 = normal * std::max(0.f, halfWidth1 - halfFeather);
+		const sf::Vector2f inner2 = normal * std::max(0.f, halfWidth2 - halfFeather);
+
+		writer.quad(p1 + inner1, color1, p1 - inner1, color1, p2 - inner2, color2, p2 + inner2, color2);
+
+		if (feathered)
+		{
+			const sf::Vector2f outer1 = normal * (halfWidth1 + halfFeather);
+			const sf::Vector2f outer2 = normal * (halfWidth2 + halfFeather);
+			const sf::Color edge1 = scaleAlpha(color1, 0);
+			const sf::Color edge2 = scaleAlpha(color2, 0);
+
+			writer.quad(p1 + outer1, edge1, p1 + inner1, color1, p2 + inner2, color2, p2 + outer2, edge2);
+			writer.quad(p1 - inner1, color1, p1 - outer1, edge1, p2 - outer2, edge2, p2 - inner2, color2);
+		}
+	}
+
+	frameUploadedVertices += vertexCount;
+	return vertexCount;
+}
+
+wosC_gfx_vertexBuffer_size_t GraphicsManager::countCircleVertices(const wosC_gfx_circle_t * circles,
+                                                                  wosC_gfx_vertexBuffer_size_t circleCount,
+                                                                  wosC_gfx_vertexBuffer_size_t maxSegments,
+                                                                  double feather) const noexcept
+{
+	if (circleCount <= 0)
+	{
+		return 0;
+	}
+
+	const std::size_t segmentLimit = std::max<wosC_gfx_vertexBuffer_size_t>(0, maxSegments);
+	std::size_t vertexCount = getUnpaddedCircleVertexCount(circles, circleCount, segmentLimit, feather > 0);
+
+	// Padded with a degenerate triangle to a whole number of quads
+	return (vertexCount + QUAD_SIZE - 1) / QUAD_SIZE * QUAD_SIZE;
+}
+
+wosC_gfx_vertexBuffer_size_t GraphicsManager::countLineVertices(wosC_gfx_vertexBuffer_size_t lineCount,
+                                                                double feather) const noexcept
+{
+	return std::max<wosC_gfx_vertexBuffer_size_t>(0, lineCount) * getLineVertexCount(feather > 0);
+}
+
 void GraphicsManager::writeVertexTextureIDs(wosC_gfx_vertexBuffer_t vbufferID,
                                             wosC_gfx_vertexBuffer_size_t vertexOffset,
                                             wosC_gfx_vertexBuffer_size_t textureIDCount,
@@ -629,9 +965,7 @@ void GraphicsManager::sortBuffer(wosC_gfx_vertexBuffer_t vbufferID) noexcept
 			if (!vbuffer.isEffectivelySorted())
 			{
 				// Sort index buffer to satisfy Z-ordering constraints
-				std::sort(indexBuffer.begin(), indexBuffer.end(), [&vbuffer](Index i1, Index i2) {
-					return vbuffer.compareBufferEntries(i1, i2);
-				});
+				zorder::sortIndices(vbuffer.zOrderBuffer.data(), quadCount, indexBuffer, &game.getThreadPool());
 
 				// Index buffer now contains target vertex order, but vertices themselves are not sorted yet.
 				vbuffer.needVertexPermutation = true;
@@ -652,13 +986,11 @@ void GraphicsManager::mergeSortedBuffers(const wosC_gfx_vertexBuffer_t * sourceI
                                          wosC_gfx_vertexBuffer_size_t sourceCount,
                                          wosC_gfx_vertexBuffer_t targetID) noexcept
 {
-	using Index = VertexBuffer::Index;
-
 	if (isVertexBufferIDValid(targetID))
 	{
 		auto & target = vertexBuffers[targetID];
 
-		std::vector<MergeRegion> mergeRegions;
+		std::vector<zorder::Run> mergeRegions;
 		std::vector<const VertexBuffer *> sourceBuffers;
 		std::size_t quadCount = 0;
 
@@ -708,35 +1040,12 @@ void GraphicsManager::mergeSortedBuffers(const wosC_gfx_vertexBuffer_t * sourceI
 			}
 		}
 
-		// Merge sorted regions pairwise
-		while (mergeRegions.size() > 1)
-		{
-			std::vector<MergeRegion> newMergeRegions;
-			for (std::size_t i = 1; i < mergeRegions.size(); i += 2)
-			{
-				auto & left = mergeRegions[i - 1];
-				auto & right = mergeRegions[i];
-				auto it = target.sortedIndexBuffer.begin();
-				std::inplace_merge(it + left.offset, it + left.offset + left.size, it + right.offset + right.size,
-				                   [&target](Index i1, Index i2) {
-					                   return target.compareBufferEntries(i1, i2);
-				                   });
-				newMergeRegions.emplace_back(left.offset, left.size + right.size);
-			}
-
-			// Add possible leftover region to the merge list
-			if (mergeRegions.size() % 2 == 1)
-			{
-				newMergeRegions.push_back(mergeRegions.back());
-			}
-
-			mergeRegions = newMergeRegions;
-		}
+		// Merge all sorted regions in a single pass
+		zorder::mergeRuns(target.zOrderBuffer.data(), target.sortedIndexBuffer, mergeRegions);
 
 		// Index buffer now contains target vertex order, but vertices themselves are not sorted yet.
 		target.needVertexPermutation = true;
 
-		// TODO merge smallest ranges first
 		// TODO apply transformation matrix if necessary
 	}
 	else
@@ -761,10 +1070,33 @@ void GraphicsManager::drawVertexBuffer(wosC_gfx_vertexBuffer_t vbufferID) noexce
 	}
 }
 
+void GraphicsManager::drawVertexBufferRange(wosC_gfx_vertexBuffer_t vbufferID,
+                                            wosC_gfx_vertexBuffer_size_t vertexOffset,
+                                            wosC_gfx_vertexBuffer_size_t vertexCount) noexcept
+{
+	if (vertexOffset < 0 || vertexCount < 0)
+	{
+		logger.warn("Attempt to draw invalid range of {} vertices at offset {} of vertex buffer with ID '{}'",
+		            vertexCount, vertexOffset, vbufferID);
+		return;
+	}
+
+	drawVertexBuffer(vbufferID);
+	if (isVertexBufferIDValid(vbufferID))
+	{
+		drawOrder.back().vertexOffset = vertexOffset;
+		drawOrder.back().vertexCount = vertexCount;
+	}
+}
+
 void GraphicsManager::resetDrawState()
 {
 	drawOrder.clear();
 
+	uploadStats.lastFrame = frameUploadedVertices;
+	uploadStats.total += frameUploadedVertices;
+	frameUploadedVertices = 0;
+
 	for (auto & buffer : vertexBuffers)
 	{
 		buffer.injectionFuncs.clear();
@@ -819,7 +1151,7 @@ void GraphicsManager::draw(sf::RenderTarget & target, sf::RenderStates states) c
 
 				drawClipped(DrawableWrapper([&](sf::RenderTarget & target, sf::RenderStates vbufferStates) {
 					            vbufferStates.transform *= entry.state.transform;
-					            drawBuffer(vbuffer, target, vbufferStates);
+					            drawBuffer(vbuffer, target, vbufferStates, entry.vertexOffset, entry.vertexCount);
 				            }),
 				            target, states, clipRect);
 			}
@@ -827,7 +1159,7 @@ void GraphicsManager::draw(sf::RenderTarget & target, sf::RenderStates states) c
 			{
 				sf::RenderStates vbufferStates = states;
 				vbufferStates.transform *= entry.state.transform;
-				drawBuffer(vbuffer, target, vbufferStates);
+				drawBuffer(vbuffer, target, vbufferStates, entry.vertexOffset, entry.vertexCount);
 				for (const InjectionFunc & injectionFunc : vbuffer.injectionFuncs)
 				{
 					injectionFunc(target, states);
@@ -841,27 +1173,31 @@ void GraphicsManager::draw(sf::RenderTarget & target, sf::RenderStates states) c
 	}
 }
 
-void GraphicsManager::drawBuffer(const VertexBuffer & buffer, sf::RenderTarget & target, sf::RenderStates states) const
+void GraphicsManager::drawBuffer(const VertexBuffer & buffer, sf::RenderTarget & target, sf::RenderStates states,
+                                 std::size_t vertexOffset, std::size_t vertexCount) const
 {
-	std::size_t startIndex = 0;
 	std::size_t quadCount = buffer.vertices.size() / QUAD_SIZE;
 
+	// Only complete quads are drawn
+	std::size_t startIndex = std::min(vertexOffset, quadCount * QUAD_SIZE);
+	std::size_t endIndex = startIndex + std::min(vertexCount, quadCount * QUAD_SIZE - startIndex);
+
 	if (getApplication() != nullptr)
 	{
-		if (buffer.textureIDs.size() >= quadCount && quadCount > 0)
+		if (buffer.textureIDs.size() >= quadCount && startIndex < endIndex)
 		{
 			// (Possibly) multiple texture pages: need to iterate and find texture differences
-			auto texturePageID = buffer.textureIDs[0];
+			auto texturePageID = buffer.textureIDs[startIndex / QUAD_SIZE];
 			states.texture = getApplication()->getTexture(texturePageID);
 
-			for (std::size_t i = 0; i < quadCount; ++i)
+			for (std::size_t i = startIndex / QUAD_SIZE; i * QUAD_SIZE < endIndex; ++i)
 			{
 				if (texturePageID != buffer.textureIDs[i])
 				{
-					target.draw(buffer.vertices.data() + startIndex * QUAD_SIZE, (i - startIndex) * QUAD_SIZE,
-					            sf::Triangles, states);
+					target.draw(buffer.vertices.data() + startIndex, i * QUAD_SIZE - startIndex, sf::Triangles,
+					            states);
 					texturePageID = buffer.textureIDs[i];
-					startIndex = i;
+					startIndex = i * QUAD_SIZE;
 					states.texture = getApplication()->getTexture(texturePageID);
 				}
 			}
@@ -874,8 +1210,7 @@ void GraphicsManager::drawBuffer(const VertexBuffer & buffer, sf::RenderTarget &
 	}
 
 	// Draw final set of vertices
-	target.draw(
-	    buffer.vertices.data() + startIndex * QUAD_SIZE, (quadCount - startIndex) * QUAD_SIZE, sf::Triangles, states);
+	target.draw(buffer.vertices.data() + startIndex, endIndex - startIndex, sf::Triangles, states);
 }
 
 GraphicsManager::TextCacheKey GraphicsManager::getTextCacheKey(const TextSettings & settings) const
@@ -1065,26 +1400,7 @@ void GraphicsManager::takeScreenshot(
 			    return;
 		    }
 
-		    sf::Image cropped;
-		    cropped.create(size.x, size.y);
-
-		    int maxX = image.getSize().x - 1;
-		    int maxY = image.getSize().y - 1;
-
-		    for (int y = 0; y < size.y; ++y)
-		    {
-			    for (int x = 0; x < size.x; ++x)
-			    {
-				    int srcX = std::floor((double(x) / size.x) * inputRect.width + inputRect.left + 0.5);
-				    int srcY = std::floor((double(y) / size.y) * inputRect.height + inputRect.top + 0.5);
-				    cropped.setPixel(x, y, image.getPixel(clamp(0, srcX, maxX), clamp(0, srcY, maxY)));
-			    }
-		    }
-
-		    if (!cropped.saveToFile(targetFile))
-		    {
-			    logger.warn("Failed to take screenshot (failed to save file '{}')", targetFile);
-		    }
+		    screenshotWriter.write(targetFile, std::move(image), inputRect, sf::Vector2u(size));
 	    });
 }
 
@@ -1203,6 +1519,91 @@ int GraphicsManager::getAvailablePreloadCapacity() const
 	return 0;
 }
 
+GraphicsManager::AsyncImageHandle GraphicsManager::loadImageAsync(const std::string & resourceName)
+{
+	if (auto resourceManager = dynamic_cast<WOSResourceManager *>(&game.getParentApplication()->getResourceManager()))
+	{
+		AsyncImageHandle handle = nextAsyncImageHandle++;
+		asyncImages[handle] = resourceManager->decodeImageAsync(resourceName, game.getThreadPool());
+		return handle;
+	}
+	return -1;
+}
+
+GraphicsManager::AsyncImageInfo GraphicsManager::getAsyncImageInfo(AsyncImageHandle handle) const
+{
+	AsyncImageInfo info;
+
+	auto it = asyncImages.find(handle);
+	if (it == asyncImages.end())
+	{
+		return info;
+	}
+
+	if (!it->second->isDone())
+	{
+		info.status = AsyncImageStatus::Pending;
+	}
+	else if (it->second->isValid())
+	{
+		info.status = AsyncImageStatus::Ready;
+		info.width = it->second->getImage().getSize().x;
+		info.height = it->second->getImage().getSize().y;
+	}
+
+	return info;
+}
+
+bool GraphicsManager::applyAsyncImage(AsyncImageHandle handle, wosC_gfx_imageID_t framebuffer)
+{
+	auto it = asyncImages.find(handle);
+	if (it == asyncImages.end())
+	{
+		logger.warn("Attempt to apply invalid async image handle {}", handle);
+		return false;
+	}
+
+	if (!it->second->isValid())
+	{
+		return false;
+	}
+
+	const sf::Image & image = it->second->getImage();
+	return updateFramebuffer(framebuffer, sf::IntRect(0, 0, image.getSize().x, image.getSize().y),
+	                         image.getPixelsPtr());
+}
+
+void GraphicsManager::releaseAsyncImage(AsyncImageHandle handle)
+{
+	asyncImages.erase(handle);
+}
+
+GraphicsManager::DecodedImageCacheStats GraphicsManager::getDecodedImageCacheStats() const
+{
+	DecodedImageCacheStats stats;
+
+	if (auto resourceManager = dynamic_cast<WOSResourceManager *>(&game.getParentApplication()->getResourceManager()))
+	{
+		stats.hits = resourceManager->getDecodedImageCacheHits();
+		stats.misses = resourceManager->getDecodedImageCacheMisses();
+		stats.evictions = resourceManager->getDecodedImageCacheEvictions();
+		stats.memoryUsage = resourceManager->getDecodedImageCacheMemoryUsage();
+		stats.budget = resourceManager->getDecodedImageCacheBudget();
+	}
+
+	return stats;
+}
+
+GraphicsManager::VertexUploadStats GraphicsManager::getVertexUploadStats() const
+{
+	return uploadStats;
+}
+
+zorder::BenchmarkResult GraphicsManager::benchmarkZOrderSort(std::size_t quadCount, std::size_t bufferCount)
+{
+	return zorder::benchmark(quadCount, bufferCount, &game.getThreadPool());
+}
+
 bool GraphicsManager::VertexBuffer::compareBufferEntries(Index i1, Index i2) const
 {
 	if (i1 >= zOrderBuffer.size())
@@ -3,10 +3,13 @@
 
 #include <Client/GUI3/ResourceManager.hpp>
 #include <Client/GUI3/Types.hpp>
+#include <Client/GameRenderer/ZOrderSort.hpp>
+#include <Client/Graphics/ImageWriter.hpp>
 #include <Client/Graphics/Text/AbstractFont.hpp>
 #include <Client/Graphics/Text/Text.hpp>
 #include <Client/Lua/Bindings/GraphicsBinding.h>
 #include <Client/Lua/Bindings/GraphicsBinding.hpp>
+#include <Client/System/WOSResourceManager.hpp>
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/Rect.hpp>
@@ -22,6 +25,7 @@
 #include <Shared/Utils/Debug/Logger.hpp>
 #include <Shared/Utils/HashTable.hpp>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <string>
@@ -100,6 +104,29 @@ public:
 	virtual void readVertices(wosC_gfx_vertexBuffer_t vbufferID, wosC_gfx_vertexBuffer_size_t vertexOffset,
 	                          wosC_gfx_vertexBuffer_size_t vertexCount,
 	                          wosC_gfx_vertex_t * vertices) const noexcept override;
+	virtual wosC_gfx_vertex_t * reserveVertices(wosC_gfx_vertexBuffer_t vbufferID,
+	                                            wosC_gfx_vertexBuffer_size_t vertexOffset,
+	                                            wosC_gfx_vertexBuffer_size_t vertexCount) noexcept override;
+	virtual void commitVertices(wosC_gfx_vertexBuffer_t vbufferID, wosC_gfx_vertexBuffer_size_t vertexOffset,
+	                            wosC_gfx_vertexBuffer_size_t vertexCount) noexcept override;
+
+	virtual wosC_gfx_vertexBuffer_size_t writeCircles(wosC_gfx_vertexBuffer_t vbufferID,
+	                                                  wosC_gfx_vertexBuffer_size_t vertexOffset,
+	                                                  const wosC_gfx_circle_t * circles,
+	                                                  wosC_gfx_vertexBuffer_size_t circleCount,
+	                                                  wosC_gfx_vertexBuffer_size_t maxSegments,
+	                                                  double feather) noexcept override;
+	virtual wosC_gfx_vertexBuffer_size_t writeLines(wosC_gfx_vertexBuffer_t vbufferID,
+	                                                wosC_gfx_vertexBuffer_size_t vertexOffset,
+	                                                const wosC_gfx_line_t * lines,
+	                                                wosC_gfx_vertexBuffer_size_t lineCount,
+	                                                double feather) noexcept override;
+	virtual wosC_gfx_vertexBuffer_size_t countCircleVertices(const wosC_gfx_circle_t * circles,
+	                                                         wosC_gfx_vertexBuffer_size_t circleCount,
+	                                                         wosC_gfx_vertexBuffer_size_t maxSegments,
+	                                                         double feather) const noexcept override;
+	virtual wosC_gfx_vertexBuffer_size_t countLineVertices(wosC_gfx_vertexBuffer_size_t lineCount,
+	                                                       double feather) const noexcept override;
 
 	virtual void writeVertexTextureIDs(wosC_gfx_vertexBuffer_t vbufferID, wosC_gfx_vertexBuffer_size_t vertexOffset,
 	                                   wosC_gfx_vertexBuffer_size_t textureIDCount,
@@ -130,6 +157,8 @@ public:
 	                                wosC_gfx_vertexBuffer_t targetID) noexcept override;
 
 	virtual void drawVertexBuffer(wosC_gfx_vertexBuffer_t vbufferID) noexcept override;
+	virtual void drawVertexBufferRange(wosC_gfx_vertexBuffer_t vbufferID, wosC_gfx_vertexBuffer_size_t vertexOffset,
+	                                   wosC_gfx_vertexBuffer_size_t vertexCount) noexcept override;
 
 	/**
 	 * Needs to be called before "drawVertexBuffer" calls are made, to reset the drawing order buffer.
@@ -201,6 +230,8 @@ public:
 
 	/**
 	 * Takes a screenshot at the current render state and saves it to the file with the specified name.
+	 *
+	 * The pixels are read back during rendering, while cropping and PNG encoding happen on the game's thread pool.
 	 */
 	void takeScreenshot(
 	    wosC_gfx_vertexBuffer_t vertexBuffer, const std::string & targetFile, sf::FloatRect rect, sf::Vector2i size);
@@ -234,6 +265,74 @@ public:
 	void preloadImage(const std::string & resourceName);
 	int getAvailablePreloadCapacity() const;
 
+	using AsyncImageHandle = int;
+
+	enum class AsyncImageStatus
+	{
+		Failed = -1,
+		Pending = 0,
+		Ready = 1,
+	};
+
+	struct AsyncImageInfo
+	{
+		AsyncImageStatus status = AsyncImageStatus::Failed;
+		int width = 0;
+		int height = 0;
+	};
+
+	/**
+	 * Starts loading and decoding the specified image on the thread pool, returning a handle that can be polled.
+	 */
+	AsyncImageHandle loadImageAsync(const std::string & resourceName);
+
+	/**
+	 * Returns the loading status and size of an asynchronously loaded image.
+	 */
+	AsyncImageInfo getAsyncImageInfo(AsyncImageHandle handle) const;
+
+	/**
+	 * Uploads a fully loaded asynchronous image into the specified framebuffer.
+	 */
+	bool applyAsyncImage(AsyncImageHandle handle, wosC_gfx_imageID_t framebuffer);
+
+	/**
+	 * Releases the handle of an asynchronously loaded image. The decoded pixels may remain in the resource manager's
+	 * decoded image cache until they are evicted.
+	 */
+	void releaseAsyncImage(AsyncImageHandle handle);
+
+	struct DecodedImageCacheStats
+	{
+		std::size_t hits = 0;
+		std::size_t misses = 0;
+		std::size_t evictions = 0;
+		std::size_t memoryUsage = 0;
+		std::size_t budget = 0;
+	};
+
+	/**
+	 * Returns the counters and memory usage of the decoded image cache.
+	 */
+	DecodedImageCacheStats getDecodedImageCacheStats() const;
+
+	struct VertexUploadStats
+	{
+		std::size_t lastFrame = 0;
+		std::size_t total = 0;
+	};
+
+	/**
+	 * Returns the number of vertices written into vertex buffers during the last completed frame, and in total.
+	 */
+	VertexUploadStats getVertexUploadStats() const;
+
+	/**
+	 * Times Z-order sorting and merging of synthetic vertex buffers, comparing the comparison-based implementations
+	 * against the radix sort and heap-based merge.
+	 */
+	zorder::BenchmarkResult benchmarkZOrderSort(std::size_t quadCount, std::size_t bufferCount);
+
 private:
 	using TextCacheKey = sf::Uint64;
 
@@ -260,11 +359,15 @@ private:
 	{
 		VertexBufferDrawState state;
 		wosC_gfx_vertexBuffer_t bufferID;
+
+		// Range of vertices to draw, clamped to the buffer size
+		std::size_t vertexOffset = 0;
+		std::size_t vertexCount = std::numeric_limits<std::size_t>::max();
 	};
 
 	struct VertexBuffer
 	{
-		using Index = uint32_t;
+		using Index = zorder::Index;
 
 		VertexBuffer() = default;
 		VertexBuffer(VertexBuffer &&) = default;
@@ -290,21 +393,9 @@ private:
 		void applyIndexBuffer();
 	};
 
-	struct MergeRegion
-	{
-		MergeRegion() = default;
-		MergeRegion(std::size_t offset, std::size_t size) :
-			offset(offset),
-			size(size)
-		{
-		}
-
-		std::size_t offset = 0;
-		std::size_t size = 0;
-	};
-
 	virtual void draw(sf::RenderTarget & target, sf::RenderStates states) const override;
-	void drawBuffer(const VertexBuffer & buffer, sf::RenderTarget & target, sf::RenderStates states) const;
+	void drawBuffer(const VertexBuffer & buffer, sf::RenderTarget & target, sf::RenderStates states,
+	                std::size_t vertexOffset, std::size_t vertexCount) const;
 
 	TextCacheKey getTextCacheKey(const TextSettings & settings) const;
 	void cleanUpTextCache();
@@ -320,12 +411,20 @@ private:
 	std::vector<VertexBuffer> vertexBuffers;
 	std::vector<VertexBufferDrawEntry> drawOrder;
 
+	std::size_t frameUploadedVertices = 0;
+	VertexUploadStats uploadStats;
+
 	mutable wosC_gfx_transform_t transformReturnValue;
 	mutable wosC_gfx_rectangle_t clipRectReturnValue;
 
 	sf::Clock textCacheTimer;
 	HashMap<TextCacheKey, TextCacheValue<text::Text>> textCache;
 
+	HashMap<AsyncImageHandle, std::shared_ptr<const WOSResourceManager::DecodedImage>> asyncImages;
+	AsyncImageHandle nextAsyncImageHandle = 0;
+
+	ImageWriter screenshotWriter;
+
 	Logger logger;
 };
 
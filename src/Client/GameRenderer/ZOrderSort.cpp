@@ -0,0 +1,393 @@
+#include <Client/GameRenderer/ZOrderSort.hpp>
+#include <SFML/System/Clock.hpp>
+#include <Shared/Utils/ThreadPool.hpp>
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+
+namespace wos
+{
+namespace zorder
+{
+
+// Below this size, a comparison sort beats clearing and scanning the radix histograms
+static constexpr std::size_t minRadixSortSize = 256;
+
+// Buffers of at least this size are sorted in parallel if a thread pool is available
+static constexpr std::size_t minParallelSortSize = 1 << 16;
+
+static constexpr std::size_t radixBits = 8;
+static constexpr std::size_t radixSize = 1 << radixBits;
+static constexpr std::size_t radixPasses = sizeof(std::uint64_t) * 8 / radixBits;
+
+using RadixKey = std::uint64_t;
+using Histogram = std::array<std::size_t, radixSize>;
+
+// Maps a floating-point key to an unsigned integer with the same ordering
+static RadixKey toRadixKey(Key key)
+{
+	static_assert(sizeof(Key) == sizeof(RadixKey), "Z-order key size mismatch");
+
+	// Negative zero compares equal to positive zero
+	if (key == 0)
+	{
+		key = 0;
+	}
+
+	RadixKey bits;
+	std::memcpy(&bits, &key, sizeof(bits));
+
+	constexpr RadixKey signBit = RadixKey(1) << 63;
+	return (bits & signBit) ? ~bits : bits | signBit;
+}
+
+static std::size_t getDigit(RadixKey key, std::size_t pass)
+{
+	return (key >> (pass * radixBits)) & (radixSize - 1);
+}
+
+namespace
+{
+class RadixSorter
+{
+public:
+	RadixSorter(const Key * keys, std::size_t count, ThreadPool * threadPool) :
+		count(count),
+		threadPool(count >= minParallelSortSize ? threadPool : nullptr)
+	{
+		chunkCount = this->threadPool ? this->threadPool->getThreadCount() + 1 : 1;
+		chunkSize = (count + chunkCount - 1) / chunkCount;
+
+		radixKeys.resize(count);
+		radixIndices.resize(count);
+		swapKeys.resize(count);
+		swapIndices.resize(count);
+		chunkHistograms.resize(chunkCount);
+
+		// Convert keys and gather the digit histograms of all passes at once. The histograms of the whole buffer do
+		// not change between passes, so passes where all keys share the same digit can be skipped.
+		std::vector<std::array<Histogram, radixPasses>> passHistograms(chunkCount);
+		forEachChunk([&](std::size_t chunk, std::size_t begin, std::size_t end) {
+			auto & histograms = passHistograms[chunk];
+			for (auto & histogram : histograms)
+			{
+				histogram.fill(0);
+			}
+
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				RadixKey radixKey = toRadixKey(keys[i]);
+				radixKeys[i] = radixKey;
+				radixIndices[i] = i;
+
+				for (std::size_t pass = 0; pass < radixPasses; ++pass)
+				{
+					histograms[pass][getDigit(radixKey, pass)]++;
+				}
+			}
+		});
+
+		for (std::size_t pass = 0; pass < radixPasses; ++pass)
+		{
+			for (std::size_t digit = 0; digit < radixSize; ++digit)
+			{
+				std::size_t digitCount = 0;
+				for (const auto & histograms : passHistograms)
+				{
+					digitCount += histograms[pass][digit];
+				}
+
+				if (digitCount == count)
+				{
+					skippedPasses[pass] = true;
+					break;
+				}
+				else if (digitCount != 0)
+				{
+					break;
+				}
+			}
+		}
+	}
+
+	void sort(std::vector<Index> & indices)
+	{
+		for (std::size_t pass = 0; pass < radixPasses; ++pass)
+		{
+			if (!skippedPasses[pass])
+			{
+				scatter(pass);
+			}
+		}
+
+		indices.swap(radixIndices);
+	}
+
+private:
+	template <typename Func>
+	void forEachChunk(Func func)
+	{
+		if (threadPool)
+		{
+			threadPool->parallelFor(chunkCount, 1, [&](std::size_t first, std::size_t last) {
+				for (std::size_t chunk = first; chunk < last; ++chunk)
+				{
+					func(chunk, std::min(chunk * chunkSize, count), std::min((chunk + 1) * chunkSize, count));
+				}
+			});
+		}
+		else
+		{
+			func(0, 0, count);
+		}
+	}
+
+	void scatter(std::size_t pass)
+	{
+		forEachChunk([&](std::size_t chunk, std::size_t begin, std::size_t end) {
+			auto & histogram = chunkHistograms[chunk];
+			histogram.fill(0);
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				histogram[getDigit(radixKeys[i], pass)]++;
+			}
+		});
+
+		// Turn the per-chunk histograms into output offsets. Earlier chunks come first within each digit, which keeps
+		// the sort stable.
+		std::size_t offset = 0;
+		for (std::size_t digit = 0; digit < radixSize; ++digit)
+		{
+			for (auto & histogram : chunkHistograms)
+			{
+				std::size_t digitCount = histogram[digit];
+				histogram[digit] = offset;
+				offset += digitCount;
+			}
+		}
+
+		forEachChunk([&](std::size_t chunk, std::size_t begin, std::size_t end) {
+			auto & offsets = chunkHistograms[chunk];
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				std::size_t target = offsets[getDigit(radixKeys[i], pass)]++;
+				swapKeys[target] = radixKeys[i];
+				swapIndices[target] = radixIndices[i];
+			}
+		});
+
+		radixKeys.swap(swapKeys);
+		radixIndices.swap(swapIndices);
+	}
+
+	std::size_t count;
+	ThreadPool * threadPool;
+	std::size_t chunkCount;
+	std::size_t chunkSize;
+
+	std::vector<RadixKey> radixKeys;
+	std::vector<Index> radixIndices;
+	std::vector<RadixKey> swapKeys;
+	std::vector<Index> swapIndices;
+	std::vector<Histogram> chunkHistograms;
+	std::array<bool, radixPasses> skippedPasses = {};
+};
+}
+
+void sortIndices(const Key * keys, std::size_t count, std::vector<Index> & indices, ThreadPool * threadPool)
+{
+	if (count < minRadixSortSize)
+	{
+		indices.resize(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			indices[i] = i;
+		}
+
+		std::sort(indices.begin(), indices.end(), [keys](Index i1, Index i2) {
+			return compareEntries(keys, i1, i2);
+		});
+		return;
+	}
+
+	RadixSorter(keys, count, threadPool).sort(indices);
+}
+
+void mergeRuns(const Key * keys, std::vector<Index> & indices, const std::vector<Run> & runs)
+{
+	if (runs.size() <= 1)
+	{
+		return;
+	}
+
+	struct Head
+	{
+		Key key;
+		Index index;
+		std::size_t position;
+		std::size_t end;
+
+		bool operator<(const Head & other) const
+		{
+			return key != other.key ? key < other.key : index < other.index;
+		}
+	};
+
+	// Binary min-heap over the current head of each run
+	std::vector<Head> heap;
+	heap.reserve(runs.size());
+	for (const auto & run : runs)
+	{
+		if (run.size > 0)
+		{
+			Index index = indices[run.offset];
+			heap.push_back({keys[index], index, run.offset, run.offset + run.size});
+		}
+	}
+
+	auto siftDown = [&heap](std::size_t node) {
+		Head head = heap[node];
+		std::size_t size = heap.size();
+		while (true)
+		{
+			std::size_t child = node * 2 + 1;
+			if (child >= size)
+			{
+				break;
+			}
+			if (child + 1 < size && heap[child + 1] < heap[child])
+			{
+				++child;
+			}
+			if (!(heap[child] < head))
+			{
+				break;
+			}
+			heap[node] = heap[child];
+			node = child;
+		}
+		heap[node] = head;
+	};
+
+	for (std::size_t node = heap.size() / 2; node-- > 0;)
+	{
+		siftDown(node);
+	}
+
+	std::vector<Index> merged(indices.size());
+	std::size_t output = 0;
+
+	while (!heap.empty())
+	{
+		Head & top = heap.front();
+		merged[output++] = top.index;
+
+		// Replace the smallest head with its successor in place, which needs a single sift-down per element
+		if (++top.position < top.end)
+		{
+			top.index = indices[top.position];
+			top.key = keys[top.index];
+		}
+		else
+		{
+			top = heap.back();
+			heap.pop_back();
+			if (heap.empty())
+			{
+				break;
+			}
+		}
+		siftDown(0);
+	}
+
+	indices.swap(merged);
+}
+
+// Previous implementation, kept for comparison
+static void mergeRunsPairwise(const Key * keys, std::vector<Index> & indices, std::vector<Run> runs)
+{
+	while (runs.size() > 1)
+	{
+		std::vector<Run> newRuns;
+		for (std::size_t i = 1; i < runs.size(); i += 2)
+		{
+			auto & left = runs[i - 1];
+			auto & right = runs[i];
+			auto it = indices.begin();
+			std::inplace_merge(it + left.offset, it + left.offset + left.size, it + right.offset + right.size,
+			                   [keys](Index i1, Index i2) {
+				                   return compareEntries(keys, i1, i2);
+			                   });
+			newRuns.emplace_back(left.offset, left.size + right.size);
+		}
+
+		if (runs.size() % 2 == 1)
+		{
+			newRuns.push_back(runs.back());
+		}
+
+		runs = newRuns;
+	}
+}
+
+BenchmarkResult benchmark(std::size_t count, std::size_t runCount, ThreadPool * threadPool)
+{
+	BenchmarkResult result;
+
+	// Layered scenes use few distinct Z-orders, with many ties
+	std::mt19937 random(count);
+	std::uniform_int_distribution<int> layerDistribution(-64, 64);
+	std::vector<Key> keys(count);
+	for (auto & key : keys)
+	{
+		key = layerDistribution(random) * 0.25;
+	}
+
+	sf::Clock clock;
+
+	std::vector<Index> comparisonIndices(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		comparisonIndices[i] = i;
+	}
+	std::sort(comparisonIndices.begin(), comparisonIndices.end(), [&keys](Index i1, Index i2) {
+		return compareEntries(keys.data(), i1, i2);
+	});
+	result.comparisonSortSeconds = clock.restart().asSeconds();
+
+	std::vector<Index> radixIndices;
+	sortIndices(keys.data(), count, radixIndices, threadPool);
+	result.radixSortSeconds = clock.restart().asSeconds();
+
+	// Build sorted runs of similar size, as produced by sorting individual buffers before merging them
+	runCount = std::max<std::size_t>(1, std::min(runCount, count));
+	std::vector<Run> runs;
+	std::vector<Index> runIndices(count);
+	for (std::size_t i = 0; i < runCount; ++i)
+	{
+		std::size_t begin = count * i / runCount;
+		std::size_t end = count * (i + 1) / runCount;
+		for (std::size_t j = begin; j < end; ++j)
+		{
+			runIndices[j] = j;
+		}
+		std::sort(runIndices.begin() + begin, runIndices.begin() + end, [&keys](Index i1, Index i2) {
+			return compareEntries(keys.data(), i1, i2);
+		});
+		runs.emplace_back(begin, end - begin);
+	}
+
+	auto pairwiseIndices = runIndices;
+	clock.restart();
+	mergeRunsPairwise(keys.data(), pairwiseIndices, runs);
+	result.pairwiseMergeSeconds = clock.restart().asSeconds();
+
+	mergeRuns(keys.data(), runIndices, runs);
+	result.heapMergeSeconds = clock.restart().asSeconds();
+
+	return result;
+}
+
+}
+}
@@ -0,0 +1,73 @@
+#ifndef SRC_CLIENT_GAMERENDERER_ZORDERSORT_HPP_
+#define SRC_CLIENT_GAMERENDERER_ZORDERSORT_HPP_
+
+#include <Client/Lua/Bindings/GraphicsBinding.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ThreadPool;
+
+namespace wos
+{
+namespace zorder
+{
+
+using Key = wosC_gfx_zOrder_t;
+using Index = std::uint32_t;
+
+/**
+ * Contiguous range of an index buffer that is already sorted.
+ */
+struct Run
+{
+	Run() = default;
+	Run(std::size_t offset, std::size_t size) :
+		offset(offset),
+		size(size)
+	{
+	}
+
+	std::size_t offset = 0;
+	std::size_t size = 0;
+};
+
+/**
+ * Orders entries by ascending key, breaking ties by ascending index.
+ */
+inline bool compareEntries(const Key * keys, Index i1, Index i2)
+{
+	return keys[i1] != keys[i2] ? keys[i1] < keys[i2] : i1 < i2;
+}
+
+/**
+ * Fills the index buffer with the indices [0, count) in Z-order, using a stable LSD radix sort on the keys.
+ *
+ * If a thread pool is specified, large buffers are sorted in parallel on it.
+ */
+void sortIndices(const Key * keys, std::size_t count, std::vector<Index> & indices, ThreadPool * threadPool);
+
+/**
+ * Merges the sorted runs of an index buffer in a single pass, using a min-heap over the heads of all runs. The runs
+ * must be adjacent and cover the whole index buffer.
+ */
+void mergeRuns(const Key * keys, std::vector<Index> & indices, const std::vector<Run> & runs);
+
+struct BenchmarkResult
+{
+	double comparisonSortSeconds = 0;
+	double radixSortSeconds = 0;
+	double pairwiseMergeSeconds = 0;
+	double heapMergeSeconds = 0;
+};
+
+/**
+ * Compares the previous comparison-based sort and pairwise in-place merge against the radix sort and heap-based merge
+ * on synthetic Z-order buffers with 'count' entries, split into 'runCount' runs for the merge.
+ */
+BenchmarkResult benchmark(std::size_t count, std::size_t runCount, ThreadPool * threadPool);
+
+}
+}
+
+#endif
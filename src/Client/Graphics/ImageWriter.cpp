@@ -0,0 +1,125 @@
+#include <Client/Graphics/ImageWriter.hpp>
+#include <Shared/Utils/MiscMath.hpp>
+#include <Shared/Utils/ThreadPool.hpp>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <memory>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <Shared/External/stb/stb_image_write.h>
+
+ImageWriter::ImageWriter(ThreadPool & threadPool) :
+	threadPool(threadPool),
+	logger("ImageWriter")
+{
+}
+
+ImageWriter::~ImageWriter()
+{
+	wait();
+}
+
+void ImageWriter::write(std::string fileName, sf::Image image)
+{
+	auto sharedImage = std::make_shared<sf::Image>(std::move(image));
+	enqueue([this, fileName, sharedImage]() {
+		encode(fileName, sharedImage->getPixelsPtr(), sharedImage->getSize());
+	});
+}
+
+void ImageWriter::write(std::string fileName, sf::Image image, sf::FloatRect sourceRect, sf::Vector2u outputSize)
+{
+	auto sharedImage = std::make_shared<sf::Image>(std::move(image));
+	enqueue([this, fileName, sharedImage, sourceRect, outputSize]() {
+		auto pixels = resample(*sharedImage, sourceRect, outputSize);
+		encode(fileName, pixels.data(), outputSize);
+	});
+}
+
+void ImageWriter::wait()
+{
+	std::unique_lock<std::mutex> lock(pendingMutex);
+	pendingCondition.wait(lock, [this]() {
+		return pendingCount == 0;
+	});
+}
+
+std::size_t ImageWriter::getPendingCount() const
+{
+	std::lock_guard<std::mutex> guard(pendingMutex);
+	return pendingCount;
+}
+
+std::vector<sf::Uint8> ImageWriter::resample(const sf::Image & image, sf::FloatRect sourceRect,
+                                             sf::Vector2u outputSize)
+{
+	static constexpr std::size_t channels = 4;
+
+	std::vector<sf::Uint8> result(std::size_t(outputSize.x) * outputSize.y * channels);
+
+	if (image.getSize().x == 0 || image.getSize().y == 0)
+	{
+		return result;
+	}
+
+	int maxX = image.getSize().x - 1;
+	int maxY = image.getSize().y - 1;
+
+	// Source columns are the same for every row, so they are only computed once
+	std::vector<std::size_t> sourceColumns(outputSize.x);
+	for (std::size_t x = 0; x < outputSize.x; ++x)
+	{
+		int srcX = std::floor((double(x) / outputSize.x) * sourceRect.width + sourceRect.left + 0.5);
+		sourceColumns[x] = clamp(0, srcX, maxX) * channels;
+	}
+
+	const sf::Uint8 * source = image.getPixelsPtr();
+	std::size_t sourceStride = image.getSize().x * channels;
+	std::size_t outputStride = outputSize.x * channels;
+
+	for (std::size_t y = 0; y < outputSize.y; ++y)
+	{
+		int srcY = std::floor((double(y) / outputSize.y) * sourceRect.height + sourceRect.top + 0.5);
+		const sf::Uint8 * sourceRow = source + clamp(0, srcY, maxY) * sourceStride;
+		sf::Uint8 * outputRow = result.data() + y * outputStride;
+
+		for (std::size_t x = 0; x < outputSize.x; ++x)
+		{
+			std::memcpy(outputRow + x * channels, sourceRow + sourceColumns[x], channels);
+		}
+	}
+
+	return result;
+}
+
+void ImageWriter::enqueue(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> guard(pendingMutex);
+		pendingCount++;
+	}
+
+	threadPool.submit([this, task]() {
+		try
+		{
+			task();
+		}
+		catch (std::exception & e)
+		{
+			logger.error("Failed to write image: {}", e.what());
+		}
+
+		std::lock_guard<std::mutex> guard(pendingMutex);
+		pendingCount--;
+		pendingCondition.notify_all();
+	});
+}
+
+void ImageWriter::encode(const std::string & fileName, const sf::Uint8 * pixels, sf::Vector2u size)
+{
+	if (!stbi_write_png(fileName.c_str(), size.x, size.y, 4, pixels, size.x * 4))
+	{
+		logger.warn("Failed to write image file '{}'", fileName);
+	}
+}
@@ -0,0 +1,72 @@
+#ifndef SRC_CLIENT_GRAPHICS_IMAGEWRITER_HPP_
+#define SRC_CLIENT_GRAPHICS_IMAGEWRITER_HPP_
+
+#include <SFML/Config.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <Shared/Utils/Debug/Logger.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * Encodes images as PNG files on the worker threads of a thread pool.
+ *
+ * Images are passed by value, so they can be captured from a render target and handed off without waiting for the
+ * encoder. The destructor blocks until all pending images have been written.
+ */
+class ImageWriter
+{
+public:
+	ImageWriter(ThreadPool & threadPool);
+	~ImageWriter();
+
+	ImageWriter(const ImageWriter &) = delete;
+	ImageWriter & operator=(const ImageWriter &) = delete;
+
+	/**
+	 * Writes the whole image to the specified PNG file.
+	 */
+	void write(std::string fileName, sf::Image image);
+
+	/**
+	 * Resamples the specified region of the image to the output size (using nearest-neighbor sampling) and writes the
+	 * result to the specified PNG file. Pixels outside of the image are clamped to its edges.
+	 */
+	void write(std::string fileName, sf::Image image, sf::FloatRect sourceRect, sf::Vector2u outputSize);
+
+	/**
+	 * Blocks until all pending images have been written.
+	 */
+	void wait();
+
+	/**
+	 * Returns the number of images that are queued or currently being encoded.
+	 */
+	std::size_t getPendingCount() const;
+
+	/**
+	 * Returns the RGBA pixels of the specified region of the image, resampled to the output size.
+	 */
+	static std::vector<sf::Uint8> resample(const sf::Image & image, sf::FloatRect sourceRect, sf::Vector2u outputSize);
+
+private:
+	void enqueue(std::function<void()> task);
+	void encode(const std::string & fileName, const sf::Uint8 * pixels, sf::Vector2u size);
+
+	ThreadPool & threadPool;
+
+	std::size_t pendingCount = 0;
+	mutable std::mutex pendingMutex;
+	std::condition_variable pendingCondition;
+
+	Logger logger;
+};
+
+#endif
@@ -564,3 +564,23 @@ bool loadImage(const sf::Uint8 * data, std::size_t size, sf::Image & image)
 	// If image data is non-null, first try to load the image as a raw image, then try conventional formats.
 	return data != nullptr && (loadRawImage(data, size, image) || image.loadFromMemory(data, size));
 }
+
+bool loadGrayscaleImage(const std::string & filename, std::vector<sf::Uint8> & pixels, sf::Vector2u & size)
+{
+	std::string data = readFileToString(filename);
+	sf::Image image;
+	if (data.empty() || !loadImage(reinterpret_cast<const sf::Uint8 *>(data.data()), data.size(), image))
+	{
+		return false;
+	}
+
+	size = image.getSize();
+	pixels.resize(std::size_t(size.x) * size.y);
+
+	const sf::Uint8 * rgba = image.getPixelsPtr();
+	for (std::size_t i = 0; i < pixels.size(); ++i, rgba += 4)
+	{
+		pixels[i] = static_cast<sf::Uint8>((rgba[0] * 77 + rgba[1] * 150 + rgba[2] * 29) >> 8);
+	}
+	return true;
+}
@@ -10,6 +10,7 @@
 #include <cmath>
 #include <cstddef>
 #include <functional>
+#include <string>
 #include <vector>
 
 namespace sf
@@ -126,4 +127,7 @@ sf::Vector2f transformVector(const sf::Transform & transform, const sf::Vector2f
 
 bool loadImage(const sf::Uint8 * data, std::size_t size, sf::Image & image);
 
+// Loads the image file via loadImage and converts it to one luma byte per pixel. Gray pixels keep their exact value.
+bool loadGrayscaleImage(const std::string & filename, std::vector<sf::Uint8> & pixels, sf::Vector2u & size);
+
 #endif
@@ -65,6 +65,15 @@ extern "C"
 #define WOSC_GFX_GLUE_ARG4(RETURN_TYPE, FUNC_NAME, T1, N1, T2, N2, T3, N3, T4, N4)                                  \
 	WOSC_GFX_GLUE_IMPL(RETURN_TYPE, FUNC_NAME, WOSC_COMMA T1 N1 WOSC_COMMA T2 N2 WOSC_COMMA T3 N3 WOSC_COMMA T4 N4, \
 	                   N1 WOSC_COMMA N2 WOSC_COMMA N3 WOSC_COMMA N4)
+#define WOSC_GFX_GLUE_ARG5(RETURN_TYPE, FUNC_NAME, T1, N1, T2, N2, T3, N3, T4, N4, T5, N5)                  \
+	WOSC_GFX_GLUE_IMPL(RETURN_TYPE, FUNC_NAME,                                                               \
+	                   WOSC_COMMA T1 N1 WOSC_COMMA T2 N2 WOSC_COMMA T3 N3 WOSC_COMMA T4 N4 WOSC_COMMA T5 N5, \
+	                   N1 WOSC_COMMA N2 WOSC_COMMA N3 WOSC_COMMA N4 WOSC_COMMA N5)
+#define WOSC_GFX_GLUE_ARG6(RETURN_TYPE, FUNC_NAME, T1, N1, T2, N2, T3, N3, T4, N4, T5, N5, T6, N6)                  \
+	WOSC_GFX_GLUE_IMPL(RETURN_TYPE, FUNC_NAME,                                                                       \
+	                   WOSC_COMMA T1 N1 WOSC_COMMA T2 N2 WOSC_COMMA T3 N3 WOSC_COMMA T4 N4 WOSC_COMMA T5 N5 WOSC_COMMA \
+	                       T6 N6,                                                                                    \
+	                   N1 WOSC_COMMA N2 WOSC_COMMA N3 WOSC_COMMA N4 WOSC_COMMA N5 WOSC_COMMA N6)
 
 	WOSC_GFX_GLUE_ARG1(wosC_gfx_imageID_t, loadImage, const char *, name)
 	WOSC_GFX_GLUE_ARG1(void, unloadImage, wosC_gfx_imageID_t, imageID)
@@ -93,6 +102,22 @@ extern "C"
 	                   vertexOffset, wosC_gfx_vertexBuffer_size_t, vertexCount, const wosC_gfx_vertex_t *, vertices)
 	WOSC_GFX_GLUE_ARG4(void, readVertices, wosC_gfx_vertexBuffer_t, vbufferID, wosC_gfx_vertexBuffer_size_t,
 	                   vertexOffset, wosC_gfx_vertexBuffer_size_t, vertexCount, wosC_gfx_vertex_t *, vertices)
+	WOSC_GFX_GLUE_ARG3(wosC_gfx_vertex_t *, reserveVertices, wosC_gfx_vertexBuffer_t, vbufferID,
+	                   wosC_gfx_vertexBuffer_size_t, vertexOffset, wosC_gfx_vertexBuffer_size_t, vertexCount)
+	WOSC_GFX_GLUE_ARG3(void, commitVertices, wosC_gfx_vertexBuffer_t, vbufferID, wosC_gfx_vertexBuffer_size_t,
+	                   vertexOffset, wosC_gfx_vertexBuffer_size_t, vertexCount)
+	WOSC_GFX_GLUE_ARG6(wosC_gfx_vertexBuffer_size_t, writeCircles, wosC_gfx_vertexBuffer_t, vbufferID,
+	                   wosC_gfx_vertexBuffer_size_t, vertexOffset, const wosC_gfx_circle_t *, circles,
+	                   wosC_gfx_vertexBuffer_size_t, circleCount, wosC_gfx_vertexBuffer_size_t, maxSegments, double,
+	                   feather)
+	WOSC_GFX_GLUE_ARG5(wosC_gfx_vertexBuffer_size_t, writeLines, wosC_gfx_vertexBuffer_t, vbufferID,
+	                   wosC_gfx_vertexBuffer_size_t, vertexOffset, const wosC_gfx_line_t *, lines,
+	                   wosC_gfx_vertexBuffer_size_t, lineCount, double, feather)
+	WOSC_GFX_GLUE_ARG4(wosC_gfx_vertexBuffer_size_t, countCircleVertices, const wosC_gfx_circle_t *, circles,
+	                   wosC_gfx_vertexBuffer_size_t, circleCount, wosC_gfx_vertexBuffer_size_t, maxSegments, double,
+	                   feather)
+	WOSC_GFX_GLUE_ARG2(wosC_gfx_vertexBuffer_size_t, countLineVertices, wosC_gfx_vertexBuffer_size_t, lineCount,
+	                   double, feather)
 	WOSC_GFX_GLUE_ARG4(void, writeVertexTextureIDs, wosC_gfx_vertexBuffer_t, vbufferID, wosC_gfx_vertexBuffer_size_t,
 	                   vertexOffset, wosC_gfx_vertexBuffer_size_t, textureIDCount, const wosC_gfx_textureID_t *,
 	                   textureIDs)
@@ -113,4 +138,6 @@ extern "C"
 	WOSC_GFX_GLUE_ARG3(void, mergeSortedBuffers, const wosC_gfx_vertexBuffer_t *, sourceIDs,
 	                   wosC_gfx_vertexBuffer_size_t, sourceCount, wosC_gfx_vertexBuffer_t, targetID)
 	WOSC_GFX_GLUE_ARG1(void, drawVertexBuffer, wosC_gfx_vertexBuffer_t, vbufferID)
+	WOSC_GFX_GLUE_ARG3(void, drawVertexBufferRange, wosC_gfx_vertexBuffer_t, vbufferID, wosC_gfx_vertexBuffer_size_t,
+	                   vertexOffset, wosC_gfx_vertexBuffer_size_t, vertexCount)
 }
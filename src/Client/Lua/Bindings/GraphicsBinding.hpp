@@ -52,6 +52,28 @@ public:
 	virtual void readVertices(wosC_gfx_vertexBuffer_t vbufferID, wosC_gfx_vertexBuffer_size_t vertexOffset,
 	                          wosC_gfx_vertexBuffer_size_t vertexCount,
 	                          wosC_gfx_vertex_t * vertices) const noexcept = 0;
+	virtual wosC_gfx_vertex_t * reserveVertices(wosC_gfx_vertexBuffer_t vbufferID,
+	                                            wosC_gfx_vertexBuffer_size_t vertexOffset,
+	                                            wosC_gfx_vertexBuffer_size_t vertexCount) noexcept = 0;
+	virtual void commitVertices(wosC_gfx_vertexBuffer_t vbufferID, wosC_gfx_vertexBuffer_size_t vertexOffset,
+	                            wosC_gfx_vertexBuffer_size_t vertexCount) noexcept = 0;
+
+	virtual wosC_gfx_vertexBuffer_size_t writeCircles(wosC_gfx_vertexBuffer_t vbufferID,
+	                                                  wosC_gfx_vertexBuffer_size_t vertexOffset,
+	                                                  const wosC_gfx_circle_t * circles,
+	                                                  wosC_gfx_vertexBuffer_size_t circleCount,
+	                                                  wosC_gfx_vertexBuffer_size_t maxSegments,
+	                                                  double feather) noexcept = 0;
+	virtual wosC_gfx_vertexBuffer_size_t writeLines(wosC_gfx_vertexBuffer_t vbufferID,
+	                                                wosC_gfx_vertexBuffer_size_t vertexOffset,
+	                                                const wosC_gfx_line_t * lines,
+	                                                wosC_gfx_vertexBuffer_size_t lineCount, double feather) noexcept = 0;
+	virtual wosC_gfx_vertexBuffer_size_t countCircleVertices(const wosC_gfx_circle_t * circles,
+	                                                         wosC_gfx_vertexBuffer_size_t circleCount,
+	                                                         wosC_gfx_vertexBuffer_size_t maxSegments,
+	                                                         double feather) const noexcept = 0;
+	virtual wosC_gfx_vertexBuffer_size_t countLineVertices(wosC_gfx_vertexBuffer_size_t lineCount,
+	                                                       double feather) const noexcept = 0;
 
 	virtual void writeVertexTextureIDs(wosC_gfx_vertexBuffer_t vbufferID, wosC_gfx_vertexBuffer_size_t vertexOffset,
 	                                   wosC_gfx_vertexBuffer_size_t textureIDCount,
@@ -80,6 +102,8 @@ public:
 	                                wosC_gfx_vertexBuffer_t targetID) noexcept = 0;
 
 	virtual void drawVertexBuffer(wosC_gfx_vertexBuffer_t vbufferID) noexcept = 0;
+	virtual void drawVertexBufferRange(wosC_gfx_vertexBuffer_t vbufferID, wosC_gfx_vertexBuffer_size_t vertexOffset,
+	                                   wosC_gfx_vertexBuffer_size_t vertexCount) noexcept = 0;
 };
 
 /**
@@ -0,0 +1,190 @@
+#include <Client/Lua/Bridges/FlowGraphBridge.hpp>
+#include <Client/Lua/Bridges/FrameSequenceUtils.hpp>
+#include <Shared/Lua/Bindings/Accel/FlowGraphExtractor.hpp>
+#include <Shared/Lua/Bindings/Accel/GraphFile.hpp>
+#include <Shared/Lua/Bindings/ArrayBinding.hpp>
+#include <Shared/Lua/LuaUtils.hpp>
+#include <Sol2/sol.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace lua
+{
+
+static wosc::FlowGraphExtractor::Settings getSettings(const sol::table & table)
+{
+	wosc::FlowGraphExtractor::Settings settings;
+	readFrameSegmentation(table, settings);
+	settings.minArea = std::max(getOr<int>(table["minArea"], int(settings.minArea)), 1);
+	settings.minOverlap = std::max(getOr<int>(table["minOverlap"], int(settings.minOverlap)), 1);
+	settings.diagonal = getOr<bool>(table["diagonal"], settings.diagonal);
+	return settings;
+}
+
+FlowGraphBridge::FlowGraphBridge(ThreadPool & threadPool, wosc::ArrayContext & arrayContext) :
+	threadPool(threadPool),
+	arrayContext(arrayContext)
+{
+}
+
+FlowGraphBridge::~FlowGraphBridge()
+{
+}
+
+wosc::FlowGraphExtractor * FlowGraphBridge::getExtractor(int extractorID) const
+{
+	auto it = extractors.find(extractorID);
+	return it == extractors.end() ? nullptr : it->second.get();
+}
+
+void FlowGraphBridge::onLoad(BridgeLoader & loader)
+{
+	using ArrayID = wosc::ArrayContext::ArrayID;
+	using ColumnType = wosc::GraphFile::ColumnType;
+
+	// Extractions started by a previous Lua state are no longer referenced
+	extractors.clear();
+
+	loader.bind("flowgraph.start", //
+	    std::function<int(sol::table, sol::table)>([=](sol::table paths, sol::table settings) {
+		    auto extractor = std::make_unique<wosc::FlowGraphExtractor>(threadPool);
+		    extractor->start(tableToVector<std::string>(paths), getSettings(settings), loadGrayscaleFrame);
+
+		    int extractorID = nextExtractorID++;
+		    extractors[extractorID] = std::move(extractor);
+		    return extractorID;
+	    }));
+
+	loader.bind("flowgraph.destroy", std::function<void(int)>([=](int extractorID) {
+		            extractors.erase(extractorID);
+	            }));
+
+	loader.bind("flowgraph.getProgress", //
+	    std::function<std::tuple<int, int, bool>(int)>([=](int extractorID) {
+		    auto extractor = getExtractor(extractorID);
+		    if (!extractor)
+		    {
+			    return std::make_tuple(0, 0, false);
+		    }
+		    return std::make_tuple(int(extractor->getProcessedFrameCount()), int(extractor->getFrameCount()),
+		                           extractor->isDone());
+	    }));
+
+	loader.bind("flowgraph.wait", std::function<void(int)>([=](int extractorID) {
+		            auto extractor = getExtractor(extractorID);
+		            if (extractor)
+		            {
+			            extractor->wait();
+		            }
+	            }));
+
+	loader.bind("flowgraph.take", //
+	    std::function<std::tuple<sol::object, std::string>(int, sol::this_state)>(
+	        [=](int extractorID, sol::this_state state) -> std::tuple<sol::object, std::string>
+	        {
+		        auto fail = [state](std::string error) {
+			        return std::make_tuple(sol::make_object(state, sol::lua_nil), std::move(error));
+		        };
+
+		        auto extractor = getExtractor(extractorID);
+		        if (!extractor)
+		        {
+			        return fail("Invalid flow graph extractor");
+		        }
+
+		        wosc::FlowGraphExtractor::Result graph;
+		        if (!extractor->takeResult(graph))
+		        {
+			        std::string error = extractor->getError();
+			        return fail(error.empty() ? "Flow graph extraction is not done" : error);
+		        }
+
+		        sol::state_view lua(state);
+		        auto columns = lua.create_table();
+
+		        // Copies the values into a new native array, owned by the script once acquired via getArrayByID
+		        auto addColumn = [&](const char * name, ColumnType type, const void * data, std::size_t size) {
+			        ArrayID arrayID = arrayContext.newArray(size);
+			        if (size > 0)
+			        {
+				        std::memcpy(arrayContext.getArrayInfo(arrayID).data, data, size);
+			        }
+			        columns[name] = lua.create_table_with("id", arrayID, "type", static_cast<int>(type));
+		        };
+
+		        std::size_t nodeCount = graph.nodes.size();
+		        std::vector<std::int32_t> times(nodeCount), ids(nodeCount), edgesIn(nodeCount), edgesOut(nodeCount);
+		        std::vector<double> xs(nodeCount), ys(nodeCount), velocities(nodeCount), areas(nodeCount);
+		        std::vector<double> rects(nodeCount * 4), interfaces(nodeCount * 2);
+		        std::vector<std::uint8_t> modified(nodeCount, 0);
+
+		        for (std::size_t i = 0; i < nodeCount; ++i)
+		        {
+			        const auto & node = graph.nodes[i];
+			        times[i] = node.time;
+			        ids[i] = std::int32_t(i);
+			        xs[i] = node.x;
+			        ys[i] = node.y;
+			        velocities[i] = node.velocity;
+			        areas[i] = node.area;
+			        edgesIn[i] = node.edgesIn;
+			        edgesOut[i] = node.edgesOut;
+			        rects[i * 4] = node.left;
+			        rects[i * 4 + 1] = node.top;
+			        rects[i * 4 + 2] = node.right;
+			        rects[i * 4 + 3] = node.bottom;
+			        interfaces[i * 2] = node.fluidInterface;
+			        interfaces[i * 2 + 1] = node.solidInterface;
+		        }
+
+		        addColumn("Time", ColumnType::Int32, times.data(), nodeCount * sizeof(std::int32_t));
+		        addColumn("Id", ColumnType::Int32, ids.data(), nodeCount * sizeof(std::int32_t));
+		        addColumn("X", ColumnType::Double, xs.data(), nodeCount * sizeof(double));
+		        addColumn("Y", ColumnType::Double, ys.data(), nodeCount * sizeof(double));
+		        addColumn("Velocity", ColumnType::Double, velocities.data(), nodeCount * sizeof(double));
+		        addColumn("Modified", ColumnType::UInt8, modified.data(), nodeCount);
+		        addColumn("Area", ColumnType::Double, areas.data(), nodeCount * sizeof(double));
+		        addColumn("EdgesIn", ColumnType::Int32, edgesIn.data(), nodeCount * sizeof(std::int32_t));
+		        addColumn("EdgesOut", ColumnType::Int32, edgesOut.data(), nodeCount * sizeof(std::int32_t));
+		        addColumn("Edges", ColumnType::Int32, graph.edges.data(), graph.edges.size() * sizeof(std::int32_t));
+		        addColumn("Rects", ColumnType::Double, rects.data(), rects.size() * sizeof(double));
+		        addColumn("Interfaces", ColumnType::Double, interfaces.data(), interfaces.size() * sizeof(double));
+
+		        // Invaded pixels per frame from the first to the last frame containing nodes
+		        std::size_t velocityCount = std::size_t(graph.endTime - graph.startTime + 1);
+		        const double * velocityData = graph.invadedPixels.data() + graph.startTime;
+		        addColumn("Velocities", ColumnType::Double, velocityData, velocityCount * sizeof(double));
+
+		        // Fluid enters from the side on which the nodes of the first frame lie
+		        double firstX = 0;
+		        std::size_t firstCount = 0;
+		        for (const auto & node : graph.nodes)
+		        {
+			        if (node.time == graph.startTime)
+			        {
+				        firstX += node.x;
+				        firstCount++;
+			        }
+		        }
+
+		        auto metadata = lua.create_table();
+		        metadata["imgW"] = graph.width;
+		        metadata["imgH"] = graph.height;
+		        metadata["startTime"] = graph.startTime;
+		        metadata["endTime"] = graph.endTime;
+		        metadata["breakthroughTime"] = graph.breakthroughTime >= 0 ? graph.breakthroughTime : graph.endTime;
+		        metadata["minRange"] = 0;
+		        metadata["maxRange"] = 1;
+		        metadata["rightToLeft"] = firstCount > 0 && firstX / firstCount > graph.width / 2.0;
+
+		        auto result = lua.create_table_with("columns", columns, "metadata", metadata);
+		        return std::make_tuple(sol::make_object(state, result), std::string());
+	        }));
+}
+
+}
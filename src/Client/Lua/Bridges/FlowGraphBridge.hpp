@@ -0,0 +1,41 @@
+#ifndef SRC_CLIENT_LUA_BRIDGES_FLOWGRAPHBRIDGE_HPP_
+#define SRC_CLIENT_LUA_BRIDGES_FLOWGRAPHBRIDGE_HPP_
+
+#include <Shared/Lua/Bridges/AbstractBridge.hpp>
+#include <Shared/Lua/Bridges/BridgeLoader.hpp>
+#include <Shared/Utils/HashTable.hpp>
+#include <memory>
+
+namespace wosc
+{
+class ArrayContext;
+class FlowGraphExtractor;
+}
+
+class ThreadPool;
+
+namespace lua
+{
+
+class FlowGraphBridge : public AbstractBridge
+{
+public:
+	FlowGraphBridge(ThreadPool & threadPool, wosc::ArrayContext & arrayContext);
+	virtual ~FlowGraphBridge();
+
+protected:
+	virtual void onLoad(BridgeLoader & loader) override;
+
+private:
+	wosc::FlowGraphExtractor * getExtractor(int extractorID) const;
+
+	ThreadPool & threadPool;
+	wosc::ArrayContext & arrayContext;
+
+	HashMap<int, std::unique_ptr<wosc::FlowGraphExtractor>> extractors;
+	int nextExtractorID = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,140 @@
+#include <Client/Lua/Bridges/FrameAnalyzerBridge.hpp>
+#include <Client/Lua/Bridges/FrameSequenceUtils.hpp>
+#include <Shared/Lua/Bindings/Accel/FrameAnalyzer.hpp>
+#include <Shared/Lua/Bindings/Accel/GraphFile.hpp>
+#include <Shared/Lua/Bindings/ArrayBinding.hpp>
+#include <Shared/Lua/LuaUtils.hpp>
+#include <Shared/Utils/Filesystem/LocalStorage.hpp>
+#include <Sol2/sol.hpp>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace lua
+{
+
+FrameAnalyzerBridge::FrameAnalyzerBridge(ThreadPool & threadPool, wosc::ArrayContext & arrayContext) :
+	threadPool(threadPool),
+	arrayContext(arrayContext)
+{
+}
+
+FrameAnalyzerBridge::~FrameAnalyzerBridge()
+{
+}
+
+wosc::FrameAnalyzer * FrameAnalyzerBridge::getAnalyzer(int analyzerID) const
+{
+	auto it = analyzers.find(analyzerID);
+	return it == analyzers.end() ? nullptr : it->second.get();
+}
+
+void FrameAnalyzerBridge::onLoad(BridgeLoader & loader)
+{
+	using ArrayID = wosc::ArrayContext::ArrayID;
+	using ColumnType = wosc::GraphFile::ColumnType;
+	using Statistics = wosc::FrameAnalyzer::Statistics;
+
+	// Analyses started by a previous Lua state are no longer referenced
+	analyzers.clear();
+
+	loader.bind("frameanalyzer.start", //
+	    std::function<int(sol::table, sol::table, bool)>([=](sol::table paths, sol::table settings, bool useCache) {
+		    std::string cacheDirectory;
+		    if (useCache)
+		    {
+			    cacheDirectory =
+			        fs::LocalStorage::getInstance(fs::LocalStorage::Path::Cache).resolve("frame-statistics");
+		    }
+
+		    wosc::FrameAnalyzer::Settings segmentation;
+		    readFrameSegmentation(settings, segmentation);
+
+		    auto analyzer = std::make_unique<wosc::FrameAnalyzer>(threadPool);
+		    analyzer->start(tableToVector<std::string>(paths), segmentation, loadGrayscaleFrame, cacheDirectory);
+
+		    int analyzerID = nextAnalyzerID++;
+		    analyzers[analyzerID] = std::move(analyzer);
+		    return analyzerID;
+	    }));
+
+	loader.bind("frameanalyzer.destroy", std::function<void(int)>([=](int analyzerID) {
+		            analyzers.erase(analyzerID);
+	            }));
+
+	loader.bind("frameanalyzer.getProgress", //
+	    std::function<std::tuple<int, int, bool, int>(int)>([=](int analyzerID) {
+		    auto analyzer = getAnalyzer(analyzerID);
+		    if (!analyzer)
+		    {
+			    return std::make_tuple(0, 0, false, 0);
+		    }
+		    return std::make_tuple(int(analyzer->getProcessedFrameCount()), int(analyzer->getFrameCount()),
+		                           analyzer->isDone(), int(analyzer->getCachedFrameCount()));
+	    }));
+
+	loader.bind("frameanalyzer.wait", std::function<void(int)>([=](int analyzerID) {
+		            auto analyzer = getAnalyzer(analyzerID);
+		            if (analyzer)
+		            {
+			            analyzer->wait();
+		            }
+	            }));
+
+	loader.bind("frameanalyzer.take", //
+	    std::function<std::tuple<sol::object, std::string>(int, sol::this_state)>(
+	        [=](int analyzerID, sol::this_state state) -> std::tuple<sol::object, std::string>
+	        {
+		        auto fail = [state](std::string error) {
+			        return std::make_tuple(sol::make_object(state, sol::lua_nil), std::move(error));
+		        };
+
+		        auto analyzer = getAnalyzer(analyzerID);
+		        if (!analyzer)
+		        {
+			        return fail("Invalid frame analyzer");
+		        }
+
+		        std::vector<Statistics> statistics;
+		        if (!analyzer->takeStatistics(statistics))
+		        {
+			        std::string error = analyzer->getError();
+			        return fail(error.empty() ? "Frame analysis is not done" : error);
+		        }
+
+		        sol::state_view lua(state);
+		        auto columns = lua.create_table();
+
+		        // One dense array per statistic, indexed by frame
+		        std::vector<double> values(statistics.size());
+		        auto addColumn = [&](const char * name, double Statistics::*field) {
+			        for (std::size_t i = 0; i < statistics.size(); ++i)
+			        {
+				        values[i] = statistics[i].*field;
+			        }
+
+			        std::size_t size = values.size() * sizeof(double);
+			        ArrayID arrayID = arrayContext.newArray(size);
+			        if (size > 0)
+			        {
+				        std::memcpy(arrayContext.getArrayInfo(arrayID).data, values.data(), size);
+			        }
+			        columns[name] = lua.create_table_with("id", arrayID, "type", static_cast<int>(ColumnType::Double));
+		        };
+
+		        addColumn("FluidPixels", &Statistics::fluidPixels);
+		        addColumn("SolidPixels", &Statistics::solidPixels);
+		        addColumn("DefendingPixels", &Statistics::defendingPixels);
+		        addColumn("Saturation", &Statistics::saturation);
+		        addColumn("FrontLeft", &Statistics::frontLeft);
+		        addColumn("FrontRight", &Statistics::frontRight);
+		        addColumn("FractalDimension", &Statistics::fractalDimension);
+		        addColumn("MeanGray", &Statistics::meanGray);
+
+		        return std::make_tuple(sol::make_object(state, columns), std::string());
+	        }));
+}
+
+}
@@ -0,0 +1,41 @@
+#ifndef SRC_CLIENT_LUA_BRIDGES_FRAMEANALYZERBRIDGE_HPP_
+#define SRC_CLIENT_LUA_BRIDGES_FRAMEANALYZERBRIDGE_HPP_
+
+#include <Shared/Lua/Bridges/AbstractBridge.hpp>
+#include <Shared/Lua/Bridges/BridgeLoader.hpp>
+#include <Shared/Utils/HashTable.hpp>
+#include <memory>
+
+namespace wosc
+{
+class ArrayContext;
+class FrameAnalyzer;
+}
+
+class ThreadPool;
+
+namespace lua
+{
+
+class FrameAnalyzerBridge : public AbstractBridge
+{
+public:
+	FrameAnalyzerBridge(ThreadPool & threadPool, wosc::ArrayContext & arrayContext);
+	virtual ~FrameAnalyzerBridge();
+
+protected:
+	virtual void onLoad(BridgeLoader & loader) override;
+
+private:
+	wosc::FrameAnalyzer * getAnalyzer(int analyzerID) const;
+
+	ThreadPool & threadPool;
+	wosc::ArrayContext & arrayContext;
+
+	HashMap<int, std::unique_ptr<wosc::FrameAnalyzer>> analyzers;
+	int nextAnalyzerID = 0;
+};
+
+}
+
+#endif
@@ -0,0 +1,35 @@
+#include <Client/Graphics/UtilitiesSf.hpp>
+#include <Client/Lua/Bridges/FrameSequenceUtils.hpp>
+#include <Shared/Lua/LuaUtils.hpp>
+#include <algorithm>
+#include <cstdint>
+
+namespace lua
+{
+
+static std::uint8_t getGrayLevel(const sol::table & table, const char * key, int defaultValue)
+{
+	return static_cast<std::uint8_t>(std::min(std::max(getOr<int>(table[key], defaultValue), 0), 255));
+}
+
+void readFrameSegmentation(const sol::table & table, wosc::FrameSegmentation & segmentation)
+{
+	segmentation.fluidMin = getGrayLevel(table, "fluidMin", segmentation.fluidMin);
+	segmentation.fluidMax = getGrayLevel(table, "fluidMax", segmentation.fluidMax);
+	segmentation.solidMin = getGrayLevel(table, "solidMin", segmentation.solidMin);
+	segmentation.solidMax = getGrayLevel(table, "solidMax", segmentation.solidMax);
+}
+
+bool loadGrayscaleFrame(const std::string & path, wosc::GrayscaleFrame & frame)
+{
+	sf::Vector2u size;
+	if (!loadGrayscaleImage(path, frame.pixels, size))
+	{
+		return false;
+	}
+	frame.width = size.x;
+	frame.height = size.y;
+	return true;
+}
+
+}
@@ -0,0 +1,24 @@
+#ifndef SRC_CLIENT_LUA_BRIDGES_FRAMESEQUENCEUTILS_HPP_
+#define SRC_CLIENT_LUA_BRIDGES_FRAMESEQUENCEUTILS_HPP_
+
+#include <Shared/Lua/Bindings/Accel/GrayscaleFrame.hpp>
+#include <Sol2/sol.hpp>
+#include <string>
+
+namespace lua
+{
+
+/**
+ * Reads the gray level ranges fluidMin/fluidMax and solidMin/solidMax from a settings table, keeping the current
+ * values of missing keys. Levels are clamped to 0 to 255.
+ */
+void readFrameSegmentation(const sol::table & table, wosc::FrameSegmentation & segmentation);
+
+/**
+ * Decodes an image file into a grayscale frame. Safe to call from pool threads.
+ */
+bool loadGrayscaleFrame(const std::string & path, wosc::GrayscaleFrame & frame);
+
+}
+
+#endif
@@ -9,6 +9,7 @@
 #include <Shared/Lua/LuaUtils.hpp>
 #include <Shared/Utils/Utilities.hpp>
 #include <Sol2/sol.hpp>
+#include <algorithm>
 #include <cstddef>
 #include <functional>
 #include <iostream>
@@ -16,8 +17,6 @@
 #include <string>
 #include <vector>
 
-#define STB_IMAGE_WRITE_STATIC
-#define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <Shared/External/stb/stb_image_write.h>
 
 namespace lua
@@ -66,6 +65,44 @@ void GraphicsBridge::onLoad(BridgeLoader & loader)
 		                                      return std::make_tuple(result.pixels, result.width, result.height);
 	                                      }));
 
+	loader.bind("gfx.loadImageAsync", std::function<int(std::string)>([=](std::string imageName) {
+		            return manager.loadImageAsync(imageName);
+	            }));
+
+	loader.bind("gfx.getAsyncImageStatus", std::function<std::tuple<int, int, int>(int)>([=](int handle) {
+		            auto info = manager.getAsyncImageInfo(handle);
+		            return std::make_tuple(static_cast<int>(info.status), info.width, info.height);
+	            }));
+
+	loader.bind("gfx.applyAsyncImage",
+	            std::function<bool(int, wosC_gfx_imageID_t)>([=](int handle, wosC_gfx_imageID_t framebuffer) {
+		            return manager.applyAsyncImage(handle, framebuffer);
+	            }));
+
+	loader.bind("gfx.releaseAsyncImage", std::function<void(int)>([=](int handle) {
+		            manager.releaseAsyncImage(handle);
+	            }));
+
+	loader.bind("gfx.getDecodedImageCacheStats",
+	            std::function<std::tuple<double, double, double, double, double>()>([=]() {
+		            auto stats = manager.getDecodedImageCacheStats();
+		            return std::make_tuple<double, double, double, double, double>(
+		                stats.hits, stats.misses, stats.evictions, stats.memoryUsage, stats.budget);
+	            }));
+
+	loader.bind("gfx.benchmarkZOrderSort",
+	            std::function<std::tuple<double, double, double, double>(int, int)>([=](int quadCount, int bufferCount) {
+		            auto result = manager.benchmarkZOrderSort(std::max(quadCount, 0), std::max(bufferCount, 1));
+		            return std::make_tuple<double, double, double, double>(
+		                result.comparisonSortSeconds, result.radixSortSeconds, result.pairwiseMergeSeconds,
+		                result.heapMergeSeconds);
+	            }));
+
+	loader.bind("gfx.getVertexUploadStats", std::function<std::tuple<double, double>()>([=]() {
+		            auto stats = manager.getVertexUploadStats();
+		            return std::make_tuple<double, double>(stats.lastFrame, stats.total);
+	            }));
+
 	loader.bind("gfx.createFramebuffer",
 	            std::function<wosC_gfx_imageID_t(int, int)>([=](int width, int height) -> wosC_gfx_imageID_t {
 		            if (width > 0 && height > 0)
@@ -18,6 +18,7 @@
 #include <Shared/Content/PackageSource.hpp>
 #include <Shared/Content/SourceAggregator.hpp>
 #include <Shared/Content/SourcePrefixer.hpp>
+#include <Shared/External/spdlog/fmt/fmt.h>
 #include <Shared/Utils/DataStream.hpp>
 #include <Shared/Utils/Debug/CrashHandler.hpp>
 #include <Shared/Utils/Debug/StackTrace.hpp>
@@ -87,6 +88,10 @@ static const cfg::List<cfg::String> assetsPackages("wos.game.assets.packages");
 static const cfg::Bool externalAssetsRequired("wos.game.assets.external.required");
 static const cfg::List<MountPointKey> externalAssetsMountPoints("wos.game.assets.external.mountPoints");
 
+static const cfg::Bool headlessEnabled("wos.game.headless.enabled");
+static const cfg::Int headlessFrames("wos.game.headless.frames");
+static const cfg::String headlessOutputPattern("wos.game.headless.output");
+
 static const cfg::Int logConsoleVerbosity("wos.game.debug.logging.console.verbosity");
 static const cfg::Int logFileVerbosity("wos.game.debug.logging.file.verbosity");
 static const cfg::Float logFileFlushInterval("wos.game.debug.logging.file.flushInterval");
@@ -193,9 +198,13 @@ void WOSClient::updateConfig()
 {
 	static cfg::Float framerate("wos.game.framerate");
 	static cfg::Bool textureFiltering("wos.game.graphics.filterTextures");
+	static cfg::Int decodedImageCacheSize("wos.game.graphics.frameStreaming.cacheSize");
 
-	setFramerateLimit(getConfig().get(framerate));
+	// Headless exports render frames back-to-back instead of pacing them
+	setFramerateLimit(headless ? 0 : getConfig().get(framerate));
 	resourceManager->setTextureFilteringEnabled(getConfig().get(textureFiltering));
+	resourceManager->setDecodedImageCacheBudget(
+	    std::max<sf::Int64>(0, getConfig().get(decodedImageCacheSize)) * 1024 * 1024);
 
 	game->getResourceLoader().setAutoReloadCoalescence(app->getCoalescenceSettings());
 }
@@ -225,10 +234,19 @@ void WOSClient::initWindow()
 
 	sf::Vector2f gameSize = getConfig().get(gameSizeCfg);
 
-	gui3::Interface * interface = open();
+	headless = getConfig().get(headlessEnabled);
+
+	gui3::Interface * interface = headless ? openHeadless(sf::Vector2u(gameSize)) : open();
+
+	if (headless)
+	{
+		headlessFrameCount = std::max<sf::Int64>(1, getConfig().get(headlessFrames));
+		headlessOutput = getConfig().get(headlessOutputPattern);
+		logger.info("Running headless, exporting {} frame(s) to '{}'", headlessFrameCount, headlessOutput);
+	}
 
 	std::string iconPath = getConfig().get(iconPathCfg);
-	if (!iconPath.empty())
+	if (!headless && !iconPath.empty())
 	{
 		std::vector<char> iconData;
 		if (app->getResources()->loadResource(iconPath, iconData))
@@ -258,6 +276,11 @@ void WOSClient::initWindow()
 	game = gui3::make<wos::LocalGame>(*app->getResources());
 	game->setCommandLineArguments(this->args);
 
+	if (headless)
+	{
+		headlessWriter = makeUnique<ImageWriter>(game->getThreadPool());
+	}
+
 	fillPanel->add(game);
 
 	game->reset();
@@ -272,6 +295,11 @@ void WOSClient::initWindow()
 	bind(fillPanel->addStateCallback(resizeFunc, gui3::StateEvent::ParentBoundsChanged, -1));
 
 	bind(interface->getRootContainer().addTickCallback([=]() {
+		if (headless)
+		{
+			captureHeadlessFrame(interface);
+		}
+
 		resourceManager->pollChangeEvents();
 		app->tick();
 
@@ -286,6 +314,41 @@ void WOSClient::initWindow()
 	}));
 }
 
+void WOSClient::captureHeadlessFrame(gui3::Interface * interface)
+{
+	// Ticks run before rendering, so each tick after the first one captures the frame displayed by the previous one
+	if (headlessFrameIndex++ == 0 || headlessFrameIndex > headlessFrameCount + 1)
+	{
+		return;
+	}
+
+	std::string fileName;
+	try
+	{
+		fileName = fmt::format(headlessOutput, headlessFrameIndex - 1);
+	}
+	catch (std::exception & e)
+	{
+		logger.error("Invalid headless output pattern '{}': {}", headlessOutput, e.what());
+		invokeLater([this]() {
+			exit();
+		});
+		return;
+	}
+
+	headlessWriter->write(fileName, interface->capture());
+
+	if (headlessFrameIndex > headlessFrameCount)
+	{
+		logger.info("Exported {} frame(s), waiting for {} pending image(s)...", headlessFrameCount,
+		            headlessWriter->getPendingCount());
+
+		invokeLater([this]() {
+			exit();
+		});
+	}
+}
+
 gui3::Interface * WOSClient::makeInterface()
 {
 	return new WOSInterface(this);
@@ -293,6 +356,11 @@ gui3::Interface * WOSClient::makeInterface()
 
 void WOSClient::cleanUpBeforeExit()
 {
+	if (headlessWriter)
+	{
+		headlessWriter->wait();
+	}
+
 	game->finalize();
 
 	for (const auto & removeAction : removeActions)
@@ -5,6 +5,7 @@
 #include <Client/GUI3/ResourceManager.hpp>
 #include <Client/GUI3/Types.hpp>
 #include <Client/Game/LocalGame.hpp>
+#include <Client/Graphics/ImageWriter.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <Shared/System/WOSApplication.hpp>
 #include <Shared/Utils/Debug/Logger.hpp>
@@ -90,6 +91,8 @@ private:
 	void initWhitePixel();
 	void initWindow();
 
+	void captureHeadlessFrame(gui3::Interface * interface);
+
 	void updateConfig();
 
 	virtual gui3::Interface * makeInterface() override;
@@ -127,6 +130,13 @@ private:
 	std::unique_ptr<wos::gog::GogAPI> gogAPI;
 #endif
 
+	// Headless export state
+	bool headless = false;
+	std::size_t headlessFrameCount = 0;
+	std::size_t headlessFrameIndex = 0;
+	std::string headlessOutput;
+	std::unique_ptr<ImageWriter> headlessWriter;
+
 	// Command line arguments
 	std::vector<std::string> args;
 
@@ -231,9 +231,21 @@ WOSResourceManager::AsyncData::AsyncData(std::string name, ThreadPool & threadPo
 	    [this, provider = std::move(provider)]()
 	    {
 		    auto data = provider();
-		    this->data = std::move(data);
-		    this->done = true;
+
+		    std::vector<std::function<void()>> pending;
+		    {
+			    std::lock_guard<std::mutex> lock(mutex);
+			    this->data = std::move(data);
+			    this->done = true;
+			    std::swap(pending, continuations);
+		    }
 		    conVar.notify_all();
+
+		    // Continuations may release the last reference to this object, so it must not be accessed afterwards
+		    for (auto & function : pending)
+		    {
+			    function();
+		    }
 	    });
 }
 
@@ -252,6 +264,17 @@ bool WOSResourceManager::AsyncData::await() const
 	return data != nullptr;
 }
 
+bool WOSResourceManager::AsyncData::runWhenDone(std::function<void()> function) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (done)
+	{
+		return false;
+	}
+	continuations.push_back(std::move(function));
+	return true;
+}
+
 const char * WOSResourceManager::AsyncData::getData() const
 {
 	return await() ? data->data() : nullptr;
@@ -267,6 +290,36 @@ std::size_t WOSResourceManager::AsyncData::getMemoryUsage() const
 	return (done && data != nullptr) ? data->size() : 0;
 }
 
+WOSResourceManager::DecodedImage::DecodedImage(std::string name) :
+	res::Resource(std::move(name)),
+	image(std::make_unique<sf::Image>())
+{
+}
+
+WOSResourceManager::DecodedImage::~DecodedImage()
+{
+}
+
+bool WOSResourceManager::DecodedImage::isDone() const
+{
+	return done;
+}
+
+bool WOSResourceManager::DecodedImage::isValid() const
+{
+	return done && valid;
+}
+
+const sf::Image & WOSResourceManager::DecodedImage::getImage() const
+{
+	return *image;
+}
+
+std::size_t WOSResourceManager::DecodedImage::getMemoryUsage() const
+{
+	return isValid() ? image->getSize().x * image->getSize().y * 4 : 0;
+}
+
 WOSResourceManager::Image::Image(std::string name, TexturePacker::Handle handle, std::size_t page) :
 	gui3::res::Image(std::move(name)),
 	handle(handle),
@@ -513,6 +566,155 @@ void WOSResourceManager::preloadData(std::string resourceName, ThreadPool & thre
 	}
 }
 
+std::shared_ptr<const WOSResourceManager::DecodedImage> WOSResourceManager::decodeImageAsync(std::string imageName,
+                                                                                            ThreadPool & threadPool)
+{
+	imageName = res::normalizeResourceName(imageName);
+
+	auto cached = decodedImageCache.find(imageName);
+	if (cached != decodedImageCache.end())
+	{
+		// Failed decodes are retried, since the file may have been fixed in the meantime
+		if (!cached->second.image->isDone() || cached->second.image->isValid())
+		{
+			decodedImageCacheHits++;
+			decodedImageRecency.splice(decodedImageRecency.begin(), decodedImageRecency, cached->second.recency);
+			return cached->second.image;
+		}
+
+		invalidateDecodedImage(imageName);
+	}
+
+	decodedImageCacheMisses++;
+
+	auto decodedImage = std::make_shared<DecodedImage>(imageName);
+
+	if (decodedImageCacheBudget != 0)
+	{
+		decodedImageRecency.push_front(imageName);
+		decodedImageCache[imageName] = {decodedImage, decodedImageRecency.begin()};
+		enforceDecodedImageCacheBudget();
+	}
+
+	// Reads the file on the thread pool
+	preloadData(imageName, threadPool);
+	auto imageData = acquireData(imageName);
+
+	if (!imageData)
+	{
+		decodedImage->done = true;
+		return decodedImage;
+	}
+
+	auto decode = [decodedImage, imageData, loadCounter = asyncLoadCounter]()
+	{
+		decodedImage->valid =
+		    loadImage((const sf::Uint8 *) imageData->getData(), imageData->getDataSize(), *decodedImage->image);
+		decodedImage->done = true;
+	};
+
+	// Decoding is chained to the read instead of occupying a pool thread that waits for the data
+	auto asyncData = std::dynamic_pointer_cast<const AsyncData>(imageData);
+	if (!asyncData || !asyncData->runWhenDone(decode))
+	{
+		threadPool.submit(decode);
+	}
+
+	return decodedImage;
+}
+
+void WOSResourceManager::setDecodedImageCacheBudget(std::size_t budget)
+{
+	decodedImageCacheBudget = budget;
+
+	if (budget == 0)
+	{
+		decodedImageCache.clear();
+		decodedImageRecency.clear();
+	}
+	else
+	{
+		enforceDecodedImageCacheBudget();
+	}
+}
+
+std::size_t WOSResourceManager::getDecodedImageCacheBudget() const
+{
+	return decodedImageCacheBudget;
+}
+
+std::size_t WOSResourceManager::getDecodedImageCacheHits() const
+{
+	return decodedImageCacheHits;
+}
+
+std::size_t WOSResourceManager::getDecodedImageCacheMisses() const
+{
+	return decodedImageCacheMisses;
+}
+
+std::size_t WOSResourceManager::getDecodedImageCacheEvictions() const
+{
+	return decodedImageCacheEvictions;
+}
+
+std::size_t WOSResourceManager::getDecodedImageCacheMemoryUsage() const
+{
+	std::size_t total = 0;
+	for (const auto & entry : decodedImageCache)
+	{
+		total += entry.second.image->getMemoryUsage();
+	}
+	return total;
+}
+
+void WOSResourceManager::enforceDecodedImageCacheBudget()
+{
+	std::size_t usage = getDecodedImageCacheMemoryUsage();
+
+	// Images that are still being decoded do not occupy any memory yet and are skipped
+	auto it = decodedImageRecency.end();
+	while (usage > decodedImageCacheBudget && it != decodedImageRecency.begin())
+	{
+		--it;
+
+		auto entry = decodedImageCache.find(*it);
+		if (entry != decodedImageCache.end() && entry->second.image->isDone())
+		{
+			usage -= entry->second.image->getMemoryUsage();
+			decodedImageCache.erase(entry);
+			it = decodedImageRecency.erase(it);
+			decodedImageCacheEvictions++;
+		}
+	}
+}
+
+void WOSResourceManager::invalidateDecodedImage(const std::string & imageName)
+{
+	auto it = decodedImageCache.find(imageName);
+	if (it != decodedImageCache.end())
+	{
+		decodedImageRecency.erase(it->second.recency);
+		decodedImageCache.erase(it);
+	}
+}
+
+void WOSResourceManager::invalidateDecodedImages(const std::string & prefix)
+{
+	for (auto it = decodedImageRecency.begin(); it != decodedImageRecency.end();)
+	{
+		if (stringStartsWith(*it, prefix))
+		{
+			decodedImageCache.erase(*it);
+			it = decodedImageRecency.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
+
 int WOSResourceManager::getPendingAsyncLoads() const
 {
 	return asyncLoadCounter.use_count() - 1;
@@ -524,6 +726,8 @@ void WOSResourceManager::pollChangeEvents()
 	{
 		source->pollChanges();
 	}
+	// Decodes finishing in the background may push the cache past its budget
+	enforceDecodedImageCacheBudget();
 }
 
 void WOSResourceManager::cleanUpBeforeExit()
@@ -533,6 +737,9 @@ void WOSResourceManager::cleanUpBeforeExit()
 	fonts.invalidateResources();
 	images.invalidateResources();
 	datas.invalidateResources();
+
+	decodedImageCache.clear();
+	decodedImageRecency.clear();
 }
 
 std::size_t WOSResourceManager::getDataMemoryUsage() const
@@ -659,6 +866,7 @@ void WOSResourceManager::handleSingleFileEvent(res::ResourceEvent event)
 	fonts.invalidateResource(event.resourceName);
 	images.invalidateResource(event.resourceName);
 	datas.invalidateResource(event.resourceName);
+	invalidateDecodedImage(event.resourceName);
 
 	auto foundCallback = callbacks.find(event.resourceName);
 	if (foundCallback != callbacks.end())
@@ -698,6 +906,7 @@ void WOSResourceManager::handleAllFilesEvent(res::ResourceEvent event)
 	fonts.invalidateResources(event.resourceName);
 	images.invalidateResources(event.resourceName);
 	datas.invalidateResources(event.resourceName);
+	invalidateDecodedImages(event.resourceName);
 
 	for (auto & callback : callbacks)
 	{
@@ -15,6 +15,7 @@
 #include <condition_variable>
 #include <cstddef>
 #include <functional>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -50,6 +51,40 @@ public:
 
 	using TextureAllocator = std::function<TextureAllocation(const std::string & name, const sf::Image & image)>;
 
+	/**
+	 * Image whose pixels are decoded into memory in the background, without being uploaded to a texture.
+	 */
+	class DecodedImage : public res::Resource
+	{
+	public:
+		DecodedImage(std::string name);
+		virtual ~DecodedImage();
+
+		/**
+		 * Returns true once decoding has finished, regardless of whether it was successful.
+		 */
+		bool isDone() const;
+
+		/**
+		 * Returns true if decoding has finished successfully.
+		 */
+		bool isValid() const;
+
+		/**
+		 * Returns the decoded image. Only safe to call once isValid() returns true.
+		 */
+		const sf::Image & getImage() const;
+
+		std::size_t getMemoryUsage() const override;
+
+	private:
+		std::unique_ptr<sf::Image> image;
+		std::atomic_bool done = ATOMIC_VAR_INIT(false);
+		std::atomic_bool valid = ATOMIC_VAR_INIT(false);
+
+		friend class WOSResourceManager;
+	};
+
 	WOSResourceManager();
 	virtual ~WOSResourceManager();
 
@@ -135,6 +170,41 @@ public:
 	 */
 	void preloadData(std::string resourceName, ThreadPool & threadPool);
 
+	/**
+	 * Asynchronously loads and decodes an image in the background. The returned handle can be polled for completion.
+	 *
+	 * Decoded images are kept in a least-recently-used cache, so requesting the same image again returns the existing
+	 * handle without reading or decoding the file a second time.
+	 */
+	std::shared_ptr<const DecodedImage> decodeImageAsync(std::string imageName, ThreadPool & threadPool);
+
+	/**
+	 * Specifies the maximum number of bytes occupied by decoded images in the cache. Least recently used images are
+	 * evicted once the budget is exceeded. A budget of 0 disables caching.
+	 */
+	void setDecodedImageCacheBudget(std::size_t budget);
+	std::size_t getDecodedImageCacheBudget() const;
+
+	/**
+	 * Returns the number of decoded images that were served from the cache.
+	 */
+	std::size_t getDecodedImageCacheHits() const;
+
+	/**
+	 * Returns the number of decoded images that had to be loaded from their source.
+	 */
+	std::size_t getDecodedImageCacheMisses() const;
+
+	/**
+	 * Returns the number of decoded images that were evicted to stay within the budget.
+	 */
+	std::size_t getDecodedImageCacheEvictions() const;
+
+	/**
+	 * Returns the total memory usage of decoded images inside the cache.
+	 */
+	std::size_t getDecodedImageCacheMemoryUsage() const;
+
 	/**
 	 * Returns how many asynchronous loads are currently being performed.
 	 */
@@ -191,11 +261,18 @@ private:
 
 		bool await() const;
 
+		/**
+		 * Queues a function to run on the loading thread as soon as the data is available, without blocking another
+		 * thread until then. Returns false without queueing the function if the data is already available.
+		 */
+		bool runWhenDone(std::function<void()> function) const;
+
 	private:
 		std::unique_ptr<std::vector<char>> data;
 		std::atomic_bool done = ATOMIC_VAR_INIT(false);
 		mutable std::mutex mutex;
 		mutable std::condition_variable conVar;
+		mutable std::vector<std::function<void()>> continuations;
 	};
 
 	class Image : public gui3::res::Image
@@ -265,6 +342,10 @@ private:
 
 	gui3::Ptr<WOSResourceManager::Image> addImageResource(std::string imageName, const sf::Image & image);
 
+	void enforceDecodedImageCacheBudget();
+	void invalidateDecodedImage(const std::string & imageName);
+	void invalidateDecodedImages(const std::string & prefix);
+
 	void handleResourceEvent(res::ResourceEvent event);
 	void handleSingleFileEvent(res::ResourceEvent event);
 	void handleAllFilesEvent(res::ResourceEvent event);
@@ -283,6 +364,20 @@ private:
 
 	std::shared_ptr<int> asyncLoadCounter;
 
+	struct DecodedImageCacheEntry
+	{
+		std::shared_ptr<DecodedImage> image;
+		std::list<std::string>::iterator recency;
+	};
+
+	// Most recently used image names first
+	std::list<std::string> decodedImageRecency;
+	HashMap<std::string, DecodedImageCacheEntry> decodedImageCache;
+	std::size_t decodedImageCacheBudget = 0;
+	std::size_t decodedImageCacheHits = 0;
+	std::size_t decodedImageCacheMisses = 0;
+	std::size_t decodedImageCacheEvictions = 0;
+
 	TextureAllocator textureAllocator;
 
 	struct TexturePage
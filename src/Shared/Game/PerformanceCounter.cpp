@@ -71,6 +71,26 @@ sf::Time PerformanceCounter::getTargetTime() const
 	return targetTime;
 }
 
+void PerformanceCounter::setLayoutIterationRate(double rate)
+{
+	layoutIterationRate = rate;
+}
+
+double PerformanceCounter::getLayoutIterationRate() const
+{
+	return layoutIterationRate;
+}
+
+void PerformanceCounter::setLayoutSwinging(double swinging)
+{
+	layoutSwinging = swinging;
+}
+
+double PerformanceCounter::getLayoutSwinging() const
+{
+	return layoutSwinging;
+}
+
 void PerformanceCounter::registerMemoryUsageProvider(std::string name, MemoryUsageProvider provider)
 {
 	memoryUsageProviders.emplace(name, provider);
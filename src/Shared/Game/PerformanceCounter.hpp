@@ -44,6 +44,12 @@ public:
 	void setTargetTime(sf::Time time);
 	sf::Time getTargetTime() const;
 
+	void setLayoutIterationRate(double rate);
+	double getLayoutIterationRate() const;
+
+	void setLayoutSwinging(double swinging);
+	double getLayoutSwinging() const;
+
 	void registerMemoryUsageProvider(std::string name, MemoryUsageProvider provider);
 	void unregisterMemoryUsageProvider(std::string name);
 	std::vector<MemoryUsageEntry> getMemoryUsage(const std::string & name, std::size_t numberOfEntries) const;
@@ -55,6 +61,8 @@ private:
 	sf::Time sleepTime;
 	sf::Time totalFrameTime;
 	sf::Time targetTime;
+	double layoutIterationRate = 0;
+	double layoutSwinging = 0;
 	HashMap<std::string, MemoryUsageProvider> memoryUsageProviders;
 };
 
@@ -101,6 +101,14 @@ const std::vector<std::shared_ptr<lua::AbstractBridge>> & ScriptManager::getBrid
 	return bridges;
 }
 
+void ScriptManager::unloadBridges()
+{
+	for (const auto & bridge : bridges)
+	{
+		bridge->unload();
+	}
+}
+
 sol::function ScriptManager::loadScript(std::string script)
 {
 	if (script.find('/') != std::string::npos)
@@ -50,6 +50,7 @@ public:
 
 	void setBridges(std::vector<std::shared_ptr<lua::AbstractBridge>> bridges);
 	const std::vector<std::shared_ptr<lua::AbstractBridge>> & getBridges() const;
+	void unloadBridges();
 
 	sol::function loadScript(std::string script);
 	bool scriptExists(const std::string & scriptName) const;
@@ -0,0 +1,274 @@
+#include <Shared/Game/ScriptWorkerPool.hpp>
+#include <Shared/Lua/LuaManager.hpp>
+#include <Shared/Utils/Debug/Logger.hpp>
+#include <Shared/Utils/Error.hpp>
+#include <algorithm>
+
+namespace wos
+{
+
+ScriptWorkerPool::ScriptWorkerPool()
+{
+	interrupted = false;
+}
+
+ScriptWorkerPool::~ScriptWorkerPool()
+{
+	stop();
+}
+
+void ScriptWorkerPool::start(std::string scriptSource, std::size_t workerCount)
+{
+	stop();
+
+	if (workerCount == 0)
+	{
+		workerCount = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+	}
+
+	interrupted = false;
+	error.clear();
+	runningWorkers = workerCount;
+
+	for (std::size_t i = 0; i < workerCount; ++i)
+	{
+		workerThreads.emplace_back([=]() {
+			runWorker(i, workerCount, scriptSource);
+		});
+	}
+}
+
+void ScriptWorkerPool::stop()
+{
+	interrupted = true;
+	condition.notify_all();
+
+	for (auto & thread : workerThreads)
+	{
+		thread.join();
+	}
+	workerThreads.clear();
+
+	std::unique_lock<std::mutex> lock(mutex);
+	runningWorkers = 0;
+	failQueuedJobs("Worker pool was stopped");
+}
+
+std::size_t ScriptWorkerPool::getWorkerCount() const
+{
+	return workerThreads.size();
+}
+
+std::string ScriptWorkerPool::getError() const
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	return error;
+}
+
+ScriptWorkerPool::JobID ScriptWorkerPool::submit(std::vector<Job> batch)
+{
+	JobID firstJobID;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		if (hasConflictingRegions(batch))
+		{
+			return 0;
+		}
+
+		firstJobID = nextJobID;
+		for (auto & job : batch)
+		{
+			QueuedJob queuedJob;
+			queuedJob.id = nextJobID++;
+			if (!job.regions.empty())
+			{
+				regionsInUse[queuedJob.id] = job.regions;
+			}
+			queuedJob.job = std::move(job);
+			jobs.push_back(std::move(queuedJob));
+		}
+		pendingJobs += batch.size();
+
+		if (runningWorkers == 0)
+		{
+			failQueuedJobs(error.empty() ? "Worker pool is not running" : error);
+		}
+	}
+	condition.notify_all();
+	return firstJobID;
+}
+
+std::size_t ScriptWorkerPool::getPendingJobCount() const
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	return pendingJobs;
+}
+
+std::vector<ScriptWorkerPool::Result> ScriptWorkerPool::takeResults()
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	std::vector<Result> takenResults;
+	takenResults.swap(results);
+	for (const auto & result : takenResults)
+	{
+		regionsInUse.erase(result.job);
+	}
+	return takenResults;
+}
+
+void ScriptWorkerPool::runWorker(std::size_t workerIndex, std::size_t workerCount, std::string scriptSource)
+{
+	try
+	{
+		lua::LuaManager luaManager;
+		luaManager.loadBaseLibraries();
+		luaManager.setGlobal("worker.index", int(workerIndex));
+		luaManager.setGlobal("worker.count", int(workerCount));
+
+		auto script = luaManager.loadScript(scriptSource.data(), scriptSource.size(), "Worker");
+		sol::object jobFunction = luaManager.execute(script);
+		if (jobFunction.get_type() != sol::type::function)
+		{
+			throw Error("Worker script did not return a job function");
+		}
+
+		sol::protected_function process = jobFunction;
+		sol::state & lua = luaManager.getState();
+
+		while (true)
+		{
+			QueuedJob queuedJob;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				condition.wait(lock, [this]() {
+					return interrupted || !jobs.empty();
+				});
+				if (interrupted)
+				{
+					break;
+				}
+				queuedJob = std::move(jobs.front());
+				jobs.pop_front();
+			}
+
+			Result result;
+			result.job = queuedJob.id;
+			result.waitTime = queuedJob.queueClock.getElapsedTime();
+
+			sf::Clock runClock;
+
+			// The job was already taken off the queue, so it must produce a result even if the call itself throws
+			try
+			{
+				auto regions = lua.create_table(int(queuedJob.job.regions.size()), 0);
+				for (const auto & region : queuedJob.job.regions)
+				{
+					regions.add(lua.create_table_with(                    //
+					    "pointer", sol::lightuserdata_value(region.data), //
+					    "size", double(region.size),                      //
+					    "writable", region.writable));
+				}
+
+				sol::protected_function_result callResult = process(queuedJob.job.input, regions);
+				if (callResult.valid())
+				{
+					sol::object output = callResult;
+					result.success = true;
+					result.output = output.get_type() == sol::type::string ? output.as<std::string>() : "";
+				}
+				else
+				{
+					sol::error callError = callResult;
+					result.output = callError.what();
+				}
+			}
+			catch (std::exception & ex)
+			{
+				result.success = false;
+				result.output = ex.what();
+			}
+			catch (...)
+			{
+				result.success = false;
+				result.output = "Unknown error in job function";
+			}
+
+			result.runTime = runClock.getElapsedTime();
+
+			std::unique_lock<std::mutex> lock(mutex);
+			results.push_back(std::move(result));
+			pendingJobs--;
+		}
+	}
+	catch (std::exception & ex)
+	{
+		Logger logger("WorkerPool");
+		logger.error("Error in Lua worker thread: {}", ex.what());
+
+		std::unique_lock<std::mutex> lock(mutex);
+		error = ex.what();
+
+		// Jobs would otherwise remain queued forever
+		if (--runningWorkers == 0)
+		{
+			failQueuedJobs(error);
+		}
+	}
+}
+
+void ScriptWorkerPool::failQueuedJobs(const std::string & message)
+{
+	for (auto & queuedJob : jobs)
+	{
+		Result result;
+		result.job = queuedJob.id;
+		result.output = message;
+		results.push_back(std::move(result));
+	}
+	pendingJobs -= jobs.size();
+	jobs.clear();
+}
+
+bool ScriptWorkerPool::hasConflictingRegions(const std::vector<Job> & batch) const
+{
+	auto conflicts = [](const Region & a, const Region & b) {
+		auto aBegin = static_cast<const char *>(a.data);
+		auto bBegin = static_cast<const char *>(b.data);
+		return (a.writable || b.writable) && a.size > 0 && b.size > 0 && aBegin < bBegin + b.size &&
+		       bBegin < aBegin + a.size;
+	};
+
+	for (std::size_t i = 0; i < batch.size(); ++i)
+	{
+		for (std::size_t j = 0; j < batch[i].regions.size(); ++j)
+		{
+			const Region & region = batch[i].regions[j];
+
+			for (const auto & entry : regionsInUse)
+			{
+				for (const auto & other : entry.second)
+				{
+					if (conflicts(region, other))
+					{
+						return true;
+					}
+				}
+			}
+
+			// Regions of the same job conflict as well, since the job function may write them in any order
+			for (std::size_t k = i; k < batch.size(); ++k)
+			{
+				for (std::size_t l = k == i ? j + 1 : 0; l < batch[k].regions.size(); ++l)
+				{
+					if (conflicts(region, batch[k].regions[l]))
+					{
+						return true;
+					}
+				}
+			}
+		}
+	}
+	return false;
+}
+
+}
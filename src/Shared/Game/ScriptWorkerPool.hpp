@@ -0,0 +1,128 @@
+#ifndef SRC_SHARED_GAME_SCRIPTWORKERPOOL_HPP_
+#define SRC_SHARED_GAME_SCRIPTWORKERPOOL_HPP_
+
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace wos
+{
+
+/**
+ * Runs the same script in several isolated Lua states, each on a dedicated thread, and distributes jobs among them.
+ *
+ * The script is executed once per worker and must return the job function, which is called as
+ * 'function(input, regions)' and returns an optional output string. Jobs can pass memory regions (such as native
+ * arrays) to the job function without copying; they are exposed as tables {pointer = lightuserdata, size = bytes,
+ * writable = bool} for use via the FFI. The submitter must keep the regions alive until the job's result was taken,
+ * and job functions must not retain them beyond the call.
+ */
+class ScriptWorkerPool
+{
+public:
+	using JobID = int;
+
+	struct Region
+	{
+		void * data = nullptr;
+		std::size_t size = 0;
+
+		// Read-only regions may be shared by any number of jobs; writable regions must not overlap other regions of
+		// jobs in flight
+		bool writable = false;
+	};
+
+	struct Job
+	{
+		std::string input;
+		std::vector<Region> regions;
+	};
+
+	struct Result
+	{
+		JobID job = 0;
+		bool success = false;
+
+		// Output string of the job function, or the error message if the job failed
+		std::string output;
+
+		// Time between submission and the start of the job, and time taken by the job function
+		sf::Time waitTime;
+		sf::Time runTime;
+	};
+
+	ScriptWorkerPool();
+	~ScriptWorkerPool();
+
+	/**
+	 * Starts 'workerCount' workers running the script (or one per hardware thread if 0). Restarts running workers.
+	 */
+	void start(std::string scriptSource, std::size_t workerCount);
+	void stop();
+
+	std::size_t getWorkerCount() const;
+
+	/**
+	 * Returns the message of the last error that occurred while starting a worker, or an empty string.
+	 */
+	std::string getError() const;
+
+	/**
+	 * Queues the jobs at once and returns the ID of the first one. Subsequent jobs have consecutive IDs.
+	 *
+	 * Returns 0 without queueing any job if a writable region overlaps another region of the batch or of a job whose
+	 * result was not taken yet.
+	 */
+	JobID submit(std::vector<Job> batch);
+
+	std::size_t getPendingJobCount() const;
+
+	/**
+	 * Returns the results of all jobs finished since the last call, in order of completion.
+	 */
+	std::vector<Result> takeResults();
+
+private:
+	struct QueuedJob
+	{
+		JobID id = 0;
+		Job job;
+		sf::Clock queueClock;
+	};
+
+	void runWorker(std::size_t workerIndex, std::size_t workerCount, std::string scriptSource);
+
+	// Fails all queued jobs; called when no worker is left to process them
+	void failQueuedJobs(const std::string & message);
+
+	// Returns true if any of the regions conflicts with another one of the batch or with a region still in use
+	bool hasConflictingRegions(const std::vector<Job> & batch) const;
+
+	std::vector<std::thread> workerThreads;
+	std::size_t runningWorkers = 0;
+	std::atomic_bool interrupted;
+
+	std::deque<QueuedJob> jobs;
+	std::vector<Result> results;
+
+	// Regions of submitted jobs, until their results are taken
+	std::map<JobID, std::vector<Region>> regionsInUse;
+	std::size_t pendingJobs = 0;
+	JobID nextJobID = 1;
+	std::string error;
+
+	mutable std::mutex mutex;
+	std::condition_variable condition;
+};
+
+}
+
+#endif
@@ -0,0 +1,490 @@
+#include <Shared/Lua/Bindings/Accel/FlowGraphExtractor.hpp>
+#include <Shared/Utils/HashTable.hpp>
+#include <Shared/Utils/ThreadPool.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <memory>
+#include <utility>
+
+namespace wosc
+{
+
+// Each frame in flight holds a label per pixel, so batches are kept small for high-resolution sequences
+static constexpr std::size_t maxBatchFrames = 8;
+
+namespace
+{
+
+struct LabelledFrame
+{
+	struct Component
+	{
+		std::size_t area = 0;
+		double sumX = 0;
+		double sumY = 0;
+
+		// Inclusive pixel bounds
+		unsigned int minX = 0;
+		unsigned int minY = 0;
+		unsigned int maxX = 0;
+		unsigned int maxY = 0;
+
+		std::size_t fluidInterface = 0;
+		std::size_t solidInterface = 0;
+
+		// Index of the component's node, or -1 for components below the minimum area
+		std::int32_t node = -1;
+	};
+
+	struct Overlap
+	{
+		std::int32_t previous = 0;
+		std::int32_t current = 0;
+		std::size_t pixels = 0;
+	};
+
+	unsigned int width = 0;
+	unsigned int height = 0;
+
+	// One-based component index per pixel, or 0 for pixels that are not invading fluid
+	std::vector<std::int32_t> labels;
+	std::vector<Component> components;
+
+	// Shared pixels with components of the previous frame, sorted by previous and current component index
+	std::vector<Overlap> overlaps;
+	std::size_t invadedPixels = 0;
+
+	std::string error;
+};
+
+}
+
+struct FlowGraphExtractor::State : FrameSequenceJob::State
+{
+	virtual std::size_t getBatchSize(const ThreadPool & threadPool) const override;
+	virtual std::string processBatch(std::size_t firstFrame, std::size_t frameCount, ThreadPool & threadPool) override;
+	virtual void complete() override;
+
+	Settings settings;
+	std::array<PixelClass, 256> pixelClasses;
+
+	// Only accessed by the batch currently running
+	LabelledFrame previous;
+	Result partialResult;
+
+	// Guarded by the mutex
+	Result result;
+};
+
+// Two-pass connected component labelling of the invading fluid, collecting the component statistics in the second pass
+static void labelFrame(const FlowGraphExtractor::Frame & frame, const std::array<PixelClass, 256> & pixelClasses,
+                       bool diagonal, std::vector<std::int32_t> & labels, std::vector<std::int32_t> & parents,
+                       std::vector<LabelledFrame::Component> & components)
+{
+	const unsigned int width = frame.width;
+	const unsigned int height = frame.height;
+	const std::uint8_t * pixels = frame.pixels.data();
+
+	auto isFluid = [&](std::size_t index) {
+		return pixelClasses[pixels[index]] == PixelClass::InvadingFluid;
+	};
+
+	auto find = [&](std::int32_t label) {
+		while (parents[label] != label)
+		{
+			parents[label] = parents[parents[label]];
+			label = parents[label];
+		}
+		return label;
+	};
+
+	auto join = [&](std::int32_t first, std::int32_t second) {
+		first = find(first);
+		second = find(second);
+		if (first < second)
+		{
+			parents[second] = first;
+			return first;
+		}
+		parents[first] = second;
+		return second;
+	};
+
+	labels.assign(std::size_t(width) * height, 0);
+	parents.assign(1, 0);
+
+	for (unsigned int y = 0; y < height; ++y)
+	{
+		std::size_t rowStart = std::size_t(y) * width;
+		for (unsigned int x = 0; x < width; ++x)
+		{
+			std::size_t index = rowStart + x;
+			if (!isFluid(index))
+			{
+				continue;
+			}
+
+			std::int32_t label = 0;
+			auto connect = [&](std::int32_t neighbour) {
+				if (neighbour != 0)
+				{
+					label = label == 0 ? neighbour : join(label, neighbour);
+				}
+			};
+
+			if (x > 0)
+			{
+				connect(labels[index - 1]);
+			}
+			if (y > 0)
+			{
+				connect(labels[index - width]);
+				if (diagonal && x > 0)
+				{
+					connect(labels[index - width - 1]);
+				}
+				if (diagonal && x + 1 < width)
+				{
+					connect(labels[index - width + 1]);
+				}
+			}
+
+			if (label == 0)
+			{
+				label = std::int32_t(parents.size());
+				parents.push_back(label);
+			}
+			labels[index] = label;
+		}
+	}
+
+	// Component indices are assigned in order of the first pixel, so they are deterministic
+	std::vector<std::int32_t> componentLabels(parents.size(), 0);
+	components.clear();
+
+	for (unsigned int y = 0; y < height; ++y)
+	{
+		std::size_t rowStart = std::size_t(y) * width;
+		for (unsigned int x = 0; x < width; ++x)
+		{
+			std::size_t index = rowStart + x;
+			if (labels[index] == 0)
+			{
+				continue;
+			}
+
+			std::int32_t root = find(labels[index]);
+			if (componentLabels[root] == 0)
+			{
+				LabelledFrame::Component component;
+				component.minX = component.maxX = x;
+				component.minY = component.maxY = y;
+				components.push_back(component);
+				componentLabels[root] = std::int32_t(components.size());
+			}
+			labels[index] = componentLabels[root];
+
+			auto & component = components[componentLabels[root] - 1];
+			component.area++;
+			component.sumX += x;
+			component.sumY += y;
+			component.minX = std::min(component.minX, x);
+			component.maxX = std::max(component.maxX, x);
+			component.maxY = y;
+
+			auto countInterface = [&](std::size_t neighbour) {
+				switch (pixelClasses[pixels[neighbour]])
+				{
+				case PixelClass::DefendingFluid:
+					component.fluidInterface++;
+					break;
+				case PixelClass::Solid:
+					component.solidInterface++;
+					break;
+				default:
+					break;
+				}
+			};
+
+			if (x > 0)
+			{
+				countInterface(index - 1);
+			}
+			if (x + 1 < width)
+			{
+				countInterface(index + 1);
+			}
+			if (y > 0)
+			{
+				countInterface(index - width);
+			}
+			if (y + 1 < height)
+			{
+				countInterface(index + width);
+			}
+		}
+	}
+}
+
+// Counts the pixels shared by each pair of components of consecutive frames, and the newly invaded pixels
+static void trackFrame(const LabelledFrame & previous, LabelledFrame & current)
+{
+	using Overlap = LabelledFrame::Overlap;
+
+	current.overlaps.clear();
+	current.invadedPixels = 0;
+
+	// The first frame has no predecessor to compare with, so all of its fluid counts as newly invaded
+	if (previous.labels.empty())
+	{
+		current.invadedPixels = current.labels.size() - std::count(current.labels.begin(), current.labels.end(), 0);
+		return;
+	}
+
+	HashMap<std::uint64_t, std::size_t> pixelCounts;
+	std::uint64_t runKey = 0;
+	std::size_t runLength = 0;
+
+	// Overlapping components mostly cover contiguous pixel runs, so runs are counted before touching the map
+	for (std::size_t i = 0; i < current.labels.size(); ++i)
+	{
+		std::int32_t label = current.labels[i];
+		if (label == 0)
+		{
+			continue;
+		}
+
+		std::int32_t previousLabel = previous.labels[i];
+		if (previousLabel == 0)
+		{
+			current.invadedPixels++;
+			continue;
+		}
+
+		std::uint64_t key = std::uint64_t(previousLabel) << 32 | std::uint32_t(label);
+		if (key != runKey)
+		{
+			if (runLength > 0)
+			{
+				pixelCounts[runKey] += runLength;
+			}
+			runKey = key;
+			runLength = 0;
+		}
+		runLength++;
+	}
+
+	if (runLength > 0)
+	{
+		pixelCounts[runKey] += runLength;
+	}
+
+	current.overlaps.reserve(pixelCounts.size());
+	for (const auto & entry : pixelCounts)
+	{
+		Overlap overlap;
+		overlap.previous = std::int32_t(entry.first >> 32) - 1;
+		overlap.current = std::int32_t(entry.first & 0xFFFFFFFF) - 1;
+		overlap.pixels = entry.second;
+		current.overlaps.push_back(overlap);
+	}
+
+	std::sort(current.overlaps.begin(), current.overlaps.end(), [](const Overlap & a, const Overlap & b) {
+		return a.previous != b.previous ? a.previous < b.previous : a.current < b.current;
+	});
+}
+
+// Adds the nodes of the frame and the edges from the previous frame's nodes to the result
+static void appendFrame(const LabelledFrame & previous, LabelledFrame & current,
+                        std::int32_t time, const FlowGraphExtractor::Settings & settings,
+                        FlowGraphExtractor::Result & result)
+{
+	for (auto & component : current.components)
+	{
+		if (component.area < settings.minArea)
+		{
+			continue;
+		}
+
+		component.node = std::int32_t(result.nodes.size());
+
+		FlowGraphExtractor::Node node;
+		node.time = time;
+		node.x = component.sumX / component.area;
+		node.y = component.sumY / component.area;
+		node.area = component.area;
+		node.left = component.minX;
+		node.top = component.minY;
+		node.right = component.maxX + 1;
+		node.bottom = component.maxY + 1;
+		node.fluidInterface = component.fluidInterface;
+		node.solidInterface = component.solidInterface;
+		result.nodes.push_back(node);
+
+		if (result.endTime < 0)
+		{
+			result.startTime = time;
+		}
+		result.endTime = time;
+
+		if (result.breakthroughTime < 0 && component.minX == 0 && component.maxX + 1 == current.width)
+		{
+			result.breakthroughTime = time;
+		}
+	}
+
+	result.invadedPixels.push_back(current.invadedPixels);
+
+	// The predecessor sharing the most pixels determines the node's velocity
+	std::vector<std::size_t> predecessorOverlaps(current.components.size(), 0);
+
+	for (const auto & overlap : current.overlaps)
+	{
+		std::int32_t source = previous.components[overlap.previous].node;
+		std::int32_t target = current.components[overlap.current].node;
+		if (source < 0 || target < 0 || overlap.pixels < settings.minOverlap)
+		{
+			continue;
+		}
+
+		result.edges.push_back(source);
+		result.edges.push_back(target);
+
+		auto & sourceNode = result.nodes[source];
+		auto & targetNode = result.nodes[target];
+		sourceNode.edgesOut++;
+		targetNode.edgesIn++;
+
+		if (overlap.pixels > predecessorOverlaps[overlap.current])
+		{
+			predecessorOverlaps[overlap.current] = overlap.pixels;
+			targetNode.velocity = std::hypot(targetNode.x - sourceNode.x, targetNode.y - sourceNode.y);
+		}
+	}
+}
+
+std::size_t FlowGraphExtractor::State::getBatchSize(const ThreadPool & threadPool) const
+{
+	return std::min(threadPool.getThreadCount(), maxBatchFrames);
+}
+
+std::string FlowGraphExtractor::State::processBatch(std::size_t firstFrame, std::size_t frameCount,
+                                                     ThreadPool & threadPool)
+{
+	std::vector<LabelledFrame> frames(frameCount);
+
+	threadPool.parallelFor(frameCount, 1, [&](std::size_t begin, std::size_t end) {
+		Frame frame;
+		std::vector<std::int32_t> parents;
+		for (std::size_t i = begin; i < end && running; ++i)
+		{
+			const std::string & path = framePaths[firstFrame + i];
+			auto & labelled = frames[i];
+
+			if (!loader(path, frame))
+			{
+				labelled.error = "Failed to load frame: " + path;
+				continue;
+			}
+			if (frame.pixels.size() != std::size_t(frame.width) * frame.height)
+			{
+				labelled.error = "Invalid frame data: " + path;
+				continue;
+			}
+
+			labelled.width = frame.width;
+			labelled.height = frame.height;
+			labelFrame(frame, pixelClasses, settings.diagonal, labelled.labels, parents, labelled.components);
+		}
+	});
+
+	// Frames skipped after stopping are incomplete
+	if (!running)
+	{
+		return "";
+	}
+
+	for (std::size_t i = 0; i < frameCount; ++i)
+	{
+		const auto & previousFrame = i == 0 ? previous : frames[i - 1];
+		if (!frames[i].error.empty())
+		{
+			return frames[i].error;
+		}
+		if (!previousFrame.labels.empty() &&
+		    (frames[i].width != previousFrame.width || frames[i].height != previousFrame.height))
+		{
+			return "Frame size differs from previous frames: " + framePaths[firstFrame + i];
+		}
+	}
+
+	threadPool.parallelFor(frameCount, 1, [&](std::size_t begin, std::size_t end) {
+		for (std::size_t i = begin; i < end; ++i)
+		{
+			trackFrame(i == 0 ? previous : frames[i - 1], frames[i]);
+		}
+	});
+
+	for (std::size_t i = 0; i < frameCount; ++i)
+	{
+		partialResult.width = frames[i].width;
+		partialResult.height = frames[i].height;
+		appendFrame(i == 0 ? previous : frames[i - 1], frames[i], std::int32_t(firstFrame + i), settings,
+		            partialResult);
+	}
+
+	if (frameCount > 0)
+	{
+		previous = std::move(frames.back());
+	}
+	return "";
+}
+
+void FlowGraphExtractor::State::complete()
+{
+	result = std::move(partialResult);
+}
+
+FlowGraphExtractor::FlowGraphExtractor(ThreadPool & threadPool) :
+	FrameSequenceJob(threadPool)
+{
+}
+
+FlowGraphExtractor::~FlowGraphExtractor()
+{
+}
+
+void FlowGraphExtractor::start(std::vector<std::string> framePaths, Settings settings, FrameLoader loader)
+{
+	auto state = std::make_shared<State>();
+	state->framePaths = std::move(framePaths);
+	state->loader = std::move(loader);
+	state->settings = settings;
+	for (unsigned int value = 0; value < 256; ++value)
+	{
+		state->pixelClasses[value] = settings.classify(std::uint8_t(value));
+	}
+	FrameSequenceJob::start(std::move(state));
+}
+
+bool FlowGraphExtractor::takeResult(Result & result)
+{
+	auto state = getState<State>();
+	if (!state)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(state->mutex);
+	if (!state->done || !state->error.empty())
+	{
+		return false;
+	}
+
+	result = std::move(state->result);
+	state->result = Result();
+	return true;
+}
+
+}
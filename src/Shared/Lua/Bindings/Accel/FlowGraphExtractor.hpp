@@ -0,0 +1,105 @@
+#ifndef SRC_SHARED_LUA_BINDINGS_ACCEL_FLOWGRAPHEXTRACTOR_HPP_
+#define SRC_SHARED_LUA_BINDINGS_ACCEL_FLOWGRAPHEXTRACTOR_HPP_
+
+#include <Shared/Lua/Bindings/Accel/FrameSequenceJob.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace wosc
+{
+
+/**
+ * Builds a flow graph from a sequence of segmented grayscale frames, as otherwise produced offline for graph files.
+ *
+ * Each frame is classified by gray level into invading fluid, solid and defending fluid. The connected components of
+ * the invading fluid become the nodes of the frame, and components of consecutive frames that overlap by enough
+ * pixels are connected by edges, so that splits and merges show up as nodes with several outgoing or incoming edges.
+ *
+ * Frames are decoded and labelled in parallel in batches on the thread pool. Only the labels of the last frame are
+ * kept between batches, so long sequences are processed in bounded memory.
+ */
+class FlowGraphExtractor : public FrameSequenceJob
+{
+public:
+	struct Settings : FrameSegmentation
+	{
+		// Smaller components still count as fluid, but do not become nodes
+		std::size_t minArea = 1;
+
+		// Minimum number of shared pixels for an edge between components of consecutive frames
+		std::size_t minOverlap = 1;
+
+		// Whether diagonally adjacent fluid pixels are connected
+		bool diagonal = false;
+	};
+
+	struct Node
+	{
+		// Zero-based frame index
+		std::int32_t time = 0;
+
+		// Centroid and pixel count
+		double x = 0;
+		double y = 0;
+		double area = 0;
+
+		// Centroid displacement from the predecessor with the largest overlap, in pixels per frame
+		double velocity = 0;
+
+		std::int32_t edgesIn = 0;
+		std::int32_t edgesOut = 0;
+
+		// Bounding box, right and bottom exclusive
+		double left = 0;
+		double top = 0;
+		double right = 0;
+		double bottom = 0;
+
+		// Number of pixel edges shared with defending fluid and solid pixels
+		double fluidInterface = 0;
+		double solidInterface = 0;
+	};
+
+	struct Result
+	{
+		unsigned int width = 0;
+		unsigned int height = 0;
+
+		std::vector<Node> nodes;
+
+		// Zero-based source/target node index pairs, sorted by source
+		std::vector<std::int32_t> edges;
+
+		// Number of pixels newly invaded in each frame, which is all fluid of the first frame
+		std::vector<double> invadedPixels;
+
+		// First and last frame containing nodes, or 0 and -1 if no frame does
+		std::int32_t startTime = 0;
+		std::int32_t endTime = -1;
+
+		// First frame in which a node spans the image from left to right, or -1
+		std::int32_t breakthroughTime = -1;
+	};
+
+	FlowGraphExtractor(ThreadPool & threadPool);
+	virtual ~FlowGraphExtractor();
+
+	/**
+	 * Starts processing the frames in order. Cancels any extraction in progress.
+	 */
+	void start(std::vector<std::string> framePaths, Settings settings, FrameLoader loader);
+
+	/**
+	 * Moves the result out if the extraction finished without error. Returns false otherwise.
+	 */
+	bool takeResult(Result & result);
+
+private:
+	struct State;
+};
+
+}
+
+#endif
@@ -0,0 +1,468 @@
+#include <Shared/Lua/Bindings/Accel/FrameAnalyzer.hpp>
+#include <Shared/Utils/Hash.hpp>
+#include <Shared/Utils/ThreadPool.hpp>
+#include <Shared/Utils/Utilities.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cppfs/FileHandle.h>
+#include <cppfs/fs.h>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define WOS_FRAMEANALYZER_SSE2
+#	include <emmintrin.h>
+#endif
+
+namespace wosc
+{
+
+// Bump whenever the statistics or their computation change, so that stale cache entries are ignored
+static constexpr std::uint32_t cacheVersion = 1;
+static constexpr char cacheMagic[4] = {'L', 'V', 'F', 'S'};
+
+// Box counts of coarser grids than this are dominated by the frame border and excluded from the dimension estimate
+static constexpr unsigned int minBoxGridSize = 4;
+
+static_assert(std::is_trivially_copyable<FrameAnalyzer::Statistics>::value, "Statistics are cached as raw bytes");
+
+struct FrameAnalyzer::State : FrameSequenceJob::State
+{
+	virtual std::size_t getBatchSize(const ThreadPool & threadPool) const override;
+	virtual std::string processBatch(std::size_t firstFrame, std::size_t frameCount, ThreadPool & threadPool) override;
+	virtual void complete() override;
+
+	Settings settings;
+	std::string cacheDirectory;
+
+	// Only accessed by the batch currently running
+	std::vector<Statistics> partialStatistics;
+
+	// Guarded by the mutex
+	std::size_t cachedFrames = 0;
+	std::vector<Statistics> statistics;
+};
+
+// Counting into interleaved sub-histograms avoids stalls on runs of equal pixels, which dominate segmented frames
+static void computeHistogram(const std::uint8_t * pixels, std::size_t count, std::array<std::size_t, 256> & histogram)
+{
+	std::array<std::array<std::uint32_t, 256>, 4> counts = {};
+
+	// Sub-histogram counters must not overflow on huge frames
+	static constexpr std::size_t maxChunk = std::size_t(1) << 30;
+
+	histogram.fill(0);
+	for (std::size_t chunkStart = 0; chunkStart < count; chunkStart += maxChunk)
+	{
+		std::size_t chunkEnd = std::min(count, chunkStart + maxChunk);
+		std::size_t i = chunkStart;
+		for (; i + 4 <= chunkEnd; i += 4)
+		{
+			counts[0][pixels[i]]++;
+			counts[1][pixels[i + 1]]++;
+			counts[2][pixels[i + 2]]++;
+			counts[3][pixels[i + 3]]++;
+		}
+		for (; i < chunkEnd; ++i)
+		{
+			counts[0][pixels[i]]++;
+		}
+
+		for (auto & subHistogram : counts)
+		{
+			for (std::size_t value = 0; value < 256; ++value)
+			{
+				histogram[value] += subHistogram[value];
+			}
+			subHistogram.fill(0);
+		}
+	}
+}
+
+// Sets each mask byte to 0xFF if the pixel lies within [min, max] and 0 otherwise, and ORs the mask into 'columns'
+static void thresholdRow(const std::uint8_t * pixels, unsigned int width, std::uint8_t min, std::uint8_t max,
+                         std::uint8_t * mask, std::uint8_t * columns)
+{
+	unsigned int x = 0;
+
+#ifdef WOS_FRAMEANALYZER_SSE2
+	const __m128i minVector = _mm_set1_epi8(static_cast<char>(min));
+	const __m128i maxVector = _mm_set1_epi8(static_cast<char>(max));
+
+	for (; x + 16 <= width; x += 16)
+	{
+		__m128i values = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pixels + x));
+
+		// Unsigned range test: v >= min <=> max(v, min) == v, and v <= max <=> min(v, max) == v
+		__m128i aboveMin = _mm_cmpeq_epi8(_mm_max_epu8(values, minVector), values);
+		__m128i belowMax = _mm_cmpeq_epi8(_mm_min_epu8(values, maxVector), values);
+		__m128i inRange = _mm_and_si128(aboveMin, belowMax);
+
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(mask + x), inRange);
+
+		__m128i occupied = _mm_loadu_si128(reinterpret_cast<const __m128i *>(columns + x));
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(columns + x), _mm_or_si128(occupied, inRange));
+	}
+#endif
+
+	for (; x < width; ++x)
+	{
+		std::uint8_t inRange = pixels[x] >= min && pixels[x] <= max ? 0xFF : 0;
+		mask[x] = inRange;
+		columns[x] |= inRange;
+	}
+}
+
+// Counts the non-zero bytes of a 0/0xFF mask
+static std::size_t countOccupied(const std::uint8_t * mask, std::size_t count)
+{
+	std::size_t occupied = 0;
+	std::size_t i = 0;
+
+#ifdef WOS_FRAMEANALYZER_SSE2
+	const __m128i ones = _mm_set1_epi8(1);
+	const __m128i zero = _mm_setzero_si128();
+	__m128i sums = _mm_setzero_si128();
+
+	for (; i + 16 <= count; i += 16)
+	{
+		__m128i values = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(mask + i)), ones);
+		sums = _mm_add_epi64(sums, _mm_sad_epu8(values, zero));
+	}
+
+	std::uint64_t laneSums[2];
+	_mm_storeu_si128(reinterpret_cast<__m128i *>(laneSums), sums);
+	occupied = laneSums[0] + laneSums[1];
+#endif
+
+	for (; i < count; ++i)
+	{
+		occupied += mask[i] != 0;
+	}
+	return occupied;
+}
+
+// Halves the resolution of a 0/0xFF mask, marking each target cell that covers any occupied source cell
+static void downsampleMask(const std::uint8_t * source, unsigned int width, unsigned int height, std::uint8_t * target,
+                           unsigned int targetWidth, unsigned int targetHeight)
+{
+	for (unsigned int y = 0; y < targetHeight; ++y)
+	{
+		const std::uint8_t * row0 = source + std::size_t(y) * 2 * width;
+		const std::uint8_t * row1 = y * 2 + 1 < height ? row0 + width : row0;
+		std::uint8_t * targetRow = target + std::size_t(y) * targetWidth;
+
+		unsigned int x = 0;
+
+#ifdef WOS_FRAMEANALYZER_SSE2
+		const __m128i lowBytes = _mm_set1_epi16(0x00FF);
+
+		for (; x * 2 + 32 <= width && x + 16 <= targetWidth; x += 16)
+		{
+			__m128i first = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + x * 2)),
+			                             _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + x * 2)));
+			__m128i second = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + x * 2 + 16)),
+			                              _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + x * 2 + 16)));
+
+			// Combine horizontal pairs in the low byte of each 16-bit lane, then pack the lanes into bytes
+			first = _mm_and_si128(_mm_or_si128(first, _mm_srli_epi16(first, 8)), lowBytes);
+			second = _mm_and_si128(_mm_or_si128(second, _mm_srli_epi16(second, 8)), lowBytes);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(targetRow + x), _mm_packus_epi16(first, second));
+		}
+#endif
+
+		for (; x < targetWidth; ++x)
+		{
+			unsigned int sourceX = x * 2;
+			std::uint8_t occupied = row0[sourceX] | row1[sourceX];
+			if (sourceX + 1 < width)
+			{
+				occupied |= row0[sourceX + 1] | row1[sourceX + 1];
+			}
+			targetRow[x] = occupied;
+		}
+	}
+}
+
+// Estimates the box-counting dimension as the slope of log(box count) over log(1 / box size) by least squares
+static double computeFractalDimension(std::vector<std::uint8_t> mask, unsigned int width, unsigned int height)
+{
+	std::vector<std::uint8_t> coarseMask;
+	std::vector<double> logSizes, logCounts;
+
+	for (unsigned int level = 0; std::min(width, height) >= minBoxGridSize; ++level)
+	{
+		std::size_t count = countOccupied(mask.data(), mask.size());
+		if (count == 0)
+		{
+			break;
+		}
+		logSizes.push_back(level);
+		logCounts.push_back(std::log2(double(count)));
+
+		unsigned int coarseWidth = (width + 1) / 2;
+		unsigned int coarseHeight = (height + 1) / 2;
+		coarseMask.resize(std::size_t(coarseWidth) * coarseHeight);
+		downsampleMask(mask.data(), width, height, coarseMask.data(), coarseWidth, coarseHeight);
+		std::swap(mask, coarseMask);
+		width = coarseWidth;
+		height = coarseHeight;
+	}
+
+	// Two points always lie on a line, so they do not give a meaningful estimate
+	std::size_t pointCount = logSizes.size();
+	if (pointCount < 3)
+	{
+		return 0;
+	}
+
+	double meanSize = 0, meanCount = 0;
+	for (std::size_t i = 0; i < pointCount; ++i)
+	{
+		meanSize += logSizes[i];
+		meanCount += logCounts[i];
+	}
+	meanSize /= pointCount;
+	meanCount /= pointCount;
+
+	double covariance = 0, variance = 0;
+	for (std::size_t i = 0; i < pointCount; ++i)
+	{
+		covariance += (logSizes[i] - meanSize) * (logCounts[i] - meanCount);
+		variance += (logSizes[i] - meanSize) * (logSizes[i] - meanSize);
+	}
+	return -covariance / variance;
+}
+
+FrameAnalyzer::Statistics FrameAnalyzer::analyze(const Frame & frame, const Settings & settings)
+{
+	Statistics statistics;
+
+	const std::size_t pixelCount = std::size_t(frame.width) * frame.height;
+	if (pixelCount == 0 || frame.pixels.size() != pixelCount)
+	{
+		return statistics;
+	}
+
+	std::array<std::size_t, 256> histogram;
+	computeHistogram(frame.pixels.data(), pixelCount, histogram);
+
+	double graySum = 0;
+	for (unsigned int value = 0; value < 256; ++value)
+	{
+		double count = histogram[value];
+		graySum += count * value;
+
+		switch (settings.classify(std::uint8_t(value)))
+		{
+		case PixelClass::InvadingFluid:
+			statistics.fluidPixels += count;
+			break;
+		case PixelClass::Solid:
+			statistics.solidPixels += count;
+			break;
+		case PixelClass::DefendingFluid:
+			statistics.defendingPixels += count;
+			break;
+		}
+	}
+
+	statistics.meanGray = graySum / pixelCount;
+
+	double porePixels = statistics.fluidPixels + statistics.defendingPixels;
+	statistics.saturation = porePixels > 0 ? statistics.fluidPixels / porePixels : 0;
+
+	if (statistics.fluidPixels == 0)
+	{
+		return statistics;
+	}
+
+	std::vector<std::uint8_t> mask(pixelCount);
+	std::vector<std::uint8_t> columns(frame.width, 0);
+	for (unsigned int y = 0; y < frame.height; ++y)
+	{
+		std::size_t rowStart = std::size_t(y) * frame.width;
+		thresholdRow(frame.pixels.data() + rowStart, frame.width, settings.fluidMin, settings.fluidMax,
+		             mask.data() + rowStart, columns.data());
+	}
+
+	auto first = std::find(columns.begin(), columns.end(), 0xFF);
+	auto last = std::find(columns.rbegin(), columns.rend(), 0xFF);
+	statistics.frontLeft = double(first - columns.begin()) / frame.width;
+	statistics.frontRight = double(columns.rend() - last) / frame.width;
+
+	statistics.fractalDimension = computeFractalDimension(std::move(mask), frame.width, frame.height);
+
+	return statistics;
+}
+
+// Identifies a frame's statistics by everything they depend on; the file name is a hash of the key
+static std::string getCacheKey(const std::string & path, const FrameAnalyzer::Settings & settings)
+{
+	cppfs::FileHandle file = cppfs::fs::open(path);
+	return path + '\n' + std::to_string(file.size()) + ' ' + std::to_string(file.modificationTime()) + ' ' +
+	       std::to_string(settings.fluidMin) + ' ' + std::to_string(settings.fluidMax) + ' ' +
+	       std::to_string(settings.solidMin) + ' ' + std::to_string(settings.solidMax) + ' ' +
+	       std::to_string(cacheVersion);
+}
+
+static std::string getCachePath(const std::string & cacheDirectory, const std::string & key)
+{
+	char name[17];
+	std::snprintf(name, sizeof(name), "%016llx",
+	              static_cast<unsigned long long>(hash::dataHash64(key.data(), key.size())));
+	return joinPaths(cacheDirectory, std::string(name) + ".lvfs");
+}
+
+// Cache files hold the magic, the full key (to rule out hash collisions) and the raw statistics
+static bool readCache(const std::string & cachePath, const std::string & key, FrameAnalyzer::Statistics & statistics)
+{
+	std::string data = readFileToString(cachePath);
+	std::size_t headerSize = sizeof(cacheMagic) + key.size();
+	if (data.size() != headerSize + sizeof(statistics) || data.compare(0, sizeof(cacheMagic), cacheMagic, 4) != 0 ||
+	    data.compare(sizeof(cacheMagic), key.size(), key) != 0)
+	{
+		return false;
+	}
+
+	std::memcpy(&statistics, data.data() + headerSize, sizeof(statistics));
+	return true;
+}
+
+static void writeCache(const std::string & cachePath, const std::string & key,
+                       const FrameAnalyzer::Statistics & statistics)
+{
+	std::string data(cacheMagic, sizeof(cacheMagic));
+	data += key;
+	data.append(reinterpret_cast<const char *>(&statistics), sizeof(statistics));
+
+	// Failing to write the cache only costs time on the next run
+	writeStringToFile(cachePath, data);
+}
+
+std::size_t FrameAnalyzer::State::getBatchSize(const ThreadPool & threadPool) const
+{
+	// Several frames per thread keep the pool busy while single frames take longer to decode
+	return std::max<std::size_t>(threadPool.getThreadCount(), 1) * 4;
+}
+
+std::string FrameAnalyzer::State::processBatch(std::size_t firstFrame, std::size_t frameCount, ThreadPool & threadPool)
+{
+	std::vector<std::string> errors(frameCount);
+	std::vector<char> cached(frameCount, false);
+
+	threadPool.parallelFor(frameCount, 1, [&](std::size_t begin, std::size_t end) {
+		Frame frame;
+		for (std::size_t i = begin; i < end && running; ++i)
+		{
+			const std::string & path = framePaths[firstFrame + i];
+			auto & frameStatistics = partialStatistics[firstFrame + i];
+
+			std::string key, cachePath;
+			if (!cacheDirectory.empty())
+			{
+				key = getCacheKey(path, settings);
+				cachePath = getCachePath(cacheDirectory, key);
+				if (readCache(cachePath, key, frameStatistics))
+				{
+					cached[i] = true;
+					continue;
+				}
+			}
+
+			if (!loader(path, frame))
+			{
+				errors[i] = "Failed to load frame: " + path;
+				continue;
+			}
+
+			frameStatistics = analyze(frame, settings);
+
+			if (!cachePath.empty())
+			{
+				writeCache(cachePath, key, frameStatistics);
+			}
+		}
+	});
+
+	for (const auto & error : errors)
+	{
+		if (!error.empty())
+		{
+			return error;
+		}
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	cachedFrames += std::count(cached.begin(), cached.end(), true);
+	return "";
+}
+
+void FrameAnalyzer::State::complete()
+{
+	statistics = std::move(partialStatistics);
+}
+
+FrameAnalyzer::FrameAnalyzer(ThreadPool & threadPool) :
+	FrameSequenceJob(threadPool)
+{
+}
+
+FrameAnalyzer::~FrameAnalyzer()
+{
+}
+
+void FrameAnalyzer::start(std::vector<std::string> framePaths, Settings settings, FrameLoader loader,
+                          std::string cacheDirectory)
+{
+	if (!cacheDirectory.empty() && !isDirectory(cacheDirectory) && !createDirectory(cacheDirectory, true))
+	{
+		cacheDirectory.clear();
+	}
+
+	auto state = std::make_shared<State>();
+	state->framePaths = std::move(framePaths);
+	state->loader = std::move(loader);
+	state->settings = settings;
+	state->cacheDirectory = std::move(cacheDirectory);
+	state->partialStatistics.resize(state->framePaths.size());
+	FrameSequenceJob::start(std::move(state));
+}
+
+std::size_t FrameAnalyzer::getCachedFrameCount() const
+{
+	auto state = getState<State>();
+	if (!state)
+	{
+		return 0;
+	}
+
+	std::lock_guard<std::mutex> lock(state->mutex);
+	return state->cachedFrames;
+}
+
+bool FrameAnalyzer::takeStatistics(std::vector<Statistics> & statistics)
+{
+	auto state = getState<State>();
+	if (!state)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(state->mutex);
+	if (!state->done || !state->error.empty())
+	{
+		return false;
+	}
+
+	statistics = std::move(state->statistics);
+	state->statistics.clear();
+	return true;
+}
+
+}
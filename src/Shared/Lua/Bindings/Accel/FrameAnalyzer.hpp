@@ -0,0 +1,70 @@
+#ifndef SRC_SHARED_LUA_BINDINGS_ACCEL_FRAMEANALYZER_HPP_
+#define SRC_SHARED_LUA_BINDINGS_ACCEL_FRAMEANALYZER_HPP_
+
+#include <Shared/Lua/Bindings/Accel/FrameSequenceJob.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace wosc
+{
+
+/**
+ * Computes pixel-level statistics for each frame of a segmented grayscale image sequence.
+ *
+ * Frames are analyzed in parallel on the thread pool, one frame per task. The statistics of each frame are cached in
+ * a file keyed by the frame's path, size and modification time and the analysis settings, so that reopening a
+ * sequence only analyzes new or modified frames.
+ */
+class FrameAnalyzer : public FrameSequenceJob
+{
+public:
+	using Settings = FrameSegmentation;
+
+	struct Statistics
+	{
+		double fluidPixels = 0;
+		double solidPixels = 0;
+		double defendingPixels = 0;
+
+		// Fraction of the pore space (all non-solid pixels) occupied by invading fluid
+		double saturation = 0;
+
+		// Leftmost and rightmost column containing invading fluid, relative to the frame width (0 to 1), or -1
+		double frontLeft = -1;
+		double frontRight = -1;
+
+		// Box-counting dimension of the invading fluid, or 0 if the frame has too little fluid to estimate it
+		double fractalDimension = 0;
+
+		double meanGray = 0;
+	};
+
+	FrameAnalyzer(ThreadPool & threadPool);
+	virtual ~FrameAnalyzer();
+
+	/**
+	 * Starts analyzing the frames. Statistics are cached in 'cacheDirectory', or not at all if it is empty. Cancels
+	 * any analysis in progress.
+	 */
+	void start(std::vector<std::string> framePaths, Settings settings, FrameLoader loader, std::string cacheDirectory);
+
+	std::size_t getCachedFrameCount() const;
+
+	/**
+	 * Moves the statistics of all frames out if the analysis finished without error. Returns false otherwise.
+	 */
+	bool takeStatistics(std::vector<Statistics> & statistics);
+
+	/**
+	 * Analyzes a single frame on the calling thread.
+	 */
+	static Statistics analyze(const Frame & frame, const Settings & settings);
+
+private:
+	struct State;
+};
+
+}
+
+#endif
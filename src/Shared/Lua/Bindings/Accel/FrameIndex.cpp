@@ -0,0 +1,429 @@
+#include <Shared/Lua/Bindings/Accel/FrameIndex.hpp>
+#include <Shared/Utils/Utilities.hpp>
+#include <algorithm>
+#include <cctype>
+
+namespace wosc
+{
+
+struct NaturalOrderSet::Node
+{
+	std::string name;
+	std::uint32_t priority = 0;
+	std::size_t size = 1;
+	NodePtr left;
+	NodePtr right;
+};
+
+constexpr std::size_t NaturalOrderSet::npos;
+
+NaturalOrderSet::NaturalOrderSet()
+{
+}
+
+NaturalOrderSet::~NaturalOrderSet()
+{
+}
+
+std::size_t NaturalOrderSet::insert(std::string name)
+{
+	if (find(name) != npos)
+	{
+		return npos;
+	}
+
+	std::size_t rank = getRank(name);
+
+	NodePtr node(new Node());
+	node->priority = random();
+
+	NodePtr first, second;
+	split(std::move(root), name, false, first, second);
+	node->name = std::move(name);
+	root = merge(merge(std::move(first), std::move(node)), std::move(second));
+	return rank;
+}
+
+std::size_t NaturalOrderSet::erase(const std::string & name)
+{
+	std::size_t rank = find(name);
+	if (rank == npos)
+	{
+		return npos;
+	}
+
+	NodePtr first, rest, middle, second;
+	split(std::move(root), name, false, first, rest);
+	split(std::move(rest), name, true, middle, second);
+	root = merge(std::move(first), std::move(second));
+	return rank;
+}
+
+std::size_t NaturalOrderSet::find(const std::string & name) const
+{
+	std::size_t rank = 0;
+	const Node * node = root.get();
+	while (node)
+	{
+		if (less(name, node->name))
+		{
+			node = node->left.get();
+		}
+		else if (less(node->name, name))
+		{
+			rank += getSize(node->left) + 1;
+			node = node->right.get();
+		}
+		else
+		{
+			return rank + getSize(node->left);
+		}
+	}
+	return npos;
+}
+
+const std::string & NaturalOrderSet::get(std::size_t rank) const
+{
+	const Node * node = root.get();
+	while (rank != getSize(node->left))
+	{
+		if (rank < getSize(node->left))
+		{
+			node = node->left.get();
+		}
+		else
+		{
+			rank -= getSize(node->left) + 1;
+			node = node->right.get();
+		}
+	}
+	return node->name;
+}
+
+std::size_t NaturalOrderSet::size() const
+{
+	return getSize(root);
+}
+
+void NaturalOrderSet::clear()
+{
+	root.reset();
+}
+
+std::vector<std::string> NaturalOrderSet::getNames() const
+{
+	std::vector<std::string> names;
+	names.reserve(size());
+
+	// In-order traversal without recursion
+	std::vector<const Node *> stack;
+	const Node * node = root.get();
+	while (node || !stack.empty())
+	{
+		while (node)
+		{
+			stack.push_back(node);
+			node = node->left.get();
+		}
+		node = stack.back();
+		stack.pop_back();
+		names.push_back(node->name);
+		node = node->right.get();
+	}
+	return names;
+}
+
+bool NaturalOrderSet::less(const std::string & a, const std::string & b)
+{
+	std::size_t i = 0, j = 0;
+	while (i < a.size() && j < b.size())
+	{
+		if (std::isdigit((unsigned char) a[i]) && std::isdigit((unsigned char) b[j]))
+		{
+			// Compare digit runs by value: skip leading zeros, then compare digit count and digits
+			while (i < a.size() && a[i] == '0')
+			{
+				i++;
+			}
+			while (j < b.size() && b[j] == '0')
+			{
+				j++;
+			}
+
+			std::size_t endA = i, endB = j;
+			while (endA < a.size() && std::isdigit((unsigned char) a[endA]))
+			{
+				endA++;
+			}
+			while (endB < b.size() && std::isdigit((unsigned char) b[endB]))
+			{
+				endB++;
+			}
+
+			if (endA - i != endB - j)
+			{
+				return endA - i < endB - j;
+			}
+			for (; i < endA; ++i, ++j)
+			{
+				if (a[i] != b[j])
+				{
+					return a[i] < b[j];
+				}
+			}
+		}
+		else if (a[i] != b[j])
+		{
+			return (unsigned char) a[i] < (unsigned char) b[j];
+		}
+		else
+		{
+			i++;
+			j++;
+		}
+	}
+
+	if (a.size() - i != b.size() - j)
+	{
+		return a.size() - i < b.size() - j;
+	}
+
+	// Naturally equal names (such as "frame01" and "frame1") still need a consistent order
+	return a < b;
+}
+
+std::size_t NaturalOrderSet::getSize(const NodePtr & node)
+{
+	return node ? node->size : 0;
+}
+
+void NaturalOrderSet::update(Node & node)
+{
+	node.size = getSize(node.left) + getSize(node.right) + 1;
+}
+
+void NaturalOrderSet::split(NodePtr tree, const std::string & name, bool inclusive, NodePtr & first, NodePtr & second)
+{
+	if (!tree)
+	{
+		first.reset();
+		second.reset();
+		return;
+	}
+
+	if (inclusive ? !less(name, tree->name) : less(tree->name, name))
+	{
+		NodePtr right = std::move(tree->right);
+		split(std::move(right), name, inclusive, tree->right, second);
+		update(*tree);
+		first = std::move(tree);
+	}
+	else
+	{
+		NodePtr left = std::move(tree->left);
+		split(std::move(left), name, inclusive, first, tree->left);
+		update(*tree);
+		second = std::move(tree);
+	}
+}
+
+NaturalOrderSet::NodePtr NaturalOrderSet::merge(NodePtr first, NodePtr second)
+{
+	if (!first)
+	{
+		return second;
+	}
+	if (!second)
+	{
+		return first;
+	}
+
+	if (first->priority > second->priority)
+	{
+		first->right = merge(std::move(first->right), std::move(second));
+		update(*first);
+		return first;
+	}
+	else
+	{
+		second->left = merge(std::move(first), std::move(second->left));
+		update(*second);
+		return second;
+	}
+}
+
+std::size_t NaturalOrderSet::getRank(const std::string & name) const
+{
+	std::size_t rank = 0;
+	const Node * node = root.get();
+	while (node)
+	{
+		if (less(node->name, name))
+		{
+			rank += getSize(node->left) + 1;
+			node = node->right.get();
+		}
+		else
+		{
+			node = node->left.get();
+		}
+	}
+	return rank;
+}
+
+FrameIndex::FrameIndex(std::string directory, std::string suffix, sf::Time settleDelay) :
+	directory(std::move(directory)),
+	suffix(std::move(suffix))
+{
+	std::vector<std::string> names;
+	if (!listFrameNames(this->directory, this->suffix, names))
+	{
+		return;
+	}
+
+	for (auto & name : names)
+	{
+		frames.insert(std::move(name));
+	}
+
+	// All events are held back until the file has settled; their type is re-derived from the file system afterwards.
+	// Coalesced events without a delay or limit would never expire, so a zero delay reports events immediately.
+	fs::DirectoryObserver::CoalescenceSettings coalescence;
+	coalescence.enabled = settleDelay > sf::Time::Zero;
+	coalescence.force = true;
+	coalescence.delay = settleDelay;
+
+	observer.setWatchedDirectory(this->directory);
+	observer.setRecursive(false);
+	observer.setEventMask(fs::DirectoryObserver::Event::Default);
+	observer.setEventCoalescence(coalescence);
+	observer.startWatching();
+
+	valid = observer.isWatching();
+}
+
+FrameIndex::~FrameIndex()
+{
+	observer.stopWatching();
+}
+
+bool FrameIndex::isValid() const
+{
+	return valid;
+}
+
+std::size_t FrameIndex::getFrameCount() const
+{
+	return frames.size();
+}
+
+std::string FrameIndex::getFramePath(std::size_t index) const
+{
+	return index < frames.size() ? getPath(frames.get(index)) : "";
+}
+
+std::vector<std::string> FrameIndex::getFramePaths() const
+{
+	std::vector<std::string> paths = frames.getNames();
+	for (auto & path : paths)
+	{
+		path = getPath(path);
+	}
+	return paths;
+}
+
+std::vector<FrameIndex::Change> FrameIndex::poll()
+{
+	std::vector<Change> changes;
+	if (!valid)
+	{
+		return changes;
+	}
+
+	observer.process();
+
+	fs::DirectoryObserver::Event event;
+	while (observer.pollEvent(event))
+	{
+		std::string name = extractFileName(event.filename);
+		if (!matches(name, suffix))
+		{
+			continue;
+		}
+
+		Change change;
+		change.path = getPath(name);
+
+		bool exists = isRegularFile(change.path);
+		std::size_t index = frames.find(name);
+
+		if (exists && index == NaturalOrderSet::npos)
+		{
+			change.type = Change::Type::Added;
+			change.index = frames.insert(name);
+		}
+		else if (!exists && index != NaturalOrderSet::npos)
+		{
+			change.type = Change::Type::Removed;
+			change.index = frames.erase(name);
+		}
+		else if (exists)
+		{
+			change.type = Change::Type::Modified;
+			change.index = index;
+		}
+		else
+		{
+			// Created and removed again before settling
+			continue;
+		}
+
+		changes.push_back(std::move(change));
+	}
+
+	return changes;
+}
+
+bool FrameIndex::listFrames(const std::string & directory, const std::string & suffix,
+                            std::vector<std::string> & paths)
+{
+	if (!listFrameNames(directory, suffix, paths))
+	{
+		return false;
+	}
+
+	std::sort(paths.begin(), paths.end(), NaturalOrderSet::less);
+	for (auto & path : paths)
+	{
+		path = joinPaths(directory, path);
+	}
+	return true;
+}
+
+bool FrameIndex::listFrameNames(const std::string & directory, const std::string & suffix,
+                                std::vector<std::string> & names)
+{
+	names.clear();
+	if (!isDirectory(directory) || !listFiles(directory, names, false, false))
+	{
+		return false;
+	}
+
+	auto isOtherFile = [&suffix](const std::string & name) {
+		return !matches(name, suffix);
+	};
+	names.erase(std::remove_if(names.begin(), names.end(), isOtherFile), names.end());
+	return true;
+}
+
+bool FrameIndex::matches(const std::string & name, const std::string & suffix)
+{
+	return name.size() > suffix.size() && stringEndsWith(name, suffix);
+}
+
+std::string FrameIndex::getPath(const std::string & name) const
+{
+	return joinPaths(directory, name);
+}
+
+}
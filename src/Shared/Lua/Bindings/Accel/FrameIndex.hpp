@@ -0,0 +1,131 @@
+#ifndef SRC_SHARED_LUA_BINDINGS_ACCEL_FRAMEINDEX_HPP_
+#define SRC_SHARED_LUA_BINDINGS_ACCEL_FRAMEINDEX_HPP_
+
+#include <SFML/System/Time.hpp>
+#include <Shared/Utils/Filesystem/DirectoryObserver.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace wosc
+{
+
+/**
+ * Set of names in natural order (digit runs compare by numeric value, so "frame9" precedes "frame10"), supporting
+ * insertion, removal and rank queries in O(log n) expected time.
+ */
+class NaturalOrderSet
+{
+public:
+	static constexpr std::size_t npos = std::size_t(-1);
+
+	NaturalOrderSet();
+	~NaturalOrderSet();
+
+	/**
+	 * Returns the zero-based rank of the inserted name, or npos if it is already contained.
+	 */
+	std::size_t insert(std::string name);
+
+	/**
+	 * Returns the rank the removed name had, or npos if it is not contained.
+	 */
+	std::size_t erase(const std::string & name);
+
+	std::size_t find(const std::string & name) const;
+	const std::string & get(std::size_t rank) const;
+	std::size_t size() const;
+	void clear();
+
+	std::vector<std::string> getNames() const;
+
+	/**
+	 * Strict weak natural order. Names that only differ in leading zeros are ordered by plain comparison.
+	 */
+	static bool less(const std::string & a, const std::string & b);
+
+private:
+	struct Node;
+	using NodePtr = std::unique_ptr<Node>;
+
+	static std::size_t getSize(const NodePtr & node);
+	static void update(Node & node);
+
+	// Splits the tree into names before 'name' and the rest; with 'inclusive', 'name' itself goes to the first part
+	static void split(NodePtr tree, const std::string & name, bool inclusive, NodePtr & first, NodePtr & second);
+	static NodePtr merge(NodePtr first, NodePtr second);
+
+	std::size_t getRank(const std::string & name) const;
+
+	NodePtr root;
+	std::minstd_rand random;
+};
+
+/**
+ * Incrementally maintained, naturally sorted list of the files in a directory whose names end with a suffix (such as
+ * the frames a running simulation writes).
+ *
+ * The directory is listed once and then observed. File events are coalesced until the file has not changed for the
+ * settle delay, so frames are only reported once they have been written completely. A zero settle delay reports
+ * events immediately.
+ */
+class FrameIndex
+{
+public:
+	struct Change
+	{
+		enum class Type
+		{
+			Added = 1,
+			Removed = 2,
+			Modified = 3,
+		};
+
+		Type type = Type::Added;
+		std::string path;
+
+		// Position of the frame in the list after adding it, or before removing it
+		std::size_t index = 0;
+	};
+
+	FrameIndex(std::string directory, std::string suffix, sf::Time settleDelay);
+	~FrameIndex();
+
+	bool isValid() const;
+
+	std::size_t getFrameCount() const;
+	std::string getFramePath(std::size_t index) const;
+	std::vector<std::string> getFramePaths() const;
+
+	/**
+	 * Applies the file events observed since the last call and returns the resulting changes in order.
+	 */
+	std::vector<Change> poll();
+
+	/**
+	 * Lists the paths of the matching files in natural order once, without observing the directory. Returns false
+	 * if the directory cannot be listed.
+	 */
+	static bool listFrames(const std::string & directory, const std::string & suffix, std::vector<std::string> & paths);
+
+private:
+	static bool listFrameNames(const std::string & directory, const std::string & suffix,
+	                           std::vector<std::string> & names);
+	static bool matches(const std::string & name, const std::string & suffix);
+
+	std::string getPath(const std::string & name) const;
+
+	std::string directory;
+	std::string suffix;
+	bool valid = false;
+
+	NaturalOrderSet frames;
+	fs::DirectoryObserver observer;
+};
+
+}
+
+#endif
@@ -0,0 +1,169 @@
+#include <Shared/Lua/Bindings/Accel/FrameSequenceJob.hpp>
+#include <Shared/Utils/ThreadPool.hpp>
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+namespace wosc
+{
+
+FrameSequenceJob::State::~State()
+{
+}
+
+FrameSequenceJob::FrameSequenceJob(ThreadPool & threadPool) :
+	threadPool(threadPool)
+{
+}
+
+FrameSequenceJob::~FrameSequenceJob()
+{
+	stop();
+}
+
+void FrameSequenceJob::start(std::shared_ptr<State> state)
+{
+	stop();
+
+	// Batches still in flight keep the previous state alive until they finish
+	this->state = std::move(state);
+	this->state->running = true;
+	submitBatch(this->state, threadPool);
+}
+
+void FrameSequenceJob::stop()
+{
+	if (state)
+	{
+		std::lock_guard<std::mutex> lock(state->mutex);
+		state->running = false;
+		state->finished.notify_all();
+	}
+}
+
+bool FrameSequenceJob::isRunning() const
+{
+	return state && state->running;
+}
+
+bool FrameSequenceJob::isDone() const
+{
+	if (!state)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(state->mutex);
+	return state->done;
+}
+
+void FrameSequenceJob::wait() const
+{
+	if (!state)
+	{
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->finished.wait(lock, [this]() {
+		return state->done || !state->running;
+	});
+}
+
+std::size_t FrameSequenceJob::getFrameCount() const
+{
+	return state ? state->framePaths.size() : 0;
+}
+
+std::size_t FrameSequenceJob::getProcessedFrameCount() const
+{
+	if (!state)
+	{
+		return 0;
+	}
+
+	std::lock_guard<std::mutex> lock(state->mutex);
+	return state->processedFrames;
+}
+
+std::string FrameSequenceJob::getError() const
+{
+	if (!state)
+	{
+		return "";
+	}
+
+	std::lock_guard<std::mutex> lock(state->mutex);
+	return state->error;
+}
+
+void FrameSequenceJob::submitBatch(std::shared_ptr<State> state, ThreadPool & threadPool)
+{
+	threadPool.submit([state, &threadPool]() {
+		runBatch(state, threadPool);
+	});
+}
+
+void FrameSequenceJob::runBatch(std::shared_ptr<State> state, ThreadPool & threadPool)
+{
+	if (!state->running)
+	{
+		return;
+	}
+
+	auto finish = [&state](std::string error) {
+		std::lock_guard<std::mutex> lock(state->mutex);
+		if (error.empty())
+		{
+			state->complete();
+		}
+		state->error = std::move(error);
+		state->done = true;
+		state->running = false;
+		state->finished.notify_all();
+	};
+
+	try
+	{
+		std::size_t firstFrame = state->nextFrame;
+		std::size_t batchFrames = std::max<std::size_t>(state->getBatchSize(threadPool), 1);
+		batchFrames = std::min(batchFrames, state->framePaths.size() - firstFrame);
+
+		std::string error = state->processBatch(firstFrame, batchFrames, threadPool);
+
+		// Frames skipped after stopping are incomplete
+		if (!state->running)
+		{
+			return;
+		}
+
+		if (!error.empty())
+		{
+			finish(std::move(error));
+			return;
+		}
+
+		state->nextFrame += batchFrames;
+
+		{
+			std::lock_guard<std::mutex> lock(state->mutex);
+			state->processedFrames = state->nextFrame;
+		}
+	}
+	catch (std::exception & ex)
+	{
+		finish(ex.what());
+		return;
+	}
+
+	if (state->nextFrame == state->framePaths.size())
+	{
+		finish("");
+	}
+	else if (state->running)
+	{
+		submitBatch(state, threadPool);
+	}
+}
+
+}
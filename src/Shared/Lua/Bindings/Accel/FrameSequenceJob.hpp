@@ -0,0 +1,115 @@
+#ifndef SRC_SHARED_LUA_BINDINGS_ACCEL_FRAMESEQUENCEJOB_HPP_
+#define SRC_SHARED_LUA_BINDINGS_ACCEL_FRAMESEQUENCEJOB_HPP_
+
+#include <Shared/Lua/Bindings/Accel/GrayscaleFrame.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class ThreadPool;
+
+namespace wosc
+{
+
+/**
+ * Processes a sequence of frames in the background, one batch of frames per thread pool task.
+ *
+ * Each batch resubmits the next one until all frames are processed, an error occurs or the job is stopped, so the
+ * job never blocks a pool thread for longer than a batch. The work itself is provided by the derived class's state.
+ */
+class FrameSequenceJob
+{
+public:
+	using Frame = GrayscaleFrame;
+	using FrameLoader = GrayscaleFrameLoader;
+
+	FrameSequenceJob(ThreadPool & threadPool);
+	virtual ~FrameSequenceJob();
+
+	FrameSequenceJob(const FrameSequenceJob &) = delete;
+	FrameSequenceJob & operator=(const FrameSequenceJob &) = delete;
+
+	void stop();
+
+	bool isRunning() const;
+
+	/**
+	 * Returns true once all frames were processed or an error occurred.
+	 */
+	bool isDone() const;
+
+	/**
+	 * Blocks until the job is done or stopped.
+	 */
+	void wait() const;
+
+	std::size_t getFrameCount() const;
+	std::size_t getProcessedFrameCount() const;
+
+	/**
+	 * Returns the message of the error that stopped the job, or an empty string.
+	 */
+	std::string getError() const;
+
+protected:
+	struct State
+	{
+		virtual ~State();
+
+		/**
+		 * Returns the maximum number of frames per batch.
+		 */
+		virtual std::size_t getBatchSize(const ThreadPool & threadPool) const = 0;
+
+		/**
+		 * Processes the frames [firstFrame, firstFrame + frameCount) on a pool thread and returns an error message,
+		 * or an empty string on success. Frames may be skipped once 'running' is false, since the batch is discarded.
+		 */
+		virtual std::string processBatch(std::size_t firstFrame, std::size_t frameCount, ThreadPool & threadPool) = 0;
+
+		/**
+		 * Publishes the result once all frames were processed without error. Called with the mutex locked.
+		 */
+		virtual void complete() = 0;
+
+		std::atomic_bool running {false};
+
+		std::vector<std::string> framePaths;
+		FrameLoader loader;
+
+		// Only accessed by the batch currently running
+		std::size_t nextFrame = 0;
+
+		mutable std::mutex mutex;
+		mutable std::condition_variable finished;
+		std::size_t processedFrames = 0;
+		bool done = false;
+		std::string error;
+	};
+
+	/**
+	 * Starts processing the state's frames in order. Cancels the job in progress.
+	 */
+	void start(std::shared_ptr<State> state);
+
+	template <typename StateType>
+	StateType * getState() const
+	{
+		return static_cast<StateType *>(state.get());
+	}
+
+private:
+	static void submitBatch(std::shared_ptr<State> state, ThreadPool & threadPool);
+	static void runBatch(std::shared_ptr<State> state, ThreadPool & threadPool);
+
+	ThreadPool & threadPool;
+	std::shared_ptr<State> state;
+};
+
+}
+
+#endif
@@ -0,0 +1,369 @@
+#include <Shared/Lua/Bindings/Accel/GraphFile.hpp>
+#include <Shared/Utils/DataStream.hpp>
+#include <Shared/Utils/Filesystem/MappedFile.hpp>
+#include <Shared/Utils/StrNumCon.hpp>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace wosc
+{
+
+static const char fileMagic[8] = {'L', 'V', 'G', 'R', 'A', 'P', 'H', '\0'};
+static const std::uint32_t fileVersion = 1;
+static const std::uint32_t fileByteOrderMark = 0x01020304;
+static const std::uint64_t columnAlignment = 64;
+
+struct FileHeader
+{
+	char magic[8];
+	std::uint32_t version;
+	std::uint32_t byteOrderMark;
+	std::uint32_t columnCount;
+	std::uint32_t reserved;
+	std::uint64_t metadataOffset;
+	std::uint64_t metadataSize;
+};
+
+struct FileColumn
+{
+	char name[GraphFile::MAX_COLUMN_NAME_LENGTH + 1];
+	std::uint32_t type;
+	std::uint32_t reserved;
+	std::uint64_t offset;
+	std::uint64_t size;
+};
+
+static std::size_t getElementSize(GraphFile::ColumnType type)
+{
+	switch (type)
+	{
+	case GraphFile::ColumnType::Int8:
+	case GraphFile::ColumnType::UInt8:
+		return 1;
+	case GraphFile::ColumnType::Int16:
+	case GraphFile::ColumnType::UInt16:
+		return 2;
+	case GraphFile::ColumnType::Int32:
+	case GraphFile::ColumnType::UInt32:
+	case GraphFile::ColumnType::Float:
+		return 4;
+	case GraphFile::ColumnType::Double:
+		return 8;
+	default:
+		return 0;
+	}
+}
+
+static std::uint64_t alignOffset(std::uint64_t offset)
+{
+	return (offset + columnAlignment - 1) / columnAlignment * columnAlignment;
+}
+
+static bool isRangeInFile(std::uint64_t offset, std::uint64_t size, std::uint64_t fileSize)
+{
+	return offset <= fileSize && size <= fileSize - offset;
+}
+
+namespace
+{
+class MetadataReader
+{
+public:
+	MetadataReader(const char * data, std::size_t size) :
+		data(data),
+		size(size)
+	{
+	}
+
+	template <typename T>
+	bool read(T & value)
+	{
+		if (sizeof(T) > size - position)
+		{
+			return false;
+		}
+		std::memcpy(&value, data + position, sizeof(T));
+		position += sizeof(T);
+		return true;
+	}
+
+	bool readString(std::string & value)
+	{
+		std::uint32_t length;
+		if (!read(length) || length > size - position)
+		{
+			return false;
+		}
+		value.assign(data + position, length);
+		position += length;
+		return true;
+	}
+
+	bool isDone() const
+	{
+		return position == size;
+	}
+
+private:
+	const char * data;
+	std::size_t size;
+	std::size_t position = 0;
+};
+}
+
+bool GraphFile::load(const std::string & filename, ArrayContext & context)
+{
+	columns.clear();
+	metadata.clear();
+	error.clear();
+
+	fs::MappedFile file(filename);
+	if (!file.isOpen())
+	{
+		return fail("Failed to open graph file '" + filename + "'");
+	}
+
+	FileHeader header;
+	if (file.getSize() < sizeof(header))
+	{
+		return fail("Graph file is truncated");
+	}
+	std::memcpy(&header, file.getData(), sizeof(header));
+
+	if (std::memcmp(header.magic, fileMagic, sizeof(fileMagic)) != 0)
+	{
+		return fail("Not a graph file");
+	}
+
+	if (header.byteOrderMark != fileByteOrderMark)
+	{
+		return fail("Graph file was written with a different byte order");
+	}
+
+	if (header.version != fileVersion)
+	{
+		return fail("Unsupported graph file version " + cNtoS(header.version));
+	}
+
+	const std::uint64_t tableSize = std::uint64_t(header.columnCount) * sizeof(FileColumn);
+	if (!isRangeInFile(sizeof(header), tableSize, file.getSize())
+	    || !isRangeInFile(header.metadataOffset, header.metadataSize, file.getSize()))
+	{
+		return fail("Graph file is truncated");
+	}
+
+	MetadataReader reader(file.getData() + header.metadataOffset, header.metadataSize);
+	while (!reader.isDone())
+	{
+		Metadata entry;
+		if (!reader.read(entry.value.type) || !reader.readString(entry.key))
+		{
+			return fail("Graph file metadata is malformed");
+		}
+
+		bool valid = false;
+		switch (entry.value.type)
+		{
+		case MetadataValue::Type::Number:
+			valid = reader.read(entry.value.number);
+			break;
+		case MetadataValue::Type::String:
+			valid = reader.readString(entry.value.string);
+			break;
+		case MetadataValue::Type::Boolean:
+		{
+			std::uint8_t boolean = 0;
+			valid = reader.read(boolean);
+			entry.value.boolean = boolean != 0;
+			break;
+		}
+		}
+
+		if (!valid)
+		{
+			return fail("Graph file metadata is malformed");
+		}
+
+		metadata.push_back(std::move(entry));
+	}
+
+	std::vector<FileColumn> fileColumns(header.columnCount);
+	std::memcpy(fileColumns.data(), file.getData() + sizeof(header), tableSize);
+
+	for (const auto & fileColumn : fileColumns)
+	{
+		std::size_t elementSize = getElementSize(ColumnType(fileColumn.type));
+		if (elementSize == 0 || fileColumn.size % elementSize != 0
+		    || fileColumn.size > std::uint64_t(std::numeric_limits<ArrayContext::ArraySize>::max())
+		    || !isRangeInFile(fileColumn.offset, fileColumn.size, file.getSize()))
+		{
+			metadata.clear();
+			return fail("Graph file column table is malformed");
+		}
+	}
+
+	// Columns are copied rather than mapped, since scripts keep them for their whole lifetime while a running
+	// simulation may rewrite the file in place
+	for (const auto & fileColumn : fileColumns)
+	{
+		Column column;
+		column.name.assign(fileColumn.name, strnlen(fileColumn.name, sizeof(fileColumn.name)));
+		column.type = ColumnType(fileColumn.type);
+		column.arrayID = context.newArray(fileColumn.size, false);
+
+		if (fileColumn.size > 0)
+		{
+			auto info = context.getArrayInfo(column.arrayID);
+			std::memcpy(info.data, file.getData() + fileColumn.offset, fileColumn.size);
+		}
+
+		columns.push_back(std::move(column));
+	}
+
+	return true;
+}
+
+bool GraphFile::save(const std::string & filename, const ArrayContext & context)
+{
+	error.clear();
+
+	DataStream metadataStream;
+	metadataStream.openMemory();
+	auto writeString = [&](const std::string & string) {
+		std::uint32_t length = string.size();
+		metadataStream.addData(&length, sizeof(length));
+		metadataStream.addData(string.data(), string.size());
+	};
+
+	for (const auto & entry : metadata)
+	{
+		metadataStream.addData(&entry.value.type, sizeof(entry.value.type));
+		writeString(entry.key);
+
+		switch (entry.value.type)
+		{
+		case MetadataValue::Type::Number:
+			metadataStream.addData(&entry.value.number, sizeof(entry.value.number));
+			break;
+		case MetadataValue::Type::String:
+			writeString(entry.value.string);
+			break;
+		case MetadataValue::Type::Boolean:
+		{
+			std::uint8_t boolean = entry.value.boolean ? 1 : 0;
+			metadataStream.addData(&boolean, sizeof(boolean));
+			break;
+		}
+		}
+	}
+
+	FileHeader header;
+	std::memcpy(header.magic, fileMagic, sizeof(fileMagic));
+	header.version = fileVersion;
+	header.byteOrderMark = fileByteOrderMark;
+	header.columnCount = columns.size();
+	header.reserved = 0;
+	header.metadataOffset = sizeof(FileHeader) + columns.size() * sizeof(FileColumn);
+	header.metadataSize = metadataStream.getDataSize();
+
+	std::vector<FileColumn> fileColumns;
+	std::vector<ArrayContext::ArrayInfo> arrays;
+	std::uint64_t offset = header.metadataOffset + header.metadataSize;
+
+	for (const auto & column : columns)
+	{
+		if (column.name.size() > MAX_COLUMN_NAME_LENGTH)
+		{
+			return fail("Column name '" + column.name + "' is too long");
+		}
+
+		auto info = context.getArrayInfo(column.arrayID);
+		if (info.data == nullptr && info.size != 0)
+		{
+			return fail("Column '" + column.name + "' refers to an invalid array");
+		}
+
+		std::size_t elementSize = getElementSize(column.type);
+		if (elementSize == 0)
+		{
+			return fail("Column '" + column.name + "' has an invalid type");
+		}
+
+		FileColumn fileColumn;
+		std::memset(&fileColumn, 0, sizeof(fileColumn));
+		std::copy(column.name.begin(), column.name.end(), fileColumn.name);
+		fileColumn.type = std::uint32_t(column.type);
+		fileColumn.offset = alignOffset(offset);
+		fileColumn.size = info.size / elementSize * elementSize;
+		offset = fileColumn.offset + fileColumn.size;
+
+		fileColumns.push_back(fileColumn);
+		arrays.push_back(info);
+	}
+
+	DataStream stream;
+	if (!stream.openOutFile(filename))
+	{
+		return fail("Failed to open '" + filename + "' for writing");
+	}
+
+	static const char padding[columnAlignment] = {};
+
+	bool written = stream.addData(&header, sizeof(header))
+	               && stream.addData(fileColumns.data(), fileColumns.size() * sizeof(FileColumn))
+	               && stream.addData(metadataStream.getData(), metadataStream.getDataSize());
+
+	std::uint64_t position = header.metadataOffset + header.metadataSize;
+	for (std::size_t i = 0; i < fileColumns.size() && written; ++i)
+	{
+		written = stream.addData(padding, fileColumns[i].offset - position)
+		          && stream.addData(arrays[i].data, fileColumns[i].size);
+		position = fileColumns[i].offset + fileColumns[i].size;
+	}
+
+	if (!written)
+	{
+		return fail("Failed to write graph file '" + filename + "'");
+	}
+
+	return true;
+}
+
+void GraphFile::addColumn(std::string name, ColumnType type, ArrayContext::ArrayID arrayID)
+{
+	Column column;
+	column.name = std::move(name);
+	column.type = type;
+	column.arrayID = arrayID;
+	columns.push_back(std::move(column));
+}
+
+const std::vector<GraphFile::Column> & GraphFile::getColumns() const
+{
+	return columns;
+}
+
+void GraphFile::addMetadata(std::string key, MetadataValue value)
+{
+	metadata.push_back(Metadata {std::move(key), std::move(value)});
+}
+
+const std::vector<GraphFile::Metadata> & GraphFile::getMetadata() const
+{
+	return metadata;
+}
+
+const std::string & GraphFile::getError() const
+{
+	return error;
+}
+
+bool GraphFile::fail(std::string message)
+{
+	error = std::move(message);
+	return false;
+}
+
+}
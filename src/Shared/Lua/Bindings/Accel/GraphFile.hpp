@@ -0,0 +1,101 @@
+#ifndef SRC_SHARED_LUA_BINDINGS_ACCEL_GRAPHFILE_HPP_
+#define SRC_SHARED_LUA_BINDINGS_ACCEL_GRAPHFILE_HPP_
+
+#include <Shared/Lua/Bindings/ArrayBinding.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace wosc
+{
+
+/**
+ * Binary columnar container for graph data.
+ *
+ * A graph file consists of a header, a column table, a metadata block and the column data. Each column is a flat
+ * array of a single element type, stored 64-byte aligned so it can be copied from the file mapping in one pass.
+ * Metadata holds named scalar values (numbers, strings and booleans).
+ *
+ * The container itself does not impose a schema; the set of columns making up a graph is defined by the scripts.
+ */
+class GraphFile
+{
+public:
+	/**
+	 * Element types, matching the array types in system.utils.Array.
+	 */
+	enum class ColumnType : std::uint32_t
+	{
+		Int8 = 1,
+		Int16 = 2,
+		Int32 = 3,
+		UInt8 = 4,
+		UInt16 = 5,
+		UInt32 = 6,
+		Float = 7,
+		Double = 8,
+	};
+
+	struct Column
+	{
+		std::string name;
+		ColumnType type = ColumnType::UInt8;
+		ArrayContext::ArrayID arrayID = 0;
+	};
+
+	struct MetadataValue
+	{
+		enum class Type : std::uint8_t
+		{
+			Number = 1,
+			String = 2,
+			Boolean = 3,
+		};
+
+		Type type = Type::Number;
+		double number = 0;
+		std::string string;
+		bool boolean = false;
+	};
+
+	struct Metadata
+	{
+		std::string key;
+		MetadataValue value;
+	};
+
+	static constexpr std::size_t MAX_COLUMN_NAME_LENGTH = 23;
+
+	/**
+	 * Maps the file into memory and copies every column into a new array of the specified context.
+	 *
+	 * Returns false and sets the error message if the file is missing or malformed. No arrays are left allocated in
+	 * that case.
+	 */
+	bool load(const std::string & filename, ArrayContext & context);
+
+	/**
+	 * Writes the currently held columns and metadata to the specified file. Column data is read from the arrays of
+	 * the specified context.
+	 */
+	bool save(const std::string & filename, const ArrayContext & context);
+
+	void addColumn(std::string name, ColumnType type, ArrayContext::ArrayID arrayID);
+	const std::vector<Column> & getColumns() const;
+
+	void addMetadata(std::string key, MetadataValue value);
+	const std::vector<Metadata> & getMetadata() const;
+
+	const std::string & getError() const;
+
+private:
+	bool fail(std::string message);
+
+	std::vector<Column> columns;
+	std::vector<Metadata> metadata;
+	std::string error;
+};
+
+}
+
+#endif
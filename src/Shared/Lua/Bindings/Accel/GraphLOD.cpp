@@ -0,0 +1,268 @@
+#include <Shared/Lua/Bindings/Accel/GraphLOD.hpp>
+#include <Shared/Utils/HashTable.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace wosc
+{
+
+// Cell coordinates are clamped to this range, so that keys cannot overflow
+static constexpr double maxCellCoord = 1 << 30;
+
+constexpr GraphLOD::ClusterID GraphLOD::noCluster;
+constexpr std::size_t GraphLOD::clusterStride;
+constexpr std::size_t GraphLOD::linkStride;
+
+static std::int32_t getParentCell(std::int32_t cell)
+{
+	// Rounds towards negative infinity, so that cells keep nesting across the origin
+	return cell >= 0 ? cell / 2 : -((-cell + 1) / 2);
+}
+
+void GraphLOD::Accumulator::add(const Accumulator & other)
+{
+	nodeCount += other.nodeCount;
+	area += other.area;
+	maxRadius = std::max(maxRadius, other.maxRadius);
+	weightedX += other.weightedX;
+	weightedY += other.weightedY;
+	plainX += other.plainX;
+	plainY += other.plainY;
+	for (std::size_t i = 0; i < 4; ++i)
+	{
+		weightedColor[i] += other.weightedColor[i];
+		plainColor[i] += other.plainColor[i];
+	}
+}
+
+void GraphLOD::build(const Input & input, double baseCellSize, std::size_t levelCount)
+{
+	clear();
+
+	if (!(baseCellSize > 0) || levelCount == 0)
+	{
+		return;
+	}
+
+	levels.reserve(levelCount);
+	buildFirstLevel(input, baseCellSize);
+	for (std::size_t i = 1; i < levelCount; ++i)
+	{
+		buildNextLevel(baseCellSize * std::pow(2.0, double(i)));
+	}
+
+	accumulators.clear();
+	accumulators.shrink_to_fit();
+	mergedLinks.clear();
+	mergedLinks.shrink_to_fit();
+}
+
+void GraphLOD::clear()
+{
+	levels.clear();
+	accumulators.clear();
+	mergedLinks.clear();
+}
+
+const std::vector<GraphLOD::Level> & GraphLOD::getLevels() const
+{
+	return levels;
+}
+
+void GraphLOD::buildFirstLevel(const Input & input, double cellSize)
+{
+	levels.emplace_back();
+	Level & level = levels.back();
+	level.cellSize = cellSize;
+	level.nodeClusters.assign(input.nodeCount, noCluster);
+
+	HashMap<std::uint64_t, ClusterID> clustersByCell;
+
+	auto toCell = [cellSize](double value) {
+		return static_cast<std::int32_t>(std::max(-maxCellCoord, std::min(maxCellCoord, std::floor(value / cellSize))));
+	};
+
+	for (std::size_t node = 0; node < input.nodeCount; ++node)
+	{
+		const double * circle = input.circles + node * 3;
+		double x = circle[0];
+		double y = circle[1];
+		double radius = std::max(circle[2], 0.0);
+		if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(radius))
+		{
+			continue;
+		}
+
+		std::int32_t cellX = toCell(x);
+		std::int32_t cellY = toCell(y);
+
+		auto inserted = clustersByCell.emplace(getCellKey(cellX, cellY), ClusterID(accumulators.size()));
+		if (inserted.second)
+		{
+			accumulators.emplace_back();
+			accumulators.back().cellX = cellX;
+			accumulators.back().cellY = cellY;
+		}
+
+		ClusterID cluster = inserted.first->second;
+		level.nodeClusters[node] = cluster;
+
+		std::uint32_t packedColor = std::uint32_t(std::int64_t(input.colors[node]));
+		double area = radius * radius;
+
+		Accumulator & acc = accumulators[cluster];
+		acc.nodeCount++;
+		acc.area += area;
+		acc.maxRadius = std::max(acc.maxRadius, radius);
+		acc.weightedX += x * area;
+		acc.weightedY += y * area;
+		acc.plainX += x;
+		acc.plainY += y;
+		for (std::size_t i = 0; i < 4; ++i)
+		{
+			double channel = (packedColor >> (i * 8)) & 0xFF;
+			acc.weightedColor[i] += channel * area;
+			acc.plainColor[i] += channel;
+		}
+	}
+
+	mergeLinks(input.linkCount, [&](std::size_t i) {
+		MergedLink link;
+		std::int32_t source = input.links[i * 2];
+		std::int32_t target = input.links[i * 2 + 1];
+		if (source >= 0 && target >= 0 && std::size_t(source) < input.nodeCount
+		    && std::size_t(target) < input.nodeCount)
+		{
+			link.source = level.nodeClusters[source];
+			link.target = level.nodeClusters[target];
+		}
+		link.weight = input.linkWeights ? input.linkWeights[i] : 1;
+		link.linkCount = 1;
+		return link;
+	});
+
+	finishLevel(level);
+}
+
+void GraphLOD::buildNextLevel(double cellSize)
+{
+	std::vector<ClusterID> parents(accumulators.size());
+	std::vector<Accumulator> parentAccumulators;
+	HashMap<std::uint64_t, ClusterID> clustersByCell;
+
+	for (std::size_t cluster = 0; cluster < accumulators.size(); ++cluster)
+	{
+		const Accumulator & child = accumulators[cluster];
+		std::int32_t cellX = getParentCell(child.cellX);
+		std::int32_t cellY = getParentCell(child.cellY);
+
+		auto inserted = clustersByCell.emplace(getCellKey(cellX, cellY), ClusterID(parentAccumulators.size()));
+		if (inserted.second)
+		{
+			parentAccumulators.emplace_back();
+			parentAccumulators.back().cellX = cellX;
+			parentAccumulators.back().cellY = cellY;
+		}
+
+		parents[cluster] = inserted.first->second;
+		parentAccumulators[parents[cluster]].add(child);
+	}
+
+	levels.emplace_back();
+	Level & level = levels.back();
+	const Level & previous = levels[levels.size() - 2];
+
+	level.cellSize = cellSize;
+	level.nodeClusters.resize(previous.nodeClusters.size());
+	std::transform(previous.nodeClusters.begin(), previous.nodeClusters.end(), level.nodeClusters.begin(),
+	               [&](ClusterID cluster) { return cluster == noCluster ? noCluster : parents[cluster]; });
+
+	accumulators = std::move(parentAccumulators);
+
+	std::vector<MergedLink> childLinks = std::move(mergedLinks);
+	mergeLinks(childLinks.size(), [&](std::size_t i) {
+		MergedLink link = childLinks[i];
+		link.source = parents[link.source];
+		link.target = parents[link.target];
+		return link;
+	});
+
+	finishLevel(level);
+}
+
+template <typename Func>
+void GraphLOD::mergeLinks(std::size_t linkCount, Func getLink)
+{
+	mergedLinks.clear();
+	HashMap<std::uint64_t, std::size_t> linksByPair;
+
+	for (std::size_t i = 0; i < linkCount; ++i)
+	{
+		MergedLink link = getLink(i);
+		if (link.source == noCluster || link.target == noCluster || link.source == link.target)
+		{
+			continue;
+		}
+
+		auto inserted = linksByPair.emplace(getPairKey(link.source, link.target), mergedLinks.size());
+		if (inserted.second)
+		{
+			mergedLinks.push_back(link);
+		}
+		else
+		{
+			MergedLink & merged = mergedLinks[inserted.first->second];
+			merged.weight += link.weight;
+			merged.linkCount += link.linkCount;
+		}
+	}
+}
+
+void GraphLOD::finishLevel(Level & level) const
+{
+	level.clusters.resize(accumulators.size() * clusterStride);
+	double * cluster = level.clusters.data();
+	for (const Accumulator & acc : accumulators)
+	{
+		bool weighted = acc.area > 0;
+		double divisor = weighted ? acc.area : double(acc.nodeCount);
+
+		std::uint32_t packedColor = 0;
+		for (std::size_t i = 0; i < 4; ++i)
+		{
+			double channel = (weighted ? acc.weightedColor[i] : acc.plainColor[i]) / divisor;
+			packedColor |= std::uint32_t(std::min(255.0, std::max(0.0, std::round(channel)))) << (i * 8);
+		}
+
+		cluster[0] = (weighted ? acc.weightedX : acc.plainX) / divisor;
+		cluster[1] = (weighted ? acc.weightedY : acc.plainY) / divisor;
+		cluster[2] = std::min(std::sqrt(acc.area), std::max(level.cellSize * 0.5, acc.maxRadius));
+		cluster[3] = std::int32_t(packedColor);
+		cluster[4] = acc.nodeCount;
+		cluster[5] = acc.area;
+		cluster += clusterStride;
+	}
+
+	level.links.resize(mergedLinks.size() * linkStride);
+	double * link = level.links.data();
+	for (const MergedLink & merged : mergedLinks)
+	{
+		link[0] = merged.source;
+		link[1] = merged.target;
+		link[2] = merged.weight;
+		link[3] = merged.linkCount;
+		link += linkStride;
+	}
+}
+
+std::uint64_t GraphLOD::getCellKey(std::int32_t x, std::int32_t y)
+{
+	return (std::uint64_t(std::uint32_t(x)) << 32) | std::uint32_t(y);
+}
+
+std::uint64_t GraphLOD::getPairKey(ClusterID source, ClusterID target)
+{
+	return (std::uint64_t(std::uint32_t(source)) << 32) | std::uint32_t(target);
+}
+
+}
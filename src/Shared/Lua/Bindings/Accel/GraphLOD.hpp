@@ -0,0 +1,130 @@
+#ifndef SRC_SHARED_LUA_BINDINGS_ACCEL_GRAPHLOD_HPP_
+#define SRC_SHARED_LUA_BINDINGS_ACCEL_GRAPHLOD_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace wosc
+{
+
+/**
+ * Screen-space level-of-detail hierarchy for drawn graphs.
+ *
+ * Nodes are clustered by the grid cell their center falls into, with the cell size doubling from one level to the
+ * next. Cells are aligned to the origin, so every cluster is contained in exactly one cluster of the next level, and
+ * coarser levels are computed from the clusters of the finer level rather than from the nodes. Links between
+ * different clusters are merged per ordered cluster pair; links within a cluster are dropped.
+ *
+ * Clusters are weighted by node area (radius squared): the cluster position and color channels are area-weighted
+ * averages, and the cluster radius preserves the total area, limited to half the cell size or the largest member.
+ */
+class GraphLOD
+{
+public:
+	using ClusterID = std::int32_t;
+
+	static constexpr ClusterID noCluster = -1;
+
+	// Per cluster: x, y, radius, packed color, node count, total area
+	static constexpr std::size_t clusterStride = 6;
+
+	// Per merged link: source cluster, target cluster, summed weight, link count
+	static constexpr std::size_t linkStride = 4;
+
+	struct Input
+	{
+		// Per node: x, y, radius. Nodes with non-finite values are not assigned to any cluster.
+		const double * circles = nullptr;
+
+		// Per node: packed RGBA color, as produced by color.rgba
+		const double * colors = nullptr;
+		std::size_t nodeCount = 0;
+
+		// Per link: zero-based source and target node indices
+		const std::int32_t * links = nullptr;
+
+		// Per link: weight, or null to weight all links equally
+		const double * linkWeights = nullptr;
+		std::size_t linkCount = 0;
+	};
+
+	struct Level
+	{
+		double cellSize = 0;
+		std::vector<double> clusters;
+		std::vector<double> links;
+		std::vector<ClusterID> nodeClusters;
+
+		inline std::size_t getClusterCount() const
+		{
+			return clusters.size() / clusterStride;
+		}
+
+		inline std::size_t getLinkCount() const
+		{
+			return links.size() / linkStride;
+		}
+	};
+
+	/**
+	 * Replaces the hierarchy with 'levelCount' levels, the first of which uses the specified cell size.
+	 */
+	void build(const Input & input, double baseCellSize, std::size_t levelCount);
+
+	void clear();
+
+	const std::vector<Level> & getLevels() const;
+
+private:
+	struct Accumulator
+	{
+		std::int32_t cellX = 0;
+		std::int32_t cellY = 0;
+		std::size_t nodeCount = 0;
+		double area = 0;
+		double maxRadius = 0;
+
+		// Area-weighted sums, with unweighted sums as a fallback for clusters of zero-radius nodes
+		double weightedX = 0;
+		double weightedY = 0;
+		double weightedColor[4] = {};
+		double plainX = 0;
+		double plainY = 0;
+		double plainColor[4] = {};
+
+		void add(const Accumulator & other);
+	};
+
+	struct MergedLink
+	{
+		ClusterID source = noCluster;
+		ClusterID target = noCluster;
+		double weight = 0;
+		std::size_t linkCount = 0;
+	};
+
+	void buildFirstLevel(const Input & input, double cellSize);
+	void buildNextLevel(double cellSize);
+
+	/**
+	 * Merges links between the clusters of the last level, given the source and target clusters of each link.
+	 */
+	template <typename Func>
+	void mergeLinks(std::size_t linkCount, Func getLink);
+
+	void finishLevel(Level & level) const;
+
+	static std::uint64_t getCellKey(std::int32_t x, std::int32_t y);
+	static std::uint64_t getPairKey(ClusterID source, ClusterID target);
+
+	std::vector<Level> levels;
+
+	// Accumulators and merged links of the last built level
+	std::vector<Accumulator> accumulators;
+	std::vector<MergedLink> mergedLinks;
+};
+
+}
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef SRC_SHARED_LUA_BINDINGS_ACCEL_GRAYSCALEFRAME_HPP_
+#define SRC_SHARED_LUA_BINDINGS_ACCEL_GRAYSCALEFRAME_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace wosc
+{
+
+/**
+ * Grayscale frame with one byte per pixel, row by row.
+ */
+struct GrayscaleFrame
+{
+	unsigned int width = 0;
+	unsigned int height = 0;
+	std::vector<std::uint8_t> pixels;
+};
+
+enum class PixelClass : std::uint8_t
+{
+	DefendingFluid,
+	InvadingFluid,
+	Solid,
+};
+
+/**
+ * Classifies the pixels of segmented frames by gray level.
+ */
+struct FrameSegmentation
+{
+	// Inclusive gray level ranges of invading fluid and solid pixels; all other pixels are defending fluid
+	std::uint8_t fluidMin = 128;
+	std::uint8_t fluidMax = 255;
+	std::uint8_t solidMin = 0;
+	std::uint8_t solidMax = 0;
+
+	// Fluid takes precedence if the ranges overlap
+	PixelClass classify(std::uint8_t value) const
+	{
+		if (value >= fluidMin && value <= fluidMax)
+		{
+			return PixelClass::InvadingFluid;
+		}
+		if (value >= solidMin && value <= solidMax)
+		{
+			return PixelClass::Solid;
+		}
+		return PixelClass::DefendingFluid;
+	}
+};
+
+/**
+ * Decodes the frame at the path. Called concurrently from pool threads; returns false if the frame is unreadable.
+ */
+using GrayscaleFrameLoader = std::function<bool(const std::string & path, GrayscaleFrame & frame)>;
+
+}
+
+#endif
@@ -0,0 +1,436 @@
+#include <Shared/Lua/Bindings/Accel/LayoutBinding.h>
+#include <Shared/Lua/Bindings/Accel/LayoutBinding.hpp>
+#include <Shared/Lua/Bindings/ArrayBinding.hpp>
+#include <Shared/Utils/Debug/Logger.hpp>
+#include <Shared/Utils/Error.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+using Coord = wosC_accel_layout_coord_t;
+using Index = wosC_accel_layout_index_t;
+using Flag = wosC_accel_layout_flag_t;
+
+using wosc::LayoutGraph;
+
+static const Coord overlapRepulsionFactor = 100;
+static const Coord minSpeedEfficiency = 0.05;
+static const Coord maxSpeed = 1000;
+
+static const Index quadTreeLeafCapacity = 8;
+static const int quadTreeMaxDepth = 24;
+
+static Logger logger()
+{
+	static Logger logInstance("LayoutAccelerator");
+	return logInstance;
+}
+
+template <typename EntryType>
+EntryType * getArrayGeneric(wosc::ArrayContext & context, wosC_array_id_t arrayID, Index expectedCount,
+                            const char * name)
+{
+	auto arrayInfo = context.getArrayInfo(arrayID);
+	auto expectedArrayLength = sizeof(EntryType) * expectedCount;
+	if (arrayInfo.data == nullptr || (std::size_t) arrayInfo.size != expectedArrayLength)
+	{
+		logger().error("Layout {} array size mismatch (expected array length: {}, actual array length: {})", name,
+		               expectedArrayLength, arrayInfo.size);
+		return nullptr;
+	}
+	if (!std::is_const<EntryType>::value && !context.isArrayWritable(arrayID))
+	{
+		logger().error("Layout {} array is read-only", name);
+		return nullptr;
+	}
+	return reinterpret_cast<EntryType *>(arrayInfo.data);
+}
+
+namespace wosc
+{
+
+LayoutGraph getLayoutGraph(const wosC_accel_layout_graph_t * graph)
+{
+	LayoutGraph wrapper;
+	try
+	{
+		auto & context = wosc::ArrayContext::getContextByID(graph->arrayContext);
+
+		if (graph->nodeCount <= 0 || graph->edgeCount < 0)
+		{
+			// Empty graph: do nothing
+			return wrapper;
+		}
+
+		auto positions = getArrayGeneric<Coord>(context, graph->positionArrayID, graph->nodeCount * 2, "position");
+		auto forces = getArrayGeneric<Coord>(context, graph->forceArrayID, graph->nodeCount * 4, "force");
+		auto masses = getArrayGeneric<const Coord>(context, graph->massArrayID, graph->nodeCount, "mass");
+		auto radii = getArrayGeneric<const Coord>(context, graph->radiusArrayID, graph->nodeCount, "radius");
+		auto fixed = getArrayGeneric<const Flag>(context, graph->fixedArrayID, graph->nodeCount, "fixed flag");
+		auto edges = graph->edgeCount == 0 ?
+		                 nullptr :
+		                 getArrayGeneric<const Index>(context, graph->edgeArrayID, graph->edgeCount * 2, "edge");
+
+		if (!positions || !forces || !masses || !radii || !fixed || (!edges && graph->edgeCount != 0))
+		{
+			return wrapper;
+		}
+
+		for (Index i = 0; i < graph->edgeCount * 2; ++i)
+		{
+			if (edges[i] < 0 || edges[i] >= graph->nodeCount)
+			{
+				logger().error("Layout edge {} references invalid node index {} (node count: {})", i / 2, edges[i],
+				               graph->nodeCount);
+				return wrapper;
+			}
+		}
+
+		wrapper.positions = positions;
+		wrapper.forces = forces;
+		wrapper.masses = masses;
+		wrapper.radii = radii;
+		wrapper.fixed = fixed;
+		wrapper.edges = edges;
+		wrapper.nodeCount = graph->nodeCount;
+		wrapper.edgeCount = graph->edgeCount;
+		return wrapper;
+	}
+	catch (std::exception & ex)
+	{
+		logger().error("Error retrieving layout graph data: {}", ex.what());
+		return wrapper;
+	}
+}
+
+}
+
+/**
+ * Computes the repulsion between two bodies, matching the radius-aware ForceAtlas2 variant used by the scripts:
+ * the node radii are subtracted from the distance, and overlapping nodes repel each other much more strongly.
+ */
+inline void addRepulsion(Coord dx, Coord dy, Coord radiusSum, Coord massProduct, Coord scalingRatio, Coord & forceX,
+                         Coord & forceY)
+{
+	Coord distance = std::sqrt(dx * dx + dy * dy) - radiusSum;
+	Coord factor = scalingRatio * massProduct;
+
+	if (distance > 0)
+	{
+		factor /= distance * distance;
+	}
+	else if (distance < 0)
+	{
+		factor *= overlapRepulsionFactor;
+	}
+
+	forceX += dx * factor;
+	forceY += dy * factor;
+}
+
+/**
+ * Barnes-Hut quadtree over the node positions of a layout graph.
+ */
+class QuadTree
+{
+public:
+	void build(LayoutGraph & graph)
+	{
+		cells.clear();
+		bodies.resize(graph.nodeCount);
+		for (Index i = 0; i < graph.nodeCount; ++i)
+		{
+			bodies[i] = i;
+		}
+
+		Coord minX = std::numeric_limits<Coord>::max(), minY = std::numeric_limits<Coord>::max();
+		Coord maxX = std::numeric_limits<Coord>::lowest(), maxY = std::numeric_limits<Coord>::lowest();
+		for (Index i = 0; i < graph.nodeCount; ++i)
+		{
+			minX = std::min(minX, graph.x(i));
+			minY = std::min(minY, graph.y(i));
+			maxX = std::max(maxX, graph.x(i));
+			maxY = std::max(maxY, graph.y(i));
+		}
+
+		buildCell(graph, 0, graph.nodeCount, minX, minY, std::max<Coord>(std::max(maxX - minX, maxY - minY), 1), 0);
+	}
+
+	void addRepulsion(LayoutGraph & graph, Index node, Coord theta, Coord scalingRatio, Coord & forceX,
+	                  Coord & forceY) const
+	{
+		if (!cells.empty())
+		{
+			addCellRepulsion(graph, 0, node, theta, scalingRatio, forceX, forceY);
+		}
+	}
+
+private:
+	struct Cell
+	{
+		Coord centerX = 0;
+		Coord centerY = 0;
+		Coord mass = 0;
+		Coord radius = 0;
+		Coord size = 0;
+
+		Index children[4] = {-1, -1, -1, -1};
+		Index bodyBegin = 0;
+		Index bodyEnd = 0;
+	};
+
+	Index buildCell(LayoutGraph & graph, Index begin, Index end, Coord minX, Coord minY, Coord size, int depth)
+	{
+		Index cellIndex = cells.size();
+		cells.emplace_back();
+		cells[cellIndex].size = size;
+		cells[cellIndex].bodyBegin = begin;
+		cells[cellIndex].bodyEnd = end;
+
+		if (end - begin > quadTreeLeafCapacity && depth < quadTreeMaxDepth)
+		{
+			Coord half = size / 2;
+			Coord midX = minX + half, midY = minY + half;
+
+			auto first = bodies.begin() + begin, last = bodies.begin() + end;
+			auto splitY = std::partition(first, last, [&](Index i) { return graph.y(i) < midY; });
+			auto splitTop = std::partition(first, splitY, [&](Index i) { return graph.x(i) < midX; });
+			auto splitBottom = std::partition(splitY, last, [&](Index i) { return graph.x(i) < midX; });
+
+			Index bounds[5] = {begin, Index(splitTop - bodies.begin()), Index(splitY - bodies.begin()),
+			                   Index(splitBottom - bodies.begin()), end};
+
+			for (int quadrant = 0; quadrant < 4; ++quadrant)
+			{
+				if (bounds[quadrant] < bounds[quadrant + 1])
+				{
+					Index child = buildCell(graph, bounds[quadrant], bounds[quadrant + 1],
+					                        (quadrant & 1) ? midX : minX, (quadrant & 2) ? midY : minY, half,
+					                        depth + 1);
+					cells[cellIndex].children[quadrant] = child;
+				}
+			}
+		}
+
+		// Accumulate center of mass and mass-weighted mean radius
+		Cell & cell = cells[cellIndex];
+		for (Index i = begin; i < end; ++i)
+		{
+			Index body = bodies[i];
+			Coord mass = graph.masses[body];
+			cell.mass += mass;
+			cell.centerX += graph.x(body) * mass;
+			cell.centerY += graph.y(body) * mass;
+			cell.radius += graph.radii[body] * mass;
+		}
+
+		if (cell.mass > 0)
+		{
+			cell.centerX /= cell.mass;
+			cell.centerY /= cell.mass;
+			cell.radius /= cell.mass;
+		}
+
+		return cellIndex;
+	}
+
+	void addCellRepulsion(LayoutGraph & graph, Index cellIndex, Index node, Coord theta, Coord scalingRatio,
+	                      Coord & forceX, Coord & forceY) const
+	{
+		const Cell & cell = cells[cellIndex];
+		bool leaf = cell.children[0] < 0 && cell.children[1] < 0 && cell.children[2] < 0 && cell.children[3] < 0;
+
+		if (leaf)
+		{
+			for (Index i = cell.bodyBegin; i < cell.bodyEnd; ++i)
+			{
+				Index other = bodies[i];
+				if (other != node)
+				{
+					::addRepulsion(graph.x(node) - graph.x(other), graph.y(node) - graph.y(other),
+					               graph.radii[node] + graph.radii[other], graph.masses[node] * graph.masses[other],
+					               scalingRatio, forceX, forceY);
+				}
+			}
+			return;
+		}
+
+		Coord dx = graph.x(node) - cell.centerX, dy = graph.y(node) - cell.centerY;
+		Coord distance = std::sqrt(dx * dx + dy * dy);
+
+		// Approximate distant cells by their center of mass, unless the node radii overlap with the cell
+		if (cell.size < theta * distance && distance > graph.radii[node] + cell.radius)
+		{
+			::addRepulsion(dx, dy, graph.radii[node] + cell.radius, graph.masses[node] * cell.mass, scalingRatio,
+			               forceX, forceY);
+			return;
+		}
+
+		for (Index child : cell.children)
+		{
+			if (child >= 0)
+			{
+				addCellRepulsion(graph, child, node, theta, scalingRatio, forceX, forceY);
+			}
+		}
+	}
+
+	std::vector<Cell> cells;
+	std::vector<Index> bodies;
+};
+
+void fa2Iteration(LayoutGraph & graph, LayoutGraph::Params & params, QuadTree & tree)
+{
+	for (Index i = 0; i < graph.nodeCount; ++i)
+	{
+		graph.oldForceX(i) = graph.forceX(i);
+		graph.oldForceY(i) = graph.forceY(i);
+		graph.forceX(i) = 0;
+		graph.forceY(i) = 0;
+	}
+
+	// Node-node repulsion
+	tree.build(graph);
+	for (Index i = 0; i < graph.nodeCount; ++i)
+	{
+		tree.addRepulsion(graph, i, params.barnesHutTheta, params.scalingRatio, graph.forceX(i), graph.forceY(i));
+	}
+
+	// Gravity towards the nearest of the two horizontal gravity lines
+	for (Index i = 0; i < graph.nodeCount; ++i)
+	{
+		Coord dist1 = graph.y(i) - params.gravityLine1;
+		Coord dist2 = graph.y(i) - params.gravityLine2;
+		Coord dist = std::abs(dist1) < std::abs(dist2) ? dist1 : dist2;
+
+		if (dist != 0)
+		{
+			Coord factor = params.scalingRatio * graph.masses[i] * params.gravity / std::abs(dist);
+			graph.forceY(i) -= dist * factor;
+		}
+	}
+
+	// Edge attraction
+	for (Index e = 0; e < graph.edgeCount; ++e)
+	{
+		Index n1 = graph.edges[e * 2], n2 = graph.edges[e * 2 + 1];
+		Coord dx = graph.x(n1) - graph.x(n2), dy = graph.y(n1) - graph.y(n2);
+		Coord distance = std::sqrt(dx * dx + dy * dy) - (graph.radii[n1] + graph.radii[n2]);
+
+		if (distance > 0)
+		{
+			Coord factor = -params.outboundCompensation / (0.5 * (graph.masses[n1] + graph.masses[n2]));
+			graph.forceX(n1) += dx * factor;
+			graph.forceY(n1) += dy * factor;
+			graph.forceX(n2) -= dx * factor;
+			graph.forceY(n2) -= dy * factor;
+		}
+	}
+
+	// Adjust speed
+	Coord totalSwinging = 0;
+	Coord totalEffectiveTraction = 0;
+	for (Index i = 0; i < graph.nodeCount; ++i)
+	{
+		if (!graph.isFixed(i))
+		{
+			Coord swingX = graph.oldForceX(i) - graph.forceX(i), swingY = graph.oldForceY(i) - graph.forceY(i);
+			Coord tractX = graph.oldForceX(i) + graph.forceX(i), tractY = graph.oldForceY(i) + graph.forceY(i);
+			totalSwinging += graph.masses[i] * std::sqrt(swingX * swingX + swingY * swingY);
+			totalEffectiveTraction += graph.masses[i] * 0.5 * std::sqrt(tractX * tractX + tractY * tractY);
+		}
+	}
+
+	Coord nodeCount = graph.nodeCount;
+	Coord estimatedOptimalJitterTolerance = 0.05 * std::sqrt(nodeCount);
+	Coord minJT = std::sqrt(estimatedOptimalJitterTolerance);
+	Coord jt = params.jitterTolerance
+	           * std::max(minJT, std::min<Coord>(10, estimatedOptimalJitterTolerance * totalEffectiveTraction
+	                                                     / (nodeCount * nodeCount)));
+
+	if (totalSwinging > 2.0 * totalEffectiveTraction)
+	{
+		if (params.speedEfficiency > minSpeedEfficiency)
+		{
+			params.speedEfficiency *= 0.5;
+		}
+
+		jt = std::max(jt, params.jitterTolerance);
+	}
+
+	Coord targetSpeed = totalSwinging > 0 ?
+	                        jt * params.speedEfficiency * totalEffectiveTraction / totalSwinging :
+	                        std::numeric_limits<Coord>::max();
+
+	if (totalSwinging > jt * totalEffectiveTraction)
+	{
+		if (params.speedEfficiency > minSpeedEfficiency)
+		{
+			params.speedEfficiency *= 0.7;
+		}
+	}
+	else if (params.speed < maxSpeed)
+	{
+		params.speedEfficiency *= 1.3;
+	}
+
+	params.speed += std::min(targetSpeed - params.speed, 0.5 * params.speed);
+
+	// Apply forces
+	for (Index i = 0; i < graph.nodeCount; ++i)
+	{
+		if (!graph.isFixed(i))
+		{
+			Coord swingX = graph.oldForceX(i) - graph.forceX(i), swingY = graph.oldForceY(i) - graph.forceY(i);
+			Coord swinging = graph.masses[i] * std::sqrt(swingX * swingX + swingY * swingY);
+			Coord factor = 0.1 * params.speed / (1 + std::sqrt(params.speed * swinging));
+
+			Coord df = std::sqrt(graph.forceX(i) * graph.forceX(i) + graph.forceY(i) * graph.forceY(i));
+			if (df > 0)
+			{
+				factor = std::min(factor * df, params.maxDisplacement) / df;
+				graph.x(i) += graph.forceX(i) * factor;
+				graph.y(i) += graph.forceY(i) * factor;
+			}
+		}
+	}
+
+	params.totalSwinging = totalSwinging;
+	params.totalEffectiveTraction = totalEffectiveTraction;
+}
+
+namespace wosc
+{
+
+void fa2Step(LayoutGraph & graph, LayoutGraph::Params & params, LayoutGraph::Index iterations)
+{
+	QuadTree tree;
+	for (Index i = 0; i < iterations; ++i)
+	{
+		if (params.resetSpeed)
+		{
+			params.speed = 1;
+			params.speedEfficiency = 1;
+		}
+
+		fa2Iteration(graph, params, tree);
+	}
+}
+
+}
+
+void wosC_accel_layout_fa2Step(wosC_accel_layout_graph_t * graph, wosC_accel_layout_fa2Params_t * params,
+                               wosC_accel_layout_index_t iterations)
+{
+	auto graphWrapper = wosc::getLayoutGraph(graph);
+	if (!graphWrapper)
+	{
+		logger().trace("Invalid layout graph passed to fa2Step");
+		return;
+	}
+
+	wosc::fa2Step(graphWrapper, *params, iterations);
+}
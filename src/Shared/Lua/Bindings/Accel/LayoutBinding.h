@@ -0,0 +1,77 @@
+#ifndef SRC_SHARED_LUA_BINDINGS_ACCEL_LAYOUTBINDING_H_
+#define SRC_SHARED_LUA_BINDINGS_ACCEL_LAYOUTBINDING_H_
+
+#include <Shared/Lua/Bindings/ArrayBinding.h>
+#include <Shared/Lua/Bindings/BindingAPI.hpp>
+
+extern "C"
+{
+
+	typedef double wosC_accel_layout_coord_t;
+	typedef int32_t wosC_accel_layout_index_t;
+	typedef uint8_t wosC_accel_layout_flag_t;
+
+	/**
+	 * Flat graph structure operated on by the layout accelerator.
+	 *
+	 * All arrays belong to the same array context:
+	 * - positions:  double[2 * nodeCount] (interleaved x/y, updated in place)
+	 * - forces:     double[4 * nodeCount] (interleaved current and previous force x/y, internal state)
+	 * - masses:     double[nodeCount]
+	 * - radii:      double[nodeCount]
+	 * - fixed:      uint8[nodeCount] (non-zero for nodes that are not moved by the layout)
+	 * - edges:      int32[2 * edgeCount] (zero-based node index pairs)
+	 */
+	typedef struct
+	{
+		wosC_array_context_t arrayContext;
+
+		wosC_array_id_t positionArrayID;
+		wosC_array_id_t forceArrayID;
+		wosC_array_id_t massArrayID;
+		wosC_array_id_t radiusArrayID;
+		wosC_array_id_t fixedArrayID;
+		wosC_array_id_t edgeArrayID;
+
+		wosC_accel_layout_index_t nodeCount;
+		wosC_accel_layout_index_t edgeCount;
+	} wosC_accel_layout_graph_t;
+
+	/**
+	 * ForceAtlas2 parameters and adaptive speed state.
+	 *
+	 * 'speed' and 'speedEfficiency' are read at the start of a step and written back afterwards, unless 'resetSpeed'
+	 * is set, in which case the speed adaptation restarts at 1 for every iteration. The total swinging and effective
+	 * traction of the last iteration are written back for convergence monitoring.
+	 */
+	typedef struct
+	{
+		wosC_accel_layout_coord_t scalingRatio;
+		wosC_accel_layout_coord_t gravity;
+		wosC_accel_layout_coord_t jitterTolerance;
+		wosC_accel_layout_coord_t outboundCompensation;
+		wosC_accel_layout_coord_t maxDisplacement;
+
+		wosC_accel_layout_coord_t gravityLine1;
+		wosC_accel_layout_coord_t gravityLine2;
+
+		wosC_accel_layout_coord_t barnesHutTheta;
+
+		wosC_accel_layout_coord_t speed;
+		wosC_accel_layout_coord_t speedEfficiency;
+		wosC_accel_layout_flag_t resetSpeed;
+
+		wosC_accel_layout_coord_t totalSwinging;
+		wosC_accel_layout_coord_t totalEffectiveTraction;
+	} wosC_accel_layout_fa2Params_t;
+
+	/**
+	 * Performs the specified number of ForceAtlas2 iterations on the graph, using a Barnes-Hut quadtree for
+	 * node-node repulsion (a theta of 0 computes exact repulsion).
+	 */
+	WOSC_API void wosC_accel_layout_fa2Step(wosC_accel_layout_graph_t * graph,
+	                                        wosC_accel_layout_fa2Params_t * params,
+	                                        wosC_accel_layout_index_t iterations);
+}
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef SRC_SHARED_LUA_BINDINGS_ACCEL_LAYOUTBINDING_HPP_
+#define SRC_SHARED_LUA_BINDINGS_ACCEL_LAYOUTBINDING_HPP_
+
+#include <Shared/Lua/Bindings/Accel/LayoutBinding.h>
+
+namespace wosc
+{
+
+/**
+ * Wrapper class for a flat layout graph
+ */
+struct LayoutGraph
+{
+	using Coord = wosC_accel_layout_coord_t;
+	using Index = wosC_accel_layout_index_t;
+	using Flag = wosC_accel_layout_flag_t;
+	using Params = wosC_accel_layout_fa2Params_t;
+
+	inline Coord & x(Index node)
+	{
+		return positions[node * 2];
+	}
+
+	inline Coord & y(Index node)
+	{
+		return positions[node * 2 + 1];
+	}
+
+	inline Coord & forceX(Index node)
+	{
+		return forces[node * 4];
+	}
+
+	inline Coord & forceY(Index node)
+	{
+		return forces[node * 4 + 1];
+	}
+
+	inline Coord & oldForceX(Index node)
+	{
+		return forces[node * 4 + 2];
+	}
+
+	inline Coord & oldForceY(Index node)
+	{
+		return forces[node * 4 + 3];
+	}
+
+	inline bool isFixed(Index node) const
+	{
+		return fixed[node] != 0;
+	}
+
+	inline operator bool() const
+	{
+		return positions != nullptr;
+	}
+
+	Coord * positions = nullptr;
+	Coord * forces = nullptr;
+	const Coord * masses = nullptr;
+	const Coord * radii = nullptr;
+	const Flag * fixed = nullptr;
+	const Index * edges = nullptr;
+
+	Index nodeCount = 0;
+	Index edgeCount = 0;
+};
+
+/**
+ * Resolves and validates the arrays of a layout graph structure. Returns an invalid wrapper on failure.
+ */
+LayoutGraph getLayoutGraph(const wosC_accel_layout_graph_t * graph);
+
+/**
+ * Performs the specified number of ForceAtlas2 iterations on a validated layout graph.
+ */
+void fa2Step(LayoutGraph & graph, LayoutGraph::Params & params, LayoutGraph::Index iterations);
+
+}
+
+#endif
@@ -0,0 +1,235 @@
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Time.hpp>
+#include <Shared/Lua/Bindings/Accel/LayoutWorker.hpp>
+#include <Shared/Utils/ThreadPool.hpp>
+#include <algorithm>
+#include <utility>
+
+namespace wosc
+{
+
+static const sf::Time batchDuration = sf::milliseconds(10);
+
+LayoutWorker::LayoutWorker(ThreadPool & threadPool) :
+	threadPool(threadPool)
+{
+}
+
+LayoutWorker::~LayoutWorker()
+{
+	stop();
+}
+
+bool LayoutWorker::start(const wosC_accel_layout_graph_t & graph, const Params & params, StopCondition stopCondition)
+{
+	stop();
+
+	auto source = getLayoutGraph(&graph);
+	if (!source)
+	{
+		return false;
+	}
+
+	// Batches still in flight keep the previous state alive until they finish
+	state = std::make_shared<State>();
+	state->params = params;
+	state->stopCondition = stopCondition;
+
+	state->positions.assign(source.positions, source.positions + source.nodeCount * 2);
+	state->forces.assign(source.forces, source.forces + source.nodeCount * 4);
+	state->masses.assign(source.masses, source.masses + source.nodeCount);
+	state->radii.assign(source.radii, source.radii + source.nodeCount);
+	state->fixed.assign(source.fixed, source.fixed + source.nodeCount);
+	state->edges.assign(source.edges, source.edges + source.edgeCount * 2);
+
+	state->graph.positions = state->positions.data();
+	state->graph.forces = state->forces.data();
+	state->graph.masses = state->masses.data();
+	state->graph.radii = state->radii.data();
+	state->graph.fixed = state->fixed.data();
+	state->graph.edges = state->edges.data();
+	state->graph.nodeCount = source.nodeCount;
+	state->graph.edgeCount = source.edgeCount;
+
+	state->running = true;
+	submitBatch(state, threadPool);
+
+	return true;
+}
+
+void LayoutWorker::stop()
+{
+	if (state)
+	{
+		std::lock_guard<std::mutex> lock(state->mutex);
+		state->running = false;
+		state->converged = false;
+	}
+}
+
+bool LayoutWorker::isRunning() const
+{
+	return state && state->running;
+}
+
+bool LayoutWorker::isConverged() const
+{
+	if (!state)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(state->mutex);
+	return state->converged;
+}
+
+bool LayoutWorker::updateRadii(const wosC_accel_layout_graph_t & graph)
+{
+	auto source = getLayoutGraph(&graph);
+	if (!state || !source || source.nodeCount != state->graph.nodeCount)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(state->mutex);
+	if (state->converged)
+	{
+		// No batch is in flight, so the worker's radii can be compared directly
+		if (std::equal(state->radii.begin(), state->radii.end(), source.radii))
+		{
+			return true;
+		}
+		state->converged = false;
+		state->iterationsSinceStart = 0;
+		state->running = true;
+		submitBatch(state, threadPool);
+	}
+	state->pendingRadii.assign(source.radii, source.radii + source.nodeCount);
+	state->radiiPending = true;
+	return true;
+}
+
+bool LayoutWorker::swapPositions(const wosC_accel_layout_graph_t & graph)
+{
+	auto target = getLayoutGraph(&graph);
+	if (!state || !target || target.nodeCount != state->graph.nodeCount)
+	{
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(state->mutex);
+	if (!state->snapshotReady)
+	{
+		return false;
+	}
+
+	std::copy(state->snapshot.begin(), state->snapshot.end(), target.positions);
+	state->snapshotReady = false;
+	return true;
+}
+
+double LayoutWorker::getIterationRate() const
+{
+	if (!state)
+	{
+		return 0;
+	}
+
+	std::lock_guard<std::mutex> lock(state->mutex);
+	return state->iterationRate;
+}
+
+double LayoutWorker::getTotalSwinging() const
+{
+	if (!state)
+	{
+		return 0;
+	}
+
+	std::lock_guard<std::mutex> lock(state->mutex);
+	return state->totalSwinging;
+}
+
+std::size_t LayoutWorker::getIterationCount() const
+{
+	if (!state)
+	{
+		return 0;
+	}
+
+	std::lock_guard<std::mutex> lock(state->mutex);
+	return state->iterationCount;
+}
+
+void LayoutWorker::submitBatch(std::shared_ptr<State> state, ThreadPool & threadPool)
+{
+	threadPool.submit([state, &threadPool]() {
+		runBatch(state, threadPool);
+	});
+}
+
+void LayoutWorker::runBatch(std::shared_ptr<State> state, ThreadPool & threadPool)
+{
+	if (!state->running)
+	{
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(state->mutex);
+		if (state->radiiPending)
+		{
+			std::swap(state->radii, state->pendingRadii);
+			state->graph.radii = state->radii.data();
+			state->radiiPending = false;
+		}
+	}
+
+	const auto & stopCondition = state->stopCondition;
+	auto isIterationLimitReached = [&](std::size_t iterations) {
+		return stopCondition.maxIterations > 0 &&
+		       state->iterationsSinceStart + iterations >= stopCondition.maxIterations;
+	};
+
+	sf::Clock clock;
+	std::size_t iterations = 0;
+	do
+	{
+		fa2Step(state->graph, state->params, 1);
+		++iterations;
+	} while (clock.getElapsedTime() < batchDuration && state->running && !isIterationLimitReached(iterations));
+
+	double elapsed = clock.getElapsedTime().asSeconds();
+	state->publishBuffer = state->positions;
+
+	bool converged = isIterationLimitReached(iterations) ||
+	                 state->params.totalSwinging < stopCondition.minSwinging * state->graph.nodeCount;
+	state->iterationsSinceStart += iterations;
+
+	bool resubmit;
+	{
+		std::lock_guard<std::mutex> lock(state->mutex);
+		std::swap(state->publishBuffer, state->snapshot);
+		state->snapshotReady = true;
+		state->iterationRate = elapsed > 0 ? iterations / elapsed : 0;
+		state->totalSwinging = state->params.totalSwinging;
+		state->iterationCount += iterations;
+
+		// A converged layout stops occupying a pool thread until its radii change
+		if (converged && state->running)
+		{
+			state->running = false;
+			state->converged = true;
+		}
+
+		// Decided under the lock, since updateRadii may resubmit a converged worker as soon as it is released
+		resubmit = state->running;
+	}
+
+	if (resubmit)
+	{
+		submitBatch(state, threadPool);
+	}
+}
+
+}
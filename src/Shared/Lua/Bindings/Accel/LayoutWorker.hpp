@@ -0,0 +1,115 @@
+#ifndef SRC_SHARED_LUA_BINDINGS_ACCEL_LAYOUTWORKER_HPP_
+#define SRC_SHARED_LUA_BINDINGS_ACCEL_LAYOUTWORKER_HPP_
+
+#include <Shared/Lua/Bindings/Accel/LayoutBinding.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+class ThreadPool;
+
+namespace wosc
+{
+
+/**
+ * Runs ForceAtlas2 iterations continuously on the thread pool, decoupled from the render loop.
+ *
+ * The worker operates on private copies of the graph arrays. After each batch of iterations, the current positions
+ * are published to a snapshot buffer, which the main thread can copy into its own position array at any time.
+ */
+class LayoutWorker
+{
+public:
+	using Coord = LayoutGraph::Coord;
+	using Index = LayoutGraph::Index;
+	using Params = LayoutGraph::Params;
+
+	/**
+	 * Determines when the worker considers the layout converged and stops iterating.
+	 */
+	struct StopCondition
+	{
+		// Maximum number of iterations after each (re)start, or 0 for no limit
+		std::size_t maxIterations = 0;
+
+		// Stops once the total swinging per node falls below this value
+		Coord minSwinging = 0;
+	};
+
+	LayoutWorker(ThreadPool & threadPool);
+	~LayoutWorker();
+
+	LayoutWorker(const LayoutWorker &) = delete;
+	LayoutWorker & operator=(const LayoutWorker &) = delete;
+
+	/**
+	 * Copies the graph data and starts iterating. Returns false if the graph is invalid.
+	 */
+	bool start(const wosC_accel_layout_graph_t & graph, const Params & params, StopCondition stopCondition);
+	void stop();
+	bool isRunning() const;
+
+	/**
+	 * Returns true if the worker stopped iterating because the stop condition was met.
+	 */
+	bool isConverged() const;
+
+	/**
+	 * Replaces the node radii used by the worker, starting with its next batch of iterations. A converged worker
+	 * resumes iterating if any radius changed.
+	 */
+	bool updateRadii(const wosC_accel_layout_graph_t & graph);
+
+	/**
+	 * Copies the latest position snapshot into the graph's position array. Returns false if no new snapshot was
+	 * available since the last swap.
+	 */
+	bool swapPositions(const wosC_accel_layout_graph_t & graph);
+
+	double getIterationRate() const;
+	double getTotalSwinging() const;
+	std::size_t getIterationCount() const;
+
+private:
+	struct State
+	{
+		std::atomic_bool running {false};
+
+		LayoutGraph graph;
+		Params params;
+		StopCondition stopCondition;
+
+		std::vector<Coord> positions;
+		std::vector<Coord> forces;
+		std::vector<Coord> masses;
+		std::vector<Coord> radii;
+		std::vector<LayoutGraph::Flag> fixed;
+		std::vector<Index> edges;
+
+		std::vector<Coord> publishBuffer;
+
+		std::mutex mutex;
+		std::vector<Coord> snapshot;
+		bool snapshotReady = false;
+		std::vector<Coord> pendingRadii;
+		bool radiiPending = false;
+		bool converged = false;
+		std::size_t iterationsSinceStart = 0;
+
+		double iterationRate = 0;
+		double totalSwinging = 0;
+		std::size_t iterationCount = 0;
+	};
+
+	static void submitBatch(std::shared_ptr<State> state, ThreadPool & threadPool);
+	static void runBatch(std::shared_ptr<State> state, ThreadPool & threadPool);
+
+	ThreadPool & threadPool;
+	std::shared_ptr<State> state;
+};
+
+}
+
+#endif
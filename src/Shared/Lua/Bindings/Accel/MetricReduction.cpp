@@ -0,0 +1,304 @@
+#include <Shared/Lua/Bindings/Accel/MetricReduction.hpp>
+#include <Shared/Utils/ThreadPool.hpp>
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace wosc
+{
+
+using Operation = MetricReduction::Operation;
+
+// Inputs smaller than this are always reduced on the calling thread
+static constexpr std::size_t parallelThreshold = 1 << 16;
+static constexpr std::size_t minChunkSize = 1 << 14;
+
+// Number of independent accumulators for the value range, allowing the compiler to vectorize the loop
+static constexpr std::size_t laneCount = 8;
+
+static constexpr double infinity = std::numeric_limits<double>::infinity();
+
+namespace
+{
+
+struct Partial
+{
+	std::vector<double> accumulators;
+	std::vector<std::int32_t> rowCounts;
+	std::vector<std::int32_t> valueCounts;
+
+	double valueMin = infinity;
+	double valueMax = -infinity;
+	std::size_t skippedRows = 0;
+};
+
+double getIdentity(Operation operation)
+{
+	switch (operation)
+	{
+	case Operation::Max:
+		return -infinity;
+	case Operation::Min:
+		return infinity;
+	default:
+		return 0;
+	}
+}
+
+template <Operation operation>
+void accumulateRows(const MetricReduction::Input & input, std::size_t begin, std::size_t end, Partial & partial)
+{
+	double * accumulators = partial.accumulators.data();
+	std::int32_t * rowCounts = partial.rowCounts.data();
+	std::int32_t * valueCounts = partial.valueCounts.data();
+	std::uint64_t bucketCount = partial.accumulators.size();
+
+	for (std::size_t i = begin; i < end; ++i)
+	{
+		// Negative bucket indices wrap around and are rejected by the same comparison
+		std::uint64_t bucket = std::int64_t(input.times[i]) - input.timeOffset;
+		if (bucket >= bucketCount)
+		{
+			partial.skippedRows++;
+			continue;
+		}
+
+		rowCounts[bucket]++;
+
+		if (operation == Operation::Count)
+		{
+			continue;
+		}
+
+		double value = input.values[i];
+		if (value != value)
+		{
+			continue;
+		}
+
+		valueCounts[bucket]++;
+
+		double & accumulator = accumulators[bucket];
+		if (operation == Operation::Max)
+		{
+			accumulator = value > accumulator ? value : accumulator;
+		}
+		else if (operation == Operation::Min)
+		{
+			accumulator = value < accumulator ? value : accumulator;
+		}
+		else
+		{
+			accumulator += value;
+		}
+	}
+}
+
+void accumulateValueRange(const double * values, std::size_t begin, std::size_t end, Partial & partial)
+{
+	double laneMin[laneCount];
+	double laneMax[laneCount];
+	std::fill_n(laneMin, laneCount, infinity);
+	std::fill_n(laneMax, laneCount, -infinity);
+
+	// NaN fails both comparisons, so missing values leave the accumulators unchanged
+	std::size_t i = begin;
+	for (; i + laneCount <= end; i += laneCount)
+	{
+		for (std::size_t lane = 0; lane < laneCount; ++lane)
+		{
+			double value = values[i + lane];
+			laneMin[lane] = value < laneMin[lane] ? value : laneMin[lane];
+			laneMax[lane] = value > laneMax[lane] ? value : laneMax[lane];
+		}
+	}
+	for (; i < end; ++i)
+	{
+		double value = values[i];
+		laneMin[0] = value < laneMin[0] ? value : laneMin[0];
+		laneMax[0] = value > laneMax[0] ? value : laneMax[0];
+	}
+
+	for (std::size_t lane = 0; lane < laneCount; ++lane)
+	{
+		partial.valueMin = std::min(partial.valueMin, laneMin[lane]);
+		partial.valueMax = std::max(partial.valueMax, laneMax[lane]);
+	}
+}
+
+void reduceChunk(Operation operation, const MetricReduction::Input & input, std::size_t begin, std::size_t end,
+                 std::size_t bucketCount, Partial & partial)
+{
+	partial.accumulators.assign(bucketCount, getIdentity(operation));
+	partial.rowCounts.assign(bucketCount, 0);
+	partial.valueCounts.assign(bucketCount, 0);
+
+	switch (operation)
+	{
+	case Operation::Sum:
+	case Operation::Mean:
+		accumulateRows<Operation::Sum>(input, begin, end, partial);
+		break;
+	case Operation::Max:
+		accumulateRows<Operation::Max>(input, begin, end, partial);
+		break;
+	case Operation::Min:
+		accumulateRows<Operation::Min>(input, begin, end, partial);
+		break;
+	case Operation::Count:
+		accumulateRows<Operation::Count>(input, begin, end, partial);
+		break;
+	}
+
+	if (input.values)
+	{
+		accumulateValueRange(input.values, begin, end, partial);
+	}
+}
+
+void mergeChunk(Operation operation, Partial & target, const Partial & source)
+{
+	std::size_t bucketCount = target.accumulators.size();
+	double * accumulators = target.accumulators.data();
+	const double * sourceAccumulators = source.accumulators.data();
+
+	for (std::size_t i = 0; i < bucketCount; ++i)
+	{
+		target.rowCounts[i] += source.rowCounts[i];
+		target.valueCounts[i] += source.valueCounts[i];
+	}
+
+	switch (operation)
+	{
+	case Operation::Max:
+		for (std::size_t i = 0; i < bucketCount; ++i)
+		{
+			accumulators[i] = sourceAccumulators[i] > accumulators[i] ? sourceAccumulators[i] : accumulators[i];
+		}
+		break;
+	case Operation::Min:
+		for (std::size_t i = 0; i < bucketCount; ++i)
+		{
+			accumulators[i] = sourceAccumulators[i] < accumulators[i] ? sourceAccumulators[i] : accumulators[i];
+		}
+		break;
+	default:
+		for (std::size_t i = 0; i < bucketCount; ++i)
+		{
+			accumulators[i] += sourceAccumulators[i];
+		}
+		break;
+	}
+
+	target.valueMin = std::min(target.valueMin, source.valueMin);
+	target.valueMax = std::max(target.valueMax, source.valueMax);
+	target.skippedRows += source.skippedRows;
+}
+
+}
+
+MetricReduction::Result MetricReduction::reduce(Operation operation, const Input & input, const Output & output,
+                                                ThreadPool * threadPool)
+{
+	Result result;
+
+	std::size_t bucketCount = output.bucketCount;
+	std::size_t rowCount = input.rowCount;
+	if (operation != Operation::Count && input.values == nullptr)
+	{
+		rowCount = 0;
+	}
+
+	// Every chunk reduces into its own set of buckets, which only pays off if there are far more rows than buckets
+	std::size_t chunkCount = 1;
+	if (threadPool && rowCount >= parallelThreshold)
+	{
+		chunkCount = std::min(threadPool->getThreadCount() + 1, rowCount / minChunkSize);
+		chunkCount = std::min(chunkCount, rowCount / std::max<std::size_t>(bucketCount * 4, 1));
+		chunkCount = std::max<std::size_t>(chunkCount, 1);
+	}
+
+	std::size_t chunkSize = (rowCount + chunkCount - 1) / chunkCount;
+	std::vector<Partial> partials(chunkCount);
+
+	auto processChunks = [&](std::size_t first, std::size_t last) {
+		for (std::size_t chunk = first; chunk < last; ++chunk)
+		{
+			std::size_t begin = std::min(chunk * chunkSize, rowCount);
+			std::size_t end = std::min(begin + chunkSize, rowCount);
+			reduceChunk(operation, input, begin, end, bucketCount, partials[chunk]);
+		}
+	};
+
+	if (chunkCount > 1)
+	{
+		threadPool->parallelFor(chunkCount, 1, processChunks);
+	}
+	else
+	{
+		processChunks(0, 1);
+	}
+
+	Partial & total = partials[0];
+	for (std::size_t chunk = 1; chunk < chunkCount; ++chunk)
+	{
+		mergeChunk(operation, total, partials[chunk]);
+	}
+
+	for (std::size_t i = 0; i < bucketCount; ++i)
+	{
+		double value;
+		switch (operation)
+		{
+		case Operation::Count:
+			value = total.rowCounts[i];
+			break;
+		case Operation::Mean:
+			value = total.valueCounts[i] > 0 ? total.accumulators[i] / total.valueCounts[i] : 0;
+			break;
+		default:
+			value = total.valueCounts[i] > 0 ? total.accumulators[i] : 0;
+			break;
+		}
+		output.buckets[i] = value;
+	}
+
+	if (output.rowCounts)
+	{
+		std::copy(total.rowCounts.begin(), total.rowCounts.end(), output.rowCounts);
+	}
+
+	double bucketMin = infinity;
+	double bucketMax = -infinity;
+	for (std::size_t i = 0; i < bucketCount; ++i)
+	{
+		if (total.rowCounts[i] > 0)
+		{
+			bucketMin = std::min(bucketMin, output.buckets[i]);
+			bucketMax = std::max(bucketMax, output.buckets[i]);
+			result.populatedBuckets++;
+		}
+	}
+
+	if (result.populatedBuckets > 0)
+	{
+		result.min = bucketMin;
+		result.max = bucketMax;
+	}
+
+	if (total.valueMin <= total.valueMax)
+	{
+		result.valueMin = total.valueMin;
+		result.valueMax = total.valueMax;
+	}
+
+	result.skippedRows = total.skippedRows;
+	return result;
+}
+
+bool MetricReduction::isValidOperation(int operation)
+{
+	return operation >= static_cast<int>(Operation::Sum) && operation <= static_cast<int>(Operation::Count);
+}
+
+}
@@ -0,0 +1,80 @@
+#ifndef SRC_SHARED_LUA_BINDINGS_ACCEL_METRICREDUCTION_HPP_
+#define SRC_SHARED_LUA_BINDINGS_ACCEL_METRICREDUCTION_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+class ThreadPool;
+
+namespace wosc
+{
+
+/**
+ * Group-by-timestep reductions over flat per-node columns.
+ *
+ * Each row consists of a time step and a value. Rows are assigned to the bucket (time - timeOffset) and reduced into
+ * a dense array with one value per bucket, in a single pass over the input. Rows outside [0, bucketCount) are skipped.
+ *
+ * NaN values mark missing entries: they count towards their bucket's row count, but are otherwise ignored. Buckets
+ * without any present value are set to 0.
+ */
+class MetricReduction
+{
+public:
+	enum class Operation
+	{
+		Sum = 1,
+		Max = 2,
+		Min = 3,
+		Mean = 4,
+		Count = 5,
+	};
+
+	struct Input
+	{
+		const std::int32_t * times = nullptr;
+
+		// May be null for Operation::Count
+		const double * values = nullptr;
+
+		std::size_t rowCount = 0;
+		std::int32_t timeOffset = 0;
+	};
+
+	struct Output
+	{
+		double * buckets = nullptr;
+
+		// Optional, receives the number of rows per bucket
+		std::int32_t * rowCounts = nullptr;
+
+		std::size_t bucketCount = 0;
+	};
+
+	struct Result
+	{
+		// Range of the reduced values, over all buckets containing at least one row
+		double min = 0;
+		double max = 0;
+
+		// Range of all present input values, including skipped rows
+		double valueMin = 0;
+		double valueMax = 0;
+
+		std::size_t populatedBuckets = 0;
+		std::size_t skippedRows = 0;
+	};
+
+	/**
+	 * Performs the reduction. If a thread pool is specified, large inputs are split into chunks that are reduced in
+	 * parallel and merged afterwards.
+	 */
+	static Result reduce(Operation operation, const Input & input, const Output & output,
+	                     ThreadPool * threadPool = nullptr);
+
+	static bool isValidOperation(int operation);
+};
+
+}
+
+#endif
@@ -0,0 +1,333 @@
+#include <Shared/Lua/Bindings/Accel/SVGWriter.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+#include <zlib.h>
+
+namespace wosc
+{
+
+static constexpr std::size_t bufferCapacity = 1 << 18;
+
+// Upper bound on the length of a single formatted element, used to flush the buffer ahead of time
+static constexpr std::size_t maxElementLength = 512;
+
+static constexpr int maxPrecision = 9;
+
+static const char hexDigits[] = "0123456789abcdef";
+
+SVGWriter::SVGWriter()
+{
+}
+
+SVGWriter::~SVGWriter()
+{
+	if (isOpen())
+	{
+		close();
+	}
+}
+
+bool SVGWriter::open(const std::string & filename, double width, double height, bool compress, int precision)
+{
+	if (isOpen())
+	{
+		close();
+	}
+
+	error.clear();
+	elementCount = 0;
+	bufferSize = 0;
+	buffer.resize(bufferCapacity);
+
+	this->precision = std::max(0, std::min(precision, maxPrecision));
+	precisionScale = std::pow(10.0, this->precision);
+
+	if (compress)
+	{
+		compressedFile = gzopen(filename.c_str(), "wb6");
+		if (compressedFile == nullptr)
+		{
+			return fail("Failed to open '" + filename + "' for writing");
+		}
+		gzbuffer(compressedFile, bufferCapacity);
+	}
+	else
+	{
+		file = std::fopen(filename.c_str(), "wb");
+		if (file == nullptr)
+		{
+			return fail("Failed to open '" + filename + "' for writing");
+		}
+	}
+
+	append("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<svg");
+	appendAttribute("width", width);
+	appendAttribute("height", height);
+	append(" fill=\"transparent\" stroke=\"#000000\" version=\"1.1\" xmlns=\"http://www.w3.org/2000/svg\">\n");
+
+	return true;
+}
+
+bool SVGWriter::write(ElementType type, const double * values, std::size_t count)
+{
+	if (!isOpen())
+	{
+		return error.empty() ? fail("Writer is not open") : false;
+	}
+
+	std::size_t stride = getStride(type);
+	if (stride == 0)
+	{
+		return fail("Invalid element type");
+	}
+
+	for (std::size_t i = 0; i < count; ++i, values += stride)
+	{
+		if (bufferSize + maxElementLength > buffer.size() && !flush())
+		{
+			return false;
+		}
+
+		switch (type)
+		{
+		case ElementType::Circle:
+			append("<circle");
+			appendAttribute("cx", values[0]);
+			appendAttribute("cy", values[1]);
+			appendAttribute("r", values[2]);
+			appendColorAttribute("stroke", values[3]);
+			appendAttribute("stroke-width", values[4]);
+			appendColorAttribute("fill", values[5]);
+			break;
+
+		case ElementType::Line:
+			append("<line");
+			appendAttribute("x1", values[0]);
+			appendAttribute("y1", values[1]);
+			appendAttribute("x2", values[2]);
+			appendAttribute("y2", values[3]);
+			appendColorAttribute("stroke", values[4]);
+			appendAttribute("stroke-width", values[5]);
+			break;
+
+		case ElementType::Rect:
+			append("<rect");
+			appendAttribute("x", values[0]);
+			appendAttribute("y", values[1]);
+			appendAttribute("width", values[2]);
+			appendAttribute("height", values[3]);
+			appendColorAttribute("stroke", values[4]);
+			appendAttribute("stroke-width", values[5]);
+			appendColorAttribute("fill", values[6]);
+			break;
+		}
+
+		append("/>\n");
+	}
+
+	elementCount += count;
+	return true;
+}
+
+bool SVGWriter::close()
+{
+	if (!isOpen())
+	{
+		return false;
+	}
+
+	append("</svg>\n");
+	bool success = flush();
+
+	if (compressedFile)
+	{
+		success = gzclose(compressedFile) == Z_OK && success;
+		compressedFile = nullptr;
+	}
+	else
+	{
+		success = std::fclose(file) == 0 && success;
+		file = nullptr;
+	}
+
+	buffer.clear();
+	buffer.shrink_to_fit();
+
+	if (!success && error.empty())
+	{
+		return fail("Failed to finish writing file");
+	}
+	return success;
+}
+
+bool SVGWriter::isOpen() const
+{
+	return file != nullptr || compressedFile != nullptr;
+}
+
+std::size_t SVGWriter::getElementCount() const
+{
+	return elementCount;
+}
+
+const std::string & SVGWriter::getError() const
+{
+	return error;
+}
+
+std::size_t SVGWriter::getStride(ElementType type)
+{
+	switch (type)
+	{
+	case ElementType::Circle:
+		return 6;
+	case ElementType::Line:
+		return 6;
+	case ElementType::Rect:
+		return 7;
+	default:
+		return 0;
+	}
+}
+
+void SVGWriter::append(const char * string, std::size_t length)
+{
+	if (bufferSize + length > buffer.size())
+	{
+		buffer.resize(bufferSize + length);
+	}
+	std::memcpy(buffer.data() + bufferSize, string, length);
+	bufferSize += length;
+}
+
+void SVGWriter::append(const char * string)
+{
+	append(string, std::strlen(string));
+}
+
+void SVGWriter::appendNumber(double value)
+{
+	char digits[32];
+	std::size_t length = 0;
+
+	double scaled = value * precisionScale;
+	if (!std::isfinite(value) || std::abs(scaled) >= 1e15)
+	{
+		int written = std::snprintf(digits, sizeof(digits), "%.15g", std::isfinite(value) ? value : 0.0);
+		append(digits, written > 0 ? std::min<std::size_t>(written, sizeof(digits) - 1) : 0);
+		return;
+	}
+
+	// Fixed-point formatting with trailing zeros removed, which is considerably faster than printf
+	std::int64_t rounded = std::llround(scaled);
+	bool negative = rounded < 0;
+	std::uint64_t magnitude = negative ? -rounded : rounded;
+	std::uint64_t divisor = static_cast<std::uint64_t>(precisionScale);
+	std::uint64_t integral = magnitude / divisor;
+	std::uint64_t fraction = magnitude % divisor;
+
+	int fractionDigits = precision;
+	while (fractionDigits > 0 && fraction % 10 == 0)
+	{
+		fraction /= 10;
+		fractionDigits--;
+	}
+
+	// Digits are produced back to front
+	char * end = digits + sizeof(digits);
+	char * pos = end;
+	for (int i = 0; i < fractionDigits; ++i)
+	{
+		*--pos = '0' + fraction % 10;
+		fraction /= 10;
+	}
+	if (fractionDigits > 0)
+	{
+		*--pos = '.';
+	}
+	do
+	{
+		*--pos = '0' + integral % 10;
+		integral /= 10;
+	} while (integral > 0);
+	if (negative && magnitude != 0)
+	{
+		*--pos = '-';
+	}
+
+	length = end - pos;
+	append(pos, length);
+}
+
+void SVGWriter::appendAttribute(const char * name, double value)
+{
+	append(" ");
+	append(name);
+	append("=\"");
+	appendNumber(value);
+	append("\"");
+}
+
+void SVGWriter::appendColorAttribute(const char * name, double packedColor)
+{
+	std::uint32_t color = static_cast<std::uint32_t>(static_cast<std::int64_t>(packedColor));
+	std::uint32_t alpha = color >> 24;
+
+	append(" ");
+	append(name);
+
+	if (alpha == 0)
+	{
+		append("=\"transparent\"");
+		return;
+	}
+
+	char hex[] = "=\"#000000\"";
+	for (int channel = 0; channel < 3; ++channel)
+	{
+		std::uint32_t value = (color >> (channel * 8)) & 0xFF;
+		hex[3 + channel * 2] = hexDigits[value >> 4];
+		hex[4 + channel * 2] = hexDigits[value & 0xF];
+	}
+	append(hex, sizeof(hex) - 1);
+
+	if (alpha < 255)
+	{
+		append(" ");
+		append(name);
+		append("-opacity=\"");
+		appendNumber(alpha / 255.0);
+		append("\"");
+	}
+}
+
+bool SVGWriter::flush()
+{
+	if (bufferSize == 0)
+	{
+		return true;
+	}
+
+	bool success;
+	if (compressedFile)
+	{
+		success = gzwrite(compressedFile, buffer.data(), bufferSize) == static_cast<int>(bufferSize);
+	}
+	else
+	{
+		success = std::fwrite(buffer.data(), 1, bufferSize, file) == bufferSize;
+	}
+
+	bufferSize = 0;
+	return success ? true : fail("Failed to write to file");
+}
+
+bool SVGWriter::fail(std::string message)
+{
+	error = std::move(message);
+	return false;
+}
+
+}
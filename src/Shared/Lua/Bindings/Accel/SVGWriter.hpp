@@ -0,0 +1,96 @@
+#ifndef SRC_SHARED_LUA_BINDINGS_ACCEL_SVGWRITER_HPP_
+#define SRC_SHARED_LUA_BINDINGS_ACCEL_SVGWRITER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+struct gzFile_s;
+
+namespace wosc
+{
+
+/**
+ * Streams SVG documents to a file, optionally gzip-compressed (.svgz).
+ *
+ * Elements are passed as flat arrays of doubles with a fixed number of values per element (see ElementType), so whole
+ * batches of primitives can be written without building intermediate strings. Colors are packed 32-bit RGBA values,
+ * in the layout used by system.utils.Color. Fully transparent colors are written as "transparent".
+ */
+class SVGWriter
+{
+public:
+	/**
+	 * Element types and their per-element values:
+	 *
+	 * - Circle: cx, cy, r, strokeColor, strokeWidth, fillColor
+	 * - Line:   x1, y1, x2, y2, strokeColor, strokeWidth
+	 * - Rect:   x, y, width, height, strokeColor, strokeWidth, fillColor
+	 */
+	enum class ElementType
+	{
+		Circle = 1,
+		Line = 2,
+		Rect = 3,
+	};
+
+	SVGWriter();
+	~SVGWriter();
+
+	SVGWriter(const SVGWriter &) = delete;
+	SVGWriter & operator=(const SVGWriter &) = delete;
+
+	/**
+	 * Opens the file and writes the document header. Numbers are written with up to 'precision' decimal places.
+	 */
+	bool open(const std::string & filename, double width, double height, bool compress, int precision = 3);
+
+	/**
+	 * Writes 'count' elements of the specified type, reading getStride(type) values per element.
+	 */
+	bool write(ElementType type, const double * values, std::size_t count);
+
+	/**
+	 * Writes the document footer and closes the file.
+	 */
+	bool close();
+
+	bool isOpen() const;
+
+	std::size_t getElementCount() const;
+
+	const std::string & getError() const;
+
+	/**
+	 * Returns the number of values per element of the specified type, or 0 for invalid types.
+	 */
+	static std::size_t getStride(ElementType type);
+
+private:
+	void append(const char * string, std::size_t length);
+	void append(const char * string);
+	void appendNumber(double value);
+	void appendAttribute(const char * name, double value);
+	void appendColorAttribute(const char * name, double packedColor);
+
+	bool flush();
+	bool fail(std::string message);
+
+	std::FILE * file = nullptr;
+	gzFile_s * compressedFile = nullptr;
+
+	std::vector<char> buffer;
+	std::size_t bufferSize = 0;
+
+	int precision = 3;
+	double precisionScale = 1000;
+
+	std::size_t elementCount = 0;
+	std::string error;
+};
+
+}
+
+#endif
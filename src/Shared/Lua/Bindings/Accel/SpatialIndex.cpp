@@ -0,0 +1,392 @@
+#include <Shared/Lua/Bindings/Accel/SpatialIndex.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace wosc
+{
+
+// Elements covering more cells than this are tested by every query instead of being stored in the grid
+static constexpr std::size_t maxCellsPerElement = 64;
+
+// Cell coordinates are clamped to this range, so that keys and cell counts cannot overflow
+static constexpr double maxCellCoord = 1 << 30;
+
+constexpr SpatialIndex::ElementID SpatialIndex::noElement;
+
+SpatialIndex::SpatialIndex(double cellSize) :
+	cellSize(cellSize > 0 ? cellSize : 1),
+	inverseCellSize(1 / this->cellSize)
+{
+}
+
+void SpatialIndex::setCircle(ElementID id, double x, double y, double radius)
+{
+	Element element;
+	element.shape = Shape::Circle;
+	element.x1 = element.x2 = x;
+	element.y1 = element.y2 = y;
+	element.radius = std::max(radius, 0.0);
+	setElement(id, element);
+}
+
+void SpatialIndex::setSegment(ElementID id, double x1, double y1, double x2, double y2, double halfWidth)
+{
+	Element element;
+	element.shape = Shape::Segment;
+	element.x1 = x1;
+	element.y1 = y1;
+	element.x2 = x2;
+	element.y2 = y2;
+	element.radius = std::max(halfWidth, 0.0);
+	setElement(id, element);
+}
+
+void SpatialIndex::remove(ElementID id)
+{
+	if (id < 0 || std::size_t(id) >= elements.size() || elements[id].shape == Shape::None)
+	{
+		return;
+	}
+
+	unlink(id);
+	elements[id].shape = Shape::None;
+	elementCount--;
+}
+
+void SpatialIndex::truncate(ElementID count)
+{
+	count = std::max<ElementID>(count, 0);
+	for (std::size_t id = count; id < elements.size(); ++id)
+	{
+		remove(id);
+	}
+	if (std::size_t(count) < elements.size())
+	{
+		elements.resize(count);
+	}
+}
+
+void SpatialIndex::clear()
+{
+	elements.clear();
+	elementCount = 0;
+	cells.clear();
+	oversizedElements.clear();
+}
+
+std::size_t SpatialIndex::getElementCount() const
+{
+	return elementCount;
+}
+
+SpatialIndex::Shape SpatialIndex::getShape(ElementID id) const
+{
+	return id >= 0 && std::size_t(id) < elements.size() ? elements[id].shape : Shape::None;
+}
+
+SpatialIndex::ElementID SpatialIndex::pick(double x, double y, double tolerance) const
+{
+	tolerance = std::max(tolerance, 0.0);
+
+	ElementID bestID = noElement;
+	double bestDistance = std::numeric_limits<double>::infinity();
+	bool bestIsCircle = false;
+
+	forEachCandidate(getCellRange(x - tolerance, y - tolerance, x + tolerance, y + tolerance), [&](ElementID id) {
+		const Element & element = elements[id];
+		double distance = getDistance(element, x, y);
+		if (distance > tolerance)
+		{
+			return;
+		}
+
+		// All elements containing the point are equally close
+		distance = std::max(distance, 0.0);
+		bool isCircle = element.shape == Shape::Circle;
+
+		if (distance < bestDistance
+		    || (distance == bestDistance && (isCircle > bestIsCircle || (isCircle == bestIsCircle && id > bestID))))
+		{
+			bestID = id;
+			bestDistance = distance;
+			bestIsCircle = isCircle;
+		}
+	});
+
+	return bestID;
+}
+
+void SpatialIndex::queryRect(double minX, double minY, double maxX, double maxY,
+                             std::vector<ElementID> & result) const
+{
+	if (!(minX <= maxX && minY <= maxY))
+	{
+		return;
+	}
+
+	forEachCandidate(getCellRange(minX, minY, maxX, maxY), [&](ElementID id) {
+		if (intersectsRect(elements[id], minX, minY, maxX, maxY))
+		{
+			result.push_back(id);
+		}
+	});
+}
+
+void SpatialIndex::setElement(ElementID id, const Element & element)
+{
+	if (id < 0)
+	{
+		return;
+	}
+
+	if (!std::isfinite(element.x1) || !std::isfinite(element.y1) || !std::isfinite(element.x2)
+	    || !std::isfinite(element.y2) || !std::isfinite(element.radius))
+	{
+		remove(id);
+		return;
+	}
+
+	if (std::size_t(id) >= elements.size())
+	{
+		elements.resize(id + 1);
+	}
+
+	Element & target = elements[id];
+	CellRange range = getBoundingCellRange(element, cellSize);
+	bool oversized = range.getCellCount() > maxCellsPerElement;
+
+	if (target.shape == Shape::None)
+	{
+		target = element;
+		target.cells = range;
+		target.oversized = oversized;
+		link(id);
+		elementCount++;
+	}
+	else if (target.cells != range || target.oversized != oversized)
+	{
+		unlink(id);
+		target = element;
+		target.cells = range;
+		target.oversized = oversized;
+		link(id);
+	}
+	else
+	{
+		// Same cells: only the shape needs to be updated
+		target = element;
+		target.cells = range;
+		target.oversized = oversized;
+	}
+}
+
+void SpatialIndex::link(ElementID id)
+{
+	const Element & element = elements[id];
+	if (element.oversized)
+	{
+		oversizedElements.push_back(id);
+		return;
+	}
+
+	for (std::int32_t y = element.cells.minY; y <= element.cells.maxY; ++y)
+	{
+		for (std::int32_t x = element.cells.minX; x <= element.cells.maxX; ++x)
+		{
+			cells[getCellKey(x, y)].push_back(id);
+		}
+	}
+}
+
+void SpatialIndex::unlink(ElementID id)
+{
+	auto removeFrom = [id](std::vector<ElementID> & list) {
+		auto it = std::find(list.begin(), list.end(), id);
+		if (it != list.end())
+		{
+			*it = list.back();
+			list.pop_back();
+		}
+	};
+
+	const Element & element = elements[id];
+	if (element.oversized)
+	{
+		removeFrom(oversizedElements);
+		return;
+	}
+
+	for (std::int32_t y = element.cells.minY; y <= element.cells.maxY; ++y)
+	{
+		for (std::int32_t x = element.cells.minX; x <= element.cells.maxX; ++x)
+		{
+			auto it = cells.find(getCellKey(x, y));
+			if (it != cells.end())
+			{
+				removeFrom(it->second);
+				if (it->second.empty())
+				{
+					cells.erase(it);
+				}
+			}
+		}
+	}
+}
+
+SpatialIndex::CellRange SpatialIndex::getCellRange(double minX, double minY, double maxX, double maxY) const
+{
+	auto toCell = [this](double value) {
+		return static_cast<std::int32_t>(
+		    std::max(-maxCellCoord, std::min(maxCellCoord, std::floor(value * inverseCellSize))));
+	};
+
+	CellRange range;
+	range.minX = toCell(minX);
+	range.minY = toCell(minY);
+	range.maxX = toCell(maxX);
+	range.maxY = toCell(maxY);
+	return range;
+}
+
+SpatialIndex::CellRange SpatialIndex::getBoundingCellRange(const Element & element, double cellSize)
+{
+	auto toCell = [cellSize](double value) {
+		return static_cast<std::int32_t>(std::max(-maxCellCoord, std::min(maxCellCoord, std::floor(value / cellSize))));
+	};
+
+	CellRange range;
+	range.minX = toCell(std::min(element.x1, element.x2) - element.radius);
+	range.minY = toCell(std::min(element.y1, element.y2) - element.radius);
+	range.maxX = toCell(std::max(element.x1, element.x2) + element.radius);
+	range.maxY = toCell(std::max(element.y1, element.y2) + element.radius);
+	return range;
+}
+
+double SpatialIndex::getDistance(const Element & element, double x, double y)
+{
+	double closestX = element.x1;
+	double closestY = element.y1;
+
+	if (element.shape == Shape::Segment)
+	{
+		double dx = element.x2 - element.x1;
+		double dy = element.y2 - element.y1;
+		double lengthSquared = dx * dx + dy * dy;
+		if (lengthSquared > 0)
+		{
+			double t = ((x - element.x1) * dx + (y - element.y1) * dy) / lengthSquared;
+			t = std::max(0.0, std::min(1.0, t));
+			closestX += t * dx;
+			closestY += t * dy;
+		}
+	}
+
+	return std::hypot(x - closestX, y - closestY) - element.radius;
+}
+
+bool SpatialIndex::intersectsRect(const Element & element, double minX, double minY, double maxX, double maxY)
+{
+	if (element.shape == Shape::Circle)
+	{
+		double dx = element.x1 - std::max(minX, std::min(maxX, element.x1));
+		double dy = element.y1 - std::max(minY, std::min(maxY, element.y1));
+		return dx * dx + dy * dy <= element.radius * element.radius;
+	}
+
+	// Liang-Barsky clipping against the expanded rectangle
+	minX -= element.radius;
+	minY -= element.radius;
+	maxX += element.radius;
+	maxY += element.radius;
+
+	double dx = element.x2 - element.x1;
+	double dy = element.y2 - element.y1;
+	double tMin = 0;
+	double tMax = 1;
+
+	auto clip = [&](double direction, double distance) {
+		if (direction == 0)
+		{
+			return distance >= 0;
+		}
+		double t = distance / direction;
+		if (direction < 0)
+		{
+			tMin = std::max(tMin, t);
+		}
+		else
+		{
+			tMax = std::min(tMax, t);
+		}
+		return tMin <= tMax;
+	};
+
+	return clip(-dx, element.x1 - minX) && clip(dx, maxX - element.x1) && clip(-dy, element.y1 - minY)
+	       && clip(dy, maxY - element.y1);
+}
+
+std::uint64_t SpatialIndex::getCellKey(std::int32_t x, std::int32_t y)
+{
+	return (std::uint64_t(std::uint32_t(x)) << 32) | std::uint32_t(y);
+}
+
+template <typename Func>
+void SpatialIndex::forEachCandidate(const CellRange & range, Func func) const
+{
+	if (++currentStamp == 0)
+	{
+		std::fill(visitStamps.begin(), visitStamps.end(), 0);
+		currentStamp = 1;
+	}
+	visitStamps.resize(elements.size(), 0);
+
+	auto visit = [&](ElementID id) {
+		if (visitStamps[id] != currentStamp)
+		{
+			visitStamps[id] = currentStamp;
+			func(id);
+		}
+	};
+
+	if (range.getCellCount() > cells.size())
+	{
+		// Large ranges are cheaper to handle by scanning the occupied cells
+		for (const auto & cell : cells)
+		{
+			std::int32_t x = std::int32_t(cell.first >> 32);
+			std::int32_t y = std::int32_t(std::uint32_t(cell.first));
+			if (x >= range.minX && x <= range.maxX && y >= range.minY && y <= range.maxY)
+			{
+				for (ElementID id : cell.second)
+				{
+					visit(id);
+				}
+			}
+		}
+	}
+	else
+	{
+		for (std::int32_t y = range.minY; y <= range.maxY; ++y)
+		{
+			for (std::int32_t x = range.minX; x <= range.maxX; ++x)
+			{
+				auto it = cells.find(getCellKey(x, y));
+				if (it != cells.end())
+				{
+					for (ElementID id : it->second)
+					{
+						visit(id);
+					}
+				}
+			}
+		}
+	}
+
+	for (ElementID id : oversizedElements)
+	{
+		visit(id);
+	}
+}
+
+}
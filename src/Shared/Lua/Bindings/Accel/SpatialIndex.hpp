@@ -0,0 +1,138 @@
+#ifndef SRC_SHARED_LUA_BINDINGS_ACCEL_SPATIALINDEX_HPP_
+#define SRC_SHARED_LUA_BINDINGS_ACCEL_SPATIALINDEX_HPP_
+
+#include <Shared/Utils/HashTable.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace wosc
+{
+
+/**
+ * Uniform grid over circles and line segments, used for picking and rectangle queries.
+ *
+ * Elements are identified by non-negative, caller-provided IDs (typically retained scene keys). Updating an element
+ * only touches the grid if the range of cells it covers changed, so re-specifying an unchanged or slightly moved scene
+ * is cheap. Elements covering too many cells are kept in a separate list that is tested by every query.
+ */
+class SpatialIndex
+{
+public:
+	using ElementID = std::int32_t;
+
+	static constexpr ElementID noElement = -1;
+
+	enum class Shape
+	{
+		None = 0,
+		Circle = 1,
+		Segment = 2,
+	};
+
+	SpatialIndex(double cellSize);
+
+	/**
+	 * Adds or updates an element. Elements with non-finite coordinates are removed instead.
+	 */
+	void setCircle(ElementID id, double x, double y, double radius);
+	void setSegment(ElementID id, double x1, double y1, double x2, double y2, double halfWidth);
+
+	void remove(ElementID id);
+
+	/**
+	 * Removes all elements with an ID greater than or equal to the specified count.
+	 */
+	void truncate(ElementID count);
+
+	void clear();
+
+	std::size_t getElementCount() const;
+	Shape getShape(ElementID id) const;
+
+	/**
+	 * Returns the element closest to the point, among the elements within 'tolerance' of it. If several elements
+	 * contain the point, circles take precedence over segments, and higher IDs over lower ones.
+	 */
+	ElementID pick(double x, double y, double tolerance) const;
+
+	/**
+	 * Appends the IDs of all elements intersecting the rectangle to 'result', in no particular order. Segments are
+	 * tested against the rectangle expanded by their half width, which slightly overestimates near the corners.
+	 */
+	void queryRect(double minX, double minY, double maxX, double maxY, std::vector<ElementID> & result) const;
+
+private:
+	struct CellRange
+	{
+		std::int32_t minX = 0;
+		std::int32_t minY = 0;
+		std::int32_t maxX = -1;
+		std::int32_t maxY = -1;
+
+		inline bool operator==(const CellRange & other) const
+		{
+			return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+		}
+
+		inline bool operator!=(const CellRange & other) const
+		{
+			return !(*this == other);
+		}
+
+		inline std::size_t getCellCount() const
+		{
+			return std::size_t(maxX - minX + 1) * std::size_t(maxY - minY + 1);
+		}
+	};
+
+	struct Element
+	{
+		Shape shape = Shape::None;
+		double x1 = 0;
+		double y1 = 0;
+		double x2 = 0;
+		double y2 = 0;
+		double radius = 0;
+		CellRange cells;
+		bool oversized = false;
+	};
+
+	void setElement(ElementID id, const Element & element);
+	void link(ElementID id);
+	void unlink(ElementID id);
+
+	CellRange getCellRange(double minX, double minY, double maxX, double maxY) const;
+	static CellRange getBoundingCellRange(const Element & element, double cellSize);
+
+	/**
+	 * Returns the distance between the point and the element's shape, which is 0 or negative inside of it.
+	 */
+	static double getDistance(const Element & element, double x, double y);
+	static bool intersectsRect(const Element & element, double minX, double minY, double maxX, double maxY);
+
+	static std::uint64_t getCellKey(std::int32_t x, std::int32_t y);
+
+	/**
+	 * Calls the function once for every element whose cells overlap the range.
+	 */
+	template <typename Func>
+	void forEachCandidate(const CellRange & range, Func func) const;
+
+	double cellSize;
+	double inverseCellSize;
+
+	std::vector<Element> elements;
+	std::size_t elementCount = 0;
+
+	HashMap<std::uint64_t, std::vector<ElementID>> cells;
+	std::vector<ElementID> oversizedElements;
+
+	// Per-element stamps to report elements that span several cells only once per query
+	mutable std::vector<std::uint32_t> visitStamps;
+	mutable std::uint32_t currentStamp = 0;
+};
+
+}
+
+#endif
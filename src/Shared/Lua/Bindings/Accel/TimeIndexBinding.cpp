@@ -0,0 +1,131 @@
+#include <Shared/Lua/Bindings/Accel/TimeIndexBinding.h>
+#include <Shared/Lua/Bindings/ArrayBinding.hpp>
+#include <Shared/Utils/Debug/Logger.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+using Index = wosC_accel_timeIndex_index_t;
+
+static Logger logger()
+{
+	static Logger logInstance("TimeIndexAccelerator");
+	return logInstance;
+}
+
+template <typename EntryType>
+static EntryType * getTimeIndexArray(wosc::ArrayContext & context, wosC_array_id_t arrayID, Index expectedCount,
+                                     const char * name)
+{
+	auto arrayInfo = context.getArrayInfo(arrayID);
+	auto expectedArrayLength = sizeof(EntryType) * expectedCount;
+	if ((arrayInfo.data == nullptr && expectedArrayLength != 0) || (std::size_t) arrayInfo.size != expectedArrayLength)
+	{
+		logger().error("Time index {} array size mismatch (expected array length: {}, actual array length: {})", name,
+		               expectedArrayLength, arrayInfo.size);
+		return nullptr;
+	}
+	if (!std::is_const<EntryType>::value && expectedArrayLength != 0 && !context.isArrayWritable(arrayID))
+	{
+		logger().error("Time index {} array is read-only", name);
+		return nullptr;
+	}
+	return reinterpret_cast<EntryType *>(arrayInfo.data);
+}
+
+bool wosC_accel_timeIndex_getTimeRange(wosC_accel_timeIndex_t * index)
+{
+	try
+	{
+		auto & context = wosc::ArrayContext::getContextByID(index->arrayContext);
+
+		Index itemCount = std::max<Index>(index->itemCount, 0);
+		auto times = getTimeIndexArray<const Index>(context, index->timeArrayID, itemCount, "time");
+		if (!times && itemCount != 0)
+		{
+			return false;
+		}
+
+		if (itemCount == 0)
+		{
+			index->minTime = 0;
+			index->maxTime = -1;
+			return true;
+		}
+
+		auto range = std::minmax_element(times, times + itemCount);
+		index->minTime = *range.first;
+		index->maxTime = *range.second;
+		return true;
+	}
+	catch (std::exception & ex)
+	{
+		logger().error("Error computing time range: {}", ex.what());
+		return false;
+	}
+}
+
+bool wosC_accel_timeIndex_build(wosC_accel_timeIndex_t * index)
+{
+	try
+	{
+		auto & context = wosc::ArrayContext::getContextByID(index->arrayContext);
+
+		Index itemCount = std::max<Index>(index->itemCount, 0);
+		Index minTime = index->minTime;
+		Index maxTime = index->maxTime;
+
+		// Ranges spanning more time steps than the int32 index type can hold are rejected by the size check below
+		std::int64_t timeCount = std::max<std::int64_t>(std::int64_t(maxTime) - minTime + 1, 0);
+		if (timeCount + 1 > std::numeric_limits<Index>::max())
+		{
+			logger().error("Time index range {} to {} is too large", minTime, maxTime);
+			return false;
+		}
+
+		auto times = getTimeIndexArray<const Index>(context, index->timeArrayID, itemCount, "time");
+		auto order = getTimeIndexArray<Index>(context, index->orderArrayID, itemCount, "order");
+		auto offsets = getTimeIndexArray<Index>(context, index->offsetArrayID, Index(timeCount + 1), "offset");
+
+		if ((!times && itemCount != 0) || (!order && itemCount != 0) || !offsets)
+		{
+			return false;
+		}
+
+		// Count items per time step, shifted by one so that the prefix sum yields the start offsets
+		std::fill(offsets, offsets + timeCount + 1, 0);
+		for (Index i = 0; i < itemCount; ++i)
+		{
+			if (times[i] < minTime || times[i] > maxTime)
+			{
+				logger().error("Time index item {} has time step {} outside of range {} to {}", i, times[i], minTime,
+				               maxTime);
+				return false;
+			}
+			offsets[times[i] - minTime + 1]++;
+		}
+
+		for (std::int64_t t = 1; t <= timeCount; ++t)
+		{
+			offsets[t] += offsets[t - 1];
+		}
+
+		// Stable placement: items of the same time step keep their relative order
+		std::vector<Index> cursors(offsets, offsets + timeCount);
+		for (Index i = 0; i < itemCount; ++i)
+		{
+			order[cursors[times[i] - minTime]++] = i;
+		}
+
+		return true;
+	}
+	catch (std::exception & ex)
+	{
+		logger().error("Error building time index: {}", ex.what());
+		return false;
+	}
+}
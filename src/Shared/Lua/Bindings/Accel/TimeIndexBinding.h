@@ -0,0 +1,53 @@
+#ifndef SRC_SHARED_LUA_BINDINGS_ACCEL_TIMEINDEXBINDING_H_
+#define SRC_SHARED_LUA_BINDINGS_ACCEL_TIMEINDEXBINDING_H_
+
+#include <Shared/Lua/Bindings/ArrayBinding.h>
+#include <Shared/Lua/Bindings/BindingAPI.hpp>
+
+extern "C"
+{
+
+	typedef int32_t wosC_accel_timeIndex_index_t;
+
+	/**
+	 * Items (nodes or links) ordered by time step, so that all items of one time step, and all items up to a time
+	 * step, form contiguous ranges of the order.
+	 *
+	 * All arrays belong to the same array context. Input:
+	 * - times:    int32[itemCount] (time step of each item)
+	 *
+	 * Outputs of wosC_accel_timeIndex_build:
+	 * - order:    int32[itemCount] (zero-based item indices, sorted by time step, keeping the item order otherwise)
+	 * - offsets:  int32[maxTime - minTime + 2] (offsets[t - minTime] is the position of the first item with time step
+	 *             t or later in the order; the last entry is itemCount)
+	 *
+	 * minTime and maxTime are written by wosC_accel_timeIndex_getTimeRange. For an empty index, minTime is 0 and
+	 * maxTime is -1, so that the offset array holds a single entry.
+	 */
+	typedef struct
+	{
+		wosC_array_context_t arrayContext;
+
+		wosC_array_id_t timeArrayID;
+		wosC_array_id_t orderArrayID;
+		wosC_array_id_t offsetArrayID;
+
+		wosC_accel_timeIndex_index_t itemCount;
+
+		wosC_accel_timeIndex_index_t minTime;
+		wosC_accel_timeIndex_index_t maxTime;
+	} wosC_accel_timeIndex_t;
+
+	/**
+	 * Determines the range of time steps, to size the offset array. Returns false if the time array is invalid.
+	 */
+	WOSC_API bool wosC_accel_timeIndex_getTimeRange(wosC_accel_timeIndex_t * index);
+
+	/**
+	 * Sorts the items by time step (counting sort) and fills the offset array. Requires the time range computed by
+	 * wosC_accel_timeIndex_getTimeRange. Returns false if an array is invalid or a time step is out of range.
+	 */
+	WOSC_API bool wosC_accel_timeIndex_build(wosC_accel_timeIndex_t * index);
+}
+
+#endif
@@ -0,0 +1,397 @@
+#include <Shared/Lua/Bindings/Accel/TopologyBinding.h>
+#include <Shared/Lua/Bindings/ArrayBinding.hpp>
+#include <Shared/Utils/Debug/Logger.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <type_traits>
+#include <vector>
+
+using Index = wosC_accel_topology_index_t;
+
+static const Index noNode = -1;
+
+// Marks nodes whose chain end or lineage is currently being resolved, to detect cycles
+static const Index inProgress = -2;
+
+static Logger logger()
+{
+	static Logger logInstance("TopologyAccelerator");
+	return logInstance;
+}
+
+template <typename EntryType>
+static EntryType * getTopologyArray(wosc::ArrayContext & context, wosC_array_id_t arrayID, Index expectedCount,
+                                    const char * name)
+{
+	auto arrayInfo = context.getArrayInfo(arrayID);
+	auto expectedArrayLength = sizeof(EntryType) * expectedCount;
+	if ((arrayInfo.data == nullptr && expectedArrayLength != 0) || (std::size_t) arrayInfo.size != expectedArrayLength)
+	{
+		logger().error("Topology {} array size mismatch (expected array length: {}, actual array length: {})", name,
+		               expectedArrayLength, arrayInfo.size);
+		return nullptr;
+	}
+	if (!std::is_const<EntryType>::value && expectedArrayLength != 0 && !context.isArrayWritable(arrayID))
+	{
+		logger().error("Topology {} array is read-only", name);
+		return nullptr;
+	}
+	return reinterpret_cast<EntryType *>(arrayInfo.data);
+}
+
+/**
+ * Resolved arrays of a topology graph structure.
+ */
+struct TopologyGraph
+{
+	inline Index getInDegree(Index node) const
+	{
+		return inOffsets[node + 1] - inOffsets[node];
+	}
+
+	inline Index getOutDegree(Index node) const
+	{
+		return outOffsets[node + 1] - outOffsets[node];
+	}
+
+	inline bool isPassThrough(Index node) const
+	{
+		return getInDegree(node) == 1 && getOutDegree(node) == 1;
+	}
+
+	const Index * edges = nullptr;
+	const double * areas = nullptr;
+	const Index * times = nullptr;
+
+	Index * outOffsets = nullptr;
+	Index * outTargets = nullptr;
+	Index * inOffsets = nullptr;
+	Index * inSources = nullptr;
+	Index * parents = nullptr;
+	Index * children = nullptr;
+	Index * lineages = nullptr;
+	Index * simplifiedNodes = nullptr;
+	Index * simplifiedEdges = nullptr;
+
+	Index nodeCount = 0;
+	Index edgeCount = 0;
+};
+
+static void buildAdjacency(const Index * edges, Index nodeCount, Index edgeCount, int keySide, Index * offsets,
+                           Index * values)
+{
+	std::fill(offsets, offsets + nodeCount + 1, 0);
+	for (Index i = 0; i < edgeCount; ++i)
+	{
+		offsets[edges[i * 2 + keySide] + 1]++;
+	}
+	for (Index i = 0; i < nodeCount; ++i)
+	{
+		offsets[i + 1] += offsets[i];
+	}
+
+	// Counting sort: entries with the same key keep their edge order
+	std::vector<Index> fill(offsets, offsets + nodeCount);
+	for (Index i = 0; i < edgeCount; ++i)
+	{
+		values[fill[edges[i * 2 + keySide]]++] = edges[i * 2 + 1 - keySide];
+	}
+}
+
+static void buildParentsAndChildren(TopologyGraph & graph)
+{
+	std::fill(graph.parents, graph.parents + graph.nodeCount, noNode);
+	std::fill(graph.children, graph.children + graph.nodeCount, noNode);
+
+	// The first of several equally large candidates is kept, in edge order
+	for (Index i = 0; i < graph.edgeCount; ++i)
+	{
+		Index source = graph.edges[i * 2];
+		Index target = graph.edges[i * 2 + 1];
+
+		Index & parent = graph.parents[target];
+		if (parent == noNode || graph.areas[parent] < graph.areas[source])
+		{
+			parent = source;
+		}
+
+		Index & child = graph.children[source];
+		if (child == noNode || graph.areas[child] < graph.areas[target])
+		{
+			child = target;
+		}
+	}
+}
+
+/**
+ * Computes, for every pass-through node, the first node that is not a pass-through node when following the specified
+ * links. Every node is visited a constant number of times; cycles of pass-through nodes end at the node where the
+ * cycle was entered.
+ */
+static std::vector<Index> resolveChainEnds(const TopologyGraph & graph, const Index * links)
+{
+	std::vector<Index> ends(graph.nodeCount, noNode);
+	std::vector<Index> path;
+
+	for (Index node = 0; node < graph.nodeCount; ++node)
+	{
+		if (ends[node] != noNode || !graph.isPassThrough(node))
+		{
+			continue;
+		}
+
+		Index current = node;
+		Index end = noNode;
+		while (end == noNode)
+		{
+			if (!graph.isPassThrough(current))
+			{
+				end = current;
+			}
+			else if (ends[current] == inProgress)
+			{
+				end = path.back();
+			}
+			else if (ends[current] != noNode)
+			{
+				end = ends[current];
+			}
+			else
+			{
+				ends[current] = inProgress;
+				path.push_back(current);
+				current = links[current];
+			}
+		}
+
+		for (Index pathNode : path)
+		{
+			ends[pathNode] = end;
+		}
+		path.clear();
+	}
+
+	return ends;
+}
+
+static void buildSimplifiedGraph(wosC_accel_topology_graph_t * structure, TopologyGraph & graph)
+{
+	auto chainSources = resolveChainEnds(graph, graph.parents);
+	auto chainTargets = resolveChainEnds(graph, graph.children);
+
+	std::vector<bool> used(graph.nodeCount, false);
+
+	// Every original edge produces one simplified edge, so edges along collapsed chains are kept with multiplicity
+	for (Index i = 0; i < graph.edgeCount; ++i)
+	{
+		Index source = graph.edges[i * 2];
+		Index target = graph.edges[i * 2 + 1];
+
+		if (graph.isPassThrough(source))
+		{
+			source = chainSources[source];
+		}
+		if (graph.isPassThrough(target))
+		{
+			target = chainTargets[target];
+		}
+
+		graph.simplifiedEdges[i * 2] = source;
+		graph.simplifiedEdges[i * 2 + 1] = target;
+		used[source] = true;
+		used[target] = true;
+	}
+
+	Index simplifiedNodeCount = 0;
+	for (Index node = 0; node < graph.nodeCount; ++node)
+	{
+		if (used[node])
+		{
+			graph.simplifiedNodes[simplifiedNodeCount++] = node;
+		}
+	}
+	std::fill(graph.simplifiedNodes + simplifiedNodeCount, graph.simplifiedNodes + graph.nodeCount, noNode);
+
+	structure->simplifiedNodeCount = simplifiedNodeCount;
+	structure->simplifiedEdgeCount = graph.edgeCount;
+}
+
+/**
+ * Assigns lineage IDs in order of time: a node inherits the ID of its parent if it is the parent's child, and starts
+ * a new lineage otherwise.
+ */
+static void buildLineages(wosC_accel_topology_graph_t * structure, TopologyGraph & graph)
+{
+	std::vector<Index> order(graph.nodeCount);
+	for (Index node = 0; node < graph.nodeCount; ++node)
+	{
+		order[node] = node;
+	}
+	std::stable_sort(order.begin(), order.end(), [&](Index a, Index b) {
+		return graph.times[a] < graph.times[b];
+	});
+
+	Index * lineages = graph.lineages;
+	std::fill(lineages, lineages + graph.nodeCount, noNode);
+
+	Index lineageCount = 0;
+	std::vector<Index> path;
+
+	// Parents normally precede their children in time, but nodes of the same time step may be linked as well
+	for (Index node : order)
+	{
+		// Nodes may already be resolved as part of an earlier node's path
+		if (lineages[node] != noNode)
+		{
+			continue;
+		}
+
+		Index current = node;
+		Index lineage = noNode;
+		while (lineage == noNode)
+		{
+			Index parent = graph.parents[current];
+			lineages[current] = inProgress;
+			path.push_back(current);
+
+			if (parent == noNode || graph.children[parent] != current || lineages[parent] == inProgress)
+			{
+				lineage = ++lineageCount;
+			}
+			else if (lineages[parent] != noNode)
+			{
+				lineage = lineages[parent];
+			}
+			else
+			{
+				current = parent;
+			}
+		}
+
+		for (Index pathNode : path)
+		{
+			lineages[pathNode] = lineage;
+		}
+		path.clear();
+	}
+
+	structure->lineageCount = lineageCount;
+}
+
+bool wosC_accel_topology_build(wosC_accel_topology_graph_t * structure)
+{
+	try
+	{
+		auto & context = wosc::ArrayContext::getContextByID(structure->arrayContext);
+
+		TopologyGraph graph;
+		graph.nodeCount = std::max<Index>(structure->nodeCount, 0);
+		graph.edgeCount = std::max<Index>(structure->edgeCount, 0);
+
+		Index nodeCount = graph.nodeCount;
+		Index edgeCount = graph.edgeCount;
+
+		graph.edges = getTopologyArray<const Index>(context, structure->edgeArrayID, edgeCount * 2, "edge");
+		graph.areas = getTopologyArray<const double>(context, structure->areaArrayID, nodeCount, "area");
+		graph.times = getTopologyArray<const Index>(context, structure->timeArrayID, nodeCount, "time");
+		graph.outOffsets =
+		    getTopologyArray<Index>(context, structure->outOffsetArrayID, nodeCount + 1, "out offset");
+		graph.outTargets = getTopologyArray<Index>(context, structure->outTargetArrayID, edgeCount, "out target");
+		graph.inOffsets = getTopologyArray<Index>(context, structure->inOffsetArrayID, nodeCount + 1, "in offset");
+		graph.inSources = getTopologyArray<Index>(context, structure->inSourceArrayID, edgeCount, "in source");
+		graph.parents = getTopologyArray<Index>(context, structure->parentArrayID, nodeCount, "parent");
+		graph.children = getTopologyArray<Index>(context, structure->childArrayID, nodeCount, "child");
+		graph.lineages = getTopologyArray<Index>(context, structure->lineageArrayID, nodeCount, "lineage");
+		graph.simplifiedNodes =
+		    getTopologyArray<Index>(context, structure->simplifiedNodeArrayID, nodeCount, "simplified node");
+		graph.simplifiedEdges =
+		    getTopologyArray<Index>(context, structure->simplifiedEdgeArrayID, edgeCount * 2, "simplified edge");
+
+		if ((!graph.edges && edgeCount != 0) || (!graph.areas && nodeCount != 0)
+		    || (!graph.times && nodeCount != 0) || !graph.outOffsets || (!graph.outTargets && edgeCount != 0)
+		    || !graph.inOffsets || (!graph.inSources && edgeCount != 0) || (!graph.parents && nodeCount != 0)
+		    || (!graph.children && nodeCount != 0) || (!graph.lineages && nodeCount != 0)
+		    || (!graph.simplifiedNodes && nodeCount != 0) || (!graph.simplifiedEdges && edgeCount != 0))
+		{
+			return false;
+		}
+
+		for (Index i = 0; i < edgeCount * 2; ++i)
+		{
+			if (graph.edges[i] < 0 || graph.edges[i] >= nodeCount)
+			{
+				logger().error("Topology edge {} references invalid node index {} (node count: {})", i / 2,
+				               graph.edges[i], nodeCount);
+				return false;
+			}
+		}
+
+		buildAdjacency(graph.edges, nodeCount, edgeCount, 0, graph.outOffsets, graph.outTargets);
+		buildAdjacency(graph.edges, nodeCount, edgeCount, 1, graph.inOffsets, graph.inSources);
+		buildParentsAndChildren(graph);
+		buildSimplifiedGraph(structure, graph);
+		buildLineages(structure, graph);
+		return true;
+	}
+	catch (std::exception & ex)
+	{
+		logger().error("Error building graph topology: {}", ex.what());
+		return false;
+	}
+}
+
+double wosC_accel_topology_traceMainChannel(wosC_accel_topology_graph_t * structure, Index startNode)
+{
+	try
+	{
+		auto & context = wosc::ArrayContext::getContextByID(structure->arrayContext);
+
+		Index nodeCount = structure->nodeCount;
+		if (startNode < 0 || startNode >= nodeCount)
+		{
+			logger().error("Invalid main channel start node {} (node count: {})", startNode, nodeCount);
+			return -1;
+		}
+
+		auto parents = getTopologyArray<const Index>(context, structure->parentArrayID, nodeCount, "parent");
+		auto xs = getTopologyArray<const double>(context, structure->xArrayID, nodeCount, "x position");
+		auto ys = getTopologyArray<const double>(context, structure->yArrayID, nodeCount, "y position");
+		auto indices =
+		    getTopologyArray<Index>(context, structure->channelIndexArrayID, nodeCount, "channel index");
+		auto distances =
+		    getTopologyArray<double>(context, structure->channelDistanceArrayID, nodeCount, "channel distance");
+
+		if (!parents || !xs || !ys || !indices || !distances)
+		{
+			return -1;
+		}
+
+		std::fill(indices, indices + nodeCount, noNode);
+		std::fill(distances, distances + nodeCount, 0.0);
+
+		double length = 0;
+		Index index = 0;
+
+		// Stops at the first node without a parent, or when reaching a node on the channel again
+		for (Index node = startNode; node != noNode && indices[node] == noNode; node = parents[node])
+		{
+			indices[node] = index++;
+			distances[node] = length;
+
+			Index parent = parents[node];
+			if (parent != noNode && indices[parent] == noNode)
+			{
+				length += std::hypot(xs[node] - xs[parent], ys[node] - ys[parent]);
+			}
+		}
+
+		return length;
+	}
+	catch (std::exception & ex)
+	{
+		logger().error("Error tracing main channel: {}", ex.what());
+		return -1;
+	}
+}
@@ -0,0 +1,89 @@
+#ifndef SRC_SHARED_LUA_BINDINGS_ACCEL_TOPOLOGYBINDING_H_
+#define SRC_SHARED_LUA_BINDINGS_ACCEL_TOPOLOGYBINDING_H_
+
+#include <Shared/Lua/Bindings/ArrayBinding.h>
+#include <Shared/Lua/Bindings/BindingAPI.hpp>
+
+extern "C"
+{
+
+	typedef int32_t wosC_accel_topology_index_t;
+
+	/**
+	 * Flat directed graph structure operated on by the topology accelerator. Node indices are zero-based, and -1
+	 * denotes "no node" in all per-node index arrays.
+	 *
+	 * All arrays belong to the same array context. Inputs:
+	 * - edges:             int32[2 * edgeCount] (source/target node index pairs)
+	 * - areas:             double[nodeCount]
+	 * - times:             int32[nodeCount]
+	 * - xs, ys:            double[nodeCount] (node positions, only used for the main channel trace)
+	 *
+	 * Outputs of wosC_accel_topology_build:
+	 * - outOffsets:        int32[nodeCount + 1] (CSR offsets into outTargets)
+	 * - outTargets:        int32[edgeCount] (target node indices, grouped by source node in edge order)
+	 * - inOffsets:         int32[nodeCount + 1] (CSR offsets into inSources)
+	 * - inSources:         int32[edgeCount] (source node indices, grouped by target node in edge order)
+	 * - parents:           int32[nodeCount] (source of the incoming edge with the largest source area)
+	 * - children:          int32[nodeCount] (target of the outgoing edge with the largest target area)
+	 * - lineages:          int32[nodeCount] (one-based lineage ID, shared along parent -> largest child links)
+	 * - simplifiedNodes:   int32[nodeCount] (nodes of the simplified graph, in ascending order)
+	 * - simplifiedEdges:   int32[2 * edgeCount] (source/target pairs with pass-through chains collapsed)
+	 *
+	 * Outputs of wosC_accel_topology_traceMainChannel:
+	 * - channelIndices:    int32[nodeCount] (number of parent steps from the start node, -1 if not on the channel)
+	 * - channelDistances:  double[nodeCount] (accumulated distance from the start node, 0 if not on the channel)
+	 *
+	 * The output array IDs of a function may be left at 0 if it is not called.
+	 */
+	typedef struct
+	{
+		wosC_array_context_t arrayContext;
+
+		wosC_array_id_t edgeArrayID;
+		wosC_array_id_t areaArrayID;
+		wosC_array_id_t timeArrayID;
+		wosC_array_id_t xArrayID;
+		wosC_array_id_t yArrayID;
+
+		wosC_array_id_t outOffsetArrayID;
+		wosC_array_id_t outTargetArrayID;
+		wosC_array_id_t inOffsetArrayID;
+		wosC_array_id_t inSourceArrayID;
+		wosC_array_id_t parentArrayID;
+		wosC_array_id_t childArrayID;
+		wosC_array_id_t lineageArrayID;
+		wosC_array_id_t simplifiedNodeArrayID;
+		wosC_array_id_t simplifiedEdgeArrayID;
+
+		wosC_array_id_t channelIndexArrayID;
+		wosC_array_id_t channelDistanceArrayID;
+
+		wosC_accel_topology_index_t nodeCount;
+		wosC_accel_topology_index_t edgeCount;
+
+		wosC_accel_topology_index_t simplifiedNodeCount;
+		wosC_accel_topology_index_t simplifiedEdgeCount;
+		wosC_accel_topology_index_t lineageCount;
+	} wosC_accel_topology_graph_t;
+
+	/**
+	 * Builds the CSR adjacency of the graph and derives the parent/child links, lineage IDs and the simplified graph,
+	 * writing the simplified node/edge counts and the number of lineages back to the structure.
+	 *
+	 * Nodes with exactly one incoming and one outgoing edge are pass-through nodes. In the simplified graph, edge
+	 * endpoints are moved along parent (for sources) or child (for targets) links until they reach a node that is not
+	 * a pass-through node. Returns false if the graph is invalid.
+	 */
+	WOSC_API bool wosC_accel_topology_build(wosC_accel_topology_graph_t * graph);
+
+	/**
+	 * Follows the parent links from the start node, recording the step index and accumulated Euclidean distance of
+	 * every node on the way. Requires the parents computed by wosC_accel_topology_build. Returns the total length of
+	 * the channel, or a negative value if the graph or start node is invalid.
+	 */
+	WOSC_API double wosC_accel_topology_traceMainChannel(wosC_accel_topology_graph_t * graph,
+	                                                     wosC_accel_topology_index_t startNode);
+}
+
+#endif
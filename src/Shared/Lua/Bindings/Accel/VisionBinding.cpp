@@ -1,12 +1,25 @@
-#include <Shared/Lua/Bindings/Accel/VisionBinding.h>
+#include <SFML/System/Clock.hpp>
+#include <Shared/Lua/Bindings/Accel/VisionBinding.hpp>
 #include <Shared/Lua/Bindings/ArrayBinding.hpp>
 #include <Shared/Utils/Attributes.hpp>
 #include <Shared/Utils/Debug/Logger.hpp>
 #include <Shared/Utils/Error.hpp>
 #include <Shared/Utils/MiscMath.hpp>
+#include <Shared/Utils/ThreadPool.hpp>
+#include <algorithm>
+#include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <limits>
+#include <random>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define WOS_VISION_SSE2
+#	include <emmintrin.h>
+#endif
 
 template <typename EntryType>
 struct AbstractVisMapWrapper
@@ -199,13 +212,84 @@ static Logger logger()
 	return logInstance;
 }
 
+static ThreadPool * visionThreadPool = nullptr;
+
+// Updates covering fewer tiles than this always run on the calling thread
+static constexpr std::size_t parallelThreshold = 1 << 16;
+
+// Minimum number of tiles in a row tile processed by one thread
+static constexpr std::size_t minTilesPerRowTile = 1 << 14;
+
+// Largest radial falloff table kept per thread; larger light sources compute the rest of the falloff per tile
+static constexpr std::size_t maxRadialTableSize = 1 << 20;
+
+void wosc::setVisionThreadPool(ThreadPool * threadPool)
+{
+	visionThreadPool = threadPool;
+}
+
+/**
+ * Calls 'func(firstRow, endRow)' for consecutive row ranges covering [firstRow, lastRow], in parallel on the thread
+ * pool if there are enough tiles. Rows are independent in all kernels using this, so no synchronization is needed.
+ */
+template <typename Func>
+void forEachRowTile(VisMap::Coord firstRow, VisMap::Coord lastRow, std::size_t rowLength, ThreadPool * threadPool,
+                    const Func & func)
+{
+	if (lastRow < firstRow)
+	{
+		return;
+	}
+
+	std::size_t rowCount = lastRow - firstRow + 1;
+	if (threadPool && rowCount > 1 && rowCount * rowLength >= parallelThreshold)
+	{
+		std::size_t rowsPerTile = std::max<std::size_t>(minTilesPerRowTile / std::max<std::size_t>(rowLength, 1), 1);
+		threadPool->parallelFor(rowCount, rowsPerTile, [&](std::size_t begin, std::size_t end) {
+			func(firstRow + VisMap::Coord(begin), firstRow + VisMap::Coord(end));
+		});
+	}
+	else
+	{
+		func(firstRow, lastRow + 1);
+	}
+}
+
+/**
+ * Returns true if the map can be indexed with the same offsets as the VisMap.
+ */
+template <typename Map>
+inline bool hasSameLayout(const VisMap & visMap, const Map & map)
+{
+	return map.width == visMap.width && map.height == visMap.height;
+}
+
+#ifdef WOS_VISION_SSE2
+/**
+ * Returns all bits set in the lanes in which all bits of the mask are set.
+ */
+inline __m128i testBitsSSE2(__m128i entries, __m128i mask)
+{
+	return _mm_cmpeq_epi32(_mm_and_si128(entries, mask), mask);
+}
+
+/**
+ * Sign-extends the light level field of four VisMap entries.
+ */
+inline __m128i getLightSSE2(__m128i entries)
+{
+	return _mm_srai_epi32(_mm_slli_epi32(entries, 32 - bitOffsetLight - bitCountLight), 32 - bitCountLight);
+}
+#endif
+
 template <typename WrapperType, typename StructureType>
 WrapperType getWrapperGeneric(const StructureType * map)
 {
 	WrapperType wrapper;
 	try
 	{
-		auto arrayInfo = wosc::ArrayContext::getContextByID(map->arrayContext).getArrayInfo(map->arrayID);
+		auto & context = wosc::ArrayContext::getContextByID(map->arrayContext);
+		auto arrayInfo = context.getArrayInfo(map->arrayID);
 
 		if (map->width == 0 || map->height == 0 || map->clipWidth == 0 || map->clipHeight == 0)
 		{
@@ -228,13 +312,20 @@ WrapperType getWrapperGeneric(const StructureType * map)
 		}
 
 		auto expectedArrayLength = sizeof(typename WrapperType::Entry) * map->width * map->height;
-		if (arrayInfo.size != expectedArrayLength)
+		if ((std::size_t) arrayInfo.size != expectedArrayLength)
 		{
 			logger().error("VisMap size mismatch (size: {}x{}; expected array length: {}, actual array length: {})",
 			               map->width, map->height, expectedArrayLength, arrayInfo.size);
 			return wrapper;
 		}
 
+		// All map types are modified by some operation, so file-backed maps must not be read-only
+		if (!context.isArrayWritable(map->arrayID))
+		{
+			logger().error("VisMap array is read-only");
+			return wrapper;
+		}
+
 		wrapper.data = reinterpret_cast<typename WrapperType::Entry *>(arrayInfo.data);
 		wrapper.width = map->width;
 		wrapper.height = map->height;
@@ -386,12 +477,17 @@ static bool isOpaque(const VisMap & visMap, VisMap::Coord x, VisMap::Coord y)
 	return !visMap.validCoord(x, y) || visMap.test(x, y, bitmaskOpaque);
 }
 
-inline void fovAddOctant(const VisMap & visMap, FovMap & fovMap, FovMap::Entry mask, FovMap::Coord cx, FovMap::Coord cy,
-                         FovMap::Coord dx, FovMap::Coord dy, FovMap::Coord px, FovMap::Coord py)
+/**
+ * Sweeps one octant of the field of view around (cx, cy), calling 'visit(x, y)' for each visible tile up to
+ * 'maxDistance' tiles along the major axis. 'isOpaque(x, y)' must return true outside the map.
+ */
+template <typename OpacityFunc, typename VisitFunc>
+inline void fovSweepOctant(const OpacityFunc & isOpaque, const VisitFunc & visit, FovMap::Coord cx, FovMap::Coord cy,
+                           FovMap::Coord dx, FovMap::Coord dy, FovMap::Coord px, FovMap::Coord py, int maxDistance)
 {
 	uint64_t slopes = ~0;
 
-	for (int d = 1; slopes; d++)
+	for (int d = 1; slopes && d <= maxDistance; d++)
 	{
 		int x = cx + d * dx;
 		int y = cy + d * dy;
@@ -403,17 +499,17 @@ inline void fovAddOctant(const VisMap & visMap, FovMap & fovMap, FovMap::Entry m
 			int minSlope = 63 * (2 * p - 1) / (2 * d + 1);
 			int maxSlope = 63 * (2 * p + 1) / (2 * d - 1);
 
-			if (p == d && isOpaque(visMap, x - dx, y - dy))
+			if (p == d && isOpaque(x - dx, y - dy))
 			{
 				slopes &= ~(static_cast<uint64_t>(1) << 63);
 			}
 
-			if ((slopes & slopeMask(minSlope - (p < 11), maxSlope - (p == 0))) && fovMap.validCoord(x, y))
+			if (slopes & slopeMask(minSlope - (p < 11), maxSlope - (p == 0)))
 			{
-				fovMap.set(x, y, mask);
+				visit(x, y);
 			}
 
-			if (isOpaque(visMap, x, y))
+			if (isOpaque(x, y))
 			{
 				blockedSlopes |= slopeMask(std::max(minSlope, p), maxSlope - 1);
 			}
@@ -425,6 +521,21 @@ inline void fovAddOctant(const VisMap & visMap, FovMap & fovMap, FovMap::Entry m
 	}
 }
 
+template <typename OpacityFunc, typename VisitFunc>
+void fovSweep(const OpacityFunc & isOpaque, const VisitFunc & visit, FovMap::Coord cx, FovMap::Coord cy,
+              int maxDistance)
+{
+	visit(cx, cy);
+	fovSweepOctant(isOpaque, visit, cx, cy, +1, 0, 0, +1, maxDistance);
+	fovSweepOctant(isOpaque, visit, cx, cy, +1, 0, 0, -1, maxDistance);
+	fovSweepOctant(isOpaque, visit, cx, cy, -1, 0, 0, +1, maxDistance);
+	fovSweepOctant(isOpaque, visit, cx, cy, -1, 0, 0, -1, maxDistance);
+	fovSweepOctant(isOpaque, visit, cx, cy, 0, +1, +1, 0, maxDistance);
+	fovSweepOctant(isOpaque, visit, cx, cy, 0, +1, -1, 0, maxDistance);
+	fovSweepOctant(isOpaque, visit, cx, cy, 0, -1, +1, 0, maxDistance);
+	fovSweepOctant(isOpaque, visit, cx, cy, 0, -1, -1, 0, maxDistance);
+}
+
 void fovAddRaycast(VisMap visMap, FovMap fovMap, FovMap::Entry mask, VisMap::Coord cx, VisMap::Coord cy)
 {
 	if (!visMap.validCoord(cx, cy))
@@ -432,15 +543,196 @@ void fovAddRaycast(VisMap visMap, FovMap fovMap, FovMap::Entry mask, VisMap::Coo
 		return;
 	}
 
-	fovMap.set(cx, cy, mask);
-	fovAddOctant(visMap, fovMap, mask, cx, cy, +1, 0, 0, +1);
-	fovAddOctant(visMap, fovMap, mask, cx, cy, +1, 0, 0, -1);
-	fovAddOctant(visMap, fovMap, mask, cx, cy, -1, 0, 0, +1);
-	fovAddOctant(visMap, fovMap, mask, cx, cy, -1, 0, 0, -1);
-	fovAddOctant(visMap, fovMap, mask, cx, cy, 0, +1, +1, 0);
-	fovAddOctant(visMap, fovMap, mask, cx, cy, 0, +1, -1, 0);
-	fovAddOctant(visMap, fovMap, mask, cx, cy, 0, -1, +1, 0);
-	fovAddOctant(visMap, fovMap, mask, cx, cy, 0, -1, -1, 0);
+	auto isOpaqueTile = [&](VisMap::Coord x, VisMap::Coord y) {
+		return isOpaque(visMap, x, y);
+	};
+	auto visit = [&](FovMap::Coord x, FovMap::Coord y) {
+		fovMap.setChecked(x, y, mask);
+	};
+	fovSweep(isOpaqueTile, visit, cx, cy, std::numeric_limits<int>::max());
+}
+
+/**
+ * Opacity of the VisMap's clipping rectangle, one byte per tile. Built once per batch and shared by all sources and
+ * threads, so that sources sharing rows read the same compact cache lines instead of testing VisMap entries.
+ */
+struct OpacityGrid
+{
+	OpacityGrid(const VisMap & visMap) :
+		x1(visMap.clipX1),
+		y1(visMap.clipY1),
+		width(visMap.clipX2 - visMap.clipX1 + 1),
+		height(visMap.clipY2 - visMap.clipY1 + 1),
+		cells(std::size_t(width) * height)
+	{
+		for (VisMap::Coord y = 0; y < height; ++y)
+		{
+			for (VisMap::Coord x = 0; x < width; ++x)
+			{
+				cells[x + std::size_t(y) * width] = visMap.test(x1 + x, y1 + y, bitmaskOpaque);
+			}
+		}
+	}
+
+	inline bool contains(VisMap::Coord x, VisMap::Coord y) const
+	{
+		// Negative offsets wrap around to large unsigned values
+		return unsigned(x - x1) < unsigned(width) && unsigned(y - y1) < unsigned(height);
+	}
+
+	// Tiles outside the grid are opaque
+	inline bool operator()(VisMap::Coord x, VisMap::Coord y) const
+	{
+		return !contains(x, y) || cells[(x - x1) + std::size_t(y - y1) * width];
+	}
+
+	VisMap::Coord x1, y1;
+	VisMap::Coord width, height;
+	std::vector<std::uint8_t> cells;
+};
+
+/**
+ * FovMap bits collected by one thread over a rectangle of the FovMap, merged into the FovMap after the batch.
+ */
+struct FovTile
+{
+	FovMap::Coord x1 = 0, y1 = 0;
+	FovMap::Coord x2 = -1, y2 = -1;
+	std::vector<FovMap::Entry> entries;
+
+	inline FovMap::Entry & at(FovMap::Coord x, FovMap::Coord y)
+	{
+		return entries[(x - x1) + std::size_t(y - y1) * (x2 - x1 + 1)];
+	}
+};
+
+// Sources processed per thread at least, as every thread needs its own FovMap tile
+static constexpr std::size_t minSourcesPerThread = 16;
+
+using FovSource = wosC_accel_vision_fovSource_t;
+
+/**
+ * Returns the number of tiles a source can see along either axis, or the maximum int for unlimited radii.
+ */
+inline int getSourceExtent(const FovSource & source)
+{
+	return source.radius > 0 ? source.radius / lightTileSize : std::numeric_limits<int>::max();
+}
+
+template <typename SetFunc>
+void fovSweepSource(const OpacityGrid & opacity, const FovMap & fovMap, const FovSource & source, const SetFunc & set)
+{
+	if (!opacity.contains(source.x, source.y))
+	{
+		return;
+	}
+
+	std::int64_t squareRadius = std::int64_t(source.radius) * source.radius;
+	bool limited = source.radius > 0;
+
+	auto visit = [&](FovMap::Coord x, FovMap::Coord y) {
+		std::int64_t dx = x - source.x, dy = y - source.y;
+		std::int64_t squareDistance = (dx * dx + dy * dy) * lightTileSize * lightTileSize;
+		if (fovMap.validCoord(x, y) && (!limited || squareDistance <= squareRadius))
+		{
+			set(x, y, source.mask);
+		}
+	};
+	fovSweep(opacity, visit, source.x, source.y, getSourceExtent(source));
+}
+
+void fovAddRaycastBatch(VisMap visMap, FovMap fovMap, const FovSource * sources, std::size_t sourceCount,
+                        ThreadPool * threadPool)
+{
+	if (sourceCount == 0)
+	{
+		return;
+	}
+
+	OpacityGrid opacity(visMap);
+
+	// Sources sorted by row share opacity rows within a thread, and keep the threads' FovMap tiles small
+	std::vector<std::size_t> order(sourceCount);
+	for (std::size_t i = 0; i < sourceCount; ++i)
+	{
+		order[i] = i;
+	}
+	std::sort(order.begin(), order.end(), [sources](std::size_t a, std::size_t b) {
+		return sources[a].y != sources[b].y ? sources[a].y < sources[b].y : sources[a].x < sources[b].x;
+	});
+
+	std::size_t chunkCount = 1;
+	if (threadPool)
+	{
+		chunkCount = std::min(threadPool->getThreadCount() + 1, sourceCount / minSourcesPerThread);
+		chunkCount = std::max<std::size_t>(chunkCount, 1);
+	}
+
+	if (chunkCount == 1)
+	{
+		for (std::size_t i : order)
+		{
+			fovSweepSource(opacity, fovMap, sources[i], [&](FovMap::Coord x, FovMap::Coord y, FovMap::Entry mask) {
+				fovMap.set(x, y, mask);
+			});
+		}
+		return;
+	}
+
+	std::size_t chunkSize = (sourceCount + chunkCount - 1) / chunkCount;
+	std::vector<FovTile> tiles(chunkCount);
+
+	threadPool->parallelFor(chunkCount, 1, [&](std::size_t first, std::size_t last) {
+		for (std::size_t chunk = first; chunk < last; ++chunk)
+		{
+			std::size_t begin = std::min(chunk * chunkSize, sourceCount);
+			std::size_t end = std::min(begin + chunkSize, sourceCount);
+			if (begin == end)
+			{
+				continue;
+			}
+
+			// The tile covers the reachable area of all sources of the chunk
+			FovTile & tile = tiles[chunk];
+			tile.x1 = fovMap.clipX2, tile.y1 = fovMap.clipY2;
+			tile.x2 = fovMap.clipX1, tile.y2 = fovMap.clipY1;
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				const FovSource & source = sources[order[i]];
+				std::int64_t extent = getSourceExtent(source);
+				tile.x1 = std::min<std::int64_t>(tile.x1, std::max<std::int64_t>(fovMap.clipX1, source.x - extent));
+				tile.y1 = std::min<std::int64_t>(tile.y1, std::max<std::int64_t>(fovMap.clipY1, source.y - extent));
+				tile.x2 = std::max<std::int64_t>(tile.x2, std::min<std::int64_t>(fovMap.clipX2, source.x + extent));
+				tile.y2 = std::max<std::int64_t>(tile.y2, std::min<std::int64_t>(fovMap.clipY2, source.y + extent));
+			}
+			tile.entries.assign(std::size_t(tile.x2 - tile.x1 + 1) * (tile.y2 - tile.y1 + 1), 0);
+
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				fovSweepSource(opacity, fovMap, sources[order[i]],
+				               [&](FovMap::Coord x, FovMap::Coord y, FovMap::Entry mask) {
+					               tile.at(x, y) |= mask;
+				               });
+			}
+		}
+	});
+
+	// Merge the tiles row by row; each row of the FovMap is written by one thread only
+	std::size_t rowLength = fovMap.clipX2 - fovMap.clipX1 + 1;
+	forEachRowTile(fovMap.clipY1, fovMap.clipY2, rowLength, threadPool, [&](FovMap::Coord y1, FovMap::Coord y2) {
+		for (FovTile & tile : tiles)
+		{
+			for (FovMap::Coord y = std::max(y1, tile.y1); y < std::min(y2, tile.y2 + 1); ++y)
+			{
+				const FovMap::Entry * source = &tile.at(tile.x1, y);
+				FovMap::Entry * target = &fovMap.at(tile.x1, y);
+				for (FovMap::Coord x = 0; x <= tile.x2 - tile.x1; ++x)
+				{
+					target[x] |= source[x];
+				}
+			}
+		}
+	});
 }
 
 void wosC_accel_vision_fovAddRaycast(wosC_accel_vision_visMap_t * visMap, wosC_accel_vision_fovMap_t * fovMap,
@@ -464,6 +756,31 @@ void wosC_accel_vision_fovAddRaycast(wosC_accel_vision_visMap_t * visMap, wosC_a
 	fovAddRaycast(visMapWrapper, fovMapWrapper, mask, x, y);
 }
 
+void wosC_accel_vision_fovAddRaycastBatch(wosC_accel_vision_visMap_t * visMap, wosC_accel_vision_fovMap_t * fovMap,
+                                          const wosC_accel_vision_fovSource_t * sources, int32_t sourceCount)
+{
+	auto visMapWrapper = getVisMapWrapper(visMap);
+	if (!visMapWrapper)
+	{
+		logger().trace("Invalid VisMap passed to fovAddRaycastBatch");
+		return;
+	}
+
+	auto fovMapWrapper = getFovMapWrapper(fovMap);
+	if (!fovMapWrapper)
+	{
+		logger().trace("Invalid FovMap passed to fovAddRaycastBatch");
+		return;
+	}
+
+	if (sources == nullptr || sourceCount <= 0)
+	{
+		return;
+	}
+
+	fovAddRaycastBatch(visMapWrapper, fovMapWrapper, sources, sourceCount, visionThreadPool);
+}
+
 void wosC_accel_vision_fovAddCircle(wosC_accel_vision_fovMap_t * fovMap, wosC_accel_vision_fovMap_entry_t mask,
                                     wosC_accel_vision_tileCoord_t x, wosC_accel_vision_tileCoord_t y,
                                     wosC_accel_vision_lightCoord_t radius)
@@ -478,7 +795,7 @@ void wosC_accel_vision_fovAddCircle(wosC_accel_vision_fovMap_t * fovMap, wosC_ac
 	mapAddCircle(fovMapWrapper, mask, x, y, radius);
 }
 
-void fovReveal(VisMap visMap, FovMap fovMap, RevealMap revealMap)
+void fovRevealScalar(VisMap visMap, FovMap fovMap, RevealMap revealMap)
 {
 	for (VisMap::Coord y = visMap.clipY1; y <= visMap.clipY2; ++y)
 	{
@@ -494,6 +811,55 @@ void fovReveal(VisMap visMap, FovMap fovMap, RevealMap revealMap)
 	}
 }
 
+void fovRevealRow(const VisMap::Entry * visRow, const FovMap::Entry * fovRow, RevealMap::Entry * revealRow,
+                  std::size_t count)
+{
+	std::size_t i = 0;
+
+#ifdef WOS_VISION_SSE2
+	const __m128i shadowMask = _mm_set1_epi32(int(bitmaskShadow));
+	const __m128i threshold = _mm_set1_epi32(lightRevealThreshold - 1);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i visEntries = _mm_loadu_si128(reinterpret_cast<const __m128i *>(visRow + i));
+		__m128i fovEntries = _mm_loadu_si128(reinterpret_cast<const __m128i *>(fovRow + i));
+		__m128i revealEntries = _mm_loadu_si128(reinterpret_cast<const __m128i *>(revealRow + i));
+
+		__m128i lit = _mm_cmpgt_epi32(getLightSSE2(visEntries), threshold);
+		__m128i revealed = _mm_andnot_si128(testBitsSSE2(visEntries, shadowMask), lit);
+		revealEntries = _mm_or_si128(revealEntries, _mm_and_si128(revealed, fovEntries));
+
+		_mm_storeu_si128(reinterpret_cast<__m128i *>(revealRow + i), revealEntries);
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		bool revealed = bitGetSignedRange(visRow[i], bitOffsetLight, bitCountLight) >= lightRevealThreshold
+		                && !(visRow[i] & bitmaskShadow);
+		revealRow[i] |= fovRow[i] * revealed;
+	}
+}
+
+void fovReveal(VisMap visMap, FovMap fovMap, RevealMap revealMap, ThreadPool * threadPool)
+{
+	if (!hasSameLayout(visMap, fovMap) || !hasSameLayout(visMap, revealMap))
+	{
+		fovRevealScalar(visMap, fovMap, revealMap);
+		return;
+	}
+
+	std::size_t rowLength = visMap.clipX2 - visMap.clipX1 + 1;
+	forEachRowTile(visMap.clipY1, visMap.clipY2, rowLength, threadPool, [&](VisMap::Coord y1, VisMap::Coord y2) {
+		for (VisMap::Coord y = y1; y < y2; ++y)
+		{
+			std::size_t offset = visMap.clipX1 + std::size_t(y) * visMap.width;
+			fovRevealRow(visMap.data + offset, fovMap.data + offset, revealMap.data + offset, rowLength);
+		}
+	});
+}
+
 void wosC_accel_vision_fovReveal(wosC_accel_vision_visMap_t * visMap, wosC_accel_vision_fovMap_t * fovMap,
                                  wosC_accel_vision_revealMap_t * revealMap)
 {
@@ -518,7 +884,7 @@ void wosC_accel_vision_fovReveal(wosC_accel_vision_visMap_t * visMap, wosC_accel
 		return;
 	}
 
-	fovReveal(visMapWrapper, fovMapWrapper, revealMapWrapper);
+	fovReveal(visMapWrapper, fovMapWrapper, revealMapWrapper, visionThreadPool);
 }
 
 void wosC_accel_vision_shadowClear(wosC_accel_vision_visMap_t * visMap)
@@ -595,8 +961,8 @@ void wosC_accel_vision_perspectiveAddCircle(wosC_accel_vision_visMap_t * visMap,
 	mapAddCircle(visMapWrapper, bitmaskPerspectiveOcclude, x, y, radius);
 }
 
-void lightApplyRadial(VisMap visMap, VisMap::Coord cx, VisMap::Coord cy, VisMap::LightCoord innerRadius,
-                      VisMap::LightCoord outerRadius, VisMap::LightIntensity intensity)
+void lightApplyRadialScalar(VisMap visMap, VisMap::Coord cx, VisMap::Coord cy, VisMap::LightCoord innerRadius,
+                            VisMap::LightCoord outerRadius, VisMap::LightIntensity intensity)
 {
 	VisMap::Coord extent = outerRadius / lightTileSize;
 
@@ -625,6 +991,154 @@ void lightApplyRadial(VisMap visMap, VisMap::Coord cx, VisMap::Coord cy, VisMap:
 	}
 }
 
+/**
+ * Light added by a radial light source to a tile at the specified squared distance (in tiles) from its center.
+ */
+inline VisMap::LightIntensity getRadialFalloff(std::int64_t squareDistance, VisMap::LightCoord innerRadius,
+                                              VisMap::LightCoord outerRadius, VisMap::LightIntensity intensity)
+{
+	VisMap::LightCoord distance = clamp<VisMap::LightCoord>(
+	    innerRadius, std::sqrt(double(squareDistance) * lightTileSize * lightTileSize), outerRadius);
+	return ((outerRadius - distance) * intensity) / (outerRadius - innerRadius);
+}
+
+/**
+ * Radial falloff indexed by squared tile distance, up to the distance at which the light level drops to zero (or up
+ * to the maximum table size).
+ */
+struct RadialFalloffTable
+{
+	VisMap::LightCoord innerRadius = 0;
+	VisMap::LightCoord outerRadius = 0;
+	VisMap::LightIntensity intensity = 0;
+
+	std::vector<VisMap::LightIntensity> values;
+
+	// Whether the table ends where the falloff reaches zero, so that tiles beyond it can be skipped
+	bool complete = false;
+};
+
+/**
+ * Returns the falloff table for a light source with inner radius less than its outer radius. Light sources usually
+ * share their radii and intensity, so the last table is kept per thread.
+ */
+static const RadialFalloffTable & getRadialFalloffTable(VisMap::LightCoord innerRadius,
+                                                        VisMap::LightCoord outerRadius,
+                                                        VisMap::LightIntensity intensity)
+{
+	static thread_local RadialFalloffTable table;
+
+	if (table.values.empty() || table.innerRadius != innerRadius || table.outerRadius != outerRadius
+	    || table.intensity != intensity)
+	{
+		table.innerRadius = innerRadius;
+		table.outerRadius = outerRadius;
+		table.intensity = intensity;
+		table.values.clear();
+		table.complete = false;
+
+		for (std::int64_t squareDistance = 0; table.values.size() < maxRadialTableSize; ++squareDistance)
+		{
+			if (std::sqrt(double(squareDistance) * lightTileSize * lightTileSize) >= outerRadius)
+			{
+				table.complete = true;
+				break;
+			}
+			table.values.push_back(getRadialFalloff(squareDistance, innerRadius, outerRadius, intensity));
+		}
+	}
+
+	return table;
+}
+
+/**
+ * Returns the largest distance d with d * d <= squareDistance.
+ */
+inline VisMap::Coord getIntegerSqrt(std::int64_t squareDistance)
+{
+	auto root = static_cast<std::int64_t>(std::sqrt(double(squareDistance)));
+	while (root * root > squareDistance)
+	{
+		root--;
+	}
+	while ((root + 1) * (root + 1) <= squareDistance)
+	{
+		root++;
+	}
+	return VisMap::Coord(root);
+}
+
+void lightApplyRadial(VisMap visMap, VisMap::Coord cx, VisMap::Coord cy, VisMap::LightCoord innerRadius,
+                      VisMap::LightCoord outerRadius, VisMap::LightIntensity intensity, ThreadPool * threadPool)
+{
+	VisMap::Coord extent = outerRadius / lightTileSize;
+
+	VisMap::Coord x1 = std::max(visMap.clipX1, cx - extent), x2 = std::min(visMap.clipX2, cx + extent);
+	VisMap::Coord y1 = std::max(visMap.clipY1, cy - extent), y2 = std::min(visMap.clipY2, cy + extent);
+	if (x1 > x2)
+	{
+		return;
+	}
+
+	// Adding to the sign-extended light level and truncating it again is the same as adding within the bit field
+	static const VisMap::Entry lightMask = bitGenRange(bitOffsetLight, bitCountLight);
+	auto addLight = [](VisMap::Entry & entry, VisMap::LightIntensity value) {
+		entry = (entry & ~lightMask) | ((entry + (VisMap::Entry(value) << bitOffsetLight)) & lightMask);
+	};
+
+	std::size_t rowLength = x2 - x1 + 1;
+
+	if (innerRadius >= outerRadius)
+	{
+		forEachRowTile(y1, y2, rowLength, threadPool, [&](VisMap::Coord rowY1, VisMap::Coord rowY2) {
+			for (VisMap::Coord y = rowY1; y < rowY2; ++y)
+			{
+				VisMap::Entry * row = visMap.data + std::size_t(y) * visMap.width;
+				for (VisMap::Coord x = x1; x <= x2; ++x)
+				{
+					addLight(row[x], intensity);
+				}
+			}
+		});
+		return;
+	}
+
+	const RadialFalloffTable & table = getRadialFalloffTable(innerRadius, outerRadius, intensity);
+	const VisMap::LightIntensity * values = table.values.data();
+	std::int64_t tableSize = table.values.size();
+
+	forEachRowTile(y1, y2, rowLength, threadPool, [&](VisMap::Coord rowY1, VisMap::Coord rowY2) {
+		for (VisMap::Coord y = rowY1; y < rowY2; ++y)
+		{
+			std::int64_t dy = y - cy;
+			VisMap::Coord rowX1 = x1, rowX2 = x2;
+
+			// Restrict the row to the lit disc if the table covers it
+			if (table.complete)
+			{
+				std::int64_t remaining = tableSize - 1 - dy * dy;
+				if (remaining < 0)
+				{
+					continue;
+				}
+				VisMap::Coord span = getIntegerSqrt(remaining);
+				rowX1 = std::max(x1, cx - span);
+				rowX2 = std::min(x2, cx + span);
+			}
+
+			VisMap::Entry * row = visMap.data + std::size_t(y) * visMap.width;
+			for (VisMap::Coord x = rowX1; x <= rowX2; ++x)
+			{
+				std::int64_t dx = x - cx;
+				std::int64_t squareDistance = dx * dx + dy * dy;
+				addLight(row[x], squareDistance < tableSize
+				                     ? values[squareDistance]
+				                     : getRadialFalloff(squareDistance, innerRadius, outerRadius, intensity));
+			}
+		}
+	});
+}
+
 void wosC_accel_vision_lightApplyRadial(wosC_accel_vision_visMap_t * visMap, wosC_accel_vision_tileCoord_t x,
                                         wosC_accel_vision_tileCoord_t y, wosC_accel_vision_lightCoord_t innerRadius,
                                         wosC_accel_vision_lightCoord_t outerRadius,
@@ -637,50 +1151,150 @@ void wosC_accel_vision_lightApplyRadial(wosC_accel_vision_visMap_t * visMap, wos
 		return;
 	}
 
-	lightApplyRadial(visMapWrapper, x, y, innerRadius, outerRadius, intensity);
+	lightApplyRadial(visMapWrapper, x, y, innerRadius, outerRadius, intensity, visionThreadPool);
 }
 
-void updateLightMap(VisMap visMap, FovMap fovMap, RevealMap revealMap, LightMap lightMap, float factor)
+/**
+ * Computes the new light map value of a tile from its VisMap, FovMap and RevealMap entries.
+ */
+inline LightMap::Entry updateLightEntry(VisMap::Entry visEntry, FovMap::Entry fovEntry, RevealMap::Entry revealEntry,
+                                        LightMap::Entry lightEntry, float factor)
 {
-	for (VisMap::Coord y = visMap.clipY1; y <= visMap.clipY2; ++y)
-	{
-		for (VisMap::Coord x = visMap.clipX1; x <= visMap.clipX2; ++x)
-		{
-			// Get current visibility map entry for reading level light and vision flags
-			auto & visEntry = visMap.at(x, y);
+	// Read the light level from all cumulative light sources at the current tile
+	auto targetLight = bitGetSignedRange(visEntry, bitOffsetLight, bitCountLight);
 
-			// Read the light level from all cumulative light sources at the current tile
-			auto targetLight = bitGetSignedRange(visEntry, bitOffsetLight, bitCountLight);
+	// Force light level to 0 for tiles outside the player's field of view
+	targetLight *= (fovEntry != 0);
 
-			// Force light level to 0 for tiles outside the player's field of view
-			targetLight *= fovMap.test(x, y, bitmaskAll);
+	// Force light level to 0 for shadowed tiles
+	bool shadowed = bitTestMask(visEntry, bitmaskShadow);
+	targetLight *= (1 - shadowed);
 
-			// Force light level to 0 for shadowed tiles
-			bool shadowed = bitTestMask(visEntry, bitmaskShadow);
-			targetLight *= (1 - shadowed);
+	// Normalize to the [0, 255] range used by graphics
+	targetLight /= lightBrightnessRatio;
 
-			// Normalize to the [0, 255] range used by graphics
-			targetLight /= lightBrightnessRatio;
+	// Set the light level to at least brightnessRevealed for revealed tiles
+	bool revealed = bitTestMask(visEntry, bitmaskPerspectiveReveal) | (revealEntry != 0);
+	shadowed &= !bitTestMask(visEntry, bitmaskOpaque);
+	targetLight = std::max(targetLight, (brightnessRevealed - brightnessShadowed * shadowed) * revealed);
 
-			// Set the light level to at least brightnessRevealed for revealed tiles
-			bool revealed = bitTestMask(visEntry, bitmaskPerspectiveReveal) | revealMap.test(x, y, bitmaskAll);
-			shadowed &= !bitTestMask(visEntry, bitmaskOpaque);
-			targetLight = std::max(targetLight, (brightnessRevealed - brightnessShadowed * shadowed) * revealed);
+	// Force light level to 0 for tiles outside the perspective's view radius
+	targetLight *= bitTestMask(visEntry, bitmaskPerspectiveOcclude);
 
-			// Force light level to 0 for tiles outside the perspective's view radius
-			targetLight *= bitTestMask(visEntry, bitmaskPerspectiveOcclude);
+	// Force light level to 255 for tiles illuminated by perspective
+	targetLight |= brightnessMax * bitTestMask(visEntry, bitmaskPerspectiveIlluminate);
 
-			// Force light level to 255 for tiles illuminated by perspective
-			targetLight |= brightnessMax * bitTestMask(visEntry, bitmaskPerspectiveIlluminate);
+	// Gradually apply effective light level, with a limited approach rate
+	// TODO Add light level flickering
+	return clamp<int>(0, interpolateLinear<int>(lightEntry, targetLight, factor), brightnessMax);
+}
 
-			// Gradually apply effective light level, with a limited approach rate
-			// TODO Add light level flickering
+void updateLightMapScalar(VisMap visMap, FovMap fovMap, RevealMap revealMap, LightMap lightMap, float factor)
+{
+	for (VisMap::Coord y = visMap.clipY1; y <= visMap.clipY2; ++y)
+	{
+		for (VisMap::Coord x = visMap.clipX1; x <= visMap.clipX2; ++x)
+		{
 			auto & lightEntry = lightMap.at(x, y);
-			lightEntry = clamp<int>(0, interpolateLinear<int>(lightEntry, targetLight, factor), brightnessMax);
+			lightEntry = updateLightEntry(visMap.at(x, y), fovMap.at(x, y), revealMap.at(x, y), lightEntry, factor);
 		}
 	}
 }
 
+/**
+ * Branch-free equivalent of updateLightEntry for a row of tiles, processing four tiles at a time where SSE2 is
+ * available.
+ */
+void updateLightRow(const VisMap::Entry * visRow, const FovMap::Entry * fovRow, const RevealMap::Entry * revealRow,
+                    LightMap::Entry * lightRow, std::size_t count, float factor)
+{
+	std::size_t i = 0;
+
+#ifdef WOS_VISION_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i shadowMask = _mm_set1_epi32(int(bitmaskShadow));
+	const __m128i opaqueMask = _mm_set1_epi32(int(bitmaskOpaque));
+	const __m128i revealMask = _mm_set1_epi32(int(bitmaskPerspectiveReveal));
+	const __m128i occludeMask = _mm_set1_epi32(int(bitmaskPerspectiveOcclude));
+	const __m128i illuminateMask = _mm_set1_epi32(int(bitmaskPerspectiveIlluminate));
+	const __m128i revealedLight = _mm_set1_epi32(brightnessRevealed);
+	const __m128i shadowedLight = _mm_set1_epi32(brightnessShadowed);
+	const __m128i maxLight = _mm_set1_epi32(brightnessMax);
+	const __m128 brightnessRatio = _mm_set1_ps(float(lightBrightnessRatio));
+	const __m128 currentWeight = _mm_set1_ps(1.f - factor);
+	const __m128 targetWeight = _mm_set1_ps(factor);
+
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128i visEntries = _mm_loadu_si128(reinterpret_cast<const __m128i *>(visRow + i));
+		__m128i fovEntries = _mm_loadu_si128(reinterpret_cast<const __m128i *>(fovRow + i));
+		__m128i revealEntries = _mm_loadu_si128(reinterpret_cast<const __m128i *>(revealRow + i));
+
+		// Zero the light level outside the field of view and in shadows
+		__m128i shadowed = testBitsSSE2(visEntries, shadowMask);
+		__m128i targetLight = getLightSSE2(visEntries);
+		targetLight = _mm_andnot_si128(_mm_cmpeq_epi32(fovEntries, zero), targetLight);
+		targetLight = _mm_andnot_si128(shadowed, targetLight);
+
+		// Light levels fit into 24 bits, so float division is exact before truncation
+		targetLight = _mm_cvttps_epi32(_mm_div_ps(_mm_cvtepi32_ps(targetLight), brightnessRatio));
+
+		// Raise revealed tiles to the minimum light level (SSE2 has no 32-bit integer max)
+		__m128i revealed = _mm_or_si128(testBitsSSE2(visEntries, revealMask),
+		                                _mm_andnot_si128(_mm_cmpeq_epi32(revealEntries, zero), _mm_set1_epi32(-1)));
+		shadowed = _mm_andnot_si128(testBitsSSE2(visEntries, opaqueMask), shadowed);
+		__m128i minLight = _mm_sub_epi32(revealedLight, _mm_and_si128(shadowed, shadowedLight));
+		minLight = _mm_and_si128(minLight, revealed);
+		__m128i raise = _mm_cmpgt_epi32(minLight, targetLight);
+		targetLight = _mm_or_si128(_mm_and_si128(raise, minLight), _mm_andnot_si128(raise, targetLight));
+
+		// Apply perspective occlusion and illumination
+		targetLight = _mm_and_si128(targetLight, testBitsSSE2(visEntries, occludeMask));
+		targetLight = _mm_or_si128(targetLight, _mm_and_si128(testBitsSSE2(visEntries, illuminateMask), maxLight));
+
+		// Widen the current light values, interpolate in the same order as interpolateLinear, then clamp via
+		// saturating packs
+		std::int32_t packedLight;
+		std::memcpy(&packedLight, lightRow + i, sizeof(packedLight));
+		__m128i currentLight = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(packedLight), zero), zero);
+
+		__m128 blended = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(currentLight), currentWeight),
+		                            _mm_mul_ps(_mm_cvtepi32_ps(targetLight), targetWeight));
+		__m128i newLight = _mm_cvttps_epi32(blended);
+		newLight = _mm_packs_epi32(newLight, newLight);
+		newLight = _mm_packus_epi16(newLight, newLight);
+
+		packedLight = _mm_cvtsi128_si32(newLight);
+		std::memcpy(lightRow + i, &packedLight, sizeof(packedLight));
+	}
+#endif
+
+	for (; i < count; ++i)
+	{
+		lightRow[i] = updateLightEntry(visRow[i], fovRow[i], revealRow[i], lightRow[i], factor);
+	}
+}
+
+void updateLightMap(VisMap visMap, FovMap fovMap, RevealMap revealMap, LightMap lightMap, float factor,
+                    ThreadPool * threadPool)
+{
+	if (!hasSameLayout(visMap, fovMap) || !hasSameLayout(visMap, revealMap) || !hasSameLayout(visMap, lightMap))
+	{
+		updateLightMapScalar(visMap, fovMap, revealMap, lightMap, factor);
+		return;
+	}
+
+	std::size_t rowLength = visMap.clipX2 - visMap.clipX1 + 1;
+	forEachRowTile(visMap.clipY1, visMap.clipY2, rowLength, threadPool, [&](VisMap::Coord y1, VisMap::Coord y2) {
+		for (VisMap::Coord y = y1; y < y2; ++y)
+		{
+			std::size_t offset = visMap.clipX1 + std::size_t(y) * visMap.width;
+			updateLightRow(visMap.data + offset, fovMap.data + offset, revealMap.data + offset, lightMap.data + offset,
+			               rowLength, factor);
+		}
+	});
+}
+
 void wosC_accel_vision_updateLightMap(
 		wosC_accel_vision_visMap_t * visMap,
 		wosC_accel_vision_fovMap_t * fovMap,
@@ -716,5 +1330,105 @@ void wosC_accel_vision_updateLightMap(
 		return;
 	}
 
-	updateLightMap(visMapWrapper, fovMapWrapper, revealMapWrapper, lightMapWrapper, factor);
+	updateLightMap(visMapWrapper, fovMapWrapper, revealMapWrapper, lightMapWrapper, factor, visionThreadPool);
+}
+
+template <typename Map>
+static Map makeBenchmarkMap(std::vector<typename Map::Entry> & data, VisMap::Coord width, VisMap::Coord height)
+{
+	Map map;
+	map.data = data.data();
+	map.width = width;
+	map.height = height;
+	map.clipX2 = width - 1;
+	map.clipY2 = height - 1;
+	return map;
+}
+
+wosc::VisionBenchmarkResult wosc::benchmarkVision(int width, int height, int iterations, ThreadPool * threadPool)
+{
+	VisionBenchmarkResult result;
+
+	width = std::max(width, 1);
+	height = std::max(height, 1);
+	iterations = std::max(iterations, 1);
+
+	// Random entries cover negative light levels and all flag combinations
+	std::size_t tileCount = std::size_t(width) * height;
+	std::mt19937 random(tileCount);
+	std::vector<VisMap::Entry> visData(tileCount);
+	std::vector<FovMap::Entry> fovData(tileCount);
+	std::vector<RevealMap::Entry> revealData(tileCount);
+	std::vector<LightMap::Entry> scalarLightData(tileCount);
+	for (std::size_t i = 0; i < tileCount; ++i)
+	{
+		visData[i] = random();
+		fovData[i] = random() % 4 != 0;
+		revealData[i] = random() % 4 == 0;
+		scalarLightData[i] = random() % 256;
+	}
+	auto vectorLightData = scalarLightData;
+	auto parallelLightData = scalarLightData;
+
+	auto visMap = makeBenchmarkMap<VisMap>(visData, width, height);
+	auto fovMap = makeBenchmarkMap<FovMap>(fovData, width, height);
+	auto revealMap = makeBenchmarkMap<RevealMap>(revealData, width, height);
+
+	static const float factor = 0.25f;
+
+	sf::Clock clock;
+	for (int i = 0; i < iterations; ++i)
+	{
+		updateLightMapScalar(visMap, fovMap, revealMap, makeBenchmarkMap<LightMap>(scalarLightData, width, height),
+		                     factor);
+	}
+	result.scalarLightMapSeconds = clock.restart().asSeconds() / iterations;
+
+	for (int i = 0; i < iterations; ++i)
+	{
+		updateLightMap(visMap, fovMap, revealMap, makeBenchmarkMap<LightMap>(vectorLightData, width, height), factor,
+		               nullptr);
+	}
+	result.vectorLightMapSeconds = clock.restart().asSeconds() / iterations;
+
+	for (int i = 0; i < iterations; ++i)
+	{
+		updateLightMap(visMap, fovMap, revealMap, makeBenchmarkMap<LightMap>(parallelLightData, width, height), factor,
+		               threadPool);
+	}
+	result.parallelLightMapSeconds = clock.restart().asSeconds() / iterations;
+
+	// The scalar kernel overflows beyond 127 tiles, so larger light sources are not compared
+	static const VisMap::Coord lightCount = 16;
+	VisMap::LightCoord outerRadius = std::min(std::min(width, height) / 4, 127) * lightTileSize + lightTileSize / 2;
+	VisMap::LightCoord innerRadius = outerRadius / 4;
+
+	auto tableVisData = visData;
+	auto tableVisMap = makeBenchmarkMap<VisMap>(tableVisData, width, height);
+
+	clock.restart();
+	for (int i = 0; i < iterations; ++i)
+	{
+		for (VisMap::Coord light = 0; light < lightCount; ++light)
+		{
+			lightApplyRadialScalar(visMap, width * light / lightCount, height * light / lightCount, innerRadius,
+			                       outerRadius, lightRevealThreshold);
+		}
+	}
+	result.scalarRadialSeconds = clock.restart().asSeconds() / iterations;
+
+	for (int i = 0; i < iterations; ++i)
+	{
+		for (VisMap::Coord light = 0; light < lightCount; ++light)
+		{
+			lightApplyRadial(tableVisMap, width * light / lightCount, height * light / lightCount, innerRadius,
+			                 outerRadius, lightRevealThreshold, threadPool);
+		}
+	}
+	result.tableRadialSeconds = clock.restart().asSeconds() / iterations;
+
+	result.identical =
+	    scalarLightData == vectorLightData && scalarLightData == parallelLightData && visData == tableVisData;
+
+	return result;
 }
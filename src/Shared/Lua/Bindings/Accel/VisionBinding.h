@@ -60,6 +60,27 @@ extern "C"
 	                                              wosC_accel_vision_fovMap_entry_t mask,
 	                                              wosC_accel_vision_tileCoord_t x, wosC_accel_vision_tileCoord_t y);
 
+	/**
+	 * Source for batched field-of-view raycasting. Visible tiles within the radius (in light coordinates, as for
+	 * fovAddCircle; unlimited if 0 or less) get the mask bits set, so sources can either share bits or use separate
+	 * bit planes.
+	 */
+	typedef struct
+	{
+		wosC_accel_vision_tileCoord_t x;
+		wosC_accel_vision_tileCoord_t y;
+		wosC_accel_vision_lightCoord_t radius;
+		wosC_accel_vision_fovMap_entry_t mask;
+	} wosC_accel_vision_fovSource_t;
+
+	/**
+	 * Adds the fields of view of all sources at once, processing groups of sources in parallel.
+	 */
+	WOSC_API void wosC_accel_vision_fovAddRaycastBatch(wosC_accel_vision_visMap_t * visMap,
+	                                                   wosC_accel_vision_fovMap_t * fovMap,
+	                                                   const wosC_accel_vision_fovSource_t * sources,
+	                                                   int32_t sourceCount);
+
 	WOSC_API void wosC_accel_vision_fovAddCircle(wosC_accel_vision_fovMap_t * fovMap,
 	                                             wosC_accel_vision_fovMap_entry_t mask, wosC_accel_vision_tileCoord_t x,
 	                                             wosC_accel_vision_tileCoord_t y,
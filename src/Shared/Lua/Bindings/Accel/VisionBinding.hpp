@@ -0,0 +1,39 @@
+#ifndef SRC_SHARED_LUA_BINDINGS_ACCEL_VISIONBINDING_HPP_
+#define SRC_SHARED_LUA_BINDINGS_ACCEL_VISIONBINDING_HPP_
+
+#include <Shared/Lua/Bindings/Accel/VisionBinding.h>
+#include <cstddef>
+
+class ThreadPool;
+
+namespace wosc
+{
+
+/**
+ * Sets the thread pool on which large vision map updates are split into row tiles, or disables parallel updates if
+ * null. The pool must outlive all vision calls made while it is set.
+ */
+void setVisionThreadPool(ThreadPool * threadPool);
+
+struct VisionBenchmarkResult
+{
+	double scalarLightMapSeconds = 0;
+	double vectorLightMapSeconds = 0;
+	double parallelLightMapSeconds = 0;
+
+	double scalarRadialSeconds = 0;
+	double tableRadialSeconds = 0;
+
+	// Whether the vectorized, parallel and table-based kernels produced the same maps as the scalar kernels
+	bool identical = false;
+};
+
+/**
+ * Compares the scalar per-tile light map update and radial light application against the vectorized, row-parallel
+ * and lookup table-based kernels on synthetic maps of the specified size, running each kernel 'iterations' times.
+ */
+VisionBenchmarkResult benchmarkVision(int width, int height, int iterations, ThreadPool * threadPool);
+
+}
+
+#endif
@@ -4,8 +4,9 @@
 #include <Shared/Utils/Error.hpp>
 #include <Shared/Utils/StrNumCon.hpp>
 #include <algorithm>
-#include <memory>
+#include <cstring>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -17,6 +18,18 @@ extern "C"
 		return wosc::ArrayContext::getContextByID(context).newArray(size);
 	}
 
+	wosC_array_id_t wosC_array_newUninitialized(wosC_array_context_t context, wosC_array_size_t size)
+	{
+		return wosc::ArrayContext::getContextByID(context).newArray(size, false);
+	}
+
+	wosC_array_id_t wosC_array_mapFile(wosC_array_context_t context, const char * filename, uint64_t offset,
+	                                   uint64_t size, bool readOnly)
+	{
+		auto mode = readOnly ? fs::MappedFile::Mode::ReadOnly : fs::MappedFile::Mode::CopyOnWrite;
+		return wosc::ArrayContext::getContextByID(context).mapFile(filename ? filename : "", offset, size, mode);
+	}
+
 	wosC_array_info_t wosC_array_getArrayInfo(wosC_array_context_t context, wosC_array_id_t array)
 	{
 		return wosc::ArrayContext::getContextByID(context).getArrayInfo(array);
@@ -36,11 +49,61 @@ extern "C"
 	{
 		return wosc::ArrayContext::getContextByID(context).getArrayOwnershipFlag(array);
 	}
+
+	bool wosC_array_isWritable(wosC_array_context_t context, wosC_array_id_t array)
+	{
+		return wosc::ArrayContext::getContextByID(context).isArrayWritable(array);
+	}
+
+	bool wosC_array_adviseAccess(wosC_array_context_t context, wosC_array_id_t array, wosC_array_access_t access,
+	                             wosC_array_size_t offset, wosC_array_size_t size)
+	{
+		if (access < 0 || access > int(fs::MappedFile::Access::DontNeed))
+		{
+			return false;
+		}
+		return wosc::ArrayContext::getContextByID(context).adviseArrayAccess(
+		    array, fs::MappedFile::Access(access), offset, size);
+	}
+
+	bool wosC_array_fill(void * data, wosC_array_size_t count, wosC_array_type_t type, double value)
+	{
+		bool valid = true;
+		bool known = wosc::visitArrayType(type, [&](auto * typeTag) {
+			using Item = std::remove_pointer_t<decltype(typeTag)>;
+
+			Item item;
+			valid = wosc::convertArrayItem(value, item);
+			if (valid && count > 0)
+			{
+				std::fill_n(static_cast<Item *>(data), count, item);
+			}
+		});
+		return known && valid;
+	}
+
+	void wosC_array_move(void * dest, const void * source, wosC_array_size_t byteCount)
+	{
+		if (byteCount > 0)
+		{
+			std::memmove(dest, source, byteCount);
+		}
+	}
 }
 
 namespace wosc
 {
 
+// Array IDs hold the slot index in their low bits and the slot's generation in the remaining bits below the sign bit.
+// Generations start at 1, so that valid IDs are always positive.
+static constexpr std::uint32_t slotIndexBits = 20;
+static constexpr std::uint32_t slotIndexMask = (1u << slotIndexBits) - 1;
+static constexpr std::uint32_t maxGeneration = (1u << (31 - slotIndexBits)) - 1;
+
+// Freed slots are only reused once this many are queued, so that a slot's generation wraps around no earlier than
+// after maxGeneration * minFreeSlots deletions, instead of after maxGeneration deletions on the same slot
+static constexpr std::size_t minFreeSlots = 4096;
+
 std::vector<ArrayContext *> ArrayContext::contexts = {};
 
 ArrayContext::ArrayContext() :
@@ -95,30 +158,80 @@ ArrayContext::ID ArrayContext::getID() const
 
 void ArrayContext::clear()
 {
-	arrays.clear();
-	arrayIDWrapped = false;
-	currentArrayID = 0;
+	// Slots keep their generation, so that IDs from before the reset stay invalid
+	freeSlots.clear();
+	for (std::size_t i = 0; i < slots.size(); ++i)
+	{
+		if (slots[i].used)
+		{
+			releaseSlot(slots[i]);
+		}
+		freeSlots.push_back(i);
+	}
+
+	allocator.clear();
 	memoryUsage = 0;
+	mappedSize = 0;
 }
 
-ArrayContext::ArrayID ArrayContext::newArray(ArraySize size)
+ArrayContext::ArrayID ArrayContext::newArray(ArraySize size, bool zeroInitialize)
 {
-	auto arrayID = getNextArrayID();
-	arrays.emplace(arrayID, ArrayStructure(size));
+	if (size < 0)
+	{
+		throw Error("Attempt to create array with negative size " + cNtoS(size));
+	}
+
+	auto block = allocator.allocate(size, zeroInitialize);
+	ArrayID arrayID = addSlot(block.data, size);
+	slots[std::uint32_t(arrayID) & slotIndexMask].block = block;
 	memoryUsage += size;
-	logger.trace("Array created: ctx = {}, id = {}, size = {}, count = {}", contextID, arrayID, size, arrays.size());
+
+	logger.trace("Array created: ctx = {}, id = {}, size = {}, count = {}", contextID, arrayID, size,
+	             slots.size() - freeSlots.size());
+	return arrayID;
+}
+
+ArrayContext::ArrayID ArrayContext::mapFile(const std::string & filename, std::uint64_t offset, std::uint64_t size,
+                                            fs::MappedFile::Mode mode)
+{
+	auto mapping = std::make_unique<fs::MappedFile>();
+	if (!mapping->open(filename, offset, size, mode))
+	{
+		logger.debug("Failed to map file region: file = {}, offset = {}, size = {}", filename, offset, size);
+		return 0;
+	}
+
+	auto data = reinterpret_cast<ArrayPointer>(const_cast<char *>(mapping->getData()));
+	ArrayID arrayID = addSlot(data, mapping->getSize());
+
+	ArraySlot & slot = slots[std::uint32_t(arrayID) & slotIndexMask];
+	slot.writable = mode == fs::MappedFile::Mode::CopyOnWrite;
+	slot.mapping = std::move(mapping);
+	mappedSize += slot.size;
+
+	logger.trace("File-backed array created: ctx = {}, id = {}, file = {}, offset = {}, size = {}", contextID, arrayID,
+	             filename, offset, slot.size);
 	return arrayID;
 }
 
 void ArrayContext::deleteArray(ArrayID id)
 {
-	auto result = arrays.find(id);
-	if (result != arrays.end())
+	ArraySlot * slot = findSlot(id);
+	if (slot)
 	{
-		memoryUsage -= result->second.size;
-		arrays.erase(id);
+		if (slot->mapping)
+		{
+			mappedSize -= slot->size;
+		}
+		else
+		{
+			memoryUsage -= slot->size;
+			allocator.deallocate(slot->block);
+		}
+		releaseSlot(*slot);
+		freeSlots.push_back(std::uint32_t(id) & slotIndexMask);
 
-		logger.trace("Array deleted: ctx = {}, id = {}, count = {}", contextID, id, arrays.size());
+		logger.trace("Array deleted: ctx = {}, id = {}, count = {}", contextID, id, slots.size() - freeSlots.size());
 	}
 	else
 	{
@@ -128,10 +241,10 @@ void ArrayContext::deleteArray(ArrayID id)
 
 ArrayContext::ArrayInfo ArrayContext::getArrayInfo(ArrayID id) const
 {
-	auto result = arrays.find(id);
-	if (result != arrays.end())
+	const ArraySlot * slot = findSlot(id);
+	if (slot)
 	{
-		return ArrayInfo {result->second.getPointer(), result->second.size};
+		return ArrayInfo {slot->data, slot->size};
 	}
 	else
 	{
@@ -141,24 +254,33 @@ ArrayContext::ArrayInfo ArrayContext::getArrayInfo(ArrayID id) const
 
 void ArrayContext::setArrayOwnershipFlag(ArrayID id, bool owned)
 {
-	auto result = arrays.find(id);
-	if (result != arrays.end())
+	ArraySlot * slot = findSlot(id);
+	if (slot)
 	{
-		result->second.owned = owned;
+		slot->owned = owned;
 	}
 }
 
 bool ArrayContext::getArrayOwnershipFlag(ArrayID id) const
 {
-	auto result = arrays.find(id);
-	if (result != arrays.end())
-	{
-		return result->second.owned;
-	}
-	else
+	const ArraySlot * slot = findSlot(id);
+	return slot && slot->owned;
+}
+
+bool ArrayContext::isArrayWritable(ArrayID id) const
+{
+	const ArraySlot * slot = findSlot(id);
+	return slot && slot->writable;
+}
+
+bool ArrayContext::adviseArrayAccess(ArrayID id, fs::MappedFile::Access access, ArraySize offset, ArraySize size) const
+{
+	const ArraySlot * slot = findSlot(id);
+	if (!slot || !slot->mapping || offset < 0 || size < 0)
 	{
 		return false;
 	}
+	return slot->mapping->advise(access, offset, size);
 }
 
 std::size_t ArrayContext::getTotalMemoryUsage() const
@@ -166,39 +288,71 @@ std::size_t ArrayContext::getTotalMemoryUsage() const
 	return memoryUsage;
 }
 
-ArrayContext::ArrayStructure::ArrayStructure(ArraySize size) :
-	data(std::make_unique<ArrayItem[]>(size)),
-	size(size),
-	owned(false)
+std::size_t ArrayContext::getMappedSize() const
 {
+	return mappedSize;
 }
 
-ArrayContext::ArrayPointer ArrayContext::ArrayStructure::getPointer() const
+std::vector<ArenaAllocator::SizeClassUsage> ArrayContext::getMemoryUsageBySizeClass() const
 {
-	return data.get();
+	return allocator.getUsage();
 }
 
-ArrayContext::ArrayID ArrayContext::getNextArrayID()
+ArrayContext::ArrayID ArrayContext::addSlot(ArrayPointer data, ArraySize size)
 {
-	if (currentArrayID == std::numeric_limits<ArrayID>::max())
+	if (freeSlots.size() < minFreeSlots && slots.size() <= slotIndexMask)
 	{
-		currentArrayID = 0;
-		arrayIDWrapped = true;
+		freeSlots.push_front(slots.size());
+		slots.emplace_back();
+		slots.back().generation = 1;
 	}
-	else
+	else if (freeSlots.empty())
 	{
-		++currentArrayID;
+		throw Error("Too many arrays in context " + cNtoS(contextID));
 	}
 
-	if (arrayIDWrapped)
+	std::uint32_t index = freeSlots.front();
+	freeSlots.pop_front();
+
+	ArraySlot & slot = slots[index];
+	slot.data = data;
+	slot.size = size;
+	slot.used = true;
+	slot.owned = false;
+	slot.writable = true;
+	return ArrayID((slot.generation << slotIndexBits) | index);
+}
+
+void ArrayContext::releaseSlot(ArraySlot & slot)
+{
+	slot.data = nullptr;
+	slot.size = 0;
+	slot.block = ArenaAllocator::Block();
+	slot.mapping.reset();
+	slot.used = false;
+	slot.owned = false;
+	slot.generation = slot.generation == maxGeneration ? 1 : slot.generation + 1;
+}
+
+ArrayContext::ArraySlot * ArrayContext::findSlot(ArrayID id)
+{
+	return const_cast<ArraySlot *>(static_cast<const ArrayContext *>(this)->findSlot(id));
+}
+
+const ArrayContext::ArraySlot * ArrayContext::findSlot(ArrayID id) const
+{
+	if (id <= 0)
 	{
-		while (arrays.count(currentArrayID))
-		{
-			++currentArrayID;
-		}
+		return nullptr;
 	}
 
-	return currentArrayID;
+	std::uint32_t index = std::uint32_t(id) & slotIndexMask;
+	std::uint32_t generation = std::uint32_t(id) >> slotIndexBits;
+	if (index >= slots.size() || !slots[index].used || slots[index].generation != generation)
+	{
+		return nullptr;
+	}
+	return &slots[index];
 }
 
 }
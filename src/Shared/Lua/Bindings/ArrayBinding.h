@@ -24,17 +24,19 @@ typedef wosC_array_item_t * wosC_array_t;
 typedef int32_t wosC_array_context_t;
 
 /**
- * Numeric ID of an array.
+ * Numeric ID of an array. IDs are positive and hold a slot index and a generation counter, so that IDs of deleted
+ * arrays are not resolved to arrays that later reuse the slot.
  */
 typedef int32_t wosC_array_id_t;
 
 /**
- * Size type of an array.
+ * Size type of an array (in bytes for array infos, in elements for typed views).
  */
-typedef int32_t wosC_array_size_t;
+typedef int64_t wosC_array_size_t;
 
 /**
- * Struct holding information about an array's data.
+ * Struct holding information about an array's data. Allocated arrays are aligned to 64 bytes; file-backed arrays are
+ * aligned like their offset in the file.
  */
 typedef struct
 {
@@ -51,6 +53,88 @@ typedef struct
 	wosC_array_id_t array;
 } wosC_array_ref_t;
 
+/**
+ * Expected access pattern of a file-backed array: 0 = normal, 1 = sequential, 2 = random, 3 = will be needed soon,
+ * 4 = not needed anymore (read-only arrays only).
+ */
+typedef int32_t wosC_array_access_t;
+
+/**
+ * Element type of a typed array view, numbered like array.Type in Array.lua (1 = int8 ... 8 = double).
+ */
+typedef int32_t wosC_array_type_t;
+
+/**
+ * Typed views of (a range of) an array. 'data' points to the first element of the range, 'size' is the number of
+ * elements in it, and 'offset' is the element index of the range's start within the array identified by 'array'.
+ *
+ * Views are plain structs, so that element accesses through 'data' compile to direct loads and stores. As sizes are
+ * 64-bit, Lua code should use '#view' to get the size as a Lua number.
+ */
+typedef struct
+{
+	int8_t * data;
+	wosC_array_size_t size;
+	wosC_array_id_t array;
+	wosC_array_size_t offset;
+} wosC_array_view_int8_t;
+
+typedef struct
+{
+	int16_t * data;
+	wosC_array_size_t size;
+	wosC_array_id_t array;
+	wosC_array_size_t offset;
+} wosC_array_view_int16_t;
+
+typedef struct
+{
+	int32_t * data;
+	wosC_array_size_t size;
+	wosC_array_id_t array;
+	wosC_array_size_t offset;
+} wosC_array_view_int32_t;
+
+typedef struct
+{
+	uint8_t * data;
+	wosC_array_size_t size;
+	wosC_array_id_t array;
+	wosC_array_size_t offset;
+} wosC_array_view_uint8_t;
+
+typedef struct
+{
+	uint16_t * data;
+	wosC_array_size_t size;
+	wosC_array_id_t array;
+	wosC_array_size_t offset;
+} wosC_array_view_uint16_t;
+
+typedef struct
+{
+	uint32_t * data;
+	wosC_array_size_t size;
+	wosC_array_id_t array;
+	wosC_array_size_t offset;
+} wosC_array_view_uint32_t;
+
+typedef struct
+{
+	float * data;
+	wosC_array_size_t size;
+	wosC_array_id_t array;
+	wosC_array_size_t offset;
+} wosC_array_view_float_t;
+
+typedef struct
+{
+	double * data;
+	wosC_array_size_t size;
+	wosC_array_id_t array;
+	wosC_array_size_t offset;
+} wosC_array_view_double_t;
+
 /**
  * Creates a new array and returns a pointer to it, or a null pointer on allocation failure.
  *
@@ -58,6 +142,22 @@ typedef struct
  */
 WOSC_API wosC_array_id_t wosC_array_new(wosC_array_context_t context, wosC_array_size_t size);
 
+/**
+ * Creates a new array like wosC_array_new, but leaves its contents uninitialized. This avoids clearing large buffers
+ * that are fully overwritten anyway.
+ */
+WOSC_API wosC_array_id_t wosC_array_newUninitialized(wosC_array_context_t context, wosC_array_size_t size);
+
+/**
+ * Creates an array backed by a memory mapping of 'size' bytes of the file, starting at byte 'offset' (or the rest of
+ * the file if 'size' is 0). Pages are read lazily when accessed, and the array can exceed the available memory.
+ *
+ * Writes to copy-on-write arrays stay in memory and never reach the file. Read-only arrays must not be written to.
+ * Returns 0 if the file region cannot be mapped.
+ */
+WOSC_API wosC_array_id_t wosC_array_mapFile(wosC_array_context_t context, const char * filename, uint64_t offset,
+                                            uint64_t size, bool readOnly);
+
 /**
  * Returns the info of an existing array by ID.
  */
@@ -78,6 +178,31 @@ WOSC_API void wosC_array_setOwnership(wosC_array_context_t context, wosC_array_i
  */
 WOSC_API bool wosC_array_isOwned(wosC_array_context_t context, wosC_array_id_t array);
 
+/**
+ * Checks if the array may be written to (false for read-only file-backed arrays and invalid arrays).
+ */
+WOSC_API bool wosC_array_isWritable(wosC_array_context_t context, wosC_array_id_t array);
+
+/**
+ * Hints the access pattern of a byte range of a file-backed array, e.g. to enable aggressive read-ahead for
+ * sequential scans. Returns false for other arrays, or if the hint is not supported on this system.
+ */
+WOSC_API bool wosC_array_adviseAccess(wosC_array_context_t context, wosC_array_id_t array,
+                                      wosC_array_access_t access, wosC_array_size_t offset, wosC_array_size_t size);
+
+/**
+ * Sets 'count' elements of the specified type, starting at 'data', to 'value' (converted to the element type).
+ * Values outside the range of an integer type are clamped to it, and fractions are truncated towards zero.
+ *
+ * Returns false if the element type is invalid, or if 'value' is NaN and the element type is an integer type.
+ */
+WOSC_API bool wosC_array_fill(void * data, wosC_array_size_t count, wosC_array_type_t type, double value);
+
+/**
+ * Copies 'byteCount' bytes from 'source' to 'dest'. The ranges may overlap.
+ */
+WOSC_API void wosC_array_move(void * dest, const void * source, wosC_array_size_t byteCount);
+
 }
 
 #endif
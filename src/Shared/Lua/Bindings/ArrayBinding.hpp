@@ -3,8 +3,16 @@
 
 #include <Shared/Lua/Bindings/ArrayBinding.h>
 #include <Shared/Utils/Debug/Logger.hpp>
-#include <Shared/Utils/HashTable.hpp>
+#include <Shared/Utils/Filesystem/MappedFile.hpp>
+#include <Shared/Utils/Memory/ArenaAllocator.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <limits>
 #include <memory>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 namespace wosc
@@ -35,41 +43,151 @@ public:
 
 	ID getID() const;
 
-	ArrayID newArray(ArraySize size);
+	/**
+	 * Creates a zero-filled array, or an uninitialized one if 'zeroInitialize' is false. Array data is aligned to
+	 * ArenaAllocator::alignment bytes.
+	 */
+	ArrayID newArray(ArraySize size, bool zeroInitialize = true);
+
+	/**
+	 * Creates an array backed by a memory mapping of 'size' bytes of the file, starting at 'offset' (or the rest of
+	 * the file if 'size' is 0). Pages are only read when accessed. The data is aligned like the offset.
+	 *
+	 * Read-only arrays must not be written to; see isArrayWritable. Returns 0 if the file region cannot be mapped.
+	 */
+	ArrayID mapFile(const std::string & filename, std::uint64_t offset, std::uint64_t size,
+	                fs::MappedFile::Mode mode = fs::MappedFile::Mode::CopyOnWrite);
+
 	void deleteArray(ArrayID id);
 
+	/**
+	 * Resolves the array ID by slot index. Returns a null pointer and zero size for unknown or deleted arrays.
+	 */
 	ArrayInfo getArrayInfo(ArrayID id) const;
 
 	void setArrayOwnershipFlag(ArrayID id, bool owned);
 	bool getArrayOwnershipFlag(ArrayID id) const;
 
+	bool isArrayWritable(ArrayID id) const;
+
+	/**
+	 * Hints the access pattern of a byte range of a file-backed array. Returns false for other arrays, or if the hint
+	 * is not supported.
+	 */
+	bool adviseArrayAccess(ArrayID id, fs::MappedFile::Access access, ArraySize offset, ArraySize size) const;
+
+	/**
+	 * Returns the memory usage of allocated arrays. File-backed arrays are excluded; see getMappedSize.
+	 */
 	std::size_t getTotalMemoryUsage() const;
 
+	/**
+	 * Returns the total size of the file regions mapped by file-backed arrays.
+	 */
+	std::size_t getMappedSize() const;
+
+	/**
+	 * Returns the memory usage per allocation size class (see ArenaAllocator).
+	 */
+	std::vector<ArenaAllocator::SizeClassUsage> getMemoryUsageBySizeClass() const;
+
 private:
-	struct ArrayStructure
+	struct ArraySlot
 	{
-		ArrayStructure(ArraySize size);
+		ArrayPointer data = nullptr;
+		ArraySize size = 0;
 
-		ArrayPointer getPointer() const;
+		// Arrays are either allocated from the arena or backed by a file mapping
+		ArenaAllocator::Block block;
+		std::unique_ptr<fs::MappedFile> mapping;
 
-		std::unique_ptr<ArrayItem[]> data;
-		ArraySize size;
-		bool owned;
+		std::uint32_t generation = 0;
+		bool used = false;
+		bool owned = false;
+		bool writable = true;
 	};
 
-	ArrayID getNextArrayID();
+	ArrayID addSlot(ArrayPointer data, ArraySize size);
+	void releaseSlot(ArraySlot & slot);
+
+	ArraySlot * findSlot(ArrayID id);
+	const ArraySlot * findSlot(ArrayID id) const;
 
 	ID contextID;
-	ArrayID currentArrayID = 0;
-	bool arrayIDWrapped = false;
-	HashMap<ArrayID, ArrayStructure> arrays;
+	std::vector<ArraySlot> slots;
+	// Reused in FIFO order, so that a slot's generation advances as slowly as possible
+	std::deque<std::uint32_t> freeSlots;
+	ArenaAllocator allocator;
 	std::size_t memoryUsage = 0;
+	std::size_t mappedSize = 0;
 
 	Logger logger;
 
 	static std::vector<ArrayContext *> contexts;
 };
 
+/**
+ * Calls 'func' with a null pointer of the element type that corresponds to the typed array view type, so that generic
+ * code can be instantiated per element type. Returns false if the type is invalid.
+ */
+template <typename Func>
+bool visitArrayType(wosC_array_type_t type, Func && func)
+{
+	switch (type)
+	{
+	case 1:
+		func(static_cast<std::int8_t *>(nullptr));
+		return true;
+	case 2:
+		func(static_cast<std::int16_t *>(nullptr));
+		return true;
+	case 3:
+		func(static_cast<std::int32_t *>(nullptr));
+		return true;
+	case 4:
+		func(static_cast<std::uint8_t *>(nullptr));
+		return true;
+	case 5:
+		func(static_cast<std::uint16_t *>(nullptr));
+		return true;
+	case 6:
+		func(static_cast<std::uint32_t *>(nullptr));
+		return true;
+	case 7:
+		func(static_cast<float *>(nullptr));
+		return true;
+	case 8:
+		func(static_cast<double *>(nullptr));
+		return true;
+	default:
+		return false;
+	}
+}
+
+/**
+ * Converts a number to an array element type. Values outside the range of an integer type are clamped to it, and
+ * fractions are truncated towards zero. Returns false if the value is NaN and the element type is an integer type,
+ * since the conversion would be undefined.
+ */
+template <typename Item>
+bool convertArrayItem(double value, Item & item)
+{
+	if (!std::is_integral<Item>::value)
+	{
+		item = static_cast<Item>(value);
+		return true;
+	}
+
+	if (std::isnan(value))
+	{
+		return false;
+	}
+
+	item = static_cast<Item>(std::min<double>(std::max<double>(value, std::numeric_limits<Item>::min()),
+	                                          std::numeric_limits<Item>::max()));
+	return true;
+}
+
 }
 
 #endif
@@ -18,4 +18,13 @@ void AbstractBridge::load(LuaManager & manager)
 	onLoad(bridgeLoader);
 }
 
+void AbstractBridge::unload()
+{
+	onUnload();
+}
+
+void AbstractBridge::onUnload()
+{
+}
+
 }
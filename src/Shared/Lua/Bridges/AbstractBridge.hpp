@@ -15,8 +15,15 @@ public:
 
 	void load(LuaManager & manager);
 
+	/**
+	 * Releases resources that must not outlive the game state, such as threads accessing array memory. Called before
+	 * the game state is reset or destroyed.
+	 */
+	void unload();
+
 protected:
 	virtual void onLoad(BridgeLoader & loader) = 0;
+	virtual void onUnload();
 };
 
 }
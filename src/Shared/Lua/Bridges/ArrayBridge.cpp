@@ -1,6 +1,10 @@
 #include <Shared/Lua/Bindings/ArrayBinding.hpp>
 #include <Shared/Lua/Bridges/ArrayBridge.hpp>
+#include <Sol2/sol.hpp>
 #include <functional>
+#include <string>
+#include <tuple>
+#include <type_traits>
 
 namespace lua
 {
@@ -16,9 +20,90 @@ ArrayBridge::~ArrayBridge()
 
 void ArrayBridge::onLoad(BridgeLoader & loader)
 {
+	using ArrayID = wosc::ArrayContext::ArrayID;
+	using ArraySize = wosc::ArrayContext::ArraySize;
+	using ArrayType = wosC_array_type_t;
+
 	loader.bind("array.getContext", std::function<wosc::ArrayContext::ID()>([=]() {
 		            return arrayContext.getID();
 	            }));
+
+	// Checks that the element range lies within the array, which holds elements of the specified size
+	auto isValidRange = [=](ArrayID arrayID, ArraySize first, ArraySize count, ArraySize itemSize) {
+		auto info = arrayContext.getArrayInfo(arrayID);
+		return info.data && first >= 0 && count >= 0 && first + count <= info.size / itemSize;
+	};
+
+	loader.bind("array.toTable", //
+	    std::function<std::tuple<sol::object, std::string>(ArrayID, ArrayType, ArraySize, ArraySize,
+	                                                       sol::this_state)>(
+	        [=](ArrayID arrayID, ArrayType type, ArraySize first, ArraySize count,
+	            sol::this_state state) -> std::tuple<sol::object, std::string>
+	        {
+		        sol::state_view lua(state);
+		        sol::object result = sol::make_object(state, sol::lua_nil);
+		        std::string error;
+
+		        bool validType = wosc::visitArrayType(type, [&](auto * typeTag) {
+			        using Item = std::remove_pointer_t<decltype(typeTag)>;
+			        if (!isValidRange(arrayID, first, count, ArraySize(sizeof(Item))))
+			        {
+				        error = "Array range out of bounds";
+				        return;
+			        }
+
+			        // Lua tables are one-based
+			        const Item * items = reinterpret_cast<const Item *>(arrayContext.getArrayInfo(arrayID).data) + first;
+			        auto table = lua.create_table(int(count), 0);
+			        for (ArraySize i = 0; i < count; ++i)
+			        {
+				        table.raw_set(i + 1, items[i]);
+			        }
+			        result = table;
+		        });
+
+		        return std::make_tuple(result, validType ? error : "Invalid array type");
+	        }));
+
+	loader.bind("array.fromTable", //
+	    std::function<std::tuple<bool, std::string>(ArrayID, ArrayType, ArraySize, sol::table)>(
+	        [=](ArrayID arrayID, ArrayType type, ArraySize first, sol::table values) -> std::tuple<bool, std::string>
+	        {
+		        std::string error;
+
+		        bool validType = wosc::visitArrayType(type, [&](auto * typeTag) {
+			        using Item = std::remove_pointer_t<decltype(typeTag)>;
+			        ArraySize count = values.size();
+			        if (!isValidRange(arrayID, first, count, ArraySize(sizeof(Item))))
+			        {
+				        error = "Array range out of bounds";
+				        return;
+			        }
+			        if (!arrayContext.isArrayWritable(arrayID))
+			        {
+				        error = "Array is read-only";
+				        return;
+			        }
+
+			        // Non-numeric values are stored as zero; elements before a NaN in an integer array are kept
+			        Item * items = reinterpret_cast<Item *>(arrayContext.getArrayInfo(arrayID).data) + first;
+			        for (ArraySize i = 0; i < count; ++i)
+			        {
+				        auto value = values.raw_get<sol::optional<double>>(i + 1);
+				        if (!wosc::convertArrayItem(value ? *value : 0.0, items[i]))
+				        {
+					        error = "Cannot store NaN in an integer array";
+					        return;
+				        }
+			        }
+		        });
+
+		        if (!validType)
+		        {
+			        error = "Invalid array type";
+		        }
+		        return std::make_tuple(error.empty(), error);
+	        }));
 }
 
 }
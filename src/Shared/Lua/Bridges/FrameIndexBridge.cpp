@@ -0,0 +1,111 @@
+#include <Shared/Lua/Bridges/FrameIndexBridge.hpp>
+#include <Shared/Lua/LuaUtils.hpp>
+#include <Sol2/sol.hpp>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace lua
+{
+
+FrameIndexBridge::FrameIndexBridge()
+{
+}
+
+FrameIndexBridge::~FrameIndexBridge()
+{
+}
+
+wosc::FrameIndex * FrameIndexBridge::getIndex(int indexID) const
+{
+	auto it = indices.find(indexID);
+	return it == indices.end() ? nullptr : it->second.get();
+}
+
+void FrameIndexBridge::onLoad(BridgeLoader & loader)
+{
+	using ChangeType = wosc::FrameIndex::Change::Type;
+
+	// Indices of a previous Lua state are no longer referenced
+	indices.clear();
+
+	loader.bind("frameindex.create", //
+	    std::function<std::tuple<sol::object, std::string>(std::string, std::string, double, sol::this_state)>(
+	        [=](std::string directory, std::string suffix, double settleDelay,
+	            sol::this_state state) -> std::tuple<sol::object, std::string>
+	        {
+		        auto index = std::make_unique<wosc::FrameIndex>(directory, suffix, sf::seconds(settleDelay));
+		        if (!index->isValid())
+		        {
+			        return std::make_tuple(sol::make_object(state, sol::lua_nil),
+			                               "Failed to observe directory '" + directory + "'");
+		        }
+
+		        int indexID = nextIndexID++;
+		        indices[indexID] = std::move(index);
+		        return std::make_tuple(sol::make_object(state, indexID), std::string());
+	        }));
+
+	loader.bind("frameindex.list", //
+	    std::function<std::tuple<sol::object, std::string>(std::string, std::string, sol::this_state)>(
+	        [=](std::string directory, std::string suffix,
+	            sol::this_state state) -> std::tuple<sol::object, std::string>
+	        {
+		        std::vector<std::string> paths;
+		        if (!wosc::FrameIndex::listFrames(directory, suffix, paths))
+		        {
+			        return std::make_tuple(sol::make_object(state, sol::lua_nil),
+			                               "Failed to list directory '" + directory + "'");
+		        }
+
+		        sol::state_view lua(state);
+		        return std::make_tuple(sol::make_object(state, listToTable(paths, lua)), std::string());
+	        }));
+
+	loader.bind("frameindex.destroy", std::function<void(int)>([=](int indexID) {
+		            indices.erase(indexID);
+	            }));
+
+	loader.bind("frameindex.getPaths", //
+	    std::function<sol::object(int, sol::this_state)>([=](int indexID, sol::this_state state) -> sol::object {
+		    auto index = getIndex(indexID);
+		    if (!index)
+		    {
+			    return sol::make_object(state, sol::lua_nil);
+		    }
+
+		    sol::state_view lua(state);
+		    auto paths = lua.create_table(int(index->getFrameCount()), 0);
+		    for (auto & path : index->getFramePaths())
+		    {
+			    paths.add(path);
+		    }
+		    return sol::make_object(state, paths);
+	    }));
+
+	loader.bind("frameindex.poll", //
+	    std::function<sol::object(int, sol::this_state)>([=](int indexID, sol::this_state state) -> sol::object {
+		    auto index = getIndex(indexID);
+		    if (!index)
+		    {
+			    return sol::make_object(state, sol::lua_nil);
+		    }
+
+		    sol::state_view lua(state);
+		    auto changes = lua.create_table();
+		    for (const auto & change : index->poll())
+		    {
+			    const char * type = change.type == ChangeType::Added
+			                            ? "added"
+			                            : change.type == ChangeType::Removed ? "removed" : "modified";
+			    changes.add(lua.create_table_with( //
+			        "type", type,                  //
+			        "path", change.path,           //
+			        "index", change.index));
+		    }
+		    return sol::make_object(state, changes);
+	    }));
+}
+
+}
@@ -0,0 +1,31 @@
+#ifndef SRC_SHARED_LUA_BRIDGES_FRAMEINDEXBRIDGE_HPP_
+#define SRC_SHARED_LUA_BRIDGES_FRAMEINDEXBRIDGE_HPP_
+
+#include <Shared/Lua/Bindings/Accel/FrameIndex.hpp>
+#include <Shared/Lua/Bridges/AbstractBridge.hpp>
+#include <Shared/Lua/Bridges/BridgeLoader.hpp>
+#include <Shared/Utils/HashTable.hpp>
+#include <memory>
+
+namespace lua
+{
+
+class FrameIndexBridge : public AbstractBridge
+{
+public:
+	FrameIndexBridge();
+	virtual ~FrameIndexBridge();
+
+protected:
+	virtual void onLoad(BridgeLoader & loader) override;
+
+private:
+	wosc::FrameIndex * getIndex(int indexID) const;
+
+	HashMap<int, std::unique_ptr<wosc::FrameIndex>> indices;
+	int nextIndexID = 0;
+};
+
+}
+
+#endif
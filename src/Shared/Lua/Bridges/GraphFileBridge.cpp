@@ -0,0 +1,113 @@
+#include <Shared/Lua/Bindings/Accel/GraphFile.hpp>
+#include <Shared/Lua/Bridges/GraphFileBridge.hpp>
+#include <Shared/Lua/LuaUtils.hpp>
+#include <Sol2/sol.hpp>
+#include <functional>
+#include <string>
+#include <tuple>
+
+namespace lua
+{
+
+GraphFileBridge::GraphFileBridge(wosc::ArrayContext & arrayContext) :
+	arrayContext(arrayContext)
+{
+}
+
+GraphFileBridge::~GraphFileBridge()
+{
+}
+
+void GraphFileBridge::onLoad(BridgeLoader & loader)
+{
+	using MetadataType = wosc::GraphFile::MetadataValue::Type;
+
+	loader.bind("graphfile.load", //
+	    std::function<std::tuple<sol::object, std::string>(std::string, sol::this_state)>(
+	        [=](std::string fileName, sol::this_state state) -> std::tuple<sol::object, std::string>
+	        {
+		        wosc::GraphFile file;
+		        if (!file.load(fileName, arrayContext))
+		        {
+			        return std::make_tuple(sol::make_object(state, sol::lua_nil), file.getError());
+		        }
+
+		        sol::state_view lua(state);
+		        auto columns = lua.create_table();
+		        for (const auto & column : file.getColumns())
+		        {
+			        columns[column.name] = lua.create_table_with( //
+			            "id", column.arrayID,                      //
+			            "type", static_cast<int>(column.type));
+		        }
+
+		        auto metadata = lua.create_table();
+		        for (const auto & entry : file.getMetadata())
+		        {
+			        switch (entry.value.type)
+			        {
+			        case MetadataType::Number:
+				        metadata[entry.key] = entry.value.number;
+				        break;
+			        case MetadataType::String:
+				        metadata[entry.key] = entry.value.string;
+				        break;
+			        case MetadataType::Boolean:
+				        metadata[entry.key] = entry.value.boolean;
+				        break;
+			        }
+		        }
+
+		        auto result = lua.create_table_with("columns", columns, "metadata", metadata);
+		        return std::make_tuple(sol::make_object(state, result), std::string());
+	        }));
+
+	loader.bind("graphfile.save", //
+	    std::function<std::tuple<bool, std::string>(std::string, sol::table, sol::table)>(
+	        [=](std::string fileName, sol::table columns, sol::table metadata) -> std::tuple<bool, std::string>
+	        {
+		        wosc::GraphFile file;
+
+		        for (std::size_t i = 1; i <= columns.size(); ++i)
+		        {
+			        sol::table column = columns[i];
+			        file.addColumn(getOr<std::string>(column["name"], ""),
+			                       static_cast<wosc::GraphFile::ColumnType>(getOr<int>(column["type"], 0)),
+			                       getOr<wosc::ArrayContext::ArrayID>(column["id"], 0));
+		        }
+
+		        for (const auto & entry : metadata)
+		        {
+			        if (entry.first.get_type() != sol::type::string)
+			        {
+				        continue;
+			        }
+
+			        wosc::GraphFile::MetadataValue value;
+			        switch (entry.second.get_type())
+			        {
+			        case sol::type::number:
+				        value.type = MetadataType::Number;
+				        value.number = entry.second.as<double>();
+				        break;
+			        case sol::type::string:
+				        value.type = MetadataType::String;
+				        value.string = entry.second.as<std::string>();
+				        break;
+			        case sol::type::boolean:
+				        value.type = MetadataType::Boolean;
+				        value.boolean = entry.second.as<bool>();
+				        break;
+			        default:
+				        continue;
+			        }
+
+			        file.addMetadata(entry.first.as<std::string>(), value);
+		        }
+
+		        bool success = file.save(fileName, arrayContext);
+		        return std::make_tuple(success, file.getError());
+	        }));
+}
+
+}
@@ -0,0 +1,30 @@
+#ifndef SRC_SHARED_LUA_BRIDGES_GRAPHFILEBRIDGE_HPP_
+#define SRC_SHARED_LUA_BRIDGES_GRAPHFILEBRIDGE_HPP_
+
+#include <Shared/Lua/Bridges/AbstractBridge.hpp>
+#include <Shared/Lua/Bridges/BridgeLoader.hpp>
+
+namespace wosc
+{
+class ArrayContext;
+}
+
+namespace lua
+{
+
+class GraphFileBridge : public AbstractBridge
+{
+public:
+	GraphFileBridge(wosc::ArrayContext & arrayContext);
+	virtual ~GraphFileBridge();
+
+protected:
+	virtual void onLoad(BridgeLoader & loader) override;
+
+private:
+	wosc::ArrayContext & arrayContext;
+};
+
+}
+
+#endif
@@ -0,0 +1,105 @@
+#include <Shared/Lua/Bindings/Accel/GraphLOD.hpp>
+#include <Shared/Lua/Bindings/ArrayBinding.hpp>
+#include <Shared/Lua/Bridges/LODBridge.hpp>
+#include <Sol2/sol.hpp>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace lua
+{
+
+LODBridge::LODBridge(wosc::ArrayContext & arrayContext) :
+	arrayContext(arrayContext)
+{
+}
+
+LODBridge::~LODBridge()
+{
+}
+
+void LODBridge::onLoad(BridgeLoader & loader)
+{
+	using ArrayID = wosc::ArrayContext::ArrayID;
+
+	// Resolves an array holding at least 'count' values of the specified type
+	auto getValues = [=](ArrayID arrayID, std::size_t count, std::size_t valueSize) -> const void * {
+		auto info = arrayContext.getArrayInfo(arrayID);
+		return info.data && info.size / valueSize >= count ? info.data : nullptr;
+	};
+
+	// Copies the values into a new native array, which is owned by the script once acquired via getArrayByID
+	auto newArray = [=](const void * data, std::size_t size) -> ArrayID {
+		ArrayID arrayID = arrayContext.newArray(size);
+		if (size > 0)
+		{
+			std::memcpy(arrayContext.getArrayInfo(arrayID).data, data, size);
+		}
+		return arrayID;
+	};
+
+	loader.bind("lod.build", //
+	    std::function<std::tuple<sol::object, std::string>(ArrayID, ArrayID, int, ArrayID, ArrayID, int, double, int,
+	                                                       sol::this_state)>(
+	        [=](ArrayID circleArrayID, ArrayID colorArrayID, int nodeCount, ArrayID linkArrayID,
+	            ArrayID linkWeightArrayID, int linkCount, double baseCellSize, int levelCount,
+	            sol::this_state state) -> std::tuple<sol::object, std::string>
+	        {
+		        auto fail = [state](std::string error) {
+			        return std::make_tuple(sol::make_object(state, sol::lua_nil), std::move(error));
+		        };
+
+		        if (nodeCount < 0 || linkCount < 0 || levelCount < 1 || !(baseCellSize > 0))
+		        {
+			        return fail("Invalid level-of-detail parameters");
+		        }
+
+		        wosc::GraphLOD::Input input;
+		        input.nodeCount = nodeCount;
+		        input.linkCount = linkCount;
+		        input.circles = static_cast<const double *>(getValues(circleArrayID, nodeCount * 3, sizeof(double)));
+		        input.colors = static_cast<const double *>(getValues(colorArrayID, nodeCount, sizeof(double)));
+		        input.links =
+		            static_cast<const std::int32_t *>(getValues(linkArrayID, linkCount * 2, sizeof(std::int32_t)));
+
+		        if (!input.circles || !input.colors || !input.links)
+		        {
+			        return fail("Node or link range exceeds array bounds");
+		        }
+
+		        // Link weights are optional
+		        if (linkWeightArrayID >= 0)
+		        {
+			        input.linkWeights =
+			            static_cast<const double *>(getValues(linkWeightArrayID, linkCount, sizeof(double)));
+			        if (!input.linkWeights)
+			        {
+				        return fail("Link range exceeds weight array bounds");
+			        }
+		        }
+
+		        wosc::GraphLOD lod;
+		        lod.build(input, baseCellSize, levelCount);
+
+		        sol::state_view lua(state);
+		        auto levels = lua.create_table();
+		        for (const auto & level : lod.getLevels())
+		        {
+			        levels.add(lua.create_table_with( //
+			            "cellSize", level.cellSize,    //
+			            "clusterCount", level.getClusterCount(),
+			            "linkCount", level.getLinkCount(),
+			            "clusters", newArray(level.clusters.data(), level.clusters.size() * sizeof(double)),
+			            "links", newArray(level.links.data(), level.links.size() * sizeof(double)),
+			            "nodeClusters",
+			            newArray(level.nodeClusters.data(), level.nodeClusters.size() * sizeof(std::int32_t))));
+		        }
+
+		        return std::make_tuple(sol::make_object(state, levels), std::string());
+	        }));
+}
+
+}
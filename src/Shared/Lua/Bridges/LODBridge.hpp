@@ -0,0 +1,30 @@
+#ifndef SRC_SHARED_LUA_BRIDGES_LODBRIDGE_HPP_
+#define SRC_SHARED_LUA_BRIDGES_LODBRIDGE_HPP_
+
+#include <Shared/Lua/Bridges/AbstractBridge.hpp>
+#include <Shared/Lua/Bridges/BridgeLoader.hpp>
+
+namespace wosc
+{
+class ArrayContext;
+}
+
+namespace lua
+{
+
+class LODBridge : public AbstractBridge
+{
+public:
+	LODBridge(wosc::ArrayContext & arrayContext);
+	virtual ~LODBridge();
+
+protected:
+	virtual void onLoad(BridgeLoader & loader) override;
+
+private:
+	wosc::ArrayContext & arrayContext;
+};
+
+}
+
+#endif
@@ -0,0 +1,128 @@
+#include <Shared/Game/PerformanceCounter.hpp>
+#include <Shared/Lua/Bindings/Accel/LayoutWorker.hpp>
+#include <Shared/Lua/Bridges/LayoutBridge.hpp>
+#include <Shared/Lua/LuaUtils.hpp>
+#include <Sol2/sol.hpp>
+#include <algorithm>
+#include <functional>
+
+namespace lua
+{
+
+static wosC_accel_layout_graph_t getGraph(const sol::table & table)
+{
+	wosC_accel_layout_graph_t graph;
+	graph.arrayContext = getOr<wosC_array_context_t>(table["arrayContext"], -1);
+	graph.positionArrayID = getOr<wosC_array_id_t>(table["positionArrayID"], 0);
+	graph.forceArrayID = getOr<wosC_array_id_t>(table["forceArrayID"], 0);
+	graph.massArrayID = getOr<wosC_array_id_t>(table["massArrayID"], 0);
+	graph.radiusArrayID = getOr<wosC_array_id_t>(table["radiusArrayID"], 0);
+	graph.fixedArrayID = getOr<wosC_array_id_t>(table["fixedArrayID"], 0);
+	graph.edgeArrayID = getOr<wosC_array_id_t>(table["edgeArrayID"], 0);
+	graph.nodeCount = getOr<wosC_accel_layout_index_t>(table["nodeCount"], 0);
+	graph.edgeCount = getOr<wosC_accel_layout_index_t>(table["edgeCount"], 0);
+	return graph;
+}
+
+static wosC_accel_layout_fa2Params_t getParams(const sol::table & table)
+{
+	wosC_accel_layout_fa2Params_t params;
+	params.scalingRatio = getOr<double>(table["scalingRatio"], 0);
+	params.gravity = getOr<double>(table["gravity"], 0);
+	params.jitterTolerance = getOr<double>(table["jitterTolerance"], 0);
+	params.outboundCompensation = getOr<double>(table["outboundCompensation"], 0);
+	params.maxDisplacement = getOr<double>(table["maxDisplacement"], 0);
+	params.gravityLine1 = getOr<double>(table["gravityLine1"], 0);
+	params.gravityLine2 = getOr<double>(table["gravityLine2"], 0);
+	params.barnesHutTheta = getOr<double>(table["barnesHutTheta"], 0);
+	params.speed = getOr<double>(table["speed"], 1);
+	params.speedEfficiency = getOr<double>(table["speedEfficiency"], 1);
+	params.resetSpeed = getOr<bool>(table["resetSpeed"], false);
+	params.totalSwinging = 0;
+	params.totalEffectiveTraction = 0;
+	return params;
+}
+
+static wosc::LayoutWorker::StopCondition getStopCondition(const sol::table & table)
+{
+	wosc::LayoutWorker::StopCondition stopCondition;
+	stopCondition.maxIterations = std::max(getOr<int>(table["maxIterations"], 0), 0);
+	stopCondition.minSwinging = getOr<double>(table["minSwinging"], 0);
+	return stopCondition;
+}
+
+LayoutBridge::LayoutBridge(ThreadPool & threadPool, wos::PerformanceCounter & performance) :
+	threadPool(threadPool),
+	performance(performance)
+{
+}
+
+LayoutBridge::~LayoutBridge()
+{
+}
+
+wosc::LayoutWorker * LayoutBridge::getWorker(int workerID) const
+{
+	auto it = workers.find(workerID);
+	return it == workers.end() ? nullptr : it->second.get();
+}
+
+void LayoutBridge::onLoad(BridgeLoader & loader)
+{
+	// Workers of a previous Lua state refer to arrays that no longer exist
+	workers.clear();
+
+	loader.bind("layout.startWorker", std::function<int(sol::table, sol::table)>([=](sol::table graph, sol::table params) {
+		            auto worker = std::make_unique<wosc::LayoutWorker>(threadPool);
+		            if (!worker->start(getGraph(graph), getParams(params), getStopCondition(params)))
+		            {
+			            return -1;
+		            }
+		            int workerID = nextWorkerID++;
+		            workers[workerID] = std::move(worker);
+		            return workerID;
+	            }));
+
+	loader.bind("layout.stopWorker", std::function<void(int)>([=](int workerID) {
+		            workers.erase(workerID);
+	            }));
+
+	loader.bind("layout.isWorkerRunning", std::function<bool(int)>([=](int workerID) {
+		            auto worker = getWorker(workerID);
+		            return worker && worker->isRunning();
+	            }));
+
+	loader.bind("layout.isWorkerConverged", std::function<bool(int)>([=](int workerID) {
+		            auto worker = getWorker(workerID);
+		            return worker && worker->isConverged();
+	            }));
+
+	loader.bind("layout.updateWorkerRadii", std::function<bool(int, sol::table)>([=](int workerID, sol::table graph) {
+		            auto worker = getWorker(workerID);
+		            return worker && worker->updateRadii(getGraph(graph));
+	            }));
+
+	loader.bind("layout.swapWorkerPositions",
+	            std::function<bool(int, sol::table)>([=](int workerID, sol::table graph) {
+		            auto worker = getWorker(workerID);
+		            if (!worker || !worker->swapPositions(getGraph(graph)))
+		            {
+			            return false;
+		            }
+		            performance.setLayoutIterationRate(worker->getIterationRate());
+		            performance.setLayoutSwinging(worker->getTotalSwinging());
+		            return true;
+	            }));
+
+	loader.bind("layout.getWorkerIterationRate", std::function<double(int)>([=](int workerID) {
+		            auto worker = getWorker(workerID);
+		            return worker ? worker->getIterationRate() : 0.0;
+	            }));
+
+	loader.bind("layout.getWorkerSwinging", std::function<double(int)>([=](int workerID) {
+		            auto worker = getWorker(workerID);
+		            return worker ? worker->getTotalSwinging() : 0.0;
+	            }));
+}
+
+}
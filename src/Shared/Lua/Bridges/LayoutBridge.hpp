@@ -0,0 +1,45 @@
+#ifndef SRC_SHARED_LUA_BRIDGES_LAYOUTBRIDGE_HPP_
+#define SRC_SHARED_LUA_BRIDGES_LAYOUTBRIDGE_HPP_
+
+#include <Shared/Lua/Bridges/AbstractBridge.hpp>
+#include <Shared/Lua/Bridges/BridgeLoader.hpp>
+#include <Shared/Utils/HashTable.hpp>
+#include <memory>
+
+namespace wos
+{
+class PerformanceCounter;
+}
+
+namespace wosc
+{
+class LayoutWorker;
+}
+
+class ThreadPool;
+
+namespace lua
+{
+
+class LayoutBridge : public AbstractBridge
+{
+public:
+	LayoutBridge(ThreadPool & threadPool, wos::PerformanceCounter & performance);
+	virtual ~LayoutBridge();
+
+protected:
+	virtual void onLoad(BridgeLoader & loader) override;
+
+private:
+	wosc::LayoutWorker * getWorker(int workerID) const;
+
+	ThreadPool & threadPool;
+	wos::PerformanceCounter & performance;
+
+	HashMap<int, std::unique_ptr<wosc::LayoutWorker>> workers;
+	int nextWorkerID = 0;
+};
+
+}
+
+#endif
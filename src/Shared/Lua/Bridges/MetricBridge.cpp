@@ -0,0 +1,104 @@
+#include <Shared/Lua/Bindings/Accel/MetricReduction.hpp>
+#include <Shared/Lua/Bindings/ArrayBinding.hpp>
+#include <Shared/Lua/Bridges/MetricBridge.hpp>
+#include <Sol2/sol.hpp>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <tuple>
+
+namespace lua
+{
+
+MetricBridge::MetricBridge(ThreadPool & threadPool, wosc::ArrayContext & arrayContext) :
+	threadPool(threadPool),
+	arrayContext(arrayContext)
+{
+}
+
+MetricBridge::~MetricBridge()
+{
+}
+
+void MetricBridge::onLoad(BridgeLoader & loader)
+{
+	using ArrayID = wosc::ArrayContext::ArrayID;
+
+	loader.bind("metric.reduce", //
+	    std::function<std::tuple<sol::object, std::string>(int, ArrayID, ArrayID, ArrayID, ArrayID, int,
+	                                                       sol::this_state)>(
+	        [=](int operation, ArrayID timeArrayID, ArrayID valueArrayID, ArrayID resultArrayID,
+	            ArrayID countArrayID, int timeOffset, sol::this_state state) -> std::tuple<sol::object, std::string>
+	        {
+		        auto fail = [&](std::string message) {
+			        return std::make_tuple(sol::make_object(state, sol::lua_nil), std::move(message));
+		        };
+
+		        if (!wosc::MetricReduction::isValidOperation(operation))
+		        {
+			        return fail("Invalid reduction operation");
+		        }
+		        auto op = static_cast<wosc::MetricReduction::Operation>(operation);
+
+		        // Row and bucket counts are derived from the array sizes; the value and count arrays are optional
+		        auto timeInfo = arrayContext.getArrayInfo(timeArrayID);
+		        auto valueInfo = arrayContext.getArrayInfo(valueArrayID);
+		        auto resultInfo = arrayContext.getArrayInfo(resultArrayID);
+		        auto countInfo = arrayContext.getArrayInfo(countArrayID);
+
+		        if (!timeInfo.data || !resultInfo.data)
+		        {
+			        return fail("Invalid time or result array");
+		        }
+		        if (!arrayContext.isArrayWritable(resultArrayID) ||
+		            (countInfo.data && !arrayContext.isArrayWritable(countArrayID)))
+		        {
+			        return fail("Result and count arrays must be writable");
+		        }
+
+		        wosc::MetricReduction::Input input;
+		        input.times = reinterpret_cast<const std::int32_t *>(timeInfo.data);
+		        input.rowCount = timeInfo.size / sizeof(std::int32_t);
+		        input.timeOffset = timeOffset;
+
+		        if (valueInfo.data)
+		        {
+			        if (valueInfo.size != input.rowCount * sizeof(double))
+			        {
+				        return fail("Value array size does not match time array size");
+			        }
+			        input.values = reinterpret_cast<const double *>(valueInfo.data);
+		        }
+		        else if (op != wosc::MetricReduction::Operation::Count)
+		        {
+			        return fail("Value array is required for this operation");
+		        }
+
+		        wosc::MetricReduction::Output output;
+		        output.buckets = reinterpret_cast<double *>(resultInfo.data);
+		        output.bucketCount = resultInfo.size / sizeof(double);
+
+		        if (countInfo.data)
+		        {
+			        if (countInfo.size != output.bucketCount * sizeof(std::int32_t))
+			        {
+				        return fail("Count array size does not match result array size");
+			        }
+			        output.rowCounts = reinterpret_cast<std::int32_t *>(countInfo.data);
+		        }
+
+		        auto result = wosc::MetricReduction::reduce(op, input, output, &threadPool);
+
+		        sol::state_view lua(state);
+		        auto table = lua.create_table_with(              //
+		            "min", result.min,                           //
+		            "max", result.max,                           //
+		            "valueMin", result.valueMin,                 //
+		            "valueMax", result.valueMax,                 //
+		            "populatedBuckets", result.populatedBuckets, //
+		            "skippedRows", result.skippedRows);
+		        return std::make_tuple(sol::make_object(state, table), std::string());
+	        }));
+}
+
+}
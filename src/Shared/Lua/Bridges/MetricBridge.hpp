@@ -0,0 +1,33 @@
+#ifndef SRC_SHARED_LUA_BRIDGES_METRICBRIDGE_HPP_
+#define SRC_SHARED_LUA_BRIDGES_METRICBRIDGE_HPP_
+
+#include <Shared/Lua/Bridges/AbstractBridge.hpp>
+#include <Shared/Lua/Bridges/BridgeLoader.hpp>
+
+namespace wosc
+{
+class ArrayContext;
+}
+
+class ThreadPool;
+
+namespace lua
+{
+
+class MetricBridge : public AbstractBridge
+{
+public:
+	MetricBridge(ThreadPool & threadPool, wosc::ArrayContext & arrayContext);
+	virtual ~MetricBridge();
+
+protected:
+	virtual void onLoad(BridgeLoader & loader) override;
+
+private:
+	ThreadPool & threadPool;
+	wosc::ArrayContext & arrayContext;
+};
+
+}
+
+#endif
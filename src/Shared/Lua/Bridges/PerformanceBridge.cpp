@@ -1,6 +1,9 @@
 #include <Shared/Game/PerformanceCounter.hpp>
 #include <Shared/Lua/Bridges/PerformanceBridge.hpp>
+#include <Sol2/sol.hpp>
+#include <algorithm>
 #include <functional>
+#include <string>
 
 namespace lua
 {
@@ -40,12 +43,32 @@ void PerformanceBridge::onLoad(BridgeLoader & loader)
 		            return performance.getTotalFrameTime().asMicroseconds() / 1000000.0;
 	            }));
 
+	loader.bind("perf.getLayoutIterationRate", std::function<double()>([=]() {
+		            return performance.getLayoutIterationRate();
+	            }));
+
+	loader.bind("perf.getLayoutSwinging", std::function<double()>([=]() {
+		            return performance.getLayoutSwinging();
+	            }));
+
 	loader.bind("perf.getMemoryUsage",
 	            std::function<sol::optional<double>(std::string)>([=](std::string source) -> sol::optional<double> {
-		            // TODO allow getting more detailed memory usage statistics
 		            auto result = performance.getMemoryUsage(source, 0);
 		            return result.empty() ? sol::nullopt : sol::optional<double>(result[0].memoryUsage);
 	            }));
+
+	loader.bind("perf.getMemoryUsageEntries", //
+	    std::function<sol::table(std::string, int, sol::this_state)>(
+	        [=](std::string source, int entryCount, sol::this_state state) -> sol::table
+	        {
+		        sol::state_view lua(state);
+		        auto entries = lua.create_table();
+		        for (const auto & entry : performance.getMemoryUsage(source, std::max(entryCount, 0)))
+		        {
+			        entries.add(lua.create_table_with("name", entry.name, "memoryUsage", double(entry.memoryUsage)));
+		        }
+		        return entries;
+	        }));
 }
 
 }
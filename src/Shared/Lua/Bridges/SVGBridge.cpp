@@ -0,0 +1,96 @@
+#include <Shared/Lua/Bindings/Accel/SVGWriter.hpp>
+#include <Shared/Lua/Bindings/ArrayBinding.hpp>
+#include <Shared/Lua/Bridges/SVGBridge.hpp>
+#include <Sol2/sol.hpp>
+#include <functional>
+#include <string>
+#include <tuple>
+
+namespace lua
+{
+
+SVGBridge::SVGBridge(wosc::ArrayContext & arrayContext) :
+	arrayContext(arrayContext)
+{
+}
+
+SVGBridge::~SVGBridge()
+{
+}
+
+wosc::SVGWriter * SVGBridge::getWriter(int writerID) const
+{
+	auto it = writers.find(writerID);
+	return it == writers.end() ? nullptr : it->second.get();
+}
+
+void SVGBridge::onLoad(BridgeLoader & loader)
+{
+	// Finish documents left open by a previous Lua state
+	writers.clear();
+
+	loader.bind("svg.open", //
+	    std::function<std::tuple<int, std::string>(std::string, double, double, bool, int)>(
+	        [=](std::string fileName, double width, double height, bool compress,
+	            int precision) -> std::tuple<int, std::string>
+	        {
+		        auto writer = std::make_unique<wosc::SVGWriter>();
+		        if (!writer->open(fileName, width, height, compress, precision))
+		        {
+			        return std::make_tuple(-1, writer->getError());
+		        }
+		        int writerID = nextWriterID++;
+		        writers[writerID] = std::move(writer);
+		        return std::make_tuple(writerID, std::string());
+	        }));
+
+	loader.bind("svg.write", //
+	    std::function<std::tuple<bool, std::string>(int, int, wosc::ArrayContext::ArrayID, int, int)>(
+	        [=](int writerID, int elementType, wosc::ArrayContext::ArrayID arrayID, int offset,
+	            int count) -> std::tuple<bool, std::string>
+	        {
+		        auto writer = getWriter(writerID);
+		        if (!writer)
+		        {
+			        return std::make_tuple(false, std::string("Invalid SVG writer"));
+		        }
+
+		        auto type = static_cast<wosc::SVGWriter::ElementType>(elementType);
+		        std::size_t stride = wosc::SVGWriter::getStride(type);
+		        if (stride == 0)
+		        {
+			        return std::make_tuple(false, std::string("Invalid element type"));
+		        }
+
+		        // Offset and count are specified in elements, and must lie within the array
+		        auto info = arrayContext.getArrayInfo(arrayID);
+		        std::size_t valueCount = info.data ? info.size / sizeof(double) : 0;
+		        if (offset < 0 || count < 0 || (std::size_t(offset) + count) * stride > valueCount)
+		        {
+			        return std::make_tuple(false, std::string("Element range exceeds array bounds"));
+		        }
+
+		        const double * values = reinterpret_cast<const double *>(info.data) + offset * stride;
+		        bool success = writer->write(type, values, count);
+		        return std::make_tuple(success, writer->getError());
+	        }));
+
+	loader.bind("svg.close", //
+	    std::function<std::tuple<bool, std::string, int>(int)>(
+	        [=](int writerID) -> std::tuple<bool, std::string, int>
+	        {
+		        auto it = writers.find(writerID);
+		        if (it == writers.end())
+		        {
+			        return std::make_tuple(false, std::string("Invalid SVG writer"), 0);
+		        }
+
+		        auto writer = std::move(it->second);
+		        writers.erase(it);
+
+		        bool success = writer->close();
+		        return std::make_tuple(success, writer->getError(), int(writer->getElementCount()));
+	        }));
+}
+
+}
@@ -0,0 +1,38 @@
+#ifndef SRC_SHARED_LUA_BRIDGES_SVGBRIDGE_HPP_
+#define SRC_SHARED_LUA_BRIDGES_SVGBRIDGE_HPP_
+
+#include <Shared/Lua/Bridges/AbstractBridge.hpp>
+#include <Shared/Lua/Bridges/BridgeLoader.hpp>
+#include <Shared/Utils/HashTable.hpp>
+#include <memory>
+
+namespace wosc
+{
+class ArrayContext;
+class SVGWriter;
+}
+
+namespace lua
+{
+
+class SVGBridge : public AbstractBridge
+{
+public:
+	SVGBridge(wosc::ArrayContext & arrayContext);
+	virtual ~SVGBridge();
+
+protected:
+	virtual void onLoad(BridgeLoader & loader) override;
+
+private:
+	wosc::SVGWriter * getWriter(int writerID) const;
+
+	wosc::ArrayContext & arrayContext;
+
+	HashMap<int, std::unique_ptr<wosc::SVGWriter>> writers;
+	int nextWriterID = 0;
+};
+
+}
+
+#endif
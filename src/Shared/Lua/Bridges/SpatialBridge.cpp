@@ -0,0 +1,161 @@
+#include <Shared/Lua/Bindings/ArrayBinding.hpp>
+#include <Shared/Lua/Bridges/SpatialBridge.hpp>
+#include <Sol2/sol.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <tuple>
+
+namespace lua
+{
+
+SpatialBridge::SpatialBridge(wosc::ArrayContext & arrayContext) :
+	arrayContext(arrayContext)
+{
+}
+
+SpatialBridge::~SpatialBridge()
+{
+}
+
+wosc::SpatialIndex * SpatialBridge::getIndex(int indexID) const
+{
+	auto it = indices.find(indexID);
+	return it == indices.end() ? nullptr : it->second.get();
+}
+
+void SpatialBridge::onLoad(BridgeLoader & loader)
+{
+	using ArrayID = wosc::ArrayContext::ArrayID;
+	using ElementID = wosc::SpatialIndex::ElementID;
+
+	// Indices of a previous Lua state are no longer referenced
+	indices.clear();
+
+	// Resolves 'count' elements of 'stride' doubles each, starting at element 'offset' of the array
+	auto getElementValues = [=](ArrayID arrayID, int offset, int count, std::size_t stride) -> const double * {
+		auto info = arrayContext.getArrayInfo(arrayID);
+		std::size_t valueCount = info.data ? info.size / sizeof(double) : 0;
+		if (offset < 0 || count < 0 || (std::size_t(offset) + count) * stride > valueCount)
+		{
+			return nullptr;
+		}
+		return reinterpret_cast<const double *>(info.data) + offset * stride;
+	};
+
+	loader.bind("spatial.create", std::function<int(double)>([=](double cellSize) -> int {
+		            int indexID = nextIndexID++;
+		            indices[indexID] = std::make_unique<wosc::SpatialIndex>(cellSize);
+		            return indexID;
+	            }));
+
+	loader.bind("spatial.destroy", std::function<void(int)>([=](int indexID) {
+		            indices.erase(indexID);
+	            }));
+
+	loader.bind("spatial.setCircles", //
+	    std::function<std::tuple<bool, std::string>(int, ElementID, ArrayID, int, int)>(
+	        [=](int indexID, ElementID firstElementID, ArrayID arrayID, int offset,
+	            int count) -> std::tuple<bool, std::string>
+	        {
+		        auto index = getIndex(indexID);
+		        if (!index)
+		        {
+			        return std::make_tuple(false, std::string("Invalid spatial index"));
+		        }
+
+		        // x, y, radius
+		        const double * values = getElementValues(arrayID, offset, count, 3);
+		        if (!values)
+		        {
+			        return std::make_tuple(false, std::string("Element range exceeds array bounds"));
+		        }
+
+		        for (int i = 0; i < count; ++i, values += 3)
+		        {
+			        index->setCircle(firstElementID + i, values[0], values[1], values[2]);
+		        }
+		        return std::make_tuple(true, std::string());
+	        }));
+
+	loader.bind("spatial.setSegments", //
+	    std::function<std::tuple<bool, std::string>(int, ElementID, ArrayID, int, int)>(
+	        [=](int indexID, ElementID firstElementID, ArrayID arrayID, int offset,
+	            int count) -> std::tuple<bool, std::string>
+	        {
+		        auto index = getIndex(indexID);
+		        if (!index)
+		        {
+			        return std::make_tuple(false, std::string("Invalid spatial index"));
+		        }
+
+		        // x1, y1, x2, y2, half width
+		        const double * values = getElementValues(arrayID, offset, count, 5);
+		        if (!values)
+		        {
+			        return std::make_tuple(false, std::string("Element range exceeds array bounds"));
+		        }
+
+		        for (int i = 0; i < count; ++i, values += 5)
+		        {
+			        index->setSegment(firstElementID + i, values[0], values[1], values[2], values[3], values[4]);
+		        }
+		        return std::make_tuple(true, std::string());
+	        }));
+
+	loader.bind("spatial.remove", std::function<void(int, ElementID)>([=](int indexID, ElementID elementID) {
+		            if (auto index = getIndex(indexID))
+		            {
+			            index->remove(elementID);
+		            }
+	            }));
+
+	loader.bind("spatial.truncate", std::function<void(int, ElementID)>([=](int indexID, ElementID count) {
+		            if (auto index = getIndex(indexID))
+		            {
+			            index->truncate(count);
+		            }
+	            }));
+
+	loader.bind("spatial.getElementCount", std::function<int(int)>([=](int indexID) -> int {
+		            auto index = getIndex(indexID);
+		            return index ? index->getElementCount() : 0;
+	            }));
+
+	loader.bind("spatial.pick", //
+	    std::function<ElementID(int, double, double, double)>(
+	        [=](int indexID, double x, double y, double tolerance) -> ElementID
+	        {
+		        auto index = getIndex(indexID);
+		        return index ? index->pick(x, y, tolerance) : wosc::SpatialIndex::noElement;
+	        }));
+
+	loader.bind("spatial.queryRect", //
+	    std::function<int(int, double, double, double, double, ArrayID)>(
+	        [=](int indexID, double minX, double minY, double maxX, double maxY, ArrayID resultArrayID) -> int
+	        {
+		        auto index = getIndex(indexID);
+		        if (!index)
+		        {
+			        return 0;
+		        }
+
+		        queryResult.clear();
+		        index->queryRect(minX, minY, maxX, maxY, queryResult);
+
+		        // The total count is returned even if the result array is too small (or read-only) to hold all IDs
+		        auto info = arrayContext.getArrayInfo(resultArrayID);
+		        bool writable = info.data && arrayContext.isArrayWritable(resultArrayID);
+		        std::size_t capacity = writable ? info.size / sizeof(ElementID) : 0;
+		        std::size_t written = std::min(capacity, queryResult.size());
+		        if (written > 0)
+		        {
+			        std::memcpy(info.data, queryResult.data(), written * sizeof(ElementID));
+		        }
+		        return queryResult.size();
+	        }));
+}
+
+}
@@ -0,0 +1,41 @@
+#ifndef SRC_SHARED_LUA_BRIDGES_SPATIALBRIDGE_HPP_
+#define SRC_SHARED_LUA_BRIDGES_SPATIALBRIDGE_HPP_
+
+#include <Shared/Lua/Bindings/Accel/SpatialIndex.hpp>
+#include <Shared/Lua/Bridges/AbstractBridge.hpp>
+#include <Shared/Lua/Bridges/BridgeLoader.hpp>
+#include <Shared/Utils/HashTable.hpp>
+#include <memory>
+#include <vector>
+
+namespace wosc
+{
+class ArrayContext;
+}
+
+namespace lua
+{
+
+class SpatialBridge : public AbstractBridge
+{
+public:
+	SpatialBridge(wosc::ArrayContext & arrayContext);
+	virtual ~SpatialBridge();
+
+protected:
+	virtual void onLoad(BridgeLoader & loader) override;
+
+private:
+	wosc::SpatialIndex * getIndex(int indexID) const;
+
+	wosc::ArrayContext & arrayContext;
+
+	HashMap<int, std::unique_ptr<wosc::SpatialIndex>> indices;
+	int nextIndexID = 0;
+
+	std::vector<wosc::SpatialIndex::ElementID> queryResult;
+};
+
+}
+
+#endif
@@ -0,0 +1,33 @@
+#include <Shared/Lua/Bindings/Accel/VisionBinding.hpp>
+#include <Shared/Lua/Bridges/VisionBridge.hpp>
+#include <Sol2/sol.hpp>
+#include <functional>
+#include <tuple>
+
+namespace lua
+{
+
+VisionBridge::VisionBridge(ThreadPool & threadPool) :
+	threadPool(threadPool)
+{
+	wosc::setVisionThreadPool(&threadPool);
+}
+
+VisionBridge::~VisionBridge()
+{
+	wosc::setVisionThreadPool(nullptr);
+}
+
+void VisionBridge::onLoad(BridgeLoader & loader)
+{
+	loader.bind("vision.benchmark", //
+	    std::function<std::tuple<double, double, double, double, double, bool>(int, int, int)>(
+	        [=](int width, int height, int iterations) {
+		        auto result = wosc::benchmarkVision(width, height, iterations, &threadPool);
+		        return std::make_tuple(result.scalarLightMapSeconds, result.vectorLightMapSeconds,
+		                               result.parallelLightMapSeconds, result.scalarRadialSeconds,
+		                               result.tableRadialSeconds, result.identical);
+	        }));
+}
+
+}
@@ -0,0 +1,30 @@
+#ifndef SRC_SHARED_LUA_BRIDGES_VISIONBRIDGE_HPP_
+#define SRC_SHARED_LUA_BRIDGES_VISIONBRIDGE_HPP_
+
+#include <Shared/Lua/Bridges/AbstractBridge.hpp>
+#include <Shared/Lua/Bridges/BridgeLoader.hpp>
+
+class ThreadPool;
+
+namespace lua
+{
+
+/**
+ * Provides the vision accelerator with the game's thread pool for row-parallel map updates.
+ */
+class VisionBridge : public AbstractBridge
+{
+public:
+	VisionBridge(ThreadPool & threadPool);
+	virtual ~VisionBridge();
+
+protected:
+	virtual void onLoad(BridgeLoader & loader) override;
+
+private:
+	ThreadPool & threadPool;
+};
+
+}
+
+#endif
@@ -0,0 +1,158 @@
+#include <Shared/Lua/Bindings/ArrayBinding.hpp>
+#include <Shared/Lua/Bridges/WorkerPoolBridge.hpp>
+#include <Sol2/sol.hpp>
+#include <functional>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace lua
+{
+
+WorkerPoolBridge::WorkerPoolBridge(wosc::ArrayContext & arrayContext) :
+	arrayContext(arrayContext)
+{
+}
+
+WorkerPoolBridge::~WorkerPoolBridge()
+{
+}
+
+wos::ScriptWorkerPool * WorkerPoolBridge::getPool(int poolID) const
+{
+	auto it = pools.find(poolID);
+	return it == pools.end() ? nullptr : it->second.get();
+}
+
+void WorkerPoolBridge::onUnload()
+{
+	// Destroying the pools waits for running jobs to finish, which may still access array memory
+	pools.clear();
+}
+
+void WorkerPoolBridge::onLoad(BridgeLoader & loader)
+{
+	using ArrayID = wosc::ArrayContext::ArrayID;
+	using Job = wos::ScriptWorkerPool::Job;
+	using Region = wos::ScriptWorkerPool::Region;
+
+	// Pools of a previous Lua state are no longer referenced
+	pools.clear();
+
+	// Resolves a byte range of an array, which must be writable if requested
+	auto getRegion = [=](ArrayID arrayID, double offset, double size, bool writable, Region & region) -> bool {
+		auto info = arrayContext.getArrayInfo(arrayID);
+		if (!info.data || offset < 0 || size < 0 || offset + size > double(info.size))
+		{
+			return false;
+		}
+		if (writable && !arrayContext.isArrayWritable(arrayID))
+		{
+			return false;
+		}
+		region.data = info.data + std::size_t(offset);
+		region.size = std::size_t(size);
+		region.writable = writable;
+		return true;
+	};
+
+	loader.bind("workers.create", std::function<int(std::string, int)>([=](std::string source, int workerCount) -> int {
+		            int poolID = nextPoolID++;
+		            pools[poolID] = std::make_unique<wos::ScriptWorkerPool>();
+		            pools[poolID]->start(source, workerCount > 0 ? workerCount : 0);
+		            return poolID;
+	            }));
+
+	loader.bind("workers.destroy", std::function<void(int)>([=](int poolID) {
+		            pools.erase(poolID);
+	            }));
+
+	loader.bind("workers.getWorkerCount", std::function<int(int)>([=](int poolID) -> int {
+		            auto pool = getPool(poolID);
+		            return pool ? int(pool->getWorkerCount()) : 0;
+	            }));
+
+	loader.bind("workers.getPendingJobCount", std::function<int(int)>([=](int poolID) -> int {
+		            auto pool = getPool(poolID);
+		            return pool ? int(pool->getPendingJobCount()) : 0;
+	            }));
+
+	loader.bind("workers.getError", std::function<std::string(int)>([=](int poolID) -> std::string {
+		            auto pool = getPool(poolID);
+		            return pool ? pool->getError() : "Invalid worker pool";
+	            }));
+
+	loader.bind("workers.submit", //
+	    std::function<std::tuple<sol::object, std::string>(int, sol::table, sol::this_state)>(
+	        [=](int poolID, sol::table jobTables, sol::this_state state) -> std::tuple<sol::object, std::string>
+	        {
+		        auto fail = [state](std::string error) {
+			        return std::make_tuple(sol::make_object(state, sol::lua_nil), std::move(error));
+		        };
+
+		        auto pool = getPool(poolID);
+		        if (!pool)
+		        {
+			        return fail("Invalid worker pool");
+		        }
+
+		        // Jobs: {input = string, regions = {{array = id, offset = bytes, size = bytes, writable = bool}, ...}}
+		        std::vector<Job> jobs(jobTables.size());
+		        for (std::size_t i = 0; i < jobs.size(); ++i)
+		        {
+			        auto jobTable = jobTables.raw_get<sol::optional<sol::table>>(i + 1);
+			        if (!jobTable)
+			        {
+				        return fail("Invalid job");
+			        }
+
+			        jobs[i].input = jobTable->get_or("input", std::string());
+
+			        auto regionTables = jobTable->get<sol::optional<sol::table>>("regions");
+			        std::size_t regionCount = regionTables ? regionTables->size() : 0;
+			        jobs[i].regions.resize(regionCount);
+			        for (std::size_t j = 0; j < regionCount; ++j)
+			        {
+				        auto regionTable = regionTables->raw_get<sol::optional<sol::table>>(j + 1);
+				        if (!regionTable
+				            || !getRegion(regionTable->get_or("array", ArrayID(-1)), regionTable->get_or("offset", 0.0),
+				                          regionTable->get_or("size", 0.0), regionTable->get_or("writable", false),
+				                          jobs[i].regions[j]))
+				        {
+					        return fail("Invalid or read-only array region");
+				        }
+			        }
+		        }
+
+		        auto firstJobID = pool->submit(std::move(jobs));
+		        if (firstJobID == 0)
+		        {
+			        return fail("Writable array region overlaps another region in use");
+		        }
+		        return std::make_tuple(sol::make_object(state, firstJobID), std::string());
+	        }));
+
+	loader.bind("workers.poll", //
+	    std::function<sol::object(int, sol::this_state)>([=](int poolID, sol::this_state state) -> sol::object {
+		    auto pool = getPool(poolID);
+		    if (!pool)
+		    {
+			    return sol::make_object(state, sol::lua_nil);
+		    }
+
+		    sol::state_view lua(state);
+		    auto results = lua.create_table();
+		    for (const auto & result : pool->takeResults())
+		    {
+			    results.add(lua.create_table_with(                    //
+			        "job", result.job,                                //
+			        "success", result.success,                        //
+			        "output", result.output,                          //
+			        "waitTime", result.waitTime.asSeconds(),          //
+			        "runTime", result.runTime.asSeconds()));
+		    }
+		    return sol::make_object(state, results);
+	    }));
+}
+
+}
@@ -0,0 +1,39 @@
+#ifndef SRC_SHARED_LUA_BRIDGES_WORKERPOOLBRIDGE_HPP_
+#define SRC_SHARED_LUA_BRIDGES_WORKERPOOLBRIDGE_HPP_
+
+#include <Shared/Game/ScriptWorkerPool.hpp>
+#include <Shared/Lua/Bridges/AbstractBridge.hpp>
+#include <Shared/Lua/Bridges/BridgeLoader.hpp>
+#include <Shared/Utils/HashTable.hpp>
+#include <memory>
+
+namespace wosc
+{
+class ArrayContext;
+}
+
+namespace lua
+{
+
+class WorkerPoolBridge : public AbstractBridge
+{
+public:
+	WorkerPoolBridge(wosc::ArrayContext & arrayContext);
+	virtual ~WorkerPoolBridge();
+
+protected:
+	virtual void onLoad(BridgeLoader & loader) override;
+	virtual void onUnload() override;
+
+private:
+	wos::ScriptWorkerPool * getPool(int poolID) const;
+
+	wosc::ArrayContext & arrayContext;
+
+	HashMap<int, std::unique_ptr<wos::ScriptWorkerPool>> pools;
+	int nextPoolID = 0;
+};
+
+}
+
+#endif
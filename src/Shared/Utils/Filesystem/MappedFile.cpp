@@ -0,0 +1,242 @@
+#include <Shared/Utils/Filesystem/MappedFile.hpp>
+#include <Shared/Utils/OSDetect.hpp>
+
+#ifdef WOS_WINDOWS
+#	include <cppfs/windows/FileNameConversions.h>
+#	include <windows.h>
+#elif defined(WOS_LINUX) || defined(WOS_OSX)
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace fs
+{
+
+MappedFile::MappedFile()
+{
+}
+
+MappedFile::MappedFile(const std::string & filename)
+{
+	open(filename);
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+bool MappedFile::open(const std::string & filename)
+{
+	return open(filename, 0, 0, Mode::ReadOnly);
+}
+
+bool MappedFile::open(const std::string & filename, std::uint64_t offset, std::uint64_t length, Mode mode)
+{
+	close();
+
+	// Returns the length of the region, or 0 if it is empty or exceeds the file
+	auto getRegionLength = [offset, length](std::uint64_t fileSize) -> std::uint64_t {
+		if (offset >= fileSize)
+		{
+			return 0;
+		}
+		if (length == 0)
+		{
+			return fileSize - offset;
+		}
+		return length <= fileSize - offset ? length : 0;
+	};
+
+#ifdef WOS_WINDOWS
+	std::wstring wideFilename = cppfs::convert::utf8ToWideString(filename);
+	HANDLE file = CreateFileW(wideFilename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+	                          FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	std::uint64_t regionLength = 0;
+	if (!GetFileSizeEx(file, &fileSize) || (regionLength = getRegionLength(fileSize.QuadPart)) == 0
+	    || regionLength > SIZE_MAX)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	DWORD protection = mode == Mode::CopyOnWrite ? PAGE_WRITECOPY : PAGE_READONLY;
+	HANDLE mapping = CreateFileMappingW(file, nullptr, protection, 0, 0, nullptr);
+	if (mapping == nullptr)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	// Views must start at a multiple of the allocation granularity
+	SYSTEM_INFO systemInfo;
+	GetSystemInfo(&systemInfo);
+	std::uint64_t mappingOffset = offset - offset % systemInfo.dwAllocationGranularity;
+	std::size_t leadingBytes = offset - mappingOffset;
+
+	DWORD access = mode == Mode::CopyOnWrite ? FILE_MAP_COPY : FILE_MAP_READ;
+	void * view = MapViewOfFile(mapping, access, DWORD(mappingOffset >> 32), DWORD(mappingOffset & 0xFFFFFFFF),
+	                            leadingBytes + regionLength);
+	if (view == nullptr)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	fileHandle = file;
+	mappingHandle = mapping;
+#else
+	int file = ::open(filename.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		return false;
+	}
+
+	struct stat fileInfo;
+	std::uint64_t regionLength = 0;
+	if (fstat(file, &fileInfo) != 0 || fileInfo.st_size <= 0
+	    || (regionLength = getRegionLength(fileInfo.st_size)) == 0 || regionLength > SIZE_MAX)
+	{
+		::close(file);
+		return false;
+	}
+
+	// Mappings must start at a page boundary
+	std::uint64_t pageSize = sysconf(_SC_PAGESIZE);
+	std::uint64_t mappingOffset = offset - offset % pageSize;
+	std::size_t leadingBytes = offset - mappingOffset;
+
+	// Copy-on-write mappings do not reserve swap space, as large regions would otherwise exceed the commit limit
+	int protection = mode == Mode::CopyOnWrite ? PROT_READ | PROT_WRITE : PROT_READ;
+	int flags = mode == Mode::CopyOnWrite ? MAP_PRIVATE | MAP_NORESERVE : MAP_PRIVATE;
+	void * view = mmap(nullptr, leadingBytes + regionLength, protection, flags, file, off_t(mappingOffset));
+
+	// The mapping stays valid after the descriptor is closed
+	::close(file);
+
+	if (view == MAP_FAILED)
+	{
+		return false;
+	}
+#endif
+
+	mappingBase = view;
+	mappingSize = leadingBytes + regionLength;
+	data = static_cast<char *>(view) + leadingBytes;
+	size = regionLength;
+	this->mode = mode;
+	return true;
+}
+
+void MappedFile::close()
+{
+	if (mappingBase == nullptr)
+	{
+		return;
+	}
+
+#ifdef WOS_WINDOWS
+	UnmapViewOfFile(mappingBase);
+	CloseHandle(mappingHandle);
+	CloseHandle(fileHandle);
+	mappingHandle = nullptr;
+	fileHandle = nullptr;
+#else
+	munmap(mappingBase, mappingSize);
+#endif
+
+	mappingBase = nullptr;
+	mappingSize = 0;
+	data = nullptr;
+	size = 0;
+}
+
+bool MappedFile::isOpen() const
+{
+	return data != nullptr;
+}
+
+const char * MappedFile::getData() const
+{
+	return data;
+}
+
+std::size_t MappedFile::getSize() const
+{
+	return size;
+}
+
+char * MappedFile::getMutableData() const
+{
+	return mode == Mode::CopyOnWrite ? data : nullptr;
+}
+
+MappedFile::Mode MappedFile::getMode() const
+{
+	return mode;
+}
+
+bool MappedFile::advise(Access access, std::size_t offset, std::size_t length) const
+{
+	if (data == nullptr || offset > size)
+	{
+		return false;
+	}
+	length = length <= size - offset ? length : size - offset;
+
+#ifdef WOS_WINDOWS
+	// Only prefetching has a Windows equivalent
+#	if _WIN32_WINNT >= 0x0602
+	if (access == Access::WillNeed)
+	{
+		WIN32_MEMORY_RANGE_ENTRY range;
+		range.VirtualAddress = data + offset;
+		range.NumberOfBytes = length;
+		return PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+	}
+#	endif
+	return false;
+#else
+	int advice = MADV_NORMAL;
+	switch (access)
+	{
+	case Access::Normal:
+		advice = MADV_NORMAL;
+		break;
+	case Access::Sequential:
+		advice = MADV_SEQUENTIAL;
+		break;
+	case Access::Random:
+		advice = MADV_RANDOM;
+		break;
+	case Access::WillNeed:
+		advice = MADV_WILLNEED;
+		break;
+	case Access::DontNeed:
+		// Discarding written copy-on-write pages would lose their contents
+		if (mode == Mode::CopyOnWrite)
+		{
+			return false;
+		}
+		advice = MADV_DONTNEED;
+		break;
+	}
+
+	// The range must start at a page boundary
+	std::size_t pageSize = sysconf(_SC_PAGESIZE);
+	char * begin = data + offset;
+	std::size_t misalignment = reinterpret_cast<std::uintptr_t>(begin) % pageSize;
+	return madvise(begin - misalignment, length + misalignment, advice) == 0;
+#endif
+}
+
+}
@@ -0,0 +1,92 @@
+#ifndef SRC_SHARED_UTILS_FILESYSTEM_MAPPEDFILE_HPP_
+#define SRC_SHARED_UTILS_FILESYSTEM_MAPPEDFILE_HPP_
+
+#include <Shared/Utils/OSDetect.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace fs
+{
+
+/**
+ * Memory mapping of a file or a region of it. Pages are loaded lazily by the operating system on first access.
+ */
+class MappedFile
+{
+public:
+	enum class Mode
+	{
+		// Pages must not be written to
+		ReadOnly,
+
+		// Written pages are copied privately; changes never reach the file
+		CopyOnWrite,
+	};
+
+	/**
+	 * Expected access pattern of a range, used to tune read-ahead and page eviction (madvise on POSIX systems).
+	 */
+	enum class Access
+	{
+		Normal,
+		Sequential,
+		Random,
+		WillNeed,
+		DontNeed,
+	};
+
+	MappedFile();
+	MappedFile(const std::string & filename);
+	~MappedFile();
+
+	MappedFile(const MappedFile &) = delete;
+	MappedFile & operator=(const MappedFile &) = delete;
+
+	/**
+	 * Maps the entire file read-only. Fails for empty files.
+	 */
+	bool open(const std::string & filename);
+
+	/**
+	 * Maps 'length' bytes starting at 'offset' (or the rest of the file if 'length' is 0). Fails if the region is
+	 * empty or exceeds the file.
+	 */
+	bool open(const std::string & filename, std::uint64_t offset, std::uint64_t length, Mode mode);
+	void close();
+
+	bool isOpen() const;
+
+	const char * getData() const;
+	std::size_t getSize() const;
+
+	/**
+	 * Returns the writable data of a copy-on-write mapping, or a null pointer for read-only mappings.
+	 */
+	char * getMutableData() const;
+
+	Mode getMode() const;
+
+	/**
+	 * Hints the expected access pattern of a range of the mapped region. Returns false if the hint is not supported.
+	 */
+	bool advise(Access access, std::size_t offset, std::size_t length) const;
+
+private:
+	char * data = nullptr;
+	std::size_t size = 0;
+	Mode mode = Mode::ReadOnly;
+
+	// Mappings start at a page boundary, which may precede the requested region
+	void * mappingBase = nullptr;
+	std::size_t mappingSize = 0;
+
+#ifdef WOS_WINDOWS
+	void * fileHandle = nullptr;
+	void * mappingHandle = nullptr;
+#endif
+};
+
+}
+
+#endif
@@ -0,0 +1,145 @@
+#include <Shared/Utils/Memory/ArenaAllocator.hpp>
+#include <cstring>
+
+// Small size classes range from 64 bytes to 64 KiB in powers of two
+static constexpr std::size_t minBlockShift = 6;
+static constexpr std::size_t maxBlockShift = 16;
+static constexpr std::size_t sizeClassCount = maxBlockShift - minBlockShift + 1;
+
+// Size of the slabs that small blocks are carved out of
+static constexpr std::size_t slabSize = 1 << 20;
+
+constexpr std::size_t ArenaAllocator::alignment;
+
+ArenaAllocator::ArenaAllocator() :
+	sizeClasses(sizeClassCount)
+{
+}
+
+ArenaAllocator::~ArenaAllocator()
+{
+}
+
+ArenaAllocator::Block ArenaAllocator::allocate(std::size_t size, bool zeroInitialize)
+{
+	Block block;
+	block.size = size;
+
+	// Find the smallest class that fits, or fall back to an individual allocation
+	block.sizeClass = 0;
+	while (block.sizeClass < sizeClassCount && getBlockSize(block.sizeClass) < size)
+	{
+		block.sizeClass++;
+	}
+
+	if (block.sizeClass == sizeClassCount)
+	{
+		// Default-initialized bytes are left uninitialized, unlike std::make_unique
+		std::unique_ptr<Byte[]> storage(new Byte[size + alignment - 1]);
+		block.data = alignPointer(storage.get());
+		largeBlocks.emplace(block.data, std::move(storage));
+		largeUsedBytes += size;
+		largeReservedBytes += size + alignment - 1;
+	}
+	else
+	{
+		SizeClass & sizeClass = sizeClasses[block.sizeClass];
+		if (sizeClass.freeBlocks.empty())
+		{
+			addSlab(block.sizeClass);
+		}
+		block.data = sizeClass.freeBlocks.back();
+		sizeClass.freeBlocks.pop_back();
+		sizeClass.blockCount++;
+		sizeClass.usedBytes += size;
+	}
+
+	if (zeroInitialize)
+	{
+		std::memset(block.data, 0, size);
+	}
+
+	return block;
+}
+
+void ArenaAllocator::deallocate(const Block & block)
+{
+	if (block.data == nullptr)
+	{
+		return;
+	}
+
+	if (block.sizeClass == sizeClassCount)
+	{
+		auto it = largeBlocks.find(block.data);
+		if (it != largeBlocks.end())
+		{
+			largeBlocks.erase(it);
+			largeUsedBytes -= block.size;
+			largeReservedBytes -= block.size + alignment - 1;
+		}
+	}
+	else if (block.sizeClass < sizeClassCount)
+	{
+		SizeClass & sizeClass = sizeClasses[block.sizeClass];
+		sizeClass.freeBlocks.push_back(block.data);
+		sizeClass.blockCount--;
+		sizeClass.usedBytes -= block.size;
+	}
+}
+
+void ArenaAllocator::clear()
+{
+	sizeClasses.clear();
+	sizeClasses.resize(sizeClassCount);
+	largeBlocks.clear();
+	largeUsedBytes = 0;
+	largeReservedBytes = 0;
+}
+
+std::vector<ArenaAllocator::SizeClassUsage> ArenaAllocator::getUsage() const
+{
+	std::vector<SizeClassUsage> usage(sizeClassCount + 1);
+	for (std::size_t i = 0; i < sizeClassCount; ++i)
+	{
+		const SizeClass & sizeClass = sizeClasses[i];
+		usage[i].blockSize = getBlockSize(i);
+		usage[i].blockCount = sizeClass.blockCount;
+		usage[i].usedBytes = sizeClass.usedBytes;
+		usage[i].reservedBytes = sizeClass.slabs.size() * (slabSize + alignment - 1);
+	}
+	usage[sizeClassCount].blockSize = 0;
+	usage[sizeClassCount].blockCount = largeBlocks.size();
+	usage[sizeClassCount].usedBytes = largeUsedBytes;
+	usage[sizeClassCount].reservedBytes = largeReservedBytes;
+	return usage;
+}
+
+std::size_t ArenaAllocator::getBlockSize(std::size_t sizeClass)
+{
+	return std::size_t(1) << (minBlockShift + sizeClass);
+}
+
+ArenaAllocator::Byte * ArenaAllocator::alignPointer(Byte * pointer)
+{
+	auto address = reinterpret_cast<std::uintptr_t>(pointer);
+	return pointer + (alignment - address % alignment) % alignment;
+}
+
+void ArenaAllocator::addSlab(std::size_t sizeClassIndex)
+{
+	SizeClass & sizeClass = sizeClasses[sizeClassIndex];
+	std::size_t blockSize = getBlockSize(sizeClassIndex);
+	std::size_t blocksPerSlab = slabSize / blockSize;
+
+	// Block sizes are multiples of the alignment, so aligning the slab aligns all of its blocks
+	std::unique_ptr<Byte[]> slab(new Byte[blocksPerSlab * blockSize + alignment - 1]);
+	Byte * firstBlock = alignPointer(slab.get());
+	sizeClass.slabs.push_back(std::move(slab));
+
+	// Hand out blocks in address order
+	for (std::size_t i = blocksPerSlab; i > 0; --i)
+	{
+		sizeClass.freeBlocks.push_back(firstBlock + (i - 1) * blockSize);
+	}
+}
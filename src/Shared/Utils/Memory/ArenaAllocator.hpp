@@ -0,0 +1,80 @@
+#ifndef SRC_SHARED_UTILS_MEMORY_ARENAALLOCATOR_HPP_
+#define SRC_SHARED_UTILS_MEMORY_ARENAALLOCATOR_HPP_
+
+#include <Shared/Utils/HashTable.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/**
+ * Allocates aligned memory blocks. Small blocks are carved out of slabs by power-of-two size class and recycled via
+ * per-class free lists; large blocks are allocated individually. Slab memory is only released on clear().
+ */
+class ArenaAllocator
+{
+public:
+	using Byte = std::uint8_t;
+
+	/**
+	 * Alignment of all blocks in bytes (a cache line, and suitable for any SIMD register width).
+	 */
+	static constexpr std::size_t alignment = 64;
+
+	struct Block
+	{
+		Byte * data = nullptr;
+		std::size_t size = 0;
+		std::size_t sizeClass = 0;
+	};
+
+	struct SizeClassUsage
+	{
+		// Block size of the class, or 0 for individually allocated blocks
+		std::size_t blockSize = 0;
+		std::size_t blockCount = 0;
+		std::size_t usedBytes = 0;
+		std::size_t reservedBytes = 0;
+	};
+
+	ArenaAllocator();
+	~ArenaAllocator();
+
+	ArenaAllocator(const ArenaAllocator &) = delete;
+	ArenaAllocator & operator=(const ArenaAllocator &) = delete;
+
+	/**
+	 * Allocates a block of at least 'size' bytes. Blocks are zero-filled unless 'zeroInitialize' is false.
+	 */
+	Block allocate(std::size_t size, bool zeroInitialize = true);
+	void deallocate(const Block & block);
+
+	/**
+	 * Releases all memory. Blocks allocated before are invalidated.
+	 */
+	void clear();
+
+	std::vector<SizeClassUsage> getUsage() const;
+
+private:
+	struct SizeClass
+	{
+		std::vector<std::unique_ptr<Byte[]>> slabs;
+		std::vector<Byte *> freeBlocks;
+		std::size_t blockCount = 0;
+		std::size_t usedBytes = 0;
+	};
+
+	static std::size_t getBlockSize(std::size_t sizeClass);
+	static Byte * alignPointer(Byte * pointer);
+
+	void addSlab(std::size_t sizeClass);
+
+	std::vector<SizeClass> sizeClasses;
+
+	HashMap<Byte *, std::unique_ptr<Byte[]>> largeBlocks;
+	std::size_t largeUsedBytes = 0;
+	std::size_t largeReservedBytes = 0;
+};
+
+#endif
@@ -2,6 +2,10 @@
 
 #include <Shared/Utils/Debug/CrashHandler.hpp>
 #include <Shared/Utils/MiscMath.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
 
 ThreadPool::ThreadPool() :
 	ThreadPool(getDefaultThreadCount())
@@ -42,6 +46,86 @@ void ThreadPool::submit(WorkItem item)
 	queueCondition.notify_one();
 }
 
+void ThreadPool::parallelFor(std::size_t count, std::size_t grainSize, const RangeFunc & func)
+{
+	grainSize = std::max<std::size_t>(grainSize, 1);
+	std::size_t chunkCount = (count + grainSize - 1) / grainSize;
+
+	if (chunkCount <= 1 || threads.empty())
+	{
+		if (count > 0)
+		{
+			func(0, count);
+		}
+		return;
+	}
+
+	struct State
+	{
+		RangeFunc func;
+		std::size_t count;
+		std::size_t chunkSize;
+		std::size_t chunkCount;
+
+		std::atomic<std::size_t> nextChunk {0};
+		std::atomic<std::size_t> finishedChunks {0};
+
+		std::mutex mutex;
+		std::condition_variable finished;
+		std::exception_ptr exception;
+	};
+
+	// Helper items may start after all chunks are done, so the state is kept alive by each of them
+	auto state = std::make_shared<State>();
+	state->func = func;
+	state->count = count;
+	state->chunkSize = (count + chunkCount - 1) / chunkCount;
+	state->chunkCount = chunkCount;
+
+	auto processChunks = [](State & state) {
+		std::size_t chunk;
+		while ((chunk = state.nextChunk++) < state.chunkCount)
+		{
+			std::size_t begin = chunk * state.chunkSize;
+			try
+			{
+				state.func(begin, std::min(begin + state.chunkSize, state.count));
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> guard(state.mutex);
+				state.exception = std::current_exception();
+			}
+
+			if (++state.finishedChunks == state.chunkCount)
+			{
+				std::lock_guard<std::mutex> guard(state.mutex);
+				state.finished.notify_all();
+			}
+		}
+	};
+
+	std::size_t helperCount = std::min(threads.size(), chunkCount - 1);
+	for (std::size_t i = 0; i < helperCount; ++i)
+	{
+		submit([state, processChunks]() {
+			processChunks(*state);
+		});
+	}
+
+	processChunks(*state);
+
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->finished.wait(lock, [&state]() {
+		return state->finishedChunks == state->chunkCount;
+	});
+
+	if (state->exception)
+	{
+		std::rethrow_exception(state->exception);
+	}
+}
+
 std::size_t ThreadPool::getThreadCount() const
 {
 	return threads.size();
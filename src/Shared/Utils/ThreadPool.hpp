@@ -14,6 +14,7 @@ class ThreadPool
 {
 public:
 	using WorkItem = std::function<void()>;
+	using RangeFunc = std::function<void(std::size_t begin, std::size_t end)>;
 
 	ThreadPool();
 	ThreadPool(std::size_t threadCount);
@@ -24,6 +25,15 @@ public:
 
 	void submit(WorkItem item);
 
+	/**
+	 * Splits the range [0, count) into chunks of at least 'grainSize' elements and processes them in parallel,
+	 * blocking until all chunks are done. The calling thread processes chunks as well, so this also completes if all
+	 * pool threads are busy with other work items.
+	 *
+	 * Exceptions thrown by the function are rethrown on the calling thread.
+	 */
+	void parallelFor(std::size_t count, std::size_t grainSize, const RangeFunc & func);
+
 	std::size_t getThreadCount() const;
 
 	static std::size_t getDefaultThreadCount();